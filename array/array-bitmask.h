@@ -0,0 +1,393 @@
+#pragma once
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @file
+
+ This file defines bit-packed boolean arrays. A mask uses a single bit per element instead of the byte per element of the
+ Array<ui8> returned by the logical operators (see array-op-logical.h), so that large masks can be produced and combined
+ with 8 times less memory traffic.
+
+ The comparisons producing a mask are vectorized for float and double, the combinations of masks (&, |, ^, ~) and
+ @ref count_nonzero are processed 64 elements at a time.
+ */
+
+/**
+ @brief N-dimensional array of bits
+
+ The bits are stored in the row-major order of the elements (the first dimension varies the fastest) in 64-bit words.
+ The bits of the last word beyond the last element are always 0.
+ */
+template <size_t N>
+class BitMask
+{
+public:
+   using word_type                = std::uint64_t;
+   using index_type               = StaticVector<ui32, N>;
+   static const size_t RANK       = N;
+   static const ui32 nb_word_bits = 64;
+
+   BitMask() = default;
+
+   explicit BitMask(const index_type& shape, bool value = false) : _shape(shape)
+   {
+      _size = 1;
+      for (size_t n = 0; n < N; ++n)
+      {
+         _size *= shape[n];
+      }
+      _words.resize((_size + nb_word_bits - 1) / nb_word_bits, value ? ~word_type(0) : word_type(0));
+      clearPadding();
+   }
+
+   const index_type& shape() const
+   {
+      return _shape;
+   }
+
+   size_t size() const
+   {
+      return _size;
+   }
+
+   /**
+    @brief The number of 64-bit words storing the bits
+    */
+   size_t getNbWords() const
+   {
+      return _words.size();
+   }
+
+   word_type* data()
+   {
+      return _words.data();
+   }
+
+   const word_type* data() const
+   {
+      return _words.data();
+   }
+
+   /**
+    @brief Return the position of the bit of an element
+    */
+   size_t position(const index_type& index) const
+   {
+      size_t position = 0;
+      for (size_t n = N; n > 0; --n)
+      {
+         NLL_FAST_ASSERT(index[n - 1] < _shape[n - 1], "out of bounds!");
+         position = position * _shape[n - 1] + index[n - 1];
+      }
+      return position;
+   }
+
+   bool operator()(const index_type& index) const
+   {
+      const size_t p = position(index);
+      return (_words[p / nb_word_bits] >> (p % nb_word_bits)) & 1;
+   }
+
+   template <class... Values, typename = typename std::enable_if<sizeof...(Values) == N>::type>
+   bool operator()(Values... values) const
+   {
+      return operator()(index_type(values...));
+   }
+
+   void set(const index_type& index, bool value)
+   {
+      const size_t p   = position(index);
+      const word_type bit = word_type(1) << (p % nb_word_bits);
+      word_type& word  = _words[p / nb_word_bits];
+      word             = value ? word | bit : word & ~bit;
+   }
+
+   bool operator==(const BitMask& other) const
+   {
+      return _shape == other._shape && _words == other._words;
+   }
+
+   bool operator!=(const BitMask& other) const
+   {
+      return !(*this == other);
+   }
+
+   BitMask& operator&=(const BitMask& other)
+   {
+      return apply(other, [](word_type a, word_type b) { return a & b; });
+   }
+
+   BitMask& operator|=(const BitMask& other)
+   {
+      return apply(other, [](word_type a, word_type b) { return a | b; });
+   }
+
+   BitMask& operator^=(const BitMask& other)
+   {
+      return apply(other, [](word_type a, word_type b) { return a ^ b; });
+   }
+
+   /**
+    @brief Invert all the bits
+    */
+   BitMask& flip()
+   {
+      for (auto& word : _words)
+      {
+         word = ~word;
+      }
+      clearPadding();
+      return *this;
+   }
+
+private:
+   template <class Op>
+   BitMask& apply(const BitMask& other, Op op)
+   {
+      ensure(_shape == other._shape, "the masks must have the same shape!");
+      word_type* words             = _words.data();
+      const word_type* other_words = other._words.data();
+      const size_t nb_words        = _words.size();
+      for (size_t n = 0; n < nb_words; ++n)
+      {
+         words[n] = op(words[n], other_words[n]);
+      }
+      return *this;
+   }
+
+   void clearPadding()
+   {
+      const size_t nb_bits_last = _size % nb_word_bits;
+      if (nb_bits_last)
+      {
+         _words.back() &= (word_type(1) << nb_bits_last) - 1;
+      }
+   }
+
+private:
+   index_type _shape;
+   size_t _size = 0;
+   std::vector<word_type> _words;
+};
+
+template <size_t N>
+BitMask<N> operator&(const BitMask<N>& m1, const BitMask<N>& m2)
+{
+   BitMask<N> result = m1;
+   return result &= m2;
+}
+
+template <size_t N>
+BitMask<N> operator|(const BitMask<N>& m1, const BitMask<N>& m2)
+{
+   BitMask<N> result = m1;
+   return result |= m2;
+}
+
+template <size_t N>
+BitMask<N> operator^(const BitMask<N>& m1, const BitMask<N>& m2)
+{
+   BitMask<N> result = m1;
+   return result ^= m2;
+}
+
+template <size_t N>
+BitMask<N> operator~(const BitMask<N>& m1)
+{
+   BitMask<N> result = m1;
+   return result.flip();
+}
+
+template <size_t N>
+BitMask<N> operator!(const BitMask<N>& m1)
+{
+   return ~m1;
+}
+
+namespace details
+{
+inline ui32 popcount(std::uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return static_cast<ui32>(__builtin_popcountll(word));
+#else
+   word = word - ((word >> 1) & 0x5555555555555555ull);
+   word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+   word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+   return static_cast<ui32>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ @brief OR the @p nb_bits first bits of @p bits in @p words, starting at the bit @p position
+
+ The bits of @p bits after @p nb_bits must be 0
+ */
+inline void or_bits(std::uint64_t* words, size_t position, const std::uint64_t* bits, size_t nb_bits)
+{
+   const ui32 shift          = static_cast<ui32>(position % 64);
+   std::uint64_t* dst        = words + position / 64;
+   const size_t nb_bits_words = (nb_bits + 63) / 64;
+   for (size_t n = 0; n < nb_bits_words; ++n)
+   {
+      dst[n] |= bits[n] << shift;
+      if (shift)
+      {
+         // only write the next word if it holds bits of the line: it may be past the end of the mask
+         const std::uint64_t high = bits[n] >> (64 - shift);
+         if (high)
+         {
+            dst[n + 1] |= high;
+         }
+      }
+   }
+}
+
+/**
+ @brief Compare a memory line of a1 with a strided line of a2 (or with @p value if @p ptr_a2 is nullptr) and store the result in
+        the bits [position, position + nb_elements) of the mask
+
+ Unit-stride lines are compared by blocks with the SIMD kernels and the packed bits are merged in the mask
+ */
+template <class T>
+void compare_line(std::uint64_t* words, size_t position, const T* ptr_a1, ui32 stride_a1, const T* ptr_a2, ui32 stride_a2, T value,
+                  Comparison comparison, ui32 nb_elements)
+{
+   static const ui32 block_size = 4096;
+   std::uint64_t block[block_size / 64];
+
+   const bool unit_stride = stride_a1 == 1 && (ptr_a2 == nullptr || stride_a2 == 1);
+   for (ui32 begin = 0; begin < nb_elements; begin += block_size)
+   {
+      const ui32 size = std::min(block_size, nb_elements - begin);
+      const T* v1     = ptr_a1 + static_cast<size_t>(begin) * stride_a1;
+      const T* v2     = ptr_a2 ? ptr_a2 + static_cast<size_t>(begin) * stride_a2 : nullptr;
+      if (!unit_stride || !simd::compare(block, v1, v2, value, comparison, size))
+      {
+         std::fill_n(block, (size + 63) / 64, std::uint64_t(0));
+         for (ui32 n = 0; n < size; ++n)
+         {
+            const bool bit = compare_values(v1[n * stride_a1], v2 ? v2[n * stride_a2] : value, comparison);
+            block[n / 64] |= std::uint64_t(bit) << (n % 64);
+         }
+      }
+      or_bits(words, position + begin, block, size);
+   }
+}
+
+template <class T, size_t N, class Config, class T2, class Config2>
+BitMask<N> bitmask(const Array<T, N, Config>& a1, const Array<T2, N, Config2>* a2, typename std::remove_cv<T>::type value, Comparison comparison)
+{
+   using value_type = typename std::remove_cv<T>::type;
+   static_assert(std::is_same<value_type, typename std::remove_cv<T2>::type>::value, "must have the same type!");
+   using array_type         = Array<T, N, Config>;
+   using const_pointer_type = typename array_type::const_pointer_type;
+   using index_type         = typename array_type::index_type;
+
+   BitMask<N> mask(a1.shape());
+   if (a1.size() == 0)
+   {
+      return mask;
+   }
+
+   // the bits of the memory lines along the first dimension are consecutive. For the other dimensions, each bit is set individually
+   auto op = [&](const_pointer_type ptr_a1, ui32 stride_a1, ui32 nb_elements, const index_type& index, ui32 varying_index) {
+      const value_type* ptr_a2 = nullptr;
+      ui32 stride_a2           = 0;
+      if (a2)
+      {
+         ptr_a2    = &(*a2)(index);
+         stride_a2 = a2->getMemory().getIndexMapper()._getPhysicalStrides()[varying_index];
+      }
+
+      if (varying_index == 0)
+      {
+         compare_line(mask.data(), mask.position(index), ptr_a1, stride_a1, ptr_a2, stride_a2, value, comparison, nb_elements);
+         return;
+      }
+
+      auto element_index = index;
+      for (ui32 n = 0; n < nb_elements; ++n, ++element_index[varying_index])
+      {
+         mask.set(element_index, compare_values(ptr_a1[n * stride_a1], a2 ? (*a2)(element_index) : value, comparison));
+      }
+   };
+   iterate_constarray_index(a1, op);
+   return mask;
+}
+}
+
+/**
+ @brief Return the mask of the elements of @p a1 satisfying (element comparison value)
+
+ bitmask(a, Comparison::greater, 0.5f) is the packed version of (a > 0.5f)
+ */
+template <class T, size_t N, class Config, class T2, typename = typename std::enable_if<std::is_arithmetic<T2>::value>::type>
+BitMask<N> bitmask(const Array<T, N, Config>& a1, Comparison comparison, T2 value)
+{
+   using value_type = typename std::remove_cv<T>::type;
+   return details::bitmask(a1, static_cast<const Array<T, N, Config>*>(nullptr), static_cast<value_type>(value), comparison);
+}
+
+/**
+ @brief Return the mask of the elements satisfying (a1 comparison a2), elementwise
+
+ bitmask(a1, Comparison::less, a2) is the packed version of (a1 < a2)
+ */
+template <class T, size_t N, class Config, class T2, class Config2>
+BitMask<N> bitmask(const Array<T, N, Config>& a1, Comparison comparison, const Array<T2, N, Config2>& a2)
+{
+   ensure(a1.shape() == a2.shape(), "must have the same shape!");
+   return details::bitmask(a1, &a2, typename std::remove_cv<T>::type(), comparison);
+}
+
+/**
+ @brief Convert a ui8 mask (e.g., the result of a logical operator) to a bit mask: the non-zero elements are set
+ */
+template <class T, size_t N, class Config>
+BitMask<N> as_bitmask(const Array<T, N, Config>& mask)
+{
+   return bitmask(mask, Comparison::not_equal, 0);
+}
+
+/**
+ @brief Convert a bit mask to the ui8 mask returned by the logical operators
+ */
+template <size_t N>
+Array<ui8, N> as_array(const BitMask<N>& mask)
+{
+   using array_type   = Array<ui8, N>;
+   using pointer_type = typename array_type::pointer_type;
+   using index_type   = typename array_type::index_type;
+
+   array_type result(mask.shape());
+   auto op = [&](pointer_type ptr, ui32 stride, ui32 nb_elements, const index_type& index, ui32 varying_index) {
+      auto element_index = index;
+      for (ui32 n = 0; n < nb_elements; ++n, ++element_index[varying_index])
+      {
+         ptr[n * stride] = mask(element_index);
+      }
+   };
+   iterate_array_index(result, op);
+   return result;
+}
+
+/**
+ @brief Return the number of bits set
+ */
+template <size_t N>
+size_t count_nonzero(const BitMask<N>& mask)
+{
+   const std::uint64_t* words = mask.data();
+   const size_t nb_words      = mask.getNbWords();
+
+   size_t count = 0;
+   for (size_t n = 0; n < nb_words; ++n)
+   {
+      count += details::popcount(words[n]);
+   }
+   return count;
+}
+
+DECLARE_NAMESPACE_NLL_END
@@ -24,31 +24,18 @@ public:
    /**
     @param nbElementsToAccessPerIter the number of elements that will be read for each call to @p _accessElements
                                      if nbElementsToAccessPerIter == 0, the number of elements will be set to the maximum possible
+                                     if the memory line size is not a multiple of nbElementsToAccessPerIter, the last access of
+                                     each line is partial
     */
    ArrayChunking_contiguous_base(const index_type& shape, const index_type& indexesOrder, ui32 nbElementsToAccessPerIter) : _shape(shape)
    {
-      _indexesOrder    = indexesOrder;
-      ui32 nb_elements = 1;
+      _indexesOrder = indexesOrder;
       for (ui32 n = 0; n < _indexesOrder.size(); ++n)
       {
-         nb_elements *= shape[n];
          _indexesOrderInv[_indexesOrder[n]] = n;
          _sizeOrder[n]                      = shape[_indexesOrder[n]];
       }
-
-      const auto maxAccessElements = shape[_indexesOrder[0]];
-      if (nbElementsToAccessPerIter == 0)
-      {
-         _nbElementsToAccessPerIter = maxAccessElements;
-      }
-      else
-      {
-         _nbElementsToAccessPerIter = nbElementsToAccessPerIter;
-      }
-      ensure(_nbElementsToAccessPerIter == 1 || _nbElementsToAccessPerIter == maxAccessElements, "TODO handle different nbElements!");
-
-      // after calling _maxNbAccess times @ref _accessElements, all elements will have been read
-      _maxNbAccess = nb_elements / _nbElementsToAccessPerIter;
+      _setNbElementsPerAccess(nbElementsToAccessPerIter);
    }
 
    // access @ref _nbElementsToAccessPerIter elements
@@ -59,9 +46,27 @@ public:
       {
          Increment<0, false>::run(_iterator_index, _sizeOrder, _pointer_invalid, _nbElementsToAccessPerIter);
       }
+      _nbElementsCurrentAccess = std::min(_nbElementsToAccessPerIter, _sizeOrder[0] - _iterator_index[0]);
       return _currentAccess < _maxNbAccess;
    }
 
+   /**
+    @brief Return the number of elements of the current access. This is @ref _nbElementsToAccessPerIter except for the last access of a memory line
+    */
+   ui32 getNbElementsCurrentAccess() const
+   {
+      return _nbElementsCurrentAccess;
+   }
+
+   /**
+    @brief Change the number of elements read for each access. This must be called before the first access and before @ref restrictAccesses
+    */
+   void setNbElementsPerAccess(ui32 nbElementsToAccessPerIter)
+   {
+      ensure(_currentAccess == 0, "the traversal has already started!");
+      _setNbElementsPerAccess(nbElementsToAccessPerIter);
+   }
+
    bool finished() const
    {
       return _currentAccess >= _maxNbAccess;
@@ -73,14 +78,29 @@ public:
       return _iterator_index;
    }
 
+   // this is the shape of the array reordered by <functor>, accounting for the coalesced dimensions
+   const index_type& getIteratorShape() const
+   {
+      return _sizeOrder;
+   }
+
    // this returns the index in the array
    const index_type getArrayIndex() const
    {
+      // a coalesced memory line spans several dimensions: an access may start in the middle of the line (e.g., split between threads)
+      index_type iteratorIndex = _iterator_index;
+      for (size_t n = 0; n + 1 < _nbCoalescedDimensions; ++n)
+      {
+         const ui32 size      = _shape[_indexesOrder[n]];
+         iteratorIndex[n + 1] = iteratorIndex[n] / size;
+         iteratorIndex[n] %= size;
+      }
+
       index_type indexReordered; // start with min offset
       for (size_t n = 0; n < Array::RANK; ++n)
       {
          // currently the index is expressed from fastest to lowest varying speed so transform it back
-         indexReordered[n] += _iterator_index[_indexesOrderInv[n]];
+         indexReordered[n] += iteratorIndex[_indexesOrderInv[n]];
       }
       return indexReordered;
    }
@@ -103,7 +123,86 @@ public:
       _currentAccess = _maxNbAccess;
    }
 
+   /**
+    @brief Return the number of calls to @ref _accessElements required to visit all the elements
+    */
+   ui32 getNbAccesses() const
+   {
+      return _maxNbAccess;
+   }
+
+   /**
+    @brief Traverse the @p nbDimensions fastest varying dimensions as a single memory line
+
+    This is only valid if the memory of these dimensions can be addressed with a single stride and if the full
+    memory line is accessed at once. This must be called before the first access and before @ref restrictAccesses.
+    */
+   void coalesceDimensions(ui32 nbDimensions)
+   {
+      ensure(_currentAccess == 0, "the traversal has already started!");
+      ensure(nbDimensions >= 1 && nbDimensions <= Array::RANK, "invalid number of dimensions!");
+      ensure(_nbElementsToAccessPerIter == _sizeOrder[0], "only full memory lines can be coalesced!");
+
+      for (size_t n = 1; n < nbDimensions; ++n)
+      {
+         _sizeOrder[0] *= _sizeOrder[n];
+         _sizeOrder[n] = 1;
+      }
+      _nbCoalescedDimensions = std::max(_nbCoalescedDimensions, nbDimensions);
+      _setNbElementsPerAccess(0);
+   }
+
+   /**
+    @brief Restrict the traversal to the accesses [access_begin, access_end)
+
+    This must be called before the first access. It is used to split a traversal between several threads:
+    each thread has its own chunking restricted to a different range of accesses.
+    */
+   void restrictAccesses(ui32 access_begin, ui32 access_end)
+   {
+      ensure(_currentAccess == 0, "the traversal has already started!");
+      ensure(access_begin <= access_end && access_end <= _maxNbAccess, "invalid range of accesses!");
+
+      if (_nbAccessesPerLine)
+      {
+         // the accesses are ordered from the fastest to the slowest varying index
+         _iterator_index[0] = (access_begin % _nbAccessesPerLine) * _nbElementsToAccessPerIter;
+         ui32 line          = access_begin / _nbAccessesPerLine;
+         for (size_t n = 1; n < Array::RANK; ++n)
+         {
+            _iterator_index[n] = line % _sizeOrder[n];
+            line /= _sizeOrder[n];
+         }
+      }
+
+      _maxNbAccess     = access_end - access_begin;
+      _pointer_invalid = true;
+   }
+
 protected:
+   void _setNbElementsPerAccess(ui32 nbElementsToAccessPerIter)
+   {
+      const ui32 maxAccessElements = _sizeOrder[0];
+      if (nbElementsToAccessPerIter == 0 || nbElementsToAccessPerIter > maxAccessElements)
+      {
+         _nbElementsToAccessPerIter = maxAccessElements;
+      }
+      else
+      {
+         _nbElementsToAccessPerIter = nbElementsToAccessPerIter;
+      }
+      _nbElementsCurrentAccess = _nbElementsToAccessPerIter;
+
+      // after calling _maxNbAccess times @ref _accessElements, all elements will have been read
+      ui32 nb_lines = 1;
+      for (size_t n = 1; n < Array::RANK; ++n)
+      {
+         nb_lines *= _sizeOrder[n];
+      }
+      _nbAccessesPerLine = _nbElementsToAccessPerIter ? (maxAccessElements + _nbElementsToAccessPerIter - 1) / _nbElementsToAccessPerIter : 0;
+      _maxNbAccess       = nb_lines * _nbAccessesPerLine;
+   }
+
    template <int I, bool B>
    struct Increment
    {
@@ -111,7 +210,7 @@ protected:
                                    ui32 nbElements)
       {
          index[I] += nbElements;
-         if (index[I] == size[I])
+         if (index[I] >= size[I]) // the last access of a memory line may be partial
          {
             recomputeIterator = true;
             for (size_t n = 0; n <= I; ++n)
@@ -137,8 +236,11 @@ protected:
 protected:
    bool _pointer_invalid = true;
    ui32 _nbElementsToAccessPerIter; // this defines how many elements will be read during a single iteration
+   ui32 _nbElementsCurrentAccess;   // the number of elements of the current access (the last access of a line may be partial)
+   ui32 _nbAccessesPerLine;         // number of accesses to read a full memory line
    ui32 _maxNbAccess;               // after this number of @p _accessElements calls, all elements will have been accessed
    ui32 _currentAccess = 0;         // so far the current number of @p _accessElements calls
+   ui32 _nbCoalescedDimensions = 1; // number of dimensions traversed as a single memory line
    index_type _iterator_index;      // the current index
    index_type _shape;               // shape of the mapped array
    index_type _sizeOrder;           // the size, ordered by <_indexesOrder>
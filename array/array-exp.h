@@ -5,24 +5,83 @@
 
  This file implements expression templates and contrary to most other libraries, the purpose is not to
  avoid temporaries but to use as much as possible the BLAS interface. In particular, this code has been
- strongly inspired from : 
- "A C++ 11 implementation of arbitrary-rank tensors for high-performance computing", Alejandro M. Aragon
+ strongly inspired from :
+ "A C++ 11 implementation of arbitrary-rank tensors for high-performance computing", Alejandro M. Aragon
  https://github.com/guyz/cpp-array/tree/master/array
 
  Often we want to be able to use Array of the same rank and type but with a different Config parameter,
  in particular to enable custom-fixed memory allocator with general purpose heap allocators.
- */
 
-#ifdef WITH_EXPRESSION_TEMPLATE
+ The operators of the arrays for which @ref array_use_naive_operator is false (i.e., the BLAS arrays when
+ WITH_EXPRESSION_TEMPLATE is defined) build an expression that is evaluated when it is assigned. The expression
+ is a linear combination of terms alpha * X and alpha * X * Y (matrix * matrix or matrix * vector) mapped to BLAS:
+
+ @code
+ C = alpha * A * B + beta * C; // a single gemm
+ y = A * x + y;                // a single gemv
+ Y += a * X;                   // a single axpy
+ C = A * B - 2 * D;            // gemm, then axpy
+ @endcode
+
+ The scalars are folded in the alpha of the BLAS calls and the terms of the destination in the beta of the first product
+ (or a scal). The operands of the products that are not arrays (e.g., (A + B) * C) are evaluated in temporaries. If the
+ destination is used elsewhere than in a term alpha * C (e.g., C = A * C), the expression is evaluated in a temporary.
+
+ The expressions reference the arrays and own the temporary arrays moved in them, so auto e = A * B + C is valid
+ as long as A, B and C are alive. The functions taking an Array must be given an evaluated expression,
+ e.g., sum(Matrix<float>(A * B)).
+ */
 
 DECLARE_NAMESPACE_NLL
 
+namespace details
+{
+template <class T, class Config, class Config2, class Config3>
+void gemm(bool trans_a, bool trans_b, T alpha, const Array<T, 2, Config>& opa, const Array<T, 2, Config2>& opb, T beta, Array<T, 2, Config3>& opc);
+
+template <class T, class Config, class Config2, class Config3>
+void gemv(bool trans_a, T alpha, const Array<T, 2, Config>& opa, const Array<T, 1, Config2>& x, T beta, Array<T, 1, Config3>& y);
+
+template <class E>
+typename E::result_type expr_evaluate(const E& expression);
+
+template <class T, size_t N, class Config, class E>
+void expr_accumulate(Array<T, N, Config>& output, const E& expression, T beta, T scale);
+
 /**
-@brief Simplify the std::enable_if expression so that it is readable
-*/
-template <class T, int N, class Config>
-using Array_TemplateExpressionEnabled = typename std::enable_if<!array_use_naive_operator<Array<T, N, Config>>::value, Array<T, N, Config>>::type;
+ @brief The result of a product: T * array, array * T, matrix * matrix or matrix * vector
+ */
+template <class A, class B>
+struct ExprMulResult;
+
+template <class T, size_t N, class Config>
+struct ExprMulResult<T, Array<T, N, Config>>
+{
+   using type = Array<T, N, Config>;
+};
+
+template <class T, size_t N, class Config>
+struct ExprMulResult<Array<T, N, Config>, T>
+{
+   using type = Array<T, N, Config>;
+};
+
+template <class T, class Config, class Config2>
+struct ExprMulResult<Array<T, 2, Config>, Array<T, 2, Config2>>
+{
+   using type = Array<T, 2, Config>;
+};
+
+template <class T, class Config, class Config2>
+struct ExprMulResult<Array<T, 2, Config>, Array<T, 1, Config2>>
+{
+   using type = Array<T, 1, Config2>;
+};
+}
 
+/**
+ @brief A scalar of an expression
+ */
 template <typename T>
 class ExprConstant
 {
@@ -30,11 +89,7 @@ public:
    using value_type  = T;
    using result_type = T;
 
-   ExprConstant(value_type value) : _value(value)
-   {
-   }
-
-   ExprConstant() : _value(value)
+   explicit ExprConstant(value_type value) : _value(value)
    {
    }
 
@@ -47,6 +102,39 @@ private:
    T _value;
 };
 
+/**
+ @brief An array of an expression. It is referenced if Storage is a reference, else it is owned (i.e., a temporary moved in the expression)
+ */
+template <class ArrayT, class Storage>
+class ExprArray
+{
+public:
+   using result_type = ArrayT;
+   using value_type  = typename ArrayT::value_type;
+   using index_type  = typename ArrayT::index_type;
+
+   explicit ExprArray(const result_type& array) : _array(array)
+   {
+   }
+
+   explicit ExprArray(result_type&& array) : _array(std::move(array))
+   {
+   }
+
+   const result_type& operator()() const
+   {
+      return _array;
+   }
+
+   const index_type& shape() const
+   {
+      return _array.shape();
+   }
+
+private:
+   Storage _array;
+};
+
 template <class A>
 class Expr
 {
@@ -55,9 +143,16 @@ class Expr
 public:
    using expression_type = A;
    using result_type     = typename A::result_type;
+   using value_type      = typename result_type::value_type;
+   using index_type      = typename result_type::index_type;
+
+   explicit Expr(A x) : _a(std::move(x))
+   {
+   }
 
-   Expr(const A& x) : _a(x)
+   const expression_type& expression() const
    {
+      return _a;
    }
 
    auto left() const -> decltype(_a.left())
@@ -70,224 +165,842 @@ public:
       return _a.right();
    }
 
-   operator result_type()
+   index_type shape() const
    {
-      return _a();
+      return _a.shape();
    }
 
    result_type operator()() const
    {
-      return _a();
+      return details::expr_evaluate(_a);
    }
 };
 
 template <class A, class B, class Op>
 class ExprBinOp
 {
-   const A& _left;
-   const B& _right;
+   A _left;
+   B _right;
 
 public:
-   using left_type     = const A&;
-   using right_type    = const B&;
+   using left_type     = A;
+   using right_type    = B;
    using operator_type = Op;
-   //using result_type = decltype( operator_type::apply( *( (A*)( nullptr ) ), *( (B*)( nullptr ) ) ) );
-   using result_type = decltype(operator_type::apply(A(), B()));
+   using result_type   = typename operator_type::template result<typename A::result_type, typename B::result_type>::type;
+   using index_type    = typename result_type::index_type;
 
-   ExprBinOp(const A& left, const B& right) : _left(left), _right(right)
+   ExprBinOp(A left, B right) : _left(std::move(left)), _right(std::move(right))
    {
    }
 
-   left_type left() const
+   const left_type& left() const
    {
       return _left;
    }
 
-   right_type right() const
+   const right_type& right() const
    {
       return _right;
    }
 
-   result_type operator()() const
+   index_type shape() const
+   {
+      return operator_type::shape(_left, _right);
+   }
+};
+
+class OpAdd
+{
+public:
+   template <class A, class B>
+   struct result
+   {
+      using type = A;
+   };
+
+   template <class A, class B>
+   static typename A::index_type shape(const A& lhs, const B& rhs)
    {
-      return operator_type::apply(_left, _right);
+      ensure(lhs.shape() == rhs.shape(), "must have the same shape!");
+      return lhs.shape();
+   }
+};
+
+class OpSub : public OpAdd
+{
+};
+
+class OpMul
+{
+public:
+   template <class A, class B>
+   using result = details::ExprMulResult<A, B>;
+
+   // scalar * array
+   template <class T, class B>
+   static typename B::index_type shape(const ExprConstant<T>&, const B& rhs)
+   {
+      return rhs.shape();
+   }
+
+   // array * scalar
+   template <class A, class T>
+   static typename A::index_type shape(const A& lhs, const ExprConstant<T>&)
+   {
+      return lhs.shape();
+   }
+
+   // matrix * matrix, matrix * vector
+   template <class A, class B>
+   static typename details::ExprMulResult<typename A::result_type, typename B::result_type>::type::index_type shape(const A& lhs, const B& rhs)
+   {
+      return product_shape(lhs.shape(), rhs.shape());
+   }
+
+private:
+   static vector2ui product_shape(const vector2ui& lhs, const vector2ui& rhs)
+   {
+      ensure(lhs[1] == rhs[0], "op1.columns() must be equal to op2.rows()");
+      return vector2ui(lhs[0], rhs[1]);
+   }
+
+   static vector1ui product_shape(const vector2ui& lhs, const vector1ui& rhs)
+   {
+      ensure(lhs[1] == rhs[0], "matrix.columns() must be equal to vector.size()");
+      return vector1ui(lhs[0]);
+   }
+};
+
+class OpDiv
+{
+public:
+   // array / scalar
+   template <class A, class B>
+   struct result
+   {
+      using type = A;
+   };
+
+   template <class A, class T>
+   static typename A::index_type shape(const A& lhs, const ExprConstant<T>&)
+   {
+      return lhs.shape();
+   }
+};
+
+namespace details
+{
+/**
+ @brief Visit the terms of the linear combination of an expression: visitor.leaf(scale, array) for scale * array
+ and visitor.product(scale, lhs, rhs) for scale * lhs * rhs
+ */
+template <class E>
+struct ExprTerms;
+
+template <class ArrayT, class Storage>
+struct ExprTerms<ExprArray<ArrayT, Storage>>
+{
+   template <class T, class Visitor>
+   static void visit(const ExprArray<ArrayT, Storage>& e, T scale, Visitor& visitor)
+   {
+      visitor.leaf(scale, e());
+   }
+};
+
+template <class A>
+struct ExprTerms<Expr<A>>
+{
+   template <class T, class Visitor>
+   static void visit(const Expr<A>& e, T scale, Visitor& visitor)
+   {
+      ExprTerms<A>::visit(e.expression(), scale, visitor);
+   }
+};
+
+template <class A, class B>
+struct ExprTerms<ExprBinOp<A, B, OpAdd>>
+{
+   template <class T, class Visitor>
+   static void visit(const ExprBinOp<A, B, OpAdd>& e, T scale, Visitor& visitor)
+   {
+      ExprTerms<A>::visit(e.left(), scale, visitor);
+      ExprTerms<B>::visit(e.right(), scale, visitor);
+   }
+};
+
+template <class A, class B>
+struct ExprTerms<ExprBinOp<A, B, OpSub>>
+{
+   template <class T, class Visitor>
+   static void visit(const ExprBinOp<A, B, OpSub>& e, T scale, Visitor& visitor)
+   {
+      ExprTerms<A>::visit(e.left(), scale, visitor);
+      ExprTerms<B>::visit(e.right(), -scale, visitor);
+   }
+};
+
+template <class T2, class B>
+struct ExprTerms<ExprBinOp<ExprConstant<T2>, B, OpMul>>
+{
+   template <class T, class Visitor>
+   static void visit(const ExprBinOp<ExprConstant<T2>, B, OpMul>& e, T scale, Visitor& visitor)
+   {
+      ExprTerms<B>::visit(e.right(), scale * e.left()(), visitor);
+   }
+};
+
+template <class A, class T2>
+struct ExprTerms<ExprBinOp<A, ExprConstant<T2>, OpMul>>
+{
+   template <class T, class Visitor>
+   static void visit(const ExprBinOp<A, ExprConstant<T2>, OpMul>& e, T scale, Visitor& visitor)
+   {
+      ExprTerms<A>::visit(e.left(), scale * e.right()(), visitor);
+   }
+};
+
+template <class A, class B>
+struct ExprTerms<ExprBinOp<A, B, OpMul>>
+{
+   template <class T, class Visitor>
+   static void visit(const ExprBinOp<A, B, OpMul>& e, T scale, Visitor& visitor)
+   {
+      visitor.product(scale, e.left(), e.right());
+   }
+};
+
+template <class A, class T2>
+struct ExprTerms<ExprBinOp<A, ExprConstant<T2>, OpDiv>>
+{
+   template <class T, class Visitor>
+   static void visit(const ExprBinOp<A, ExprConstant<T2>, OpDiv>& e, T scale, Visitor& visitor)
+   {
+      ExprTerms<A>::visit(e.left(), scale / e.right()(), visitor);
+   }
+};
+
+/**
+ @brief Visit all the arrays of an expression, including the operands of the products
+ */
+template <class E>
+struct ExprLeaves;
+
+template <class T2>
+struct ExprLeaves<ExprConstant<T2>>
+{
+   template <class Visitor>
+   static void visit(const ExprConstant<T2>&, Visitor&)
+   {
+   }
+};
+
+template <class ArrayT, class Storage>
+struct ExprLeaves<ExprArray<ArrayT, Storage>>
+{
+   template <class Visitor>
+   static void visit(const ExprArray<ArrayT, Storage>& e, Visitor& visitor)
+   {
+      visitor(e());
+   }
+};
+
+template <class A>
+struct ExprLeaves<Expr<A>>
+{
+   template <class Visitor>
+   static void visit(const Expr<A>& e, Visitor& visitor)
+   {
+      ExprLeaves<A>::visit(e.expression(), visitor);
    }
 };
 
 template <class A, class B, class Op>
-class RefExprBinOp
+struct ExprLeaves<ExprBinOp<A, B, Op>>
 {
-   A& _left;
-   const B& _right;
+   template <class Visitor>
+   static void visit(const ExprBinOp<A, B, Op>& e, Visitor& visitor)
+   {
+      ExprLeaves<A>::visit(e.left(), visitor);
+      ExprLeaves<B>::visit(e.right(), visitor);
+   }
+};
+
+/**
+ @brief An operand of a product as scale * array. It is evaluated in a temporary if it is not a scaled array
+ */
+template <class E>
+class ExprFactor
+{
+public:
+   using array_type = typename E::result_type;
+   using value_type = typename array_type::value_type;
+
+   explicit ExprFactor(const E& e) : _array(expr_evaluate(e))
+   {
+   }
 
-   //  using _result = decltype( operator_type::apply( A(), B() ) ) &;
+   value_type scale() const
+   {
+      return 1;
+   }
 
+   const array_type& array() const
+   {
+      return _array;
+   }
+
+private:
+   array_type _array;
+};
+
+template <class ArrayT, class Storage>
+class ExprFactor<ExprArray<ArrayT, Storage>>
+{
 public:
-   using left_type     = A&;
-   using right_type    = const B&;
-   using operator_type = Op;
-   using result_type   = decltype(operator_type::apply(A(), B()))&;
+   using array_type = ArrayT;
+   using value_type = typename array_type::value_type;
 
-   RefExprBinOp(A& left, const B& right) : _left(left), _right(right)
+   explicit ExprFactor(const ExprArray<ArrayT, Storage>& e) : _array(e())
    {
    }
 
-   left_type left() const
+   value_type scale() const
    {
-      return _left;
+      return 1;
    }
 
-   right_type right() const
+   const array_type& array() const
    {
-      return _right;
+      return _array;
    }
 
-   result_type operator()() const
+private:
+   const array_type& _array;
+};
+
+template <class A>
+class ExprFactor<Expr<A>> : public ExprFactor<A>
+{
+public:
+   explicit ExprFactor(const Expr<A>& e) : ExprFactor<A>(e.expression())
    {
-      return operator_type::apply(_left, _right);
    }
 };
 
-class OpAdd;
-class OpSub;
-class OpMul;
+template <class T, class B>
+class ExprFactor<ExprBinOp<ExprConstant<T>, B, OpMul>> : public ExprFactor<B>
+{
+public:
+   explicit ExprFactor(const ExprBinOp<ExprConstant<T>, B, OpMul>& e) : ExprFactor<B>(e.right()), _scale(e.left()())
+   {
+   }
 
-template <class T, int N, class Config, class Config2>
-using ArrayArrayAdd = Expr<ExprBinOp<Array<T, N, Config>, Array<T, N, Config2>, OpAdd>>;
+   T scale() const
+   {
+      return _scale * ExprFactor<B>::scale();
+   }
 
-template <class T, int N, class Config>
-using ScalarArrayMul = Expr<ExprBinOp<ExprConstant<T>, Array<T, N, Config>, OpMul>>;
+private:
+   T _scale;
+};
 
-class OpAdd
+template <class A, class T>
+class ExprFactor<ExprBinOp<A, ExprConstant<T>, OpMul>> : public ExprFactor<A>
 {
 public:
-   /// Array + Array
-   template <class T, int N, class Config, class Config2>
-   static Array<T, N, Config> apply(const Array<T, N, Config>& lhs, const Array<T, N, Config2>& rhs)
+   explicit ExprFactor(const ExprBinOp<A, ExprConstant<T>, OpMul>& e) : ExprFactor<A>(e.left()), _scale(e.right()())
    {
-      Array<T, N, Config> cpy = lhs;
-      array_add(cpy, rhs);
-      return cpy;
    }
 
-   /*
-   template <class A, class B>
-   static decltype(A() + B())
-   apply( const Expr<A>& a, const Expr<B>& b )
+   T scale() const
    {
-      return a() + b();
-   }*/
+      return ExprFactor<A>::scale() * _scale;
+   }
+
+private:
+   T _scale;
+};
 
-   /// Array += Array
-   template <class T, int N, class Config, class Config2>
-   static Array<T, N, Config>& apply(Array<T, N, Config>& lhs, const Array<T, N, Config2>& rhs)
+template <class A, class T>
+class ExprFactor<ExprBinOp<A, ExprConstant<T>, OpDiv>> : public ExprFactor<A>
+{
+public:
+   explicit ExprFactor(const ExprBinOp<A, ExprConstant<T>, OpDiv>& e) : ExprFactor<A>(e.left()), _scale(e.right()())
    {
-      array_add(lhs, rhs);
-      return lhs;
    }
 
-   /*
-   /// Array += Expr
-   template <class T, int N, class Config, class B>
-   static Array<T, N, Config>& apply(Array<T, N, Config>& lhs, const Expr<B>& b)
+   T scale() const
    {
-      lhs += b();
-      return lhs;
-   }*/
+      return ExprFactor<A>::scale() / _scale;
+   }
+
+private:
+   T _scale;
 };
 
-class OpMul
+/**
+ @brief The address of the first and last elements of an array
+ */
+template <class T, size_t N, class Config>
+std::pair<const void*, const void*> expr_memory_range(const Array<T, N, Config>& array)
+{
+   using index_type = typename Array<T, N, Config>::index_type;
+   index_type last;
+   for (size_t n = 0; n < N; ++n)
+   {
+      last[n] = array.shape()[n] - 1;
+   }
+   return std::make_pair(static_cast<const void*>(&array(index_type())), static_cast<const void*>(&array(last)));
+}
+
+/**
+ @brief Returns true if the memory of the arrays may overlap
+ */
+template <class T, size_t N, class Config, class T2, size_t N2, class Config2>
+bool expr_overlap(const Array<T, N, Config>& a1, const Array<T2, N2, Config2>& a2)
+{
+   if (a1.size() == 0 || a2.size() == 0)
+   {
+      return false;
+   }
+
+   const auto range1 = expr_memory_range(a1);
+   const auto range2 = expr_memory_range(a2);
+   const std::less<const void*> less;
+   return !less(range1.second, range2.first) && !less(range2.second, range1.first);
+}
+
+/**
+ @brief Returns true if the arrays reference exactly the same elements, e.g., an array and an ArrayRef of the whole array
+ */
+template <class T, size_t N, class Config>
+bool expr_same_array(const Array<T, N, Config>& a1, const Array<T, N, Config>& a2)
+{
+   if (&a1 == &a2)
+   {
+      return true;
+   }
+   if (a1.shape() != a2.shape() || a1.size() == 0)
+   {
+      return false;
+   }
+
+   // the first and last elements and the step in each dimension
+   using index_type = typename Array<T, N, Config>::index_type;
+   if (expr_memory_range(a1) != expr_memory_range(a2))
+   {
+      return false;
+   }
+   for (size_t n = 0; n < N; ++n)
+   {
+      if (a1.shape()[n] > 1)
+      {
+         index_type index;
+         index[n] = 1;
+         if (&a1(index) != &a2(index))
+         {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+template <class A1, class A2>
+bool expr_same_array(const A1&, const A2&)
+{
+   return false;
+}
+
+/**
+ @brief Find the terms alpha * output of an expression and if output is read by other terms
+ */
+template <class Output>
+class ExprAliasing
 {
 public:
-   // scalar * array
-   template <typename T, size_t N, class Config>
-   static Array<T, N, Config> apply(const ExprConstant<T>& a, const Array<T, N, Config>& b)
+   using value_type = typename Output::value_type;
+
+   explicit ExprAliasing(const Output& output) : _output(output)
    {
-      Array<T, N, Config> r = b;
-      details::array_mul(r, a());
-      return r;
    }
 
-   // array * scalar
-   template <typename T, size_t N, class Config>
-   static Array<T, N, Config> apply(const Array<T, N, Config>& b, const ExprConstant<T>& a)
+   template <class ArrayT>
+   void leaf(value_type scale, const ArrayT& array)
+   {
+      if (expr_same_array(array, _output))
+      {
+         _scale += scale;
+      }
+      else
+      {
+         _hazard |= expr_overlap(array, _output);
+      }
+   }
+
+   template <class L, class R>
+   void product(value_type, const L& lhs, const R& rhs)
+   {
+      auto read = [&](const auto& array) { _hazard |= expr_overlap(array, _output); };
+      ExprLeaves<L>::visit(lhs, read);
+      ExprLeaves<R>::visit(rhs, read);
+   }
+
+   /// sum of alpha of the terms alpha * output
+   value_type scale() const
+   {
+      return _scale;
+   }
+
+   /// true if output is read by the other terms: it can't be updated until the expression is evaluated
+   bool hazard() const
+   {
+      return _hazard;
+   }
+
+private:
+   const Output& _output;
+   value_type _scale = 0;
+   bool _hazard      = false;
+};
+
+template <class T, class Config, class Config2, class Config3>
+void expr_product(T alpha, const Array<T, 2, Config>& opa, const Array<T, 2, Config2>& opb, T beta, Array<T, 2, Config3>& opc)
+{
+   gemm(false, false, alpha, opa, opb, beta, opc);
+}
+
+template <class T, class Config, class Config2, class Config3>
+void expr_product(T alpha, const Array<T, 2, Config>& opa, const Array<T, 1, Config2>& x, T beta, Array<T, 1, Config3>& y)
+{
+   gemv(false, alpha, opa, x, beta, y);
+}
+
+template <class T, size_t N, class Config, class Config2>
+void expr_copy(Array<T, N, Config>& output, const Array<T, N, Config2>& input)
+{
+   using pointer_type       = typename Array<T, N, Config>::pointer_type;
+   using const_pointer_type = typename Array<T, N, Config2>::const_pointer_type;
+   auto op = [&](pointer_type y_pointer, ui32 y_stride, const_pointer_type x_pointer, ui32 x_stride, ui32 nb_elements) {
+      copy_naive(y_pointer, y_stride, x_pointer, x_stride, nb_elements);
+   };
+   iterate_array_constarray(output, input, op, Parallel());
+}
+
+/**
+ @brief Accumulate the terms of an expression in the output, which is pending a scaling by beta (0: the output is ignored)
+
+ The products are accumulated first so that beta is applied by the first gemm/gemv. The remaining scaling is applied by scal.
+ */
+template <class Output>
+class ExprAccumulator
+{
+public:
+   using value_type = typename Output::value_type;
+
+   ExprAccumulator(Output& output, value_type beta) : _output(output), _beta(beta)
+   {
+   }
+
+   template <class E>
+   void run(const E& expression, value_type scale)
+   {
+      _products = true;
+      ExprTerms<E>::visit(expression, scale, *this);
+      _products = false;
+      ExprTerms<E>::visit(expression, scale, *this);
+      if (_beta != 1)
+      {
+         scal(_output, _beta);
+      }
+   }
+
+   template <class L, class R>
+   void product(value_type scale, const L& lhs, const R& rhs)
+   {
+      if (_products)
+      {
+         const ExprFactor<L> a(lhs);
+         const ExprFactor<R> b(rhs);
+         expr_product(scale * a.scale() * b.scale(), a.array(), b.array(), _beta, _output);
+         _beta = 1;
+      }
+   }
+
+   template <class ArrayT>
+   void leaf(value_type scale, const ArrayT& array)
+   {
+      if (_products || expr_same_array(array, _output))
+      {
+         // the terms of the output are already in beta
+         return;
+      }
+
+      if (_beta == 0)
+      {
+         expr_copy(_output, array);
+         _beta = scale;
+      }
+      else
+      {
+         if (_beta != 1)
+         {
+            scal(_output, _beta);
+            _beta = 1;
+         }
+         axpy(scale, array, _output);
+      }
+   }
+
+private:
+   Output& _output;
+   value_type _beta;
+   bool _products = false;
+};
+
+/**
+ @brief Compute output = beta * output + scale * expression with a BLAS call per term of the expression
+
+ If beta is 0, output is resized to the shape of the expression
+ */
+template <class T, size_t N, class Config, class E>
+void expr_accumulate(Array<T, N, Config>& output, const E& expression, T beta, T scale)
+{
+   using output_type = Array<T, N, Config>;
+   const auto shape  = expression.shape();
+
+   ExprAliasing<output_type> aliasing(output);
+   ExprTerms<E>::visit(expression, scale, aliasing);
+   if (aliasing.hazard())
+   {
+      using result_type         = typename E::result_type;
+      const result_type result = expr_evaluate(expression);
+      expr_accumulate(output, ExprArray<result_type, const result_type&>(result), beta, scale);
+      return;
+   }
+
+   if (output.shape() != shape)
+   {
+      // the output is not a term of the expression
+      ensure(beta == 0, "must have the same shape!");
+      output = output_type(shape);
+   }
+
+   ExprAccumulator<output_type> accumulator(output, beta + aliasing.scale());
+   accumulator.run(expression, scale);
+}
+
+template <class E>
+typename E::result_type expr_evaluate(const E& expression)
+{
+   using result_type = typename E::result_type;
+   using value_type  = typename result_type::value_type;
+
+   result_type result;
+   expr_accumulate(result, expression, static_cast<value_type>(0), static_cast<value_type>(1));
+   return result;
+}
+
+template <class T, size_t N, class Config, class A>
+void expr_assign(Array<T, N, Config>& output, const Expr<A>& expression)
+{
+   expr_accumulate(output, expression.expression(), static_cast<T>(0), static_cast<T>(1));
+}
+
+template <class T, size_t N, class Config>
+Array<T, N, Config> expr_array_base(const Array<T, N, Config>*);
+
+void expr_array_base(...);
+
+template <class X>
+struct ExprValueType
+{
+   using type = void;
+};
+
+template <class A>
+struct ExprValueType<Expr<A>>
+{
+   using type = typename Expr<A>::value_type;
+};
+
+/**
+ @brief Convert an operand X (deduced as a forwarding reference) to a node of an expression
+
+ value is true for the expressions and the arrays using the expression templates. The lvalue arrays are referenced and the
+ temporary arrays are moved in the expression.
+ */
+template <class X, class Base = decltype(expr_array_base(std::declval<typename std::decay<X>::type*>()))>
+struct ExprOperand
+{
+   static const bool value = !array_use_naive_operator<Base>::value;
+   using value_type        = typename Base::value_type;
+   using storage_type      = typename std::conditional<std::is_same<X, Base>::value, Base, const Base&>::type;
+   using type              = ExprArray<Base, storage_type>;
+
+   static type make(X&& x)
    {
-      Array<T, N, Config> r = b;
-      details::array_mul(r, a());
-      return r;
+      return type(std::forward<X>(x));
    }
+};
+
+template <class X>
+struct ExprOperand<X, void>
+{
+   using type              = typename std::decay<X>::type;
+   using value_type        = typename ExprValueType<type>::type;
+   static const bool value = !std::is_same<value_type, void>::value;
 
-   // array *= scalar
-   template <typename T, size_t N, class Config>
-   static Array<T, N, Config>& apply(Array<T, N, Config>& b, const ExprConstant<T>& a)
+   static type make(X&& x)
    {
-      details::array_mul(b, a());
-      return b;
+      return std::forward<X>(x);
    }
 };
 
+template <class L, class R, class Op>
+using ExprBinary = typename std::enable_if<ExprOperand<L>::value && ExprOperand<R>::value &&
+                                               std::is_same<typename ExprOperand<L>::value_type, typename ExprOperand<R>::value_type>::value,
+                                           Expr<ExprBinOp<typename ExprOperand<L>::type, typename ExprOperand<R>::type, Op>>>::type;
+
+template <class L, class S, class Op>
+using ExprScalarRight = typename std::enable_if<ExprOperand<L>::value && std::is_convertible<S, typename ExprOperand<L>::value_type>::value,
+                                                Expr<ExprBinOp<typename ExprOperand<L>::type, ExprConstant<typename ExprOperand<L>::value_type>, Op>>>::type;
+
+template <class S, class R, class Op>
+using ExprScalarLeft = typename std::enable_if<ExprOperand<R>::value && std::is_convertible<S, typename ExprOperand<R>::value_type>::value,
+                                               Expr<ExprBinOp<ExprConstant<typename ExprOperand<R>::value_type>, typename ExprOperand<R>::type, Op>>>::type;
+
+template <class Output, class X>
+using ExprCompound = typename std::enable_if<!array_use_naive_operator<Output>::value && ExprOperand<X>::value, Output&>::type;
+
+template <class Output, class S>
+using ExprCompoundScalar =
+    typename std::enable_if<!array_use_naive_operator<Output>::value && std::is_convertible<S, typename Output::value_type>::value, Output&>::type;
+
+template <class A, class S>
+using ExprMaterialized = typename std::enable_if<std::is_convertible<S, typename Expr<A>::value_type>::value, typename Expr<A>::result_type>::type;
+
+template <class Op, class L, class R>
+Expr<ExprBinOp<typename ExprOperand<L>::type, typename ExprOperand<R>::type, Op>> expr_make(L&& lhs, R&& rhs)
+{
+   using node_type = ExprBinOp<typename ExprOperand<L>::type, typename ExprOperand<R>::type, Op>;
+   return Expr<node_type>(node_type(ExprOperand<L>::make(std::forward<L>(lhs)), ExprOperand<R>::make(std::forward<R>(rhs))));
+}
+}
+
 //
-// operator+ (Array, Array)
+// Array/Expr + Array/Expr
 //
-template <class T, int N, class Config, class Config2>
-Expr<ExprBinOp<Array_TemplateExpressionEnabled<T, N, Config>, Array<T, N, Config2>, OpAdd>> operator+(const Array<T, N, Config>& a,
-                                                                                                      const Array<T, N, Config2>& b)
+template <class L, class R>
+details::ExprBinary<L, R, OpAdd> operator+(L&& lhs, R&& rhs)
 {
-   using ExprT = ExprBinOp<Array<T, N, Config>, Array<T, N, Config2>, OpAdd>;
-   return Expr<ExprT>(ExprT(a, b));
+   return details::expr_make<OpAdd>(std::forward<L>(lhs), std::forward<R>(rhs));
 }
-/*
-// (Array, Expr)
-template <class T, int N, class Config, class A>
-Expr<ExprBinOp<Array_TemplateExpressionEnabled<T, N, Config>, Expr<A>, OpAdd>> operator+( const Array<T, N, Config>& a,
-                                                                                          const Expr<A>& b )
-{
-   using ExprT = ExprBinOp<Array<T, N, Config>, Expr<A>, OpAdd> ;
-   return Expr<ExprT>( ExprT( a, b ) );
+
+//
+// Array/Expr - Array/Expr
+//
+template <class L, class R>
+details::ExprBinary<L, R, OpSub> operator-(L&& lhs, R&& rhs)
+{
+   return details::expr_make<OpSub>(std::forward<L>(lhs), std::forward<R>(rhs));
 }
-*/
+
 //
-// operator+= (Array, Array)
+// Matrix/Expr * Matrix/Vector/Expr
 //
-template <class T, int N, class Config, class Config2>
-Array_TemplateExpressionEnabled<T, N, Config>& operator+=(Array<T, N, Config>& a, const Array<T, N, Config2>& b)
+template <class L, class R>
+details::ExprBinary<L, R, OpMul> operator*(L&& lhs, R&& rhs)
 {
-   using ExprT = RefExprBinOp<Array<T, N, Config>, Array<T, N, Config2>, OpAdd>;
-   return Expr<ExprT>(ExprT(a, b))();
+   return details::expr_make<OpMul>(std::forward<L>(lhs), std::forward<R>(rhs));
 }
 
 //
-// operator* (Array, scalar)
+// Array/Expr * scalar, scalar * Array/Expr, Array/Expr / scalar
 //
-template <class T, int N, class Config>
-Array_TemplateExpressionEnabled<T, N, Config> operator*(const Array<T, N, Config>& a, T value)
+template <class L, class S>
+details::ExprScalarRight<L, S, OpMul> operator*(L&& lhs, S value)
 {
-   using ExprT = typename ScalarArrayMul<T, N, Config>::expression_type;
-   return ScalarArrayMul<T, N, Config>(ExprT(ExprConstant<T>(value), a));
+   using value_type = typename details::ExprOperand<L>::value_type;
+   return details::expr_make<OpMul>(std::forward<L>(lhs), ExprConstant<value_type>(static_cast<value_type>(value)));
 }
 
-template <class T, int N, class Config>
-Array_TemplateExpressionEnabled<T, N, Config> operator*(T value, const Array<T, N, Config>& a)
+template <class S, class R>
+details::ExprScalarLeft<S, R, OpMul> operator*(S value, R&& rhs)
 {
-   using ExprT = typename ScalarArrayMul<T, N, Config>::expression_type;
-   return ScalarArrayMul<T, N, Config>(ExprT(ExprConstant<T>(value), a));
+   using value_type = typename details::ExprOperand<R>::value_type;
+   return details::expr_make<OpMul>(ExprConstant<value_type>(static_cast<value_type>(value)), std::forward<R>(rhs));
 }
 
-template <class T, int N, class Config>
-Array_TemplateExpressionEnabled<T, N, Config>& operator*=(Array<T, N, Config>& a, T value)
+template <class L, class S>
+details::ExprScalarRight<L, S, OpDiv> operator/(L&& lhs, S value)
 {
-   using ExprT             = RefExprBinOp<Array<T, N, Config>, ExprConstant<T>, OpMul>;
-   using RefScalarArrayMul = Expr<ExprT>;
+   using value_type = typename details::ExprOperand<L>::value_type;
+   return details::expr_make<OpDiv>(std::forward<L>(lhs), ExprConstant<value_type>(static_cast<value_type>(value)));
+}
 
-   return RefScalarArrayMul(ExprT(a, ExprConstant<T>(value)));
+//
+// Expr + scalar, scalar + Expr, Expr - scalar: not BLAS operations, the expression is evaluated
+//
+template <class A, class S>
+details::ExprMaterialized<A, S> operator+(const Expr<A>& lhs, S value)
+{
+   auto result = lhs();
+   result += static_cast<typename Expr<A>::value_type>(value);
+   return result;
+}
+
+template <class A, class S>
+details::ExprMaterialized<A, S> operator+(S value, const Expr<A>& rhs)
+{
+   return rhs + value;
+}
+
+template <class A, class S>
+details::ExprMaterialized<A, S> operator-(const Expr<A>& lhs, S value)
+{
+   auto result = lhs();
+   result -= static_cast<typename Expr<A>::value_type>(value);
+   return result;
+}
+
+//
+// operator+=, -= (Array, Array/Expr)
+//
+template <class T, size_t N, class Config, class R>
+details::ExprCompound<Array<T, N, Config>, R> operator+=(Array<T, N, Config>& lhs, R&& rhs)
+{
+   const auto expression = details::ExprOperand<R>::make(std::forward<R>(rhs));
+   details::expr_accumulate(lhs, expression, static_cast<T>(1), static_cast<T>(1));
+   return lhs;
+}
+
+template <class T, size_t N, class Config, class R>
+details::ExprCompound<Array<T, N, Config>, R> operator-=(Array<T, N, Config>& lhs, R&& rhs)
+{
+   const auto expression = details::ExprOperand<R>::make(std::forward<R>(rhs));
+   details::expr_accumulate(lhs, expression, static_cast<T>(1), static_cast<T>(-1));
+   return lhs;
+}
+
+//
+// operator*=, /= (Array, scalar)
+//
+template <class T, size_t N, class Config, class S>
+details::ExprCompoundScalar<Array<T, N, Config>, S> operator*=(Array<T, N, Config>& lhs, S value)
+{
+   details::scal(lhs, static_cast<T>(value));
+   return lhs;
+}
+
+template <class T, size_t N, class Config, class S>
+details::ExprCompoundScalar<Array<T, N, Config>, S> operator/=(Array<T, N, Config>& lhs, S value)
+{
+   details::scal(lhs, static_cast<T>(1) / static_cast<T>(value));
+   return lhs;
 }
 
 // https://github.com/guyz/cpp-array/blob/master/array/expr.hpp
 // https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Expression-template
 
-// TODO reconsider boost.proto:
-// http://web.archive.org/web/20120906070131/http://cpp-next.com/archive/2011/01/expressive-c-expression-optimization/
-
 DECLARE_NAMESPACE_NLL_END
-
-#endif
@@ -6,7 +6,7 @@ DECLARE_NAMESPACE_NLL
 @brief Generic fill of an array. The index order is defined by memory locality
 @param functor will be called using functor(index_type(x, y, z, ...)), i.e., each coordinate components
 
-Note: there will be a significan't overhead (as compared to naive access) due to the linear index to array index conversion
+The index of the first element of each memory line is computed once, the index of the other elements of the line is derived incrementally
 */
 template <class T, size_t N, class Config, class Functor>
 void fill_index(Array<T, N, Config>& array, Functor functor)
@@ -19,20 +19,19 @@ void fill_index(Array<T, N, Config>& array, Functor functor)
       return;
    }
 
-   using array_type     = Array<T, N, Config>;
-   bool hasMoreElements = true;
-   using pointer_type   = typename array_type::pointer_type;
+   using array_type   = Array<T, N, Config>;
+   using pointer_type = typename array_type::pointer_type;
+   using index_type   = typename array_type::index_type;
 
-   ArrayProcessor_contiguous_byMemoryLocality<array_type> iterator(array, 1);
-   while (hasMoreElements)
-   {
-      pointer_type ptr(nullptr);
-      hasMoreElements         = iterator.accessSingleElement(ptr);
-      const auto currentIndex = iterator.getArrayIndex();
-
-      const auto value = functor(currentIndex);
-      details::copy_naive(ptr, 1, &value, 1, 1);
-   }
+   auto f = [&](pointer_type ptr, ui32 stride, ui32 nb_elements, const index_type& line_index, ui32 varying_index) {
+      index_type index = line_index;
+      for (ui32 n = 0; n < nb_elements; ++n, ++index[varying_index])
+      {
+         const auto value = functor(index);
+         details::copy_naive(ptr + n * stride, 1, &value, 1, 1);
+      }
+   };
+   iterate_array_index(array, f);
 }
 
 namespace details
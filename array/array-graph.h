@@ -0,0 +1,1011 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @file
+
+ This file defines the deferred execution of a graph of array operations. The operations on the handles of an @ref ArrayGraph are
+ recorded instead of being executed, then the whole graph is executed by @ref ArrayGraph::run:
+
+ @code
+ ArrayGraph graph;
+ const auto a = graph.input(array_a);
+ const auto b = graph.input(array_b);
+ const auto m = graph.input(matrix);
+ const auto r1 = sqrt(sqr(a) + sqr(b)) * 0.5f;   // a single fused pass
+ const auto r2 = sum(sqr(a) + sqr(b), 0);        // sqr(a) + sqr(b) is only computed once
+ const auto r3 = transpose(m) * m;               // computed concurrently with r1 and r2
+ graph.output(r1);
+ graph.output(r2);
+ graph.output(r3);
+ graph.run();
+ const auto& result = r1.value();
+ @endcode
+
+ - the identical operations are recorded once (common subexpression elimination): an operation on the same nodes with the same
+   parameters returns the existing node
+ - an elementwise node read by a single elementwise node is fused in it: the fused nodes are evaluated in a single pass by blocks
+   of @ref details::lazy_block_elements elements with the kernels of the operators, as the lazy expressions (see array-lazy.h)
+ - the nodes are executed by levels of dependencies: the independent nodes of a level are executed concurrently, each by a single thread
+ - the buffer of an intermediate result is recycled as soon as its last consumer finished and reused by the nodes executed after it
+ - only the nodes needed by the outputs are executed
+
+ Within a graph, as for the arrays, a * b is the matrix product and @ref mul_elementwise the elementwise product. The graph only holds
+ references to its input arrays: they must outlive the execution of the graph. The values of the outputs are valid until the next
+ execution of the graph. The elementwise nodes require arrays based on a single slice of memory (see @ref IsArrayLayoutContiguous).
+ */
+class ArrayGraph;
+
+template <class array_type>
+class GraphArray;
+
+namespace details
+{
+/**
+ @brief Return a key representing the bits of a value, to compare parameters exactly
+ */
+template <class T>
+std::string graph_key_bits(const T& value)
+{
+   unsigned char bytes[sizeof(T)];
+   std::memcpy(bytes, &value, sizeof(T));
+
+   std::ostringstream key;
+   key << std::hex;
+   for (auto byte : bytes)
+   {
+      key << static_cast<int>(byte) << '.';
+   }
+   return key.str();
+}
+
+class GraphBuffersBase
+{
+public:
+   virtual ~GraphBuffersBase()
+   {
+   }
+};
+
+/**
+ @brief The recycled arrays of a given type
+ */
+template <class array_type>
+class GraphBuffersTyped : public GraphBuffersBase
+{
+public:
+   std::vector<array_type> arrays;
+};
+
+/**
+ @brief Pool of the recycled buffers of the intermediate results of a graph, safe to use by concurrent nodes
+ */
+class GraphBuffers
+{
+public:
+   /**
+    @brief Return an array of the given shape, reusing a recycled buffer if possible
+    */
+   template <class array_type>
+   array_type acquire(const typename array_type::index_type& shape)
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto& arrays = buffers<array_type>().arrays;
+      for (auto it = arrays.begin(); it != arrays.end(); ++it)
+      {
+         if (it->shape() == shape)
+         {
+            array_type array = std::move(*it);
+            arrays.erase(it);
+            ++_nb_reuses;
+            return array;
+         }
+      }
+
+      ++_nb_allocations;
+      return array_type(shape);
+   }
+
+   /**
+    @brief The array is not used anymore: its buffer can be reused
+    */
+   template <class array_type>
+   void recycle(array_type&& array)
+   {
+      if (array.size() == 0 || !array.getMemory().isDataAllocated())
+      {
+         // do not keep the references to memory we don't own
+         return;
+      }
+
+      std::lock_guard<std::mutex> lock(_mutex);
+      buffers<array_type>().arrays.push_back(std::move(array));
+   }
+
+   /**
+    @brief Free the recycled buffers and reset the statistics
+    */
+   void clear()
+   {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _buffers.clear();
+      _nb_allocations = 0;
+      _nb_reuses      = 0;
+   }
+
+   size_t nbAllocations() const
+   {
+      return _nb_allocations;
+   }
+
+   size_t nbReuses() const
+   {
+      return _nb_reuses;
+   }
+
+private:
+   template <class array_type>
+   GraphBuffersTyped<array_type>& buffers()
+   {
+      auto& buffers = _buffers[std::type_index(typeid(array_type))];
+      if (!buffers)
+      {
+         buffers.reset(new GraphBuffersTyped<array_type>());
+      }
+      return static_cast<GraphBuffersTyped<array_type>&>(*buffers);
+   }
+
+private:
+   std::mutex _mutex;
+   std::map<std::type_index, std::unique_ptr<GraphBuffersBase>> _buffers;
+   size_t _nb_allocations = 0;
+   size_t _nb_reuses      = 0;
+};
+
+/**
+ @brief Node of an @ref ArrayGraph
+ */
+class GraphNode
+{
+public:
+   virtual ~GraphNode()
+   {
+   }
+
+   /**
+    @brief Compute the result of the node. The results of the nodes it reads (except the fused ones) are available
+    */
+   virtual void evaluate(GraphBuffers& buffers) = 0;
+
+   /**
+    @brief The result is not used anymore
+    */
+   virtual void release(GraphBuffers& buffers) = 0;
+
+   /**
+    @brief Number of elements of the result
+    */
+   virtual size_t size() const = 0;
+
+   std::vector<size_t> inputs; /// the nodes read by this node
+   bool external    = false;   /// the node references an array, always available
+   bool elementwise = false;   /// the node can be fused in an elementwise consumer
+   bool output      = false;   /// the result is kept after the execution of the graph
+   bool fused       = false;   /// the node is evaluated within its consumer
+   bool available   = false;   /// the result can be read
+};
+
+template <class array_type>
+class GraphTypedNode : public GraphNode
+{
+public:
+   virtual const array_type& value() const = 0;
+
+   size_t size() const override
+   {
+      return value().size();
+   }
+};
+
+/**
+ @brief An array referenced by the graph
+ */
+template <class array_type>
+class GraphInput : public GraphTypedNode<array_type>
+{
+public:
+   GraphInput(const array_type& array) : _array(&array)
+   {
+      this->external  = true;
+      this->available = true;
+   }
+
+   void evaluate(GraphBuffers&) override
+   {
+   }
+
+   void release(GraphBuffers&) override
+   {
+   }
+
+   const array_type& value() const override
+   {
+      return *_array;
+   }
+
+private:
+   const array_type* _array;
+};
+
+/**
+ @brief A node owning its result
+ */
+template <class array_type>
+class GraphResult : public GraphTypedNode<array_type>
+{
+public:
+   const array_type& value() const override
+   {
+      return _result;
+   }
+
+   void release(GraphBuffers& buffers) override
+   {
+      this->available = false;
+      buffers.recycle(std::move(_result));
+      _result = array_type();
+   }
+
+protected:
+   array_type _result;
+};
+
+/**
+ @brief Any operation computing its result from the results of other nodes (e.g., gemm, axis reductions)
+ */
+template <class array_type>
+class GraphOperation : public GraphResult<array_type>
+{
+public:
+   using compute_type = std::function<array_type()>;
+
+   GraphOperation(const std::vector<size_t>& inputs, const compute_type& compute) : _compute(compute)
+   {
+      this->inputs = inputs;
+   }
+
+   void evaluate(GraphBuffers&) override
+   {
+      this->_result   = _compute();
+      this->available = true;
+   }
+
+private:
+   compute_type _compute;
+};
+
+enum class GraphElementwiseOp
+{
+   load,
+   add,
+   sub,
+   mul,
+   div,
+   add_scalar,
+   mul_scalar,
+   div_scalar,
+   function
+};
+
+/**
+ @brief Elementwise operation, evaluated with the elementwise nodes fused in it
+ */
+template <class array_type>
+class GraphElementwise : public GraphResult<array_type>
+{
+public:
+   using value_type    = typename array_type::value_type;
+   using function_type = void (*)(value_type* output, ui32 output_stride, const value_type* input, ui32 input_stride, ui32 nb_elements);
+   using operand_type  = GraphTypedNode<array_type>;
+   static_assert(IsArrayLayoutContiguous<array_type>::value, "the elementwise nodes are evaluated on a single slice of memory");
+
+   /**
+    @brief Instruction of the program of the fused nodes: the operands are on a stack of blocks
+    */
+   struct Instruction
+   {
+      GraphElementwiseOp op;
+      size_t leaf;
+      value_type value;
+      function_type function;
+   };
+
+   GraphElementwise(GraphElementwiseOp op, const std::vector<size_t>& inputs, const std::vector<const operand_type*>& operands, value_type value,
+                    function_type function)
+       : _operands(operands), _instruction{op, 0, value, function}
+   {
+      this->inputs      = inputs;
+      this->elementwise = true;
+   }
+
+   void evaluate(GraphBuffers& buffers) override
+   {
+      std::vector<Instruction> program;
+      std::vector<const array_type*> leaves;
+      size_t depth     = 0;
+      size_t max_depth = 0;
+      compile(program, leaves, depth, max_depth);
+
+      const auto shape = leaves[0]->shape();
+      for (auto leaf : leaves)
+      {
+         ensure(leaf->shape() == shape, "must have the same shape!");
+      }
+
+      this->_result                = buffers.acquire<array_type>(shape);
+      const size_t nb_elements     = this->_result.size();
+      value_type* const output_ptr = array_base_memory(this->_result);
+
+      // the arrays are read linearly: make a contiguous copy of the sub-arrays
+      std::vector<array_type> copies;
+      copies.reserve(leaves.size());
+      std::vector<const value_type*> leaves_ptr;
+      for (auto leaf : leaves)
+      {
+         if (!is_memory_fully_contiguous(leaf->getMemory()) || !same_data_ordering(*leaf, this->_result))
+         {
+            copies.push_back(buffers.acquire<array_type>(shape));
+            copies.back().copy(*leaf, Conversion::cast);
+            leaf = &copies.back();
+         }
+         leaves_ptr.push_back(array_base_memory(*leaf));
+      }
+
+      const ui32 nb_blocks = static_cast<ui32>((nb_elements + lazy_block_elements - 1) / lazy_block_elements);
+      auto process         = [&](ui32 block_begin, ui32 block_end) {
+         std::vector<value_type> scratch(max_depth * lazy_block_elements);
+         std::vector<const value_type*> stack(max_depth);
+         for (ui32 block = block_begin; block < block_end; ++block)
+         {
+            const size_t offset = static_cast<size_t>(block) * lazy_block_elements;
+            const ui32 size     = static_cast<ui32>(std::min<size_t>(lazy_block_elements, nb_elements - offset));
+
+            size_t top = 0;
+            for (const auto& instruction : program)
+            {
+               if (instruction.op == GraphElementwiseOp::load)
+               {
+                  stack[top++] = leaves_ptr[instruction.leaf] + offset;
+                  continue;
+               }
+
+               const value_type* right = nullptr;
+               if (instruction.op == GraphElementwiseOp::add || instruction.op == GraphElementwiseOp::sub ||
+                   instruction.op == GraphElementwiseOp::mul || instruction.op == GraphElementwiseOp::div)
+               {
+                  right = stack[--top];
+               }
+
+               // the result of the operation is in the block of the top of the stack
+               value_type* buffer = &scratch[(top - 1) * lazy_block_elements];
+               if (instruction.op == GraphElementwiseOp::function)
+               {
+                  instruction.function(buffer, 1, stack[top - 1], 1, size);
+                  stack[top - 1] = buffer;
+                  continue;
+               }
+               if (stack[top - 1] != buffer)
+               {
+                  copy_naive(buffer, 1, stack[top - 1], 1, size);
+                  stack[top - 1] = buffer;
+               }
+
+               switch (instruction.op)
+               {
+               case GraphElementwiseOp::add:
+                  add_naive(buffer, 1, right, 1, size);
+                  break;
+               case GraphElementwiseOp::sub:
+                  sub_naive(buffer, 1, right, 1, size);
+                  break;
+               case GraphElementwiseOp::mul:
+                  mul_naive_elementwise(buffer, 1, right, 1, size);
+                  break;
+               case GraphElementwiseOp::div:
+                  div_naive_elementwise(buffer, 1, right, 1, size);
+                  break;
+               case GraphElementwiseOp::add_scalar:
+                  add_naive_cte(buffer, 1, size, instruction.value);
+                  break;
+               case GraphElementwiseOp::mul_scalar:
+                  mul_naive(buffer, 1, instruction.value, size);
+                  break;
+               case GraphElementwiseOp::div_scalar:
+                  div_naive(buffer, 1, instruction.value, size);
+                  break;
+               default:
+                  break;
+               }
+            }
+            copy_naive(output_ptr + offset, 1, stack[0], 1, size);
+         }
+      };
+      details::parallel_accesses(Parallel().nbThreads(nb_elements * leaves.size(), nb_blocks), nb_blocks, process);
+
+      for (auto& copy : copies)
+      {
+         buffers.recycle(std::move(copy));
+      }
+      this->available = true;
+   }
+
+private:
+   /**
+    @brief Append the postfix program of this node and the fused nodes it reads
+    */
+   void compile(std::vector<Instruction>& program, std::vector<const array_type*>& leaves, size_t& depth, size_t& max_depth) const
+   {
+      for (auto operand : _operands)
+      {
+         if (operand->fused)
+         {
+            // only the elementwise nodes of the same type are fused
+            static_cast<const GraphElementwise&>(*operand).compile(program, leaves, depth, max_depth);
+         }
+         else
+         {
+            program.push_back(Instruction{GraphElementwiseOp::load, leaves.size(), value_type(), nullptr});
+            leaves.push_back(&operand->value());
+            max_depth = std::max(max_depth, ++depth);
+         }
+      }
+      program.push_back(_instruction);
+      depth -= _operands.size() - 1;
+   }
+
+private:
+   std::vector<const operand_type*> _operands;
+   Instruction _instruction;
+};
+}
+
+/**
+ @brief Record array operations in a graph, executed by @ref run. See array-graph.h
+ */
+class ArrayGraph
+{
+public:
+   struct Statistics
+   {
+      size_t nb_nodes       = 0; /// number of recorded nodes, after the elimination of the common subexpressions
+      size_t nb_tasks       = 0; /// number of nodes executed
+      size_t nb_fused       = 0; /// number of nodes evaluated within their consumer
+      size_t nb_levels      = 0; /// number of levels of dependencies, executed one after the other
+      size_t nb_allocations = 0; /// number of buffers allocated for the intermediate results
+      size_t nb_reuses      = 0; /// number of recycled buffers reused
+   };
+
+   ArrayGraph()                  = default;
+   ArrayGraph(const ArrayGraph&) = delete;
+   ArrayGraph& operator=(const ArrayGraph&) = delete;
+
+   /**
+    @brief Reference an array in the graph. The array must outlive the execution of the graph
+    */
+   template <class T, size_t N, class Config>
+   GraphArray<Array<T, N, Config>> input(const Array<T, N, Config>& array)
+   {
+      using array_type = Array<T, N, Config>;
+      const std::string key = std::string("input ") + typeid(array_type).name() + " " + details::graph_key_bits(&array);
+      return add<array_type>(key, std::unique_ptr<details::GraphTypedNode<array_type>>(new details::GraphInput<array_type>(array)));
+   }
+
+   /**
+    @brief The value of this node will be available after the execution of the graph
+    */
+   template <class array_type>
+   void output(const GraphArray<array_type>& array)
+   {
+      ensure(&array.graph() == this, "the node belongs to another graph!");
+      _nodes[array.id()]->output = true;
+   }
+
+   /**
+    @brief Execute the nodes needed by the outputs. The values of the previous execution are released
+    */
+   void run()
+   {
+      const size_t nb_nodes = _nodes.size();
+      for (auto& node : _nodes)
+      {
+         if (!node->external)
+         {
+            node->release(_buffers);
+         }
+         node->fused = false;
+      }
+
+      // the nodes are recorded after their inputs
+      std::vector<char> needed(nb_nodes, 0);
+      std::vector<size_t> nb_consumers(nb_nodes, 0);
+      for (size_t n = nb_nodes; n-- > 0;)
+      {
+         needed[n] |= _nodes[n]->output;
+         if (needed[n])
+         {
+            for (auto input : _nodes[n]->inputs)
+            {
+               needed[input] = 1;
+               ++nb_consumers[input];
+            }
+         }
+      }
+
+      // an elementwise node read once by an elementwise node is evaluated within it
+      _statistics = Statistics();
+      for (size_t n = 0; n < nb_nodes; ++n)
+      {
+         if (needed[n] && _nodes[n]->elementwise)
+         {
+            for (auto input : _nodes[n]->inputs)
+            {
+               auto& node  = *_nodes[input];
+               node.fused  = node.elementwise && !node.output && nb_consumers[input] == 1;
+               _statistics.nb_fused += node.fused;
+            }
+         }
+      }
+
+      // the dependencies of the executed nodes and their level
+      std::vector<std::vector<size_t>> dependencies(nb_nodes);
+      std::vector<size_t> remaining_consumers(nb_nodes, 0);
+      std::vector<size_t> level(nb_nodes, 0);
+      std::vector<std::vector<size_t>> levels;
+      for (size_t n = 0; n < nb_nodes; ++n)
+      {
+         if (!needed[n] || _nodes[n]->fused || _nodes[n]->external)
+         {
+            continue;
+         }
+
+         level[n]                = 1;
+         auto& node_dependencies = dependencies[n];
+         collect_dependencies(n, node_dependencies);
+         std::sort(node_dependencies.begin(), node_dependencies.end());
+         node_dependencies.erase(std::unique(node_dependencies.begin(), node_dependencies.end()), node_dependencies.end());
+         for (auto dependency : node_dependencies)
+         {
+            ++remaining_consumers[dependency];
+            level[n] = std::max(level[n], level[dependency] + 1);
+         }
+
+         if (levels.size() < level[n])
+         {
+            levels.resize(level[n]);
+         }
+         levels[level[n] - 1].push_back(n);
+         ++_statistics.nb_tasks;
+      }
+      _statistics.nb_levels = levels.size();
+
+      std::mutex mutex;
+      auto execute = [&](size_t n) {
+         _nodes[n]->evaluate(_buffers);
+
+         std::vector<size_t> finished;
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto dependency : dependencies[n])
+            {
+               if (--remaining_consumers[dependency] == 0 && !_nodes[dependency]->output)
+               {
+                  finished.push_back(dependency);
+               }
+            }
+         }
+
+         for (auto dependency : finished)
+         {
+            _nodes[dependency]->release(_buffers);
+         }
+      };
+
+      for (const auto& tasks : levels)
+      {
+         if (tasks.size() == 1)
+         {
+            // the node can use all the threads
+            execute(tasks[0]);
+            continue;
+         }
+
+         size_t nb_elements = 0;
+         for (auto n : tasks)
+         {
+            for (auto dependency : dependencies[n])
+            {
+               nb_elements += _nodes[dependency]->size();
+            }
+         }
+
+         std::exception_ptr error;
+         const int nb_tasks   = static_cast<int>(tasks.size());
+         const ui32 nb_threads = Parallel().nbThreads(nb_elements, static_cast<ui32>(nb_tasks));
+         (void)nb_threads;
+#ifdef WITH_OMP
+#pragma omp parallel for num_threads(nb_threads) schedule(dynamic, 1)
+#endif
+         for (int task = 0; task < nb_tasks; ++task)
+         {
+            try
+            {
+               execute(tasks[task]);
+            }
+            catch (...)
+            {
+               std::lock_guard<std::mutex> lock(mutex);
+               if (!error)
+               {
+                  error = std::current_exception();
+               }
+            }
+         }
+
+         if (error)
+         {
+            std::rethrow_exception(error);
+         }
+      }
+
+      _statistics.nb_nodes       = nb_nodes;
+      _statistics.nb_allocations = _buffers.nbAllocations();
+      _statistics.nb_reuses      = _buffers.nbReuses();
+      _buffers.clear();
+   }
+
+   /**
+    @brief Statistics of the last execution
+    */
+   const Statistics& statistics() const
+   {
+      return _statistics;
+   }
+
+   /**
+    @brief Number of recorded nodes
+    */
+   size_t size() const
+   {
+      return _nodes.size();
+   }
+
+   /**
+    @brief Record a node. If an identical node was already recorded (same @p key), @p node is discarded and the existing node returned
+    */
+   template <class array_type>
+   GraphArray<array_type> add(const std::string& key, std::unique_ptr<details::GraphTypedNode<array_type>> node)
+   {
+      auto it = _keys.find(key);
+      if (it != _keys.end())
+      {
+         return GraphArray<array_type>(this, it->second, static_cast<details::GraphTypedNode<array_type>*>(_nodes[it->second].get()));
+      }
+
+      const size_t id = _nodes.size();
+      for (auto input : node->inputs)
+      {
+         ensure(input < id, "the inputs must be recorded first!");
+      }
+
+      auto node_ptr = node.get();
+      _nodes.push_back(std::move(node));
+      _keys[key] = id;
+      return GraphArray<array_type>(this, id, node_ptr);
+   }
+
+private:
+   void collect_dependencies(size_t n, std::vector<size_t>& dependencies) const
+   {
+      for (auto input : _nodes[n]->inputs)
+      {
+         if (_nodes[input]->fused)
+         {
+            collect_dependencies(input, dependencies);
+         }
+         else if (!_nodes[input]->external)
+         {
+            dependencies.push_back(input);
+         }
+      }
+   }
+
+private:
+   std::vector<std::unique_ptr<details::GraphNode>> _nodes;
+   std::map<std::string, size_t> _keys;
+   details::GraphBuffers _buffers;
+   Statistics _statistics;
+};
+
+/**
+ @brief Handle on a node of an @ref ArrayGraph, holding an array of type @p array_type once executed
+ */
+template <class array_type_t>
+class GraphArray
+{
+public:
+   using array_type = array_type_t;
+   using value_type = typename array_type::value_type;
+
+   GraphArray(ArrayGraph* graph, size_t id, details::GraphTypedNode<array_type>* node) : _graph(graph), _id(id), _node(node)
+   {
+   }
+
+   ArrayGraph& graph() const
+   {
+      return *_graph;
+   }
+
+   size_t id() const
+   {
+      return _id;
+   }
+
+   const details::GraphTypedNode<array_type>& node() const
+   {
+      return *_node;
+   }
+
+   /**
+    @brief The value of an output of the graph, after its execution
+    */
+   const array_type& value() const
+   {
+      ensure(_node->available, "the node must be an output of an executed graph!");
+      return _node->value();
+   }
+
+private:
+   ArrayGraph* _graph;
+   size_t _id;
+   details::GraphTypedNode<array_type>* _node;
+};
+
+namespace details
+{
+template <class array_type, class T2>
+using graph_scalar_type_enabled = typename std::enable_if<std::is_convertible<T2, typename array_type::value_type>::value>::type;
+
+template <class array_type>
+GraphArray<array_type> graph_elementwise(GraphElementwiseOp op, std::vector<GraphArray<array_type>> operands,
+                                         typename array_type::value_type value,
+                                         typename GraphElementwise<array_type>::function_type function = nullptr)
+{
+   if ((op == GraphElementwiseOp::add || op == GraphElementwiseOp::mul) && operands[1].id() < operands[0].id())
+   {
+      // commutative: a + b and b + a are the same node
+      std::swap(operands[0], operands[1]);
+   }
+
+   auto& graph = operands[0].graph();
+   std::vector<size_t> inputs;
+   std::vector<const GraphTypedNode<array_type>*> nodes;
+   std::string key = "elementwise " + graph_key_bits(op) + " " + graph_key_bits(value) + " " + graph_key_bits(function);
+   for (const auto& operand : operands)
+   {
+      ensure(&operand.graph() == &graph, "the nodes must belong to the same graph!");
+      inputs.push_back(operand.id());
+      nodes.push_back(&operand.node());
+      key += " " + std::to_string(operand.id());
+   }
+
+   return graph.template add<array_type>(key, std::unique_ptr<GraphTypedNode<array_type>>(new GraphElementwise<array_type>(op, inputs, nodes, value, function)));
+}
+
+template <class result_type, class array_type>
+GraphArray<result_type> graph_operation(const std::string& name, const std::vector<GraphArray<array_type>>& operands,
+                                        const typename GraphOperation<result_type>::compute_type& compute)
+{
+   auto& graph = operands[0].graph();
+   std::vector<size_t> inputs;
+   std::string key = name;
+   for (const auto& operand : operands)
+   {
+      ensure(&operand.graph() == &graph, "the nodes must belong to the same graph!");
+      inputs.push_back(operand.id());
+      key += " " + std::to_string(operand.id());
+   }
+
+   return graph.template add<result_type>(key, std::unique_ptr<GraphTypedNode<result_type>>(new GraphOperation<result_type>(inputs, compute)));
+}
+}
+
+template <class array_type>
+GraphArray<array_type> operator+(const GraphArray<array_type>& a, const GraphArray<array_type>& b)
+{
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::add, {a, b}, typename array_type::value_type());
+}
+
+template <class array_type>
+GraphArray<array_type> operator-(const GraphArray<array_type>& a, const GraphArray<array_type>& b)
+{
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::sub, {a, b}, typename array_type::value_type());
+}
+
+/**
+ @brief Elementwise product of two nodes (a * b is the matrix product)
+ */
+template <class array_type>
+GraphArray<array_type> mul_elementwise(const GraphArray<array_type>& a, const GraphArray<array_type>& b)
+{
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::mul, {a, b}, typename array_type::value_type());
+}
+
+/**
+ @brief Elementwise division of two nodes
+ */
+template <class array_type>
+GraphArray<array_type> operator/(const GraphArray<array_type>& a, const GraphArray<array_type>& b)
+{
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::div, {a, b}, typename array_type::value_type());
+}
+
+template <class array_type, class T2, typename = details::graph_scalar_type_enabled<array_type, T2>>
+GraphArray<array_type> operator+(const GraphArray<array_type>& a, T2 value)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::add_scalar, {a}, static_cast<T>(value));
+}
+
+template <class array_type, class T2, typename = details::graph_scalar_type_enabled<array_type, T2>>
+GraphArray<array_type> operator+(T2 value, const GraphArray<array_type>& a)
+{
+   return a + value;
+}
+
+template <class array_type, class T2, typename = details::graph_scalar_type_enabled<array_type, T2>>
+GraphArray<array_type> operator-(const GraphArray<array_type>& a, T2 value)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::add_scalar, {a}, -static_cast<T>(value));
+}
+
+template <class array_type, class T2, typename = details::graph_scalar_type_enabled<array_type, T2>>
+GraphArray<array_type> operator*(const GraphArray<array_type>& a, T2 value)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::mul_scalar, {a}, static_cast<T>(value));
+}
+
+template <class array_type, class T2, typename = details::graph_scalar_type_enabled<array_type, T2>>
+GraphArray<array_type> operator*(T2 value, const GraphArray<array_type>& a)
+{
+   return a * value;
+}
+
+template <class array_type, class T2, typename = details::graph_scalar_type_enabled<array_type, T2>>
+GraphArray<array_type> operator/(const GraphArray<array_type>& a, T2 value)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::div_scalar, {a}, static_cast<T>(value));
+}
+
+template <class array_type>
+GraphArray<array_type> cos(const GraphArray<array_type>& a)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::function, {a}, T(), &details::cos<T>);
+}
+
+template <class array_type>
+GraphArray<array_type> sin(const GraphArray<array_type>& a)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::function, {a}, T(), &details::sin<T>);
+}
+
+template <class array_type>
+GraphArray<array_type> sqrt(const GraphArray<array_type>& a)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::function, {a}, T(), &details::sqrt<T>);
+}
+
+template <class array_type>
+GraphArray<array_type> sqr(const GraphArray<array_type>& a)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::function, {a}, T(), &details::sqr<T>);
+}
+
+template <class array_type>
+GraphArray<array_type> abs(const GraphArray<array_type>& a)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::function, {a}, T(), &details::abs<T>);
+}
+
+template <class array_type>
+GraphArray<array_type> exp(const GraphArray<array_type>& a)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::function, {a}, T(), &details::exp<T>);
+}
+
+template <class array_type>
+GraphArray<array_type> log(const GraphArray<array_type>& a)
+{
+   using T = typename array_type::value_type;
+   return details::graph_elementwise<array_type>(details::GraphElementwiseOp::function, {a}, T(), &details::log<T>);
+}
+
+/**
+ @brief Matrix product of two nodes
+ */
+template <class T, class Config>
+GraphArray<Array<T, 2, Config>> operator*(const GraphArray<Array<T, 2, Config>>& a, const GraphArray<Array<T, 2, Config>>& b)
+{
+   using array_type = Array<T, 2, Config>;
+   const auto& lhs  = a.node();
+   const auto& rhs  = b.node();
+   return details::graph_operation<array_type, array_type>("gemm", {a, b}, [&lhs, &rhs]() { return array_type(lhs.value() * rhs.value()); });
+}
+
+template <class T, class Config>
+GraphArray<Array<T, 2, Config>> transpose(const GraphArray<Array<T, 2, Config>>& a)
+{
+   using array_type = Array<T, 2, Config>;
+   const auto& node = a.node();
+   return details::graph_operation<array_type, array_type>("transpose", {a}, [&node]() { return transpose(node.value()); });
+}
+
+template <class T, size_t N, class Config>
+GraphArray<axis_apply_fun_type<T, N, Config, details::adaptor_sum>> sum(const GraphArray<Array<T, N, Config>>& a, size_t axis)
+{
+   using result_type = axis_apply_fun_type<T, N, Config, details::adaptor_sum>;
+   const auto& node  = a.node();
+   return details::graph_operation<result_type, Array<T, N, Config>>("sum " + std::to_string(axis), {a},
+                                                                     [&node, axis]() { return sum(node.value(), axis); });
+}
+
+template <class T, size_t N, class Config>
+GraphArray<axis_apply_fun_type<T, N, Config, details::adaptor_mean>> mean(const GraphArray<Array<T, N, Config>>& a, size_t axis)
+{
+   using result_type = axis_apply_fun_type<T, N, Config, details::adaptor_mean>;
+   const auto& node  = a.node();
+   return details::graph_operation<result_type, Array<T, N, Config>>("mean " + std::to_string(axis), {a},
+                                                                     [&node, axis]() { return mean(node.value(), axis); });
+}
+
+template <class T, size_t N, class Config>
+GraphArray<axis_apply_fun_type<T, N, Config, details::adaptor_max>> max(const GraphArray<Array<T, N, Config>>& a, size_t axis)
+{
+   using result_type = axis_apply_fun_type<T, N, Config, details::adaptor_max>;
+   const auto& node  = a.node();
+   return details::graph_operation<result_type, Array<T, N, Config>>("max " + std::to_string(axis), {a},
+                                                                     [&node, axis]() { return max(node.value(), axis); });
+}
+
+template <class T, size_t N, class Config>
+GraphArray<axis_apply_fun_type<T, N, Config, details::adaptor_min>> min(const GraphArray<Array<T, N, Config>>& a, size_t axis)
+{
+   using result_type = axis_apply_fun_type<T, N, Config, details::adaptor_min>;
+   const auto& node  = a.node();
+   return details::graph_operation<result_type, Array<T, N, Config>>("min " + std::to_string(axis), {a},
+                                                                     [&node, axis]() { return min(node.value(), axis); });
+}
+
+DECLARE_NAMESPACE_NLL_END
@@ -0,0 +1,427 @@
+#pragma once
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @file
+
+ This file defines iteration plans: the traversal of a set of memories (order of the dimensions, coalesced memory lines
+ and the offset of each line) is computed once and replayed on any memories having the same shape and strides.
+
+ This removes the setup of the traversal (sorting of the strides, creation of the processors, data ordering checks) from
+ operations repeatedly applied on arrays of the same geometry.
+ */
+
+namespace details
+{
+/**
+ @brief Shape and physical strides of a set of memories. Two sets of memories with the same geometry are traversed identically
+ */
+template <size_t N, size_t NbMemories>
+struct IterationGeometry
+{
+   using index_type = StaticVector<ui32, N>;
+
+   index_type shape;
+   std::array<index_type, NbMemories> strides;
+
+   bool operator==(const IterationGeometry& other) const
+   {
+      return shape == other.shape && strides == other.strides;
+   }
+
+   bool operator!=(const IterationGeometry& other) const
+   {
+      return !(*this == other);
+   }
+};
+
+template <class Memory1, class... Memories>
+IterationGeometry<Memory1::RANK, sizeof...(Memories) + 1> getIterationGeometry(const Memory1& a1, const Memories&... memories)
+{
+   static_assert(is_same<std::integral_constant<size_t, Memory1::RANK>, std::integral_constant<size_t, Memories::RANK>...>::value,
+                 "must have the same rank!");
+
+   IterationGeometry<Memory1::RANK, sizeof...(Memories) + 1> geometry;
+   geometry.shape   = a1.shape();
+   geometry.strides = {{a1.getIndexMapper()._getPhysicalStrides(), memories.getIndexMapper()._getPhysicalStrides()...}};
+   return geometry;
+}
+
+template <class Op, class Pointers, size_t... I>
+FORCE_INLINE void call_plan_line(Op& op, const Pointers& origins, const size_t* offsets, const ui32* strides, ui32 nb_elements,
+                                 std::index_sequence<I...> sequence)
+{
+   call_interleaved(op, strides, nb_elements, sequence, (std::get<I>(origins) + offsets[I])...);
+}
+}
+
+/**
+ @brief Traversal of @p NbMemories memories of rank @p N, computed once and replayable on memories with the same geometry
+
+ The memory lines are along the fastest varying dimension, coalesced with the following dimensions when all the memories are
+ contiguous along them. The offset of each memory line, relative to the origin of each memory, is precomputed.
+
+ A plan can only be created for memories having the same data ordering and that can be fully reached by strides from their origin
+ (i.e., not spanning several slices of a slice based memory). @ref isValid is false otherwise.
+
+ @note the offsets of all the lines are stored, so this is intended for small and medium sized arrays
+ */
+template <size_t N, size_t NbMemories>
+class IterationPlan
+{
+public:
+   using index_type    = StaticVector<ui32, N>;
+   using geometry_type = details::IterationGeometry<N, NbMemories>;
+
+   /**
+    @brief Create an invalid plan
+    */
+   IterationPlan() = default;
+
+   /**
+    @brief Compute the traversal of the memories
+    */
+   template <class... Memories>
+   static IterationPlan create(const Memories&... memories)
+   {
+      static_assert(sizeof...(Memories) == NbMemories, "unexpected number of memories!");
+
+      IterationPlan plan;
+      plan._geometry = details::getIterationGeometry(memories...);
+
+      bool same_shape = true;
+      (void)std::initializer_list<int>{(same_shape = same_shape && memories.shape() == plan._geometry.shape, 0)...};
+      ensure(same_shape, "must have the same shape!");
+
+      const auto& shape = plan._geometry.shape;
+      const auto order  = details::getFastestVaryingIndexesMemory(std::get<0>(std::forward_as_tuple(memories...)));
+      bool valid        = true;
+      (void)std::initializer_list<int>{(valid = valid && details::getFastestVaryingIndexesMemory(memories) == order, 0)...};
+      for (size_t k = 0; k < NbMemories; ++k)
+      {
+         for (size_t n = 0; n < N; ++n)
+         {
+            // a slice dimension can't be reached using a stride
+            valid = valid && (plan._geometry.strides[k][n] != 0 || shape[n] == 1);
+         }
+      }
+      if (!valid)
+      {
+         return plan;
+      }
+
+      ui32 nb_dimensions = N;
+      for (size_t k = 0; k < NbMemories; ++k)
+      {
+         nb_dimensions = std::min(nb_dimensions, details::getNbContiguousDimensions(shape, plan._geometry.strides[k], order));
+      }
+
+      index_type sizeOrder;
+      for (size_t n = 0; n < N; ++n)
+      {
+         sizeOrder[n] = shape[order[n]];
+      }
+      for (size_t n = 1; n < nb_dimensions; ++n)
+      {
+         sizeOrder[0] *= sizeOrder[n];
+         sizeOrder[n] = 1;
+      }
+
+      size_t nb_lines = 1;
+      for (size_t n = 1; n < N; ++n)
+      {
+         nb_lines *= sizeOrder[n];
+      }
+      if (sizeOrder[0] == 0)
+      {
+         nb_lines = 0;
+      }
+
+      plan._valid     = true;
+      plan._order     = order;
+      plan._line_size = sizeOrder[0];
+      plan._nb_lines  = static_cast<ui32>(nb_lines);
+      for (size_t k = 0; k < NbMemories; ++k)
+      {
+         plan._line_strides[k] = plan._geometry.strides[k][order[0]];
+      }
+
+      // enumerate the lines from the fastest to the slowest varying dimension
+      plan._offsets.resize(nb_lines * NbMemories);
+      index_type line_index;
+      std::array<size_t, NbMemories> offsets = {{}};
+      for (size_t line = 0; line < nb_lines; ++line)
+      {
+         std::copy(offsets.begin(), offsets.end(), plan._offsets.begin() + line * NbMemories);
+         for (size_t n = 1; n < N; ++n)
+         {
+            const auto dim = order[n];
+            if (++line_index[n] < sizeOrder[n])
+            {
+               for (size_t k = 0; k < NbMemories; ++k)
+               {
+                  offsets[k] += plan._geometry.strides[k][dim];
+               }
+               break;
+            }
+
+            for (size_t k = 0; k < NbMemories; ++k)
+            {
+               offsets[k] -= static_cast<size_t>(plan._geometry.strides[k][dim]) * (sizeOrder[n] - 1);
+            }
+            line_index[n] = 0;
+         }
+      }
+      return plan;
+   }
+
+   bool isValid() const
+   {
+      return _valid;
+   }
+
+   /**
+    @brief Return true if the memories have the geometry this plan was computed for
+    */
+   template <class... Memories>
+   bool matches(const Memories&... memories) const
+   {
+      static_assert(sizeof...(Memories) == NbMemories, "unexpected number of memories!");
+      return details::getIterationGeometry(memories...) == _geometry;
+   }
+
+   const geometry_type& getGeometry() const
+   {
+      return _geometry;
+   }
+
+   /**
+    @brief the order of traversal of the dimensions
+    */
+   const index_type& getIndexesOrder() const
+   {
+      return _order;
+   }
+
+   ui32 getLineSize() const
+   {
+      return _line_size;
+   }
+
+   ui32 getNbLines() const
+   {
+      return _nb_lines;
+   }
+
+   /**
+    @brief Return the offsets of the memory line @p line, relative to the origin of each memory
+    */
+   const size_t* getLineOffsets(ui32 line) const
+   {
+      return _offsets.data() + static_cast<size_t>(line) * NbMemories;
+   }
+
+   /**
+    @brief Call op(ptr_a1, stride_a1, ptr_a2, stride_a2, ..., nb_elements) for each memory line of the memories
+
+    The memories must match the geometry of the plan
+    */
+   template <class Op, class Memory1, class... Memories>
+   void run(const Parallel& parallel, Op& op, Memory1& a1, const Memories&... memories) const
+   {
+      using pointer_type = typename Memory1::pointer_type;
+      static_assert(are_pointers<pointer_type, typename Memories::pointer_type...>::value, "only memories in main memory are handled!");
+
+      ensure(_valid, "invalid plan!");
+      ensure(matches(a1, memories...), "the memories do not have the geometry of the plan!");
+      if (_nb_lines == 0)
+      {
+         return;
+      }
+
+      // split the memory lines if there are fewer lines than threads
+      const ui32 nb_threads_max         = details::getNbThreads<pointer_type>(parallel, a1.size(), std::numeric_limits<ui32>::max());
+      const ui32 nb_elements_per_access = details::getNbElementsPerAccessParallel<pointer_type>(nb_threads_max, _nb_lines, _line_size);
+      const ui32 nb_accesses_per_line   = (_line_size + nb_elements_per_access - 1) / nb_elements_per_access;
+      const ui32 nb_accesses            = _nb_lines * nb_accesses_per_line;
+
+      const index_type origin;
+      const auto origins =
+          std::make_tuple(pointer_type(a1.at(origin)), typename array_add_const<typename Memories::pointer_type>::type(memories.at(origin))...);
+      if (nb_accesses_per_line == 1 && nb_threads_max == 1)
+      {
+         for (ui32 line = 0; line < _nb_lines; ++line)
+         {
+            details::call_plan_line(op, origins, getLineOffsets(line), _line_strides.data(), _line_size, std::make_index_sequence<NbMemories>());
+         }
+         return;
+      }
+
+      auto process = [&](ui32 access_begin, ui32 access_end) {
+         std::array<size_t, NbMemories> offsets;
+         for (ui32 access = access_begin; access < access_end; ++access)
+         {
+            const ui32 line            = access / nb_accesses_per_line;
+            const ui32 element_begin   = (access % nb_accesses_per_line) * nb_elements_per_access;
+            const size_t* line_offsets = getLineOffsets(line);
+            for (size_t k = 0; k < NbMemories; ++k)
+            {
+               offsets[k] = line_offsets[k] + static_cast<size_t>(element_begin) * _line_strides[k];
+            }
+            const ui32 nb_elements = std::min(nb_elements_per_access, _line_size - element_begin);
+            details::call_plan_line(op, origins, offsets.data(), _line_strides.data(), nb_elements, std::make_index_sequence<NbMemories>());
+         }
+      };
+
+      details::parallel_accesses(std::min(nb_threads_max, nb_accesses), nb_accesses, process);
+   }
+
+private:
+   bool _valid = false;
+   geometry_type _geometry;
+   index_type _order;
+   ui32 _line_size = 0;
+   ui32 _nb_lines  = 0;
+   std::array<ui32, NbMemories> _line_strides;
+   std::vector<size_t> _offsets;
+};
+
+namespace details
+{
+/**
+ @brief Most recently used iteration plans, identified by their geometry
+ */
+template <size_t N, size_t NbMemories>
+class IterationPlanCache
+{
+public:
+   using plan_type = IterationPlan<N, NbMemories>;
+
+   /**
+    @brief Return the plan of the memories. It is computed if not in the cache
+    @note the plan is shared so that it stays alive if it is evicted by a nested traversal
+    */
+   template <class... Memories>
+   std::shared_ptr<const plan_type> get(const Memories&... memories)
+   {
+      const auto geometry = getIterationGeometry(memories...);
+      for (auto it = _plans.begin(); it != _plans.end(); ++it)
+      {
+         if ((*it)->getGeometry() == geometry)
+         {
+            auto plan = *it;
+            _plans.erase(it);
+            _plans.insert(_plans.begin(), plan);
+            return plan;
+         }
+      }
+
+      auto plan = std::make_shared<const plan_type>(plan_type::create(memories...));
+      _plans.insert(_plans.begin(), plan);
+      if (_plans.size() > capacity)
+      {
+         _plans.pop_back();
+      }
+      return plan;
+   }
+
+   void clear()
+   {
+      _plans.clear();
+   }
+
+   size_t size() const
+   {
+      return _plans.size();
+   }
+
+   static const size_t capacity = 16;
+
+private:
+   std::vector<std::shared_ptr<const plan_type>> _plans;
+};
+
+/**
+ @brief The cache is per thread so that no synchronization is required
+ */
+template <size_t N, size_t NbMemories>
+IterationPlanCache<N, NbMemories>& iteration_plan_cache()
+{
+   static thread_local IterationPlanCache<N, NbMemories> cache;
+   return cache;
+}
+}
+
+/**
+ @brief Compute the iteration plan of an array and any number of const arrays
+ @see iterate_array_constarrays
+ */
+template <class T, size_t N, class Config, class... Arrays>
+IterationPlan<N, sizeof...(Arrays) + 1> make_iteration_plan(const Array<T, N, Config>& a1, const Arrays&... arrays)
+{
+   return IterationPlan<N, sizeof...(Arrays) + 1>::create(a1.getMemory(), arrays.getMemory()...);
+}
+
+/**
+ @brief iterate jointly an array and any number of const arrays following a precomputed plan
+
+ @tparam Op must be callable with (pointer_type1 a1, ui32 stride_a1, const_pointer_type2 a2, ui32 stride_a2, ..., ui32 nb_elements)
+
+ @code
+ const auto plan = make_iteration_plan(out, a, b);
+ for (...)
+ {
+    iterate_array_constarrays(plan, op, out, a, b);
+ }
+ @endcode
+ */
+template <class Op, size_t NbMemories, class T, size_t N, class Config, class... Arrays,
+          typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_array_constarrays(const IterationPlan<N, NbMemories>& plan, Op& op, Array<T, N, Config>& a1, const Arrays&... arrays)
+{
+   plan.run(Parallel(1), op, a1.getMemory(), arrays.getMemory()...);
+}
+
+/**
+ @brief iterate jointly an array and any number of const arrays following a precomputed plan using several threads
+ */
+template <class Op, size_t NbMemories, class T, size_t N, class Config, class... Arrays,
+          typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_array_constarrays(const IterationPlan<N, NbMemories>& plan, const Parallel& parallel, Op& op, Array<T, N, Config>& a1,
+                               const Arrays&... arrays)
+{
+   plan.run(parallel, op, a1.getMemory(), arrays.getMemory()...);
+}
+
+/**
+ @brief iterate jointly an array and any number of const arrays, reusing the plan of a previous traversal with the same geometry
+
+ The plans are cached per thread. If no plan can be created (e.g., different data ordering), this is @ref iterate_array_constarrays
+ */
+template <class Op, class T, size_t N, class Config, class... Arrays,
+          typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_array_constarrays_cached(const Parallel& parallel, Op& op, Array<T, N, Config>& a1, const Arrays&... arrays)
+{
+   const auto plan = details::iteration_plan_cache<N, sizeof...(Arrays) + 1>().get(a1.getMemory(), arrays.getMemory()...);
+   if (plan->isValid())
+   {
+      plan->run(parallel, op, a1.getMemory(), arrays.getMemory()...);
+   }
+   else
+   {
+      details::iterate_memory_constmemories(parallel, op, a1.getMemory(), arrays.getMemory()...);
+   }
+}
+
+/**
+ @brief iterate jointly an array and any number of const arrays, reusing the plan of a previous traversal with the same geometry
+ */
+template <class Op, class T, size_t N, class Config, class... Arrays,
+          typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_array_constarrays_cached(Op& op, Array<T, N, Config>& a1, const Arrays&... arrays)
+{
+   iterate_array_constarrays_cached(Parallel(1), op, a1, arrays...);
+}
+
+DECLARE_NAMESPACE_NLL_END
@@ -0,0 +1,674 @@
+#pragma once
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @file
+
+ This file defines lazy elementwise expressions of arrays. The operators of the arrays return materialized arrays (see
+ array-noexp.h): r = (a - b) * 0.5f + c allocates two temporary arrays and reads and writes the memory three times.
+ Instead, the expressions built from @ref lazy are only evaluated when they are assigned to an array, in a single pass:
+
+ @code
+ Array<float, 2> r = (lazy(a) - b) * 0.5f + c; // a single pass, no temporary array
+ const float d = sum(lazy(a) * b);             // the products are summed in the same pass
+ r = sqrt(sqr(lazy(a)) + sqr(b));
+ @endcode
+
+ The memory lines of all the arrays of the expression are traversed jointly (see @ref iterate_array_constarrays) and evaluated
+ by blocks of @ref details::lazy_block_elements elements: each node of the expression computes its block in a buffer that stays
+ in the cache, using the same kernels as the operators (e.g., @ref details::add_naive) so that the results are identical to
+ the operators.
+
+ Within a lazy expression, a * b is the elementwise product, even for matrices. The expressions only hold references to their arrays:
+ the arrays must outlive the expression, e.g., lazy(a + b) must be evaluated in the statement that created it.
+ */
+
+/**
+ @brief Base class of the lazy expressions
+
+ Derived must provide:
+ - value_type, RANK and nb_leaves: the arrays of the expression
+ - shape(): the shape of the result
+ - leaves(): a tuple of references to the arrays of the expression, in the order of evaluation
+ - template <size_t Leaf> const value_type* evaluate(value_type* buffer, const details::LazyLine<value_type>& line, ui32 offset, ui32 size):
+   compute the elements [offset, offset + size) of the current line. The result is either in @p buffer or directly read from an array
+ */
+template <class Derived>
+class LazyExpression
+{
+public:
+   const Derived& derived() const
+   {
+      return static_cast<const Derived&>(*this);
+   }
+};
+
+namespace details
+{
+/**
+ @brief Number of elements of the lines of the lazy expressions evaluated at once: the buffers of the nodes stay in the L1 cache
+ */
+static const ui32 lazy_block_elements = 256;
+
+/**
+ @brief The current line of each array of a lazy expression
+ */
+template <class T>
+struct LazyLine
+{
+   const T* const* pointers;
+   const ui32* strides;
+};
+
+template <class T>
+void lazy_collect_line(const T**, ui32*, ui32& nb_elements, ui32 nb_elements_line)
+{
+   nb_elements = nb_elements_line;
+}
+
+/**
+ @brief Collect the (pointer, stride) pairs and the number of elements of the lines of a joint traversal
+ */
+template <class T, class Pointer, class... Inputs>
+void lazy_collect_line(const T** pointers, ui32* strides, ui32& nb_elements, Pointer pointer, ui32 stride, Inputs... inputs)
+{
+   *pointers = pointer;
+   *strides  = stride;
+   lazy_collect_line(pointers + 1, strides + 1, nb_elements, inputs...);
+}
+
+/**
+ @brief An array of a lazy expression
+ */
+template <class T, size_t N, class Config>
+class LazyArray : public LazyExpression<LazyArray<T, N, Config>>
+{
+public:
+   using value_type          = T;
+   using array_type          = Array<T, N, Config>;
+   using index_type          = typename array_type::index_type;
+   static const size_t RANK      = N;
+   static const size_t nb_leaves = 1;
+
+   explicit LazyArray(const array_type& array) : _array(array)
+   {
+   }
+
+   const index_type& shape() const
+   {
+      return _array.shape();
+   }
+
+   std::tuple<const array_type&> leaves() const
+   {
+      return std::tuple<const array_type&>(_array);
+   }
+
+   template <size_t Leaf>
+   const T* evaluate(T* buffer, const LazyLine<T>& line, ui32 offset, ui32 size) const
+   {
+      const ui32 stride = line.strides[Leaf];
+      const T* input    = line.pointers[Leaf] + static_cast<size_t>(offset) * stride;
+      if (stride == 1)
+      {
+         return input;
+      }
+      copy_naive(buffer, 1, input, stride, size);
+      return buffer;
+   }
+
+private:
+   const array_type& _array;
+};
+
+template <class T>
+T* lazy_copy_to_buffer(T* buffer, const T* input, ui32 size)
+{
+   if (input != buffer)
+   {
+      copy_naive(buffer, 1, input, 1, size);
+   }
+   return buffer;
+}
+
+/// buffer += input
+struct LazyAdd
+{
+   template <class T>
+   static void apply(T* buffer, const T* input, ui32 size)
+   {
+      add_naive(buffer, 1, input, 1, size);
+   }
+};
+
+/// buffer -= input
+struct LazySub
+{
+   template <class T>
+   static void apply(T* buffer, const T* input, ui32 size)
+   {
+      sub_naive(buffer, 1, input, 1, size);
+   }
+};
+
+/// buffer *= input
+struct LazyMul
+{
+   template <class T>
+   static void apply(T* buffer, const T* input, ui32 size)
+   {
+      mul_naive_elementwise(buffer, 1, input, 1, size);
+   }
+};
+
+/// buffer /= input
+struct LazyDiv
+{
+   template <class T>
+   static void apply(T* buffer, const T* input, ui32 size)
+   {
+      div_naive_elementwise(buffer, 1, input, 1, size);
+   }
+};
+
+/**
+ @brief Elementwise operation of two expressions
+ */
+template <class Left, class Right, class Op>
+class LazyBinary : public LazyExpression<LazyBinary<Left, Right, Op>>
+{
+public:
+   using value_type              = typename Left::value_type;
+   static const size_t RANK      = Left::RANK;
+   static const size_t nb_leaves = Left::nb_leaves + Right::nb_leaves;
+
+   static_assert(std::is_same<value_type, typename Right::value_type>::value, "the arrays of an expression must have the same type!");
+   static_assert(Left::RANK == Right::RANK, "the arrays of an expression must have the same rank!");
+
+   LazyBinary(const Left& left, const Right& right) : _left(left), _right(right)
+   {
+   }
+
+   auto shape() const -> decltype(std::declval<const Left&>().shape())
+   {
+      return _left.shape();
+   }
+
+   auto leaves() const -> decltype(std::tuple_cat(std::declval<const Left&>().leaves(), std::declval<const Right&>().leaves()))
+   {
+      return std::tuple_cat(_left.leaves(), _right.leaves());
+   }
+
+   template <size_t Leaf>
+   const value_type* evaluate(value_type* buffer, const LazyLine<value_type>& line, ui32 offset, ui32 size) const
+   {
+      value_type right_buffer[lazy_block_elements];
+      const value_type* left  = _left.template evaluate<Leaf>(buffer, line, offset, size);
+      const value_type* right = _right.template evaluate<Leaf + Left::nb_leaves>(right_buffer, line, offset, size);
+      Op::apply(lazy_copy_to_buffer(buffer, left, size), right, size);
+      return buffer;
+   }
+
+private:
+   Left _left;
+   Right _right;
+};
+
+/// buffer += value
+struct LazyAddScalar
+{
+   template <class T>
+   static void apply(T* buffer, T value, ui32 size)
+   {
+      add_naive_cte(buffer, 1, size, value);
+   }
+};
+
+/// buffer -= value
+struct LazySubScalar
+{
+   template <class T>
+   static void apply(T* buffer, T value, ui32 size)
+   {
+      add_naive_cte(buffer, 1, size, static_cast<T>(-value));
+   }
+};
+
+/// buffer *= value
+struct LazyMulScalar
+{
+   template <class T>
+   static void apply(T* buffer, T value, ui32 size)
+   {
+      mul_naive(buffer, 1, value, size);
+   }
+};
+
+/// buffer /= value
+struct LazyDivScalar
+{
+   template <class T>
+   static void apply(T* buffer, T value, ui32 size)
+   {
+      div_naive(buffer, 1, value, size);
+   }
+};
+
+/**
+ @brief Elementwise operation of an expression and a scalar
+ */
+template <class E, class Op>
+class LazyScalar : public LazyExpression<LazyScalar<E, Op>>
+{
+public:
+   using value_type              = typename E::value_type;
+   static const size_t RANK      = E::RANK;
+   static const size_t nb_leaves = E::nb_leaves;
+
+   LazyScalar(const E& expression, value_type value) : _expression(expression), _value(value)
+   {
+   }
+
+   auto shape() const -> decltype(std::declval<const E&>().shape())
+   {
+      return _expression.shape();
+   }
+
+   auto leaves() const -> decltype(std::declval<const E&>().leaves())
+   {
+      return _expression.leaves();
+   }
+
+   template <size_t Leaf>
+   const value_type* evaluate(value_type* buffer, const LazyLine<value_type>& line, ui32 offset, ui32 size) const
+   {
+      const value_type* input = _expression.template evaluate<Leaf>(buffer, line, offset, size);
+      Op::apply(lazy_copy_to_buffer(buffer, input, size), _value, size);
+      return buffer;
+   }
+
+private:
+   E _expression;
+   value_type _value;
+};
+
+/**
+ @brief A function applied to each element of an expression, e.g., @ref details::sqrt
+ */
+template <class E>
+class LazyFunction : public LazyExpression<LazyFunction<E>>
+{
+public:
+   using value_type              = typename E::value_type;
+   using function_type           = void (*)(value_type* output, ui32 output_stride, const value_type* input, ui32 input_stride, ui32 nb_elements);
+   static const size_t RANK      = E::RANK;
+   static const size_t nb_leaves = E::nb_leaves;
+
+   LazyFunction(const E& expression, function_type function) : _expression(expression), _function(function)
+   {
+   }
+
+   auto shape() const -> decltype(std::declval<const E&>().shape())
+   {
+      return _expression.shape();
+   }
+
+   auto leaves() const -> decltype(std::declval<const E&>().leaves())
+   {
+      return _expression.leaves();
+   }
+
+   template <size_t Leaf>
+   const value_type* evaluate(value_type* buffer, const LazyLine<value_type>& line, ui32 offset, ui32 size) const
+   {
+      const value_type* input = _expression.template evaluate<Leaf>(buffer, line, offset, size);
+      _function(buffer, 1, input, 1, size);
+      return buffer;
+   }
+
+private:
+   E _expression;
+   function_type _function;
+};
+
+template <class T, size_t N, class Config>
+LazyArray<T, N, Config> lazy_operand(const Array<T, N, Config>& array)
+{
+   return LazyArray<T, N, Config>(array);
+}
+
+template <class E>
+const E& lazy_operand(const LazyExpression<E>& expression)
+{
+   return expression.derived();
+}
+
+/**
+ @brief The node of an operand of a lazy expression: an array or an expression
+ */
+template <class X>
+using lazy_operand_type = typename std::decay<decltype(lazy_operand(std::declval<const X&>()))>::type;
+
+template <class X>
+using is_lazy_expression = std::is_base_of<LazyExpression<typename std::decay<X>::type>, typename std::decay<X>::type>;
+
+/**
+ @brief The binary operators are enabled if one of the operands is an expression and the other an expression or an array
+ */
+template <class A, class B, class Op>
+using lazy_binary_type = typename std::enable_if<is_lazy_expression<A>::value || is_lazy_expression<B>::value,
+                                                 LazyBinary<lazy_operand_type<A>, lazy_operand_type<B>, Op>>::type;
+
+template <class E, class T2>
+using lazy_scalar_enabled = typename std::enable_if<std::is_convertible<T2, typename E::value_type>::value>::type;
+
+/**
+ @brief Evaluate the expression over the joint traversal of its arrays
+ */
+template <class E>
+class LazyEvaluation
+{
+public:
+   using value_type = typename E::value_type;
+
+   LazyEvaluation(const E& expression) : _expression(expression)
+   {
+   }
+
+   /// output = expression
+   template <class Pointer, class... Inputs>
+   void operator()(Pointer output, ui32 output_stride, Inputs... inputs) const
+   {
+      const value_type* pointers[E::nb_leaves];
+      ui32 strides[E::nb_leaves];
+      ui32 nb_elements;
+      lazy_collect_line(pointers, strides, nb_elements, inputs...);
+
+      const LazyLine<value_type> line = {pointers, strides};
+      value_type buffer[lazy_block_elements];
+      for (ui32 offset = 0; offset < nb_elements; offset += lazy_block_elements)
+      {
+         const ui32 size           = std::min(lazy_block_elements, nb_elements - offset);
+         const value_type* results = _expression.template evaluate<0>(buffer, line, offset, size);
+         copy_naive(output + static_cast<size_t>(offset) * output_stride, output_stride, results, 1, size);
+      }
+   }
+
+private:
+   const E& _expression;
+};
+
+/**
+ @brief Sum of the expression over the memory lines of a block of the joint traversal of its arrays, see @ref sum
+
+ The first array of the expression is the first array of the traversal but it is only read
+ */
+template <class E, class Accum>
+class LazySum
+{
+public:
+   using value_type = typename E::value_type;
+
+   LazySum(const E& expression, const ReducerSum<value_type, Accum>& reducer) : _expression(expression), _reducer(reducer), _merge(reducer)
+   {
+   }
+
+   template <class... Inputs>
+   void operator()(Inputs... inputs)
+   {
+      const value_type* pointers[E::nb_leaves];
+      ui32 strides[E::nb_leaves];
+      ui32 nb_elements;
+      lazy_collect_line(pointers, strides, nb_elements, inputs...);
+
+      // the line is split in blocks of the reductions, merged pairwise
+      const LazyLine<value_type> line = {pointers, strides};
+      value_type buffer[lazy_block_elements];
+      for (ui32 block = 0; block < nb_elements; block += reduction_block_elements)
+      {
+         const ui32 block_end = std::min(block + reduction_block_elements, nb_elements);
+         Accum accum          = _reducer.init();
+         for (ui32 offset = block; offset < block_end; offset += lazy_block_elements)
+         {
+            const ui32 size           = std::min(lazy_block_elements, block_end - offset);
+            const value_type* results = _expression.template evaluate<0>(buffer, line, offset, size);
+            accum += sum_naive<value_type, Accum>(results, 1, size);
+         }
+         _merge.add(accum);
+      }
+   }
+
+   Accum result() const
+   {
+      return _merge.result();
+   }
+
+private:
+   const E& _expression;
+   const ReducerSum<value_type, Accum>& _reducer;
+   PairwiseMerge<ReducerSum<value_type, Accum>> _merge;
+};
+
+template <class Op, class T, size_t N, class Config, class Leaves, size_t... I>
+void lazy_iterate(const Parallel& parallel, Op& op, Array<T, N, Config>& output, const Leaves& leaves, std::index_sequence<I...>)
+{
+   iterate_array_constarrays(parallel, op, output, std::get<I>(leaves)...);
+}
+
+/**
+ @brief output = expression, evaluated in a single pass. @p output is reallocated if it doesn't have the shape of the expression
+ */
+template <class T, size_t N, class Config, class E>
+void lazy_evaluate(Array<T, N, Config>& output, const LazyExpression<E>& expression)
+{
+   static_assert(std::is_same<T, typename E::value_type>::value, "the expression must have the type of the array!");
+   static_assert(E::RANK == N, "the expression must have the rank of the array!");
+
+   const E& e = expression.derived();
+   if (output.shape() != e.shape())
+   {
+      output = Array<T, N, Config>(e.shape());
+   }
+
+   LazyEvaluation<E> op(e);
+   const auto leaves = e.leaves();
+   lazy_iterate(Parallel(), op, output, leaves, std::make_index_sequence<E::nb_leaves>());
+}
+
+template <class Schedule, class Leaves, size_t... I>
+void lazy_iterate_accesses(Schedule& schedule, const Leaves& leaves, std::index_sequence<I...>)
+{
+   using first_array = typename std::decay<typename std::tuple_element<0, Leaves>::type>::type;
+   iterate_memory_constmemories_tiled_accesses(schedule, const_cast<first_array&>(std::get<0>(leaves)).getMemory(), std::get<I + 1>(leaves).getMemory()...);
+}
+
+template <class Accum, class E>
+Accum lazy_sum(const E& e)
+{
+   using value_type = typename E::value_type;
+   const ReducerSum<value_type, Accum> reducer;
+
+   size_t size = 1;
+   for (auto s : e.shape())
+   {
+      size *= s;
+   }
+   if (size == 0)
+   {
+      return reducer.init();
+   }
+
+   // as in reduce_constarray, the accesses of the traversal are grouped in blocks of about reduction_block_elements elements that
+   // are summed independently and merged pairwise in block order: the result doesn't depend on the number of threads
+   Accum result  = reducer.init();
+   auto schedule = [&](ui32 nb_accesses, auto& process) {
+      const size_t nb_elements_per_access = std::max<size_t>(1, size / nb_accesses);
+      const ui32 nb_accesses_per_block    = static_cast<ui32>(std::max<size_t>(1, reduction_block_elements / nb_elements_per_access));
+      const ui32 nb_blocks                = (nb_accesses + nb_accesses_per_block - 1) / nb_accesses_per_block;
+
+      std::vector<Accum> partials(nb_blocks, reducer.init());
+      auto process_blocks = [&](ui32 block_begin, ui32 block_end) {
+         for (ui32 block = block_begin; block < block_end; ++block)
+         {
+            LazySum<E, Accum> op(e, reducer);
+            const ui32 access_begin = block * nb_accesses_per_block;
+            process(op, access_begin, std::min(nb_accesses - access_begin, nb_accesses_per_block) + access_begin);
+            partials[block] = op.result();
+         }
+      };
+      const ui32 nb_threads = getNbThreads<const value_type*>(Parallel(), size, nb_blocks);
+      parallel_accesses(nb_threads, nb_blocks, process_blocks);
+      result = merge_blocks_pairwise(reducer, partials);
+   };
+
+   const auto leaves = e.leaves();
+   lazy_iterate_accesses(schedule, leaves, std::make_index_sequence<E::nb_leaves - 1>());
+   return result;
+}
+}
+
+/**
+ @brief Start a lazy expression from an array, see array-lazy.h
+
+ @code
+ Array<float, 2> r = (lazy(a) - b) * 0.5f + c;
+ @endcode
+ */
+template <class T, size_t N, class Config>
+details::LazyArray<T, N, Config> lazy(const Array<T, N, Config>& array)
+{
+   return details::LazyArray<T, N, Config>(array);
+}
+
+template <class A, class B>
+details::lazy_binary_type<A, B, details::LazyAdd> operator+(const A& a, const B& b)
+{
+   return details::lazy_binary_type<A, B, details::LazyAdd>(details::lazy_operand(a), details::lazy_operand(b));
+}
+
+template <class A, class B>
+details::lazy_binary_type<A, B, details::LazySub> operator-(const A& a, const B& b)
+{
+   return details::lazy_binary_type<A, B, details::LazySub>(details::lazy_operand(a), details::lazy_operand(b));
+}
+
+/**
+ @brief Elementwise product. Unlike the operator of the arrays, this is not the matrix product
+ */
+template <class A, class B>
+details::lazy_binary_type<A, B, details::LazyMul> operator*(const A& a, const B& b)
+{
+   return details::lazy_binary_type<A, B, details::LazyMul>(details::lazy_operand(a), details::lazy_operand(b));
+}
+
+template <class A, class B>
+details::lazy_binary_type<A, B, details::LazyDiv> operator/(const A& a, const B& b)
+{
+   return details::lazy_binary_type<A, B, details::LazyDiv>(details::lazy_operand(a), details::lazy_operand(b));
+}
+
+template <class E, class T2, typename = details::lazy_scalar_enabled<E, T2>>
+details::LazyScalar<E, details::LazyAddScalar> operator+(const LazyExpression<E>& expression, T2 value)
+{
+   return details::LazyScalar<E, details::LazyAddScalar>(expression.derived(), static_cast<typename E::value_type>(value));
+}
+
+template <class E, class T2, typename = details::lazy_scalar_enabled<E, T2>>
+details::LazyScalar<E, details::LazyAddScalar> operator+(T2 value, const LazyExpression<E>& expression)
+{
+   return details::LazyScalar<E, details::LazyAddScalar>(expression.derived(), static_cast<typename E::value_type>(value));
+}
+
+template <class E, class T2, typename = details::lazy_scalar_enabled<E, T2>>
+details::LazyScalar<E, details::LazySubScalar> operator-(const LazyExpression<E>& expression, T2 value)
+{
+   return details::LazyScalar<E, details::LazySubScalar>(expression.derived(), static_cast<typename E::value_type>(value));
+}
+
+template <class E, class T2, typename = details::lazy_scalar_enabled<E, T2>>
+details::LazyScalar<E, details::LazyMulScalar> operator*(const LazyExpression<E>& expression, T2 value)
+{
+   return details::LazyScalar<E, details::LazyMulScalar>(expression.derived(), static_cast<typename E::value_type>(value));
+}
+
+template <class E, class T2, typename = details::lazy_scalar_enabled<E, T2>>
+details::LazyScalar<E, details::LazyMulScalar> operator*(T2 value, const LazyExpression<E>& expression)
+{
+   return details::LazyScalar<E, details::LazyMulScalar>(expression.derived(), static_cast<typename E::value_type>(value));
+}
+
+template <class E, class T2, typename = details::lazy_scalar_enabled<E, T2>>
+details::LazyScalar<E, details::LazyDivScalar> operator/(const LazyExpression<E>& expression, T2 value)
+{
+   return details::LazyScalar<E, details::LazyDivScalar>(expression.derived(), static_cast<typename E::value_type>(value));
+}
+
+template <class E>
+details::LazyFunction<E> cos(const LazyExpression<E>& expression)
+{
+   return details::LazyFunction<E>(expression.derived(), &details::cos<typename E::value_type>);
+}
+
+template <class E>
+details::LazyFunction<E> sin(const LazyExpression<E>& expression)
+{
+   return details::LazyFunction<E>(expression.derived(), &details::sin<typename E::value_type>);
+}
+
+template <class E>
+details::LazyFunction<E> sqrt(const LazyExpression<E>& expression)
+{
+   return details::LazyFunction<E>(expression.derived(), &details::sqrt<typename E::value_type>);
+}
+
+template <class E>
+details::LazyFunction<E> sqr(const LazyExpression<E>& expression)
+{
+   return details::LazyFunction<E>(expression.derived(), &details::sqr<typename E::value_type>);
+}
+
+template <class E>
+details::LazyFunction<E> abs(const LazyExpression<E>& expression)
+{
+   return details::LazyFunction<E>(expression.derived(), &details::abs<typename E::value_type>);
+}
+
+template <class E>
+details::LazyFunction<E> exp(const LazyExpression<E>& expression)
+{
+   return details::LazyFunction<E>(expression.derived(), &details::exp<typename E::value_type>);
+}
+
+template <class E>
+details::LazyFunction<E> log(const LazyExpression<E>& expression)
+{
+   return details::LazyFunction<E>(expression.derived(), &details::log<typename E::value_type>);
+}
+
+/**
+ @brief return the sum of the elements of an expression, computed in the same pass as the expression (e.g., sum(lazy(a) * b))
+
+ The sums of the blocks are merged pairwise in block order as in @ref sum: the result doesn't depend on the number of threads
+ */
+template <class E, class Accum = typename PromoteSum<typename E::value_type>::type>
+Accum sum(const LazyExpression<E>& expression)
+{
+   return details::lazy_sum<Accum>(expression.derived());
+}
+
+/**
+ @brief return the mean of the elements of an expression, computed in the same pass as the expression
+ */
+template <class E, class Accum = typename PromoteSum<typename E::value_type>::type>
+Accum mean(const LazyExpression<E>& expression)
+{
+   size_t size = 1;
+   for (auto s : expression.derived().shape())
+   {
+      size *= s;
+   }
+   return details::lazy_sum<Accum>(expression.derived()) / static_cast<Accum>(size);
+}
+
+DECLARE_NAMESPACE_NLL_END
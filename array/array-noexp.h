@@ -4,6 +4,12 @@
  @file
 
  This file defines the array operators for the non enabled expression template arrays
+
+ The operators that are not mapped to BLAS (i.e., adding a scalar and the elementwise division) are defined
+ for all the arrays
+
+ The operators taking a temporary array reuse its memory for the result, so that a chain of operations,
+ e.g., a + b + c + d, allocates a single array. operator+ and operator- reuse either operand
  */
 DECLARE_NAMESPACE_NLL
 
@@ -28,6 +34,34 @@ Array_NaiveOperatorEnabled<T, N, Config1> operator+(const Array<T, N, Config1>&
    return cpy;
 }
 
+template <class T, size_t N, class Config1, class Config2>
+Array_NaiveOperatorEnabled<T, N, Config1> operator+(Array<T, N, Config1>&& lhs, const Array<T, N, Config2>& rhs)
+{
+   if (!details::array_is_reusable(lhs))
+   {
+      return static_cast<const Array<T, N, Config1>&>(lhs) + rhs;
+   }
+   lhs += rhs;
+   return std::move(lhs);
+}
+
+template <class T, size_t N, class Config>
+Array_NaiveOperatorEnabled<T, N, Config> operator+(const Array<T, N, Config>& lhs, Array<T, N, Config>&& rhs)
+{
+   if (!details::array_is_reusable(rhs))
+   {
+      return lhs + static_cast<const Array<T, N, Config>&>(rhs);
+   }
+   rhs += lhs;
+   return std::move(rhs);
+}
+
+template <class T, size_t N, class Config>
+Array_NaiveOperatorEnabled<T, N, Config> operator+(Array<T, N, Config>&& lhs, Array<T, N, Config>&& rhs)
+{
+   return std::move(lhs) + static_cast<const Array<T, N, Config>&>(rhs);
+}
+
 template <class T, size_t N, class Config1, class Config2>
 Array_NaiveOperatorEnabled<T, N, Config1>& operator-=(Array<T, N, Config1>& lhs, const Array<T, N, Config2>& rhs)
 {
@@ -43,6 +77,34 @@ Array_NaiveOperatorEnabled<T, N, Config1> operator-(const Array<T, N, Config1>&
    return cpy;
 }
 
+template <class T, size_t N, class Config1, class Config2>
+Array_NaiveOperatorEnabled<T, N, Config1> operator-(Array<T, N, Config1>&& lhs, const Array<T, N, Config2>& rhs)
+{
+   if (!details::array_is_reusable(lhs))
+   {
+      return static_cast<const Array<T, N, Config1>&>(lhs) - rhs;
+   }
+   lhs -= rhs;
+   return std::move(lhs);
+}
+
+template <class T, size_t N, class Config>
+Array_NaiveOperatorEnabled<T, N, Config> operator-(const Array<T, N, Config>& lhs, Array<T, N, Config>&& rhs)
+{
+   if (!details::array_is_reusable(rhs))
+   {
+      return lhs - static_cast<const Array<T, N, Config>&>(rhs);
+   }
+   sub(rhs, lhs, rhs);
+   return std::move(rhs);
+}
+
+template <class T, size_t N, class Config>
+Array_NaiveOperatorEnabled<T, N, Config> operator-(Array<T, N, Config>&& lhs, Array<T, N, Config>&& rhs)
+{
+   return std::move(lhs) - static_cast<const Array<T, N, Config>&>(rhs);
+}
+
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
 Array_NaiveOperatorEnabled<T, N, Config1>& operator*=(Array<T, N, Config1>& lhs, T2 value)
 {
@@ -59,14 +121,25 @@ Array_NaiveOperatorEnabled<T, N, Config1> operator*(const Array<T, N, Config1>&
 }
 
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
-Array_NaiveOperatorEnabled<T, N, Config1>& operator+=(Array<T, N, Config1>& lhs, T2 value)
+Array_NaiveOperatorEnabled<T, N, Config1> operator*(Array<T, N, Config1>&& lhs, T2 value)
+{
+   if (!details::array_is_reusable(lhs))
+   {
+      return static_cast<const Array<T, N, Config1>&>(lhs) * value;
+   }
+   lhs *= static_cast<T>(value);
+   return std::move(lhs);
+}
+
+template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config1>& operator+=(Array<T, N, Config1>& lhs, T2 value)
 {
    details::array_add_cte(lhs, static_cast<T>(value));
    return lhs;
 }
 
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
-Array_NaiveOperatorEnabled<T, N, Config1> operator+(const Array<T, N, Config1>& lhs, T2 value)
+Array<T, N, Config1> operator+(const Array<T, N, Config1>& lhs, T2 value)
 {
    Array<T, N, Config1> cpy = lhs;
    cpy += static_cast<T>(value);
@@ -74,7 +147,18 @@ Array_NaiveOperatorEnabled<T, N, Config1> operator+(const Array<T, N, Config1>&
 }
 
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
-Array_NaiveOperatorEnabled<T, N, Config1> operator+(T2 value, const Array<T, N, Config1>& lhs)
+Array<T, N, Config1> operator+(Array<T, N, Config1>&& lhs, T2 value)
+{
+   if (!details::array_is_reusable(lhs))
+   {
+      return static_cast<const Array<T, N, Config1>&>(lhs) + value;
+   }
+   lhs += static_cast<T>(value);
+   return std::move(lhs);
+}
+
+template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config1> operator+(T2 value, const Array<T, N, Config1>& lhs)
 {
    Array<T, N, Config1> cpy = lhs;
    cpy += static_cast<T>(value);
@@ -82,20 +166,37 @@ Array_NaiveOperatorEnabled<T, N, Config1> operator+(T2 value, const Array<T, N,
 }
 
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
-Array_NaiveOperatorEnabled<T, N, Config1>& operator-=(Array<T, N, Config1>& lhs, T2 value)
+Array<T, N, Config1> operator+(T2 value, Array<T, N, Config1>&& lhs)
+{
+   return std::move(lhs) + value;
+}
+
+template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config1>& operator-=(Array<T, N, Config1>& lhs, T2 value)
 {
    details::array_add_cte(lhs, static_cast<T>(-value));
    return lhs;
 }
 
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
-Array_NaiveOperatorEnabled<T, N, Config1> operator-(const Array<T, N, Config1>& lhs, T2 value)
+Array<T, N, Config1> operator-(const Array<T, N, Config1>& lhs, T2 value)
 {
    Array<T, N, Config1> cpy = lhs;
    cpy -= static_cast<T>(value);
    return cpy;
 }
 
+template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config1> operator-(Array<T, N, Config1>&& lhs, T2 value)
+{
+   if (!details::array_is_reusable(lhs))
+   {
+      return static_cast<const Array<T, N, Config1>&>(lhs) - value;
+   }
+   lhs -= static_cast<T>(value);
+   return std::move(lhs);
+}
+
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
 Array_NaiveOperatorEnabled<T, N, Config1> operator*(T2 value, const Array<T, N, Config1>& rhs)
 {
@@ -104,6 +205,12 @@ Array_NaiveOperatorEnabled<T, N, Config1> operator*(T2 value, const Array<T, N,
    return cpy;
 }
 
+template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array_NaiveOperatorEnabled<T, N, Config1> operator*(T2 value, Array<T, N, Config1>&& rhs)
+{
+   return std::move(rhs) * value;
+}
+
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
 Array_NaiveOperatorEnabled<T, N, Config1>& operator/=(Array<T, N, Config1>& lhs, T2 value)
 {
@@ -112,28 +219,50 @@ Array_NaiveOperatorEnabled<T, N, Config1>& operator/=(Array<T, N, Config1>& lhs,
 }
 
 template <class T, class T2, size_t N, class Config1, class Config2>
-Array_NaiveOperatorEnabled<T, N, Config1>& operator/=(Array<T, N, Config1>& lhs, const Array<T2, N, Config2>& rhs)
+Array<T, N, Config1>& operator/=(Array<T, N, Config1>& lhs, const Array<T2, N, Config2>& rhs)
 {
    details::array_div_elementwise(lhs, rhs);
    return lhs;
 }
 
 template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
-Array_NaiveOperatorEnabled<T, N, Config1> operator/(Array<T, N, Config1>& lhs, T2 value)
+Array_NaiveOperatorEnabled<T, N, Config1> operator/(const Array<T, N, Config1>& lhs, T2 value)
 {
    Array<T, N, Config1> cpy = lhs;
    cpy /= static_cast<T>(value);
    return cpy;
 }
 
+template <class T, class T2, size_t N, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array_NaiveOperatorEnabled<T, N, Config1> operator/(Array<T, N, Config1>&& lhs, T2 value)
+{
+   if (!details::array_is_reusable(lhs))
+   {
+      return static_cast<const Array<T, N, Config1>&>(lhs) / value;
+   }
+   lhs /= static_cast<T>(value);
+   return std::move(lhs);
+}
+
 template <class T, class T2, size_t N, class Config1, class Config2>
-Array_NaiveOperatorEnabled<T, N, Config1> operator/(const Array<T, N, Config1>& lhs, const Array<T2, N, Config2>& rhs)
+Array<T, N, Config1> operator/(const Array<T, N, Config1>& lhs, const Array<T2, N, Config2>& rhs)
 {
    Array<T, N, Config1> cpy = lhs;
    cpy /= rhs;
    return cpy;
 }
 
+template <class T, class T2, size_t N, class Config1, class Config2>
+Array<T, N, Config1> operator/(Array<T, N, Config1>&& lhs, const Array<T2, N, Config2>& rhs)
+{
+   if (!details::array_is_reusable(lhs))
+   {
+      return static_cast<const Array<T, N, Config1>&>(lhs) / rhs;
+   }
+   lhs /= rhs;
+   return std::move(lhs);
+}
+
 template <class T, size_t N, class Config1, class Config2>
 Array_NaiveOperatorEnabled<T, N, Config1> operator*(const Array<T, N, Config1>& lhs, const Array<T, N, Config2>& rhs)
 {
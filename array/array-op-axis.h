@@ -56,33 +56,33 @@ axis_apply_fun_type<T, N, Config, Function> constarray_axis_apply_function(const
    }
 
    // for each value of <result>, iterate over the <axis> dimension
-   // here we can only iterate over a single element at a time
+   // the index of the elements of each memory line of <result> is derived incrementally
    using array_result = axis_apply_fun_type<T, N, Config, Function>;
    array_result result(shape_result);
 
    using pointer_type       = typename array_result::pointer_type;
    using const_pointer_type = typename array_result::const_pointer_type;
 
-   bool hasMoreElements = true;
-   ArrayProcessor_contiguous_byMemoryLocality<array_result> iterator(result, 1);
-   while (hasMoreElements)
-   {
-      pointer_type ptr(nullptr);
-      hasMoreElements         = iterator.accessSingleElement(ptr);
-      const auto currentIndex = iterator.getArrayIndex();
-
+   using index_result = typename array_result::index_type;
+   auto op            = [&](pointer_type ptr, ui32 stride, ui32 nb_elements, const index_result& line_index, ui32 varying_index) {
       for (size_t n = 0; n < N - 1; ++n)
       {
-         max_index[mapping_result_array[n]] = currentIndex[n];
-         min_index[mapping_result_array[n]] = currentIndex[n];
+         max_index[mapping_result_array[n]] = line_index[n];
+         min_index[mapping_result_array[n]] = line_index[n];
       }
-      // finally apply the operation along <axis>
-      const auto ref = const_cast<Array<T, N, Config>&>(array)(
-          min_index,
-          max_index); // for interface usability, the sub-array of a const array is not practical. Instead, unconstify the array and constify the reference
-      const auto value = f(ref);
-      details::copy_naive(ptr, 1, &value, 1, 1);
-   }
+
+      const ui32 varying_index_array = mapping_result_array[varying_index];
+      for (ui32 n = 0; n < nb_elements; ++n, ++min_index[varying_index_array], ++max_index[varying_index_array])
+      {
+         // finally apply the operation along <axis>
+         const auto ref = const_cast<Array<T, N, Config>&>(array)(
+             min_index,
+             max_index); // for interface usability, the sub-array of a const array is not practical. Instead, unconstify the array and constify the reference
+         const auto value = f(ref);
+         details::copy_naive(ptr + n * stride, 1, &value, 1, 1);
+      }
+   };
+   iterate_array_index(result, op);
    return result;
 }
 
@@ -325,35 +325,109 @@ axis_apply_fun_type<T, N, Config, Function> constarray_axis_apply_function_basei
    }
 
    // for each value of <result>, iterate over the <axis> dimension
-   // here we can only iterate over a single element at a time
+   // the index of the elements of each memory line of <result> is derived incrementally
    using array_result = axis_apply_fun_type<T, N, Config, Function>;
    array_result result(shape_result);
 
    using pointer_type       = typename array_result::pointer_type;
    using const_pointer_type = typename array_result::const_pointer_type;
 
-   bool hasMoreElements = true;
-   ArrayProcessor_contiguous_byMemoryLocality<array_result> iterator(result, 1);
-   while (hasMoreElements)
+   using index_result = typename array_result::index_type;
+   auto op            = [&](pointer_type ptr, ui32 stride, ui32 nb_elements, const index_result& line_index, ui32 varying_index) {
+      for (size_t n = 0; n < N - 1; ++n)
+      {
+         max_index[mapping_result_array[n]] = line_index[n];
+         min_index[mapping_result_array[n]] = line_index[n];
+      }
+
+      const ui32 varying_index_array = mapping_result_array[varying_index];
+      for (ui32 n = 0; n < nb_elements; ++n, ++min_index[varying_index_array], ++max_index[varying_index_array])
+      {
+         // finally apply the operation along <axis>
+         const auto ref = const_cast<Array<T, N, Config>&>(array)(
+             min_index,
+             max_index); // for interface usability, the sub-array of a const array is not practical. Instead, unconstify the array and constify the reference
+         const auto value = f(ref) + min_index;
+         details::copy_naive(ptr + n * stride, 1, &value, 1, 1);
+      }
+   };
+   iterate_array_index(result, op);
+   return result;
+}
+}
+
+namespace details
+{
+/**
+@brief argmin (Max = false) or argmax (Max = true) along <axis> of an array with a contiguous memory
+
+Each result is computed directly from the strided memory line along <axis> and the results are computed in parallel
+*/
+template <bool Max, class T, size_t N, class Config>
+axis_apply_fun_type<T, N, Config, details::adaptor_argmax> constarray_axis_arg(const Array<T, N, Config>& array, size_t axis)
+{
+   static_assert(N >= 2, "can only do this for RANK >= 2");
+   using array_result = axis_apply_fun_type<T, N, Config, details::adaptor_argmax>;
+   if (array.size() == 0)
    {
-      pointer_type ptr(nullptr);
-      hasMoreElements         = iterator.accessSingleElement(ptr);
-      const auto currentIndex = iterator.getArrayIndex();
+      return array_result();
+   }
 
-      for (size_t n = 0; n < N - 1; ++n)
+   StaticVector<ui32, N - 1> shape_result;
+   StaticVector<ui32, N - 1> mapping_result_array;
+   size_t index = 0;
+   for (ui32 n = 0; n < N; ++n)
+   {
+      if (n != axis)
       {
-         max_index[mapping_result_array[n]] = currentIndex[n];
-         min_index[mapping_result_array[n]] = currentIndex[n];
+         shape_result[index]         = array.shape()[n];
+         mapping_result_array[index] = n;
+         ++index;
       }
-      // finally apply the operation along <axis>
-      const auto ref = const_cast<Array<T, N, Config>&>(array)(
-          min_index,
-          max_index); // for interface usability, the sub-array of a const array is not practical. Instead, unconstify the array and constify the reference
-      const auto value = f(ref) + min_index;
-      details::copy_naive(ptr, 1, &value, 1, 1);
    }
+   array_result result(shape_result);
+
+   const ui32 axis_stride = array.getMemory().getIndexMapper()._getPhysicalStrides()[axis];
+   const ui32 axis_size   = array.shape()[axis];
+
+   using pointer_type = typename array_result::pointer_type;
+   using index_result = typename array_result::index_type;
+   auto op            = [&](pointer_type ptr, ui32 stride, ui32 nb_elements, const index_result& line_index, ui32 varying_index) {
+      typename Array<T, N, Config>::index_type array_index;
+      for (size_t n = 0; n < N - 1; ++n)
+      {
+         array_index[mapping_result_array[n]] = line_index[n];
+      }
+
+      const ui32 varying_index_array = mapping_result_array[varying_index];
+      for (ui32 n = 0; n < nb_elements; ++n, ++array_index[varying_index_array])
+      {
+         const auto best = details::arg_naive<Max>(&array(array_index), axis_stride, axis_size);
+         auto value      = array_index;
+         value[axis]     = best.first;
+         details::copy_naive(ptr + n * stride, 1, &value, 1, 1);
+      }
+   };
+
+   // each result reads <axis_size> elements
+   const size_t min_results_thread = std::max<size_t>(1, get_parallel_min_elements() / axis_size);
+   iterate_array_index(result, op, Parallel(0, min_results_thread));
    return result;
 }
+
+template <bool Max, class T, size_t N, class Config>
+axis_apply_fun_type<T, N, Config, details::adaptor_argmax> constarray_axis_arg(std::true_type, const Array<T, N, Config>& array, size_t axis)
+{
+   return constarray_axis_arg<Max>(array, axis);
+}
+
+template <bool Max, class T, size_t N, class Config>
+axis_apply_fun_type<T, N, Config, details::adaptor_argmax> constarray_axis_arg(std::false_type, const Array<T, N, Config>& array, size_t axis)
+{
+   using adaptor = typename std::conditional<Max, details::adaptor_argmax, details::adaptor_argmin>::type;
+   adaptor f;
+   return details::constarray_axis_apply_function_baseindex(array, axis, f);
+}
 }
 
 /**
@@ -362,8 +436,8 @@ axis_apply_fun_type<T, N, Config, Function> constarray_axis_apply_function_basei
 template <class T, size_t N, class Config>
 axis_apply_fun_type<T, N, Config, details::adaptor_argmin> argmin(const Array<T, N, Config>& array, size_t axis)
 {
-   details::adaptor_argmin f;
-   return details::constarray_axis_apply_function_baseindex(array, axis, f);
+   using is_contiguous = std::integral_constant<bool, IsArrayLayoutContiguous<Array<T, N, Config>>::value>;
+   return details::constarray_axis_arg<false>(is_contiguous(), array, axis);
 }
 
 /**
@@ -372,8 +446,8 @@ axis_apply_fun_type<T, N, Config, details::adaptor_argmin> argmin(const Array<T,
 template <class T, size_t N, class Config>
 axis_apply_fun_type<T, N, Config, details::adaptor_argmax> argmax(const Array<T, N, Config>& array, size_t axis)
 {
-   details::adaptor_argmax f;
-   return details::constarray_axis_apply_function_baseindex(array, axis, f);
+   using is_contiguous = std::integral_constant<bool, IsArrayLayoutContiguous<Array<T, N, Config>>::value>;
+   return details::constarray_axis_arg<true>(is_contiguous(), array, axis);
 }
 
 DECLARE_NAMESPACE_NLL_END
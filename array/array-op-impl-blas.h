@@ -44,7 +44,7 @@ void axpy(T a, const Array<T, N, Config>& x, Array<T, N, Config2>& y)
       auto op = [&](pointer_type y_pointer, ui32 y_stride, const_pointer x_pointer, ui32 x_stride, ui32 nb_elements) {
          blas::axpy<T>(static_cast<blas::BlasInt>(nb_elements), a, x_pointer, x_stride, y_pointer, y_stride);
       };
-      iterate_array_constarray(y, x, op);
+      iterate_array_constarray(y, x, op, Parallel());
    }
 }
 
@@ -68,7 +68,7 @@ void scal(Array<T, N, Config>& y, T a)
       auto op = [&](pointer_type y_pointer, ui32 y_stride, ui32 nb_elements) {
          blas::scal<T>(static_cast<blas::BlasInt>(nb_elements), a, y_pointer, y_stride);
       };
-      iterate_array(y, op);
+      iterate_array(y, op, Parallel());
    }
 }
 
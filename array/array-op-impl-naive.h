@@ -25,7 +25,7 @@ template <class T, size_t N, class Config, class Config2>
 Array_NaiveEnabled<T, N, Config>& array_add(Array<T, N, Config>& a1, const Array<T, N, Config2>& a2)
 {
    auto op = &add_naive<T>;
-   iterate_array_constarray(a1, a2, op);
+   iterate_array_constarray(a1, a2, op, Parallel());
    return a1;
 }
 
@@ -37,7 +37,7 @@ Array<T, N, Config>& array_add_cte(Array<T, N, Config>& a1, T a2)
 {
    using pointer_type = typename Array<T, N, Config>::pointer_type;
    auto op            = [&](pointer_type ptr, ui32 stride, ui32 elements) { add_naive_cte<T>(ptr, stride, elements, a2); };
-   iterate_array(a1, op);
+   iterate_array(a1, op, Parallel());
    return a1;
 }
 
@@ -48,7 +48,7 @@ template <class T, size_t N, class Config, class Config2>
 Array_NaiveEnabled<T, N, Config>& array_sub(Array<T, N, Config>& a1, const Array<T, N, Config2>& a2)
 {
    auto op = &sub_naive<T>;
-   iterate_array_constarray(a1, a2, op);
+   iterate_array_constarray(a1, a2, op, Parallel());
    return a1;
 }
 
@@ -61,7 +61,7 @@ Array_NaiveEnabled<T, N, Config>& array_mul(Array<T, N, Config>& a1, T a2)
    using pointer_type = typename Array<T, N, Config>::pointer_type;
    auto op            = [&](pointer_type ptr, ui32 stride, ui32 elements) { mul_naive(ptr, stride, a2, elements); };
 
-   iterate_array(a1, op);
+   iterate_array(a1, op, Parallel());
    return a1;
 }
 
@@ -75,7 +75,7 @@ Array_NaiveEnabled<T, N, Config>& array_div(Array<T, N, Config>& a1, T a2)
    using pointer_type = typename Array<T, N, Config>::pointer_type;
    auto op            = [&](pointer_type ptr, ui32 stride, ui32 elements) { div_naive(ptr, stride, a2, elements); };
 
-   iterate_array(a1, op);
+   iterate_array(a1, op, Parallel());
    return a1;
 }
 
@@ -87,7 +87,7 @@ Array<T, N, Config>& array_div_elementwise(Array<T, N, Config>& a1, const Array<
 {
    ensure(a1.shape() == a2.shape(), "must have the same shape!");
    auto op = &div_naive_elementwise<T, T2>;
-   iterate_array_constarray(a1, a2, op);
+   iterate_array_constarray(a1, a2, op, Parallel());
    return a1;
 }
 
@@ -99,7 +99,7 @@ Array<T, N, Config>& array_mul_elementwise_inplace(Array<T, N, Config>& a1, cons
 {
    ensure(a1.shape() == a2.shape(), "must have the same shape!");
    auto op = &mul_naive_elementwise<T, T2>;
-   iterate_array_constarray(a1, a2, op);
+   iterate_array_constarray(a1, a2, op, Parallel());
    return a1;
 }
 
@@ -114,6 +114,109 @@ Array<T, N, Config> array_mul_elementwise(const Array<T, N, Config>& a1, const A
    return copy;
 }
 
+/**
+ @brief Computes output = a * b + c, element by element in a single pass. output may be one of the inputs (e.g., c = a * b + c)
+ @see FusedArithmetic for the rounding
+ */
+template <class T, size_t N, class Config, class Config1, class Config2, class Config3>
+Array<T, N, Config>& array_mul_add(Array<T, N, Config>& output, const Array<T, N, Config1>& a, const Array<T, N, Config2>& b,
+                                   const Array<T, N, Config3>& c)
+{
+   ensure(output.shape() == a.shape() && a.shape() == b.shape() && a.shape() == c.shape(), "must have the same shape!");
+   auto op = &fma_naive<T>;
+   iterate_array_constarrays(Parallel(), op, output, a, b, c);
+   return output;
+}
+
+/**
+ @brief Computes output = a * b - c, element by element in a single pass. output may be one of the inputs
+ */
+template <class T, size_t N, class Config, class Config1, class Config2, class Config3>
+Array<T, N, Config>& array_mul_sub(Array<T, N, Config>& output, const Array<T, N, Config1>& a, const Array<T, N, Config2>& b,
+                                   const Array<T, N, Config3>& c)
+{
+   ensure(output.shape() == a.shape() && a.shape() == b.shape() && a.shape() == c.shape(), "must have the same shape!");
+   auto op = &fms_naive<T>;
+   iterate_array_constarrays(Parallel(), op, output, a, b, c);
+   return output;
+}
+
+/**
+ @brief Computes output = alpha * x + beta * y, element by element in a single pass. output may be x or y (e.g., y = alpha * x + beta * y)
+ */
+template <class T, size_t N, class Config, class Config1, class Config2>
+Array<T, N, Config>& array_axpby(Array<T, N, Config>& output, T alpha, const Array<T, N, Config1>& x, T beta, const Array<T, N, Config2>& y)
+{
+   ensure(output.shape() == x.shape() && x.shape() == y.shape(), "must have the same shape!");
+   using pointer_type       = typename Array<T, N, Config>::pointer_type;
+   using const_pointer_type = typename Array<T, N, Config1>::const_pointer_type;
+
+   auto op = [&](pointer_type output_pointer, ui32 output_stride, const_pointer_type x_pointer, ui32 x_stride, const_pointer_type y_pointer,
+                 ui32 y_stride, ui32 nb_elements) {
+      axpby_naive(output_pointer, output_stride, x_pointer, x_stride, alpha, y_pointer, y_stride, beta, nb_elements);
+   };
+   iterate_array_constarrays(Parallel(), op, output, x, y);
+   return output;
+}
+
+/**
+ @brief Computes output = a * value + b, element by element in a single pass. output may be a or b (e.g., a = a * value + b)
+ */
+template <class T, size_t N, class Config, class Config1, class Config2>
+Array<T, N, Config>& array_fma(Array<T, N, Config>& output, const Array<T, N, Config1>& a, T value, const Array<T, N, Config2>& b)
+{
+   // b * 1 is exact: a single rounding
+   return array_axpby(output, value, a, static_cast<T>(1), b);
+}
+
+/**
+ @brief Computes a1 = saturate(a1 + a2), element by element
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& array_add_saturated(Array<T, N, Config>& a1, const Array<T, N, Config2>& a2)
+{
+   ensure(a1.shape() == a2.shape(), "must have the same shape!");
+   auto op = &add_saturated_naive<T>;
+   iterate_array_constarray(a1, a2, op, Parallel());
+   return a1;
+}
+
+/**
+ @brief Computes a1 = saturate(a1 - a2), element by element
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& array_sub_saturated(Array<T, N, Config>& a1, const Array<T, N, Config2>& a2)
+{
+   ensure(a1.shape() == a2.shape(), "must have the same shape!");
+   auto op = &sub_saturated_naive<T>;
+   iterate_array_constarray(a1, a2, op, Parallel());
+   return a1;
+}
+
+/**
+ @brief Computes a1 = |a1 - a2|, element by element
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& array_abs_diff(Array<T, N, Config>& a1, const Array<T, N, Config2>& a2)
+{
+   ensure(a1.shape() == a2.shape(), "must have the same shape!");
+   auto op = &abs_diff_naive<T>;
+   iterate_array_constarray(a1, a2, op, Parallel());
+   return a1;
+}
+
+/**
+ @brief Computes a1 = (a1 * value) >> bits(T), see @ref SaturatedArithmetic::mul_high
+ */
+template <class T, size_t N, class Config>
+Array<T, N, Config>& array_mul_high(Array<T, N, Config>& a1, T value)
+{
+   using pointer_type = typename Array<T, N, Config>::pointer_type;
+   auto op            = [&](pointer_type ptr, ui32 stride, ui32 elements) { mul_high_naive(ptr, stride, value, elements); };
+   iterate_array(a1, op, Parallel());
+   return a1;
+}
+
 /**
  @brief Display matrices
  */
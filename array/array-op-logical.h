@@ -189,101 +189,380 @@ typename Array<T1, N, Config1>::template rebind<ui8>::other operator!(const Arra
    return details::ApplyUnaryOp<ui8>()(a1, op);
 }
 
+namespace details
+{
+template <class T1, class T2>
+bool compare_values(T1 a, T2 b, Comparison comparison)
+{
+   // a NaN is only different: tested explicitly, the comparisons are not reliable with -ffast-math
+   if (is_nan(a) || is_nan(b))
+   {
+      return comparison == Comparison::not_equal;
+   }
+
+   switch (comparison)
+   {
+   case Comparison::less:
+      return a < b;
+   case Comparison::less_equal:
+      return a <= b;
+   case Comparison::greater:
+      return a > b;
+   case Comparison::greater_equal:
+      return a >= b;
+   case Comparison::equal:
+      return a == b;
+   case Comparison::not_equal:
+      return a != b;
+   }
+   return false;
+}
+}
+
 /**
-@brief Return true if any predicate is true
+ @brief Predicate (element comparison value), see @ref predicate_compare
+ */
+template <class T>
+struct PredicateCompare
+{
+   Comparison comparison;
+   T value;
 
-any([1, 2, 3, 4, 5], value > 4) = true
-any([1, 2, 3, 4, 5], value > 14) = false
+   template <class T2>
+   bool operator()(T2 element) const
+   {
+      return details::compare_values(element, value, comparison);
+   }
+};
 
-if indexes_out != nullptr, the full list of indexes satisfying the predicate will be returned (i.e., no early stopping)
+/**
+ @brief Predicate true for NaN elements, see @ref predicate_is_nan
+ */
+struct PredicateIsNan
+{
+   template <class T>
+   bool operator()(T element) const
+   {
+      return details::is_nan(element);
+   }
+};
 
-if index_out != nullptr, one index satisfying the predicate will be returned (i.e., no early stopping)
-*/
+/**
+ @brief Predicate true for the elements neither NaN nor infinite, see @ref predicate_is_finite
+ */
+struct PredicateIsFinite
+{
+   template <class T>
+   bool operator()(T element) const
+   {
+      return details::is_finite(element);
+   }
+};
+
+/**
+ @brief Predicate (|element - value| <= tolerance), see @ref predicate_approx_equal
+ */
+template <class T>
+struct PredicateApproxEqual
+{
+   T value;
+   T tolerance;
+
+   template <class T2>
+   bool operator()(T2 element) const
+   {
+      return !details::is_nan(element) && (element > value ? element - value : value - element) <= tolerance;
+   }
+};
+
+/**
+ @brief The predicates below are recognized by @ref any and @ref all and evaluated with SIMD instructions on the
+        unit-stride memory lines of float and double arrays (if @p value has the type of the array elements)
+
+ any(a, predicate_compare(Comparison::greater, 1.0f)) is equivalent to any(a, [](float v) { return v > 1.0f; })
+ */
+template <class T>
+PredicateCompare<T> predicate_compare(Comparison comparison, T value)
+{
+   return PredicateCompare<T>{comparison, value};
+}
+
+inline PredicateIsNan predicate_is_nan()
+{
+   return PredicateIsNan();
+}
+
+inline PredicateIsFinite predicate_is_finite()
+{
+   return PredicateIsFinite();
+}
+
+template <class T>
+PredicateApproxEqual<T> predicate_approx_equal(T value, T tolerance)
+{
+   return PredicateApproxEqual<T>{value, tolerance};
+}
+
+namespace details
+{
+/**
+ @brief True for the predicates of the library: they have no side effects and are evaluated by the SIMD kernels
+ */
+template <class Predicate>
+struct IsLibraryPredicate : public std::false_type
+{
+};
+
+template <class T>
+struct IsLibraryPredicate<PredicateCompare<T>> : public std::true_type
+{
+};
+
+template <>
+struct IsLibraryPredicate<PredicateIsNan> : public std::true_type
+{
+};
+
+template <>
+struct IsLibraryPredicate<PredicateIsFinite> : public std::true_type
+{
+};
+
+template <class T>
+struct IsLibraryPredicate<PredicateApproxEqual<T>> : public std::true_type
+{
+};
+
+/**
+ @brief The default parallelism of @ref any and @ref all: the predicates of the user may have side effects and are
+        evaluated serially, unless a @ref Parallel is given
+ */
+template <class Predicate>
+Parallel predicate_default_parallel()
+{
+   return IsLibraryPredicate<Predicate>::value ? Parallel() : Parallel(1);
+}
+
+/**
+ @brief Convert the predicate to a test the SIMD kernels can evaluate. Return false if this is not possible
+ */
+template <class T, class Predicate>
+bool as_line_predicate(const Predicate&, simd::LinePredicate<T>&)
+{
+   return false;
+}
+
+template <class T>
+bool as_line_predicate(const PredicateCompare<T>& predicate, simd::LinePredicate<T>& line)
+{
+   line.test       = simd::LinePredicate<T>::Test::compare;
+   line.comparison = predicate.comparison;
+   line.value      = predicate.value;
+   return true;
+}
+
+template <class T>
+bool as_line_predicate(const PredicateIsNan&, simd::LinePredicate<T>& line)
+{
+   line.test = simd::LinePredicate<T>::Test::nan;
+   return true;
+}
+
+template <class T>
+bool as_line_predicate(const PredicateIsFinite&, simd::LinePredicate<T>& line)
+{
+   line.test = simd::LinePredicate<T>::Test::finite;
+   return true;
+}
+
+template <class T>
+bool as_line_predicate(const PredicateApproxEqual<T>& predicate, simd::LinePredicate<T>& line)
+{
+   line.test      = simd::LinePredicate<T>::Test::approx_equal;
+   line.value     = predicate.value;
+   line.tolerance = predicate.tolerance;
+   return true;
+}
+
+/**
+ @brief Return the position of the first element of the line for which (p(element) == expected), @p nb_elements if there is none
+
+ @param line if not nullptr, the predicate evaluated by the SIMD kernels
+ */
+template <class T, class Predicate>
+ui32 find_line(const T* ptr, ui32 stride, ui32 nb_elements, const Predicate& p, bool expected, const simd::LinePredicate<T>* line)
+{
+   size_t position = 0;
+   if (line && stride == 1 && simd::find(ptr, *line, expected, nb_elements, position))
+   {
+      return static_cast<ui32>(position);
+   }
+
+   for (ui32 n = 0; n < nb_elements; ++n)
+   {
+      if (static_cast<bool>(p(ptr[n * stride])) == expected)
+      {
+         return n;
+      }
+   }
+   return nb_elements;
+}
+
+/**
+ @brief Maximum number of elements of a memory access of @ref find_constarray: the threads check if the search is over between accesses
+ */
+static const ui32 find_block_elements = 1 << 14;
+
+/**
+ @brief Search the elements for which (p(element) == expected)
+
+ In parallel, the threads stop as soon as one of them found an element. If @p index_out is not nullptr, the threads only stop once
+ an element was found before their current position so that the first element in memory order is returned, as in serial.
+ If @p indexes_out is not nullptr, all the elements are collected in memory order and the traversal is serial.
+
+ @return true if at least one element was found
+ */
 template <class T, size_t N, class Config, class Predicate>
-bool any(const Array<T, N, Config>& array, Predicate p, StaticVector<ui32, N>* index_out = nullptr, std::vector<StaticVector<ui32, N>>* indexes_out = nullptr)
+bool find_constarray(const Array<T, N, Config>& array, const Predicate& p, bool expected, StaticVector<ui32, N>* index_out,
+                     std::vector<StaticVector<ui32, N>>* indexes_out, const Parallel& parallel)
 {
    using array_type         = Array<T, N, Config>;
+   using value_type         = typename std::remove_cv<T>::type;
+   using pointer_type       = typename array_type::pointer_type;
    using const_pointer_type = typename array_type::const_pointer_type;
-   StaticVector<ui32, N> index;
 
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor(array, 0);
-   bool hasMoreElements = true;
-   ui32 current_varying_index;
+   if (array.size() == 0)
+   {
+      return false;
+   }
 
-   bool result  = false;
-   auto functor = [&](T value) {
-      if (p(value))
-      {
-         result = true;
-         if (index_out)
-         {
-            index = processor.getArrayIndex();
-            index[processor.getVaryingIndex()] += current_varying_index;
-            *index_out = index;
-            index_out  = nullptr;
-         }
+   simd::LinePredicate<value_type> line_predicate;
+   const simd::LinePredicate<value_type>* line = as_line_predicate(p, line_predicate) ? &line_predicate : nullptr;
+
+   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_all(array, 0);
+   const bool need_index = index_out || indexes_out;
+   if (!need_index)
+   {
+      // the index of an element can't be derived from its position in a coalesced line
+      processor_all.coalesceDimensions(processor_all.getNbContiguousDimensions());
+   }
+   processor_all.setNbElementsPerAccess(std::min(processor_all.getNbElementsPerAccess(), find_block_elements));
+   const ui32 nb_accesses   = processor_all.getNbAccesses();
+   const ui32 varying_index = processor_all.getVaryingIndex();
+
+   // (access << 32 | position) of the first element found. The threads stop after this access
+   static const std::uint64_t not_found = std::numeric_limits<std::uint64_t>::max();
+   std::atomic<std::uint64_t> found(not_found);
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      auto processor = processor_all;
+      processor.restrictAccesses(access_begin, access_end);
 
-         if (indexes_out)
+      bool hasMoreElements = true;
+      for (ui32 access = access_begin; hasMoreElements; ++access)
+      {
+         const std::uint64_t current = found.load(std::memory_order_relaxed);
+         if (current != not_found && (!index_out || (current >> 32) < access))
          {
-            index = processor.getArrayIndex();
-            index[processor.getVaryingIndex()] += current_varying_index;
-            indexes_out->push_back(index);
+            return;
          }
 
-         if (!indexes_out)
+         const_pointer_type ptr(nullptr);
+         hasMoreElements        = processor.accessMaxElements(ptr);
+         const ui32 stride      = processor.stride();
+         const ui32 nb_elements = processor.getNbElementsPerAccess();
+         for (ui32 position = find_line(ptr, stride, nb_elements, p, expected, line); position < nb_elements;)
          {
-            processor.stop(); // early stop, we know the result is true
+            if (indexes_out)
+            {
+               auto index = processor.getArrayIndex();
+               index[varying_index] += position;
+               indexes_out->push_back(index);
+
+               const ui32 next = position + 1;
+               position        = next + find_line(ptr + next * stride, stride, nb_elements - next, p, expected, line);
+               continue;
+            }
+
+            const std::uint64_t result = static_cast<std::uint64_t>(access) << 32 | position;
+            std::uint64_t current      = found.load();
+            while (result < current && !found.compare_exchange_weak(current, result))
+            {
+            }
+            return;
          }
       }
    };
 
-   while (hasMoreElements)
-   {
-      const_pointer_type ptr(nullptr);
-      hasMoreElements = processor.accessMaxElements(ptr);
+   const ui32 nb_threads = indexes_out ? 1 : getNbThreads<pointer_type>(parallel, array.size(), nb_accesses);
+   parallel_accesses(nb_threads, nb_accesses, process);
 
-      const auto y_stride = processor.stride();
-      const T* y_end      = ptr + y_stride * processor.getNbElementsPerAccess();
-      for (current_varying_index = 0; ptr != y_end; ptr += y_stride, ++current_varying_index)
+   if (indexes_out)
+   {
+      if (index_out && !indexes_out->empty())
       {
-         functor(*ptr);
+         *index_out = indexes_out->front();
       }
+      return !indexes_out->empty();
+   }
+
+   const std::uint64_t result = found.load();
+   if (result == not_found)
+   {
+      return false;
+   }
+
+   if (index_out)
+   {
+      const ui32 access = static_cast<ui32>(result >> 32);
+      auto processor    = processor_all;
+      processor.restrictAccesses(access, access + 1);
+      const_pointer_type ptr(nullptr);
+      processor.accessMaxElements(ptr);
+      *index_out = processor.getArrayIndex();
+      (*index_out)[varying_index] += static_cast<ui32>(result & 0xffffffff);
    }
-   return result;
+   return true;
+}
 }
 
 /**
-@brief Return true if all predicate is true for all values
+@brief Return true if any predicate is true
 
-all([1, 2, 3, 4, 5], value > 0) = true
-all([1, 2, 3, 4, 5], value > 4) = false
+any([1, 2, 3, 4, 5], value > 4) = true
+any([1, 2, 3, 4, 5], value > 14) = false
+
+if indexes_out != nullptr, the full list of indexes satisfying the predicate will be returned (i.e., no early stopping)
+
+if index_out != nullptr, the index of the first element (in memory order) satisfying the predicate will be returned
+
+The search stops as soon as the result is known, so the predicate may not be called on all the elements. The predicates created
+by @ref predicate_compare, @ref predicate_is_nan, @ref predicate_is_finite and @ref predicate_approx_equal are vectorized for float
+and double arrays, and large arrays are searched in parallel with them (see @ref Parallel). The other predicates are called
+from the calling thread, unless a @ref Parallel is given: they are then called concurrently and must not have side effects.
 */
 template <class T, size_t N, class Config, class Predicate>
-bool all(const Array<T, N, Config>& array, Predicate p)
+bool any(const Array<T, N, Config>& array, Predicate p, StaticVector<ui32, N>* index_out = nullptr, std::vector<StaticVector<ui32, N>>* indexes_out = nullptr,
+         const Parallel& parallel = details::predicate_default_parallel<Predicate>())
 {
-   using array_type         = Array<T, N, Config>;
-   using const_pointer_type = typename array_type::const_pointer_type;
-
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor(array, 0);
-   bool hasMoreElements = true;
+   return details::find_constarray(array, p, true, index_out, indexes_out, parallel);
+}
 
-   bool result  = true;
-   auto functor = [&](T value) {
-      if (!p(value))
-      {
-         result = false;
-         processor.stop(); // early stop, we know the result is true
-      }
-   };
+/**
+@brief Return true if all predicate is true for all values
 
-   while (hasMoreElements)
-   {
-      const_pointer_type ptr(nullptr);
-      hasMoreElements = processor.accessMaxElements(ptr);
+all([1, 2, 3, 4, 5], value > 0) = true
+all([1, 2, 3, 4, 5], value > 4) = false
 
-      details::apply_naive1_const(ptr, processor.stride(), processor.getNbElementsPerAccess(), functor);
-   }
-   return result;
+Like @ref any, the search stops at the first element not satisfying the predicate and is only parallel by default for the
+predicates of the library
+*/
+template <class T, size_t N, class Config, class Predicate>
+bool all(const Array<T, N, Config>& array, Predicate p, const Parallel& parallel = details::predicate_default_parallel<Predicate>())
+{
+   StaticVector<ui32, N>* no_index                = nullptr;
+   std::vector<StaticVector<ui32, N>>* no_indexes = nullptr;
+   return !details::find_constarray(array, p, false, no_index, no_indexes, parallel);
 }
 
 DECLARE_NAMESPACE_NLL_END
@@ -66,6 +66,48 @@ Array<T, N, Config> constarray_apply_function_strided_array(const Array<T, N, Co
    return array_cpy;
 }
 
+/**
+@brief transform each element of a temporary array by a given function @p f. The result is stored in the memory of the array
+       if it is not a reference
+
+@tparam Function must be callable (pointer_type a1_pointer, ui32 a1_stride, const_pointer_type a2_pointer, ui32 a2_stride, ui32 nb_elements)
+       with a1_pointer == a2_pointer
+*/
+template <class T, size_t N, class Config, class Function>
+Array<T, N, Config> constarray_apply_function_strided_array(Array<T, N, Config>&& array, Function& f)
+{
+   using array_type   = Array<T, N, Config>;
+   using pointer_type = typename array_type::pointer_type;
+
+   if (!details::array_is_reusable(array))
+   {
+      return constarray_apply_function_strided_array(static_cast<const array_type&>(array), f);
+   }
+
+   auto op = [&](pointer_type a1_pointer, ui32 a1_stride, ui32 nb_elements) { f(a1_pointer, a1_stride, a1_pointer, a1_stride, nb_elements); };
+   iterate_array(array, op);
+   return std::move(array);
+}
+
+/**
+@brief transform each element of an array by a given function @p f and store the result in @p output, without allocation
+
+@p output must have the same shape as @p array. It may be @p array itself (in place) but must not partially overlap it
+
+@tparam Function must be callable (pointer_type a1_pointer, ui32 a1_stride, const_pointer_type a2_pointer, ui32 a2_stride, ui32 nb_elements)
+*/
+template <class T2, size_t N, class Config2, class T, class Config, class Function>
+Array<T2, N, Config2>& array_apply_function_strided_array(Array<T2, N, Config2>& output, const Array<T, N, Config>& array, Function& f)
+{
+   using pointer_type       = typename Array<T2, N, Config2>::pointer_type;
+   using const_pointer_type = typename Array<T, N, Config>::const_pointer_type;
+
+   static_assert(is_callable_with<Function, pointer_type, ui32, const_pointer_type, ui32, ui32>::value, "Op is not callable!");
+   ensure(output.shape() == array.shape(), "must have the same shape!");
+   iterate_array_constarray(output, array, f);
+   return output;
+}
+
 /**
 @brief return a copy of the array where each element is transformed by a given function @p f
 
@@ -109,10 +151,17 @@ namespace details
 // Here we want to expose the function as a strided array. This is to enable more custom implementations
 // using overloads (e.g., CUDA gpu)
 //
+// Unit-stride float & double arrays use the vectorized functions of op-naive-simd.h
+//
 
 template <class T>
 void cos(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements)
 {
+   if (output_stride == 1 && input_stride == 1 && simd::cos(output, input, nb_elements))
+   {
+      return;
+   }
+
    auto op = [](T value) { return std::cos(value); };
    apply_fun_array_strided(output, output_stride, input, input_stride, nb_elements, op);
 }
@@ -120,6 +169,11 @@ void cos(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32
 template <class T>
 void sin(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements)
 {
+   if (output_stride == 1 && input_stride == 1 && simd::sin(output, input, nb_elements))
+   {
+      return;
+   }
+
    auto op = [](T value) { return std::sin(value); };
    apply_fun_array_strided(output, output_stride, input, input_stride, nb_elements, op);
 }
@@ -127,6 +181,11 @@ void sin(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32
 template <class T>
 void sqrt(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements)
 {
+   if (output_stride == 1 && input_stride == 1 && simd::sqrt(output, input, nb_elements))
+   {
+      return;
+   }
+
    auto op = [](T value) { return std::sqrt(value); };
    apply_fun_array_strided(output, output_stride, input, input_stride, nb_elements, op);
 }
@@ -148,6 +207,11 @@ void norm2_elementwise(T2* output, ui32 output_stride, const T1* input, ui32 inp
 template <class T>
 void abs(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements)
 {
+   if (output_stride == 1 && input_stride == 1 && simd::abs(output, input, nb_elements))
+   {
+      return;
+   }
+
    auto op = [](T value) { return std::abs(value); };
    apply_fun_array_strided(output, output_stride, input, input_stride, nb_elements, op);
 }
@@ -155,6 +219,11 @@ void abs(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32
 template <class T>
 void exp(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements)
 {
+   if (output_stride == 1 && input_stride == 1 && simd::exp(output, input, nb_elements))
+   {
+      return;
+   }
+
    auto op = [](T value) { return std::exp(value); };
    apply_fun_array_strided(output, output_stride, input, input_stride, nb_elements, op);
 }
@@ -162,6 +231,11 @@ void exp(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32
 template <class T>
 void log(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements)
 {
+   if (output_stride == 1 && input_stride == 1 && simd::log(output, input, nb_elements))
+   {
+      return;
+   }
+
    auto op = [](T value) { return std::log(value); };
    apply_fun_array_strided(output, output_stride, input, input_stride, nb_elements, op);
 }
@@ -169,12 +243,7 @@ void log(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32
 template <class T1, class T2>
 void round(T2* output, ui32 output_stride, const T1* input, ui32 input_stride, ui32 nb_elements)
 {
-   auto op = [](T1 value)->T2
-   {
-      // TODO CHECK performance with custom round
-      return static_cast<T2>(std::round(value));
-   };
-   apply_fun_array_strided(output, output_stride, input, input_stride, nb_elements, op);
+   convert_naive(output, output_stride, input, input_stride, nb_elements, Conversion::round);
 }
 
 /**
@@ -183,6 +252,14 @@ void round(T2* output, ui32 output_stride, const T1* input, ui32 input_stride, u
 template <class T2, class T1>
 void saturate(T2* output, ui32 output_stride, const T1* input, ui32 input_stride, ui32 nb_elements, T1 min_value, T1 max_value)
 {
+   // the saturation to the range of T2 is vectorized
+   using limits = std::numeric_limits<T2>;
+   if (static_cast<double>(min_value) == static_cast<double>(limits::lowest()) && static_cast<double>(max_value) == static_cast<double>(limits::max()))
+   {
+      convert_naive(output, output_stride, input, input_stride, nb_elements, Conversion::saturate);
+      return;
+   }
+
    auto op = [&](T1 value)->T2
    {
       return NAMESPACE_NLL::saturate_value<T2, T1>(value, min_value, max_value);
@@ -203,6 +280,35 @@ Array<T, N, Config> cos(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+/**
+@brief std::cos applied to each element of a temporary array, reusing its memory
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config> cos(Array<T, N, Config>&& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::cos<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
+/**
+@brief output = cos(array) computed element by element without allocation. @p output may be @p array
+*/
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& cos(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::cos<T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
+/**
+@brief std::cos applied in place to each element of the array
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config>& cos_inplace(Array<T, N, Config>& array)
+{
+   return cos(array, array);
+}
+
 /**
 @brief return a copy of array with std::sin applied to each element
 */
@@ -213,6 +319,35 @@ Array<T, N, Config> sin(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+/**
+@brief std::sin applied to each element of a temporary array, reusing its memory
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config> sin(Array<T, N, Config>&& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::sin<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
+/**
+@brief output = sin(array) computed element by element without allocation. @p output may be @p array
+*/
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& sin(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::sin<T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
+/**
+@brief std::sin applied in place to each element of the array
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config>& sin_inplace(Array<T, N, Config>& array)
+{
+   return sin(array, array);
+}
+
 /**
 @brief return a copy of array with std::sqrt applied to each element
 */
@@ -223,6 +358,35 @@ Array<T, N, Config> sqrt(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+/**
+@brief std::sqrt applied to each element of a temporary array, reusing its memory
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config> sqrt(Array<T, N, Config>&& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::sqrt<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
+/**
+@brief output = sqrt(array) computed element by element without allocation. @p output may be @p array
+*/
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& sqrt(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::sqrt<T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
+/**
+@brief std::sqrt applied in place to each element of the array
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config>& sqrt_inplace(Array<T, N, Config>& array)
+{
+   return sqrt(array, array);
+}
+
 /**
 @brief return a copy of array with for each element e is returned e * e
 */
@@ -233,6 +397,35 @@ Array<T, N, Config> sqr(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+/**
+@brief e * e computed for each element of a temporary array, reusing its memory
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config> sqr(Array<T, N, Config>&& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::sqr<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
+/**
+@brief output = sqr(array) computed element by element without allocation. @p output may be @p array
+*/
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& sqr(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::sqr<T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
+/**
+@brief e * e applied in place to each element of the array
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config>& sqr_inplace(Array<T, N, Config>& array)
+{
+   return sqr(array, array);
+}
+
 /**
 @brief return a copy of array with std::abs applied to each element
 */
@@ -243,6 +436,35 @@ Array<T, N, Config> abs(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+/**
+@brief std::abs applied to each element of a temporary array, reusing its memory
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config> abs(Array<T, N, Config>&& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::abs<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
+/**
+@brief output = abs(array) computed element by element without allocation. @p output may be @p array
+*/
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& abs(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::abs<T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
+/**
+@brief std::abs applied in place to each element of the array
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config>& abs_inplace(Array<T, N, Config>& array)
+{
+   return abs(array, array);
+}
+
 /**
 @brief return a copy of array with std::log applied to each element
 */
@@ -253,6 +475,35 @@ Array<T, N, Config> log(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+/**
+@brief std::log applied to each element of a temporary array, reusing its memory
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config> log(Array<T, N, Config>&& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::log<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
+/**
+@brief output = log(array) computed element by element without allocation. @p output may be @p array
+*/
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& log(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::log<T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
+/**
+@brief std::log applied in place to each element of the array
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config>& log_inplace(Array<T, N, Config>& array)
+{
+   return log(array, array);
+}
+
 /**
 @brief return a copy of array with std::exp applied to each element
 */
@@ -263,6 +514,35 @@ Array<T, N, Config> exp(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+/**
+@brief std::exp applied to each element of a temporary array, reusing its memory
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config> exp(Array<T, N, Config>&& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::exp<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
+/**
+@brief output = exp(array) computed element by element without allocation. @p output may be @p array
+*/
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config>& exp(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   void (*ptr)(T*, ui32, const T*, ui32, ui32) = &details::exp<T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
+/**
+@brief std::exp applied in place to each element of the array
+*/
+template <class T, size_t N, class Config>
+Array<T, N, Config>& exp_inplace(Array<T, N, Config>& array)
+{
+   return exp(array, array);
+}
+
 /**
 @brief Round to the nearest integer each array element
 */
@@ -273,6 +553,16 @@ Array<T2, N, typename Config::template rebind<T2>::other> round(const Array<T, N
    return constarray_apply_function_strided_array_type_matched<T2>(array, ptr);
 }
 
+/**
+@brief output = round(array) without allocation. The type of the result is the type of @p output
+*/
+template <class T2, size_t N, class Config2, class T, class Config>
+Array<T2, N, Config2>& round(Array<T2, N, Config2>& output, const Array<T, N, Config>& array)
+{
+   void (*ptr)(T2*, ui32, const T*, ui32, ui32) = &details::round<T, T2>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
 /**
 @brief Round to the nearest integer each array element
 */
@@ -287,6 +577,42 @@ Array<T2, N, typename Config::template rebind<T2>::other> saturate(const Array<T
    return constarray_apply_function_strided_array_type_matched<T2>(array, apply_saturate);
 }
 
+/**
+@brief output = saturate(array, min_value, max_value) without allocation. The type of the result is the type of @p output
+*/
+template <class T2, size_t N, class Config2, class T, class Config>
+Array<T2, N, Config2>& saturate(Array<T2, N, Config2>& output, const Array<T, N, Config>& array, T min_value, T max_value)
+{
+   auto apply_saturate = [&](T2* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements) {
+      details::saturate<T2, T>(output, output_stride, input, input_stride, nb_elements, min_value, max_value);
+   };
+
+   return array_apply_function_strided_array(output, array, apply_saturate);
+}
+
+/**
+ @brief Convert an array to another type with a specific conversion when copied, see @ref details::convert_value
+
+ Array<ui8, 3> a = converted(b, Conversion::round_saturate);
+ */
+template <class T, size_t N, class Config>
+ArrayConversion<Array<T, N, Config>> converted(const Array<T, N, Config>& array, Conversion conversion)
+{
+   return {array, conversion};
+}
+
+/**
+ @brief Saturate an array when copied to another type: the values are clamped to the range of the destination type (NaN is
+        converted to 0 for the integers)
+
+ Array<ui8, 3> a = saturated(b);
+ */
+template <class T, size_t N, class Config>
+ArrayConversion<Array<T, N, Config>> saturated(const Array<T, N, Config>& array)
+{
+   return {array, Conversion::saturate};
+}
+
 /**
  @brief Cast an array to another type using static_cast on each of the elements
  */
@@ -297,66 +623,297 @@ Array<T2, N, typename Config::template rebind<T2>::other> cast(const Array<T, N,
 }
 
 /**
-@brief return the min value contained in the array
+ @brief output = static_cast<T2>(array) element by element without allocation
+ */
+template <class T2, size_t N, class Config2, class T, class Config>
+Array<T2, N, Config2>& cast(Array<T2, N, Config2>& output, const Array<T, N, Config>& array)
+{
+   ensure(output.shape() == array.shape(), "must have the same shape!");
+   output.copy(array, Conversion::cast);
+   return output;
+}
+
+/**
+ @brief return a * b + c computed element by element in a single pass, without temporary array
+
+ The floating point types are rounded once (see @ref details::FusedArithmetic) so the result may differ from the
+ operators (a * b + c) in the last bit
+ */
+template <class T, size_t N, class Config, class Config2, class Config3>
+Array<T, N, Config> mul_add(const Array<T, N, Config>& a, const Array<T, N, Config2>& b, const Array<T, N, Config3>& c)
+{
+   Array<T, N, Config> output(a.shape());
+   details::array_mul_add(output, a, b, c);
+   return output;
+}
+
+/**
+ @brief output = a * b + c in a single pass. output may be one of the inputs, e.g., c = a * b + c is mul_add(c, a, b, c)
+ */
+template <class T, size_t N, class Config, class Config1, class Config2, class Config3>
+Array<T, N, Config>& mul_add(Array<T, N, Config>& output, const Array<T, N, Config1>& a, const Array<T, N, Config2>& b,
+                             const Array<T, N, Config3>& c)
+{
+   return details::array_mul_add(output, a, b, c);
+}
+
+/**
+ @brief return a * b - c computed element by element in a single pass, without temporary array
+ */
+template <class T, size_t N, class Config, class Config2, class Config3>
+Array<T, N, Config> mul_sub(const Array<T, N, Config>& a, const Array<T, N, Config2>& b, const Array<T, N, Config3>& c)
+{
+   Array<T, N, Config> output(a.shape());
+   details::array_mul_sub(output, a, b, c);
+   return output;
+}
+
+/**
+ @brief output = a * b - c in a single pass. output may be one of the inputs
+ */
+template <class T, size_t N, class Config, class Config1, class Config2, class Config3>
+Array<T, N, Config>& mul_sub(Array<T, N, Config>& output, const Array<T, N, Config1>& a, const Array<T, N, Config2>& b,
+                             const Array<T, N, Config3>& c)
+{
+   return details::array_mul_sub(output, a, b, c);
+}
+
+/**
+ @brief return a * value + b computed element by element in a single pass, without temporary array
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config> fma(const Array<T, N, Config>& a, T value, const Array<T, N, Config2>& b)
+{
+   Array<T, N, Config> output(a.shape());
+   details::array_fma(output, a, value, b);
+   return output;
+}
+
+/**
+ @brief output = a * value + b in a single pass. output may be a or b, e.g., a = a * value + b is fma(a, a, value, b)
+ */
+template <class T, size_t N, class Config, class Config1, class Config2>
+Array<T, N, Config>& fma(Array<T, N, Config>& output, const Array<T, N, Config1>& a, T value, const Array<T, N, Config2>& b)
+{
+   return details::array_fma(output, a, value, b);
+}
+
+/**
+ @brief y = alpha * x + beta * y in a single pass, without temporary array
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config2>& axpby(T alpha, const Array<T, N, Config>& x, T beta, Array<T, N, Config2>& y)
+{
+   return details::array_axpby(y, alpha, x, beta, y);
+}
+
+//
+// Destination-passing forms of the operators: the result is stored in a preallocated array (or a sub-array) of the same shape, so
+// that a loop can run without allocation. output may be one of the operands (in place) but must not partially overlap them
+//
+
+namespace details
+{
+/**
+ @brief output = array, unless output is already the array
+ */
+template <class T, size_t N, class Config, class Config2>
+void array_copy_operand(Array<T, N, Config>& output, const Array<T, N, Config2>& array)
+{
+   ensure(output.shape() == array.shape(), "must have the same shape!");
+   if (output.isEmpty() || &output(typename Array<T, N, Config>::index_type()) != &array(typename Array<T, N, Config2>::index_type()))
+   {
+      output.copy(array, Conversion::cast);
+   }
+}
+}
+
+/**
+ @brief output = a + b in a single pass
+ */
+template <class T, size_t N, class Config, class Config1, class Config2>
+Array<T, N, Config>& add(Array<T, N, Config>& output, const Array<T, N, Config1>& a, const Array<T, N, Config2>& b)
+{
+   // x * 1 is exact: identical to a + b
+   return details::array_axpby(output, static_cast<T>(1), a, static_cast<T>(1), b);
+}
+
+/**
+ @brief output = a - b in a single pass
+ */
+template <class T, size_t N, class Config, class Config1, class Config2>
+Array<T, N, Config>& sub(Array<T, N, Config>& output, const Array<T, N, Config1>& a, const Array<T, N, Config2>& b)
+{
+   return details::array_axpby(output, static_cast<T>(1), a, static_cast<T>(-1), b);
+}
+
+/**
+ @brief output = a + value
+ */
+template <class T, class T2, size_t N, class Config, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config>& add(Array<T, N, Config>& output, const Array<T, N, Config1>& a, T2 value)
+{
+   details::array_copy_operand(output, a);
+   return details::array_add_cte(output, static_cast<T>(value));
+}
+
+/**
+ @brief output = a - value
+ */
+template <class T, class T2, size_t N, class Config, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config>& sub(Array<T, N, Config>& output, const Array<T, N, Config1>& a, T2 value)
+{
+   details::array_copy_operand(output, a);
+   return details::array_add_cte(output, static_cast<T>(-static_cast<T>(value)));
+}
+
+/**
+ @brief output = a * value
+ */
+template <class T, class T2, size_t N, class Config, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config>& mul(Array<T, N, Config>& output, const Array<T, N, Config1>& a, T2 value)
+{
+   details::array_copy_operand(output, a);
+   details::array_mul(output, static_cast<T>(value));
+   return output;
+}
+
+/**
+ @brief output = a / value
+ */
+template <class T, class T2, size_t N, class Config, class Config1, typename = typename std::enable_if<std::is_convertible<T2, T>::value>::type>
+Array<T, N, Config>& div(Array<T, N, Config>& output, const Array<T, N, Config1>& a, T2 value)
+{
+   details::array_copy_operand(output, a);
+   details::array_div(output, static_cast<T>(value));
+   return output;
+}
+
+/**
+ @brief output = a / b, element by element. output may be a but not b
+ */
+template <class T, class T2, size_t N, class Config, class Config1, class Config2>
+Array<T, N, Config>& div(Array<T, N, Config>& output, const Array<T, N, Config1>& a, const Array<T2, N, Config2>& b)
+{
+   ensure(output.shape() == b.shape(), "must have the same shape!");
+   ensure(b.isEmpty() || static_cast<const void*>(&output(typename Array<T, N, Config>::index_type())) !=
+                            static_cast<const void*>(&b(typename Array<T2, N, Config2>::index_type())),
+          "output must not be the divisor!");
+   details::array_copy_operand(output, a);
+   return details::array_div_elementwise(output, b);
+}
+
+/**
+ @brief return saturate(a + b) computed element by element: the integer results are clamped to the range of T
+
+ The 8 and 16-bit integers are vectorized, e.g., the sum of two ui8 images saturates at 255 instead of wrapping around
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config> add_saturated(const Array<T, N, Config>& a, const Array<T, N, Config2>& b)
+{
+   auto copy = a;
+   details::array_add_saturated(copy, b);
+   return copy;
+}
+
+/**
+ @brief return saturate(a - b) computed element by element, e.g., 10 - 20 is 0 for ui8
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config> sub_saturated(const Array<T, N, Config>& a, const Array<T, N, Config2>& b)
+{
+   auto copy = a;
+   details::array_sub_saturated(copy, b);
+   return copy;
+}
+
+/**
+ @brief return |a - b| computed element by element, without the wrap around of the unsigned types
+ */
+template <class T, size_t N, class Config, class Config2>
+Array<T, N, Config> abs_diff(const Array<T, N, Config>& a, const Array<T, N, Config2>& b)
+{
+   auto copy = a;
+   details::array_abs_diff(copy, b);
+   return copy;
+}
+
+/**
+ @brief return (a * value) >> bits(T), the high half of the integer products
+
+ Scales integers by the fixed point fraction value / 2^bits(T) without overflow, e.g., mul_high(a, ui8(0.75 * 256)) is floor(a * 0.75)
+ for a ui8 array
+ */
+template <class T, size_t N, class Config>
+Array<T, N, Config> mul_high(const Array<T, N, Config>& a, T value)
+{
+   auto copy = a;
+   details::array_mul_high(copy, value);
+   return copy;
+}
+
+/**
+@brief return the min value contained in the array. NaN are ignored
+
+ The reductions are vectorized and multithreaded, see @ref details::reduce_constarray
 */
 template <class T, size_t N, class Config>
 T min(const Array<T, N, Config>& array)
 {
-   T min_value = std::numeric_limits<T>::max();
-   auto f = [&](T value) { min_value = std::min(min_value, value); };
-   constarray_apply_function_inplace(array, f);
-   return min_value;
+   return details::reduce_constarray(array, details::ReducerMin<T>(), Parallel());
 }
 
 /**
-@brief return the max value contained in the array
+@brief return the max value contained in the array. NaN are ignored
 */
 template <class T, size_t N, class Config>
 T max(const Array<T, N, Config>& array)
 {
-   T max_value = std::numeric_limits<T>::lowest();
-   auto f = [&](T value) { max_value = std::max(max_value, value); };
-   constarray_apply_function_inplace(array, f);
-   return max_value;
+   return details::reduce_constarray(array, details::ReducerMax<T>(), Parallel());
 }
 
 /**
-@brief return the min and max value contained in the array
+@brief return the min and max value contained in the array. NaN are ignored
 */
 template <class T, size_t N, class Config>
 std::pair<T, T> minmax(const Array<T, N, Config>& array)
 {
-   T max_value = std::numeric_limits<T>::lowest();
-   T min_value = std::numeric_limits<T>::max();
+   return details::reduce_constarray(array, details::ReducerMinMax<T>(), Parallel());
+}
 
-   auto f = [&](T value) {
-      max_value = std::max(max_value, value);
-      min_value = std::min(min_value, value);
-   };
-   constarray_apply_function_inplace(array, f);
+/**
+@brief return the sum of all the elements contained in the array
 
-   return std::make_pair(min_value, max_value);
+ The result doesn't depend on the number of threads in reproducible mode (see @ref set_parallel_reproducible). The 8 and 16-bit
+ integers are accumulated in 64 bits by default (see @ref PromoteSum)
+*/
+template <class T, size_t N, class Config, class Accum = typename PromoteSum<T>::type>
+Accum sum(const Array<T, N, Config>& array, Summation summation)
+{
+   if (summation == Summation::kahan)
+   {
+      const auto result = details::reduce_constarray(array, details::ReducerSumKahan<T, Accum>(), Parallel());
+      return result.first + result.second;
+   }
+   return details::reduce_constarray(array, details::ReducerSum<T, Accum>(), Parallel());
 }
 
 /**
-@brief return the mean value of all the elements contained in the array
+@brief return the sum of all the elements contained in the array
 */
-template <class T, size_t N, class Config, class Accum = T>
+template <class T, size_t N, class Config, class Accum = typename PromoteSum<T>::type>
 Accum sum(const Array<T, N, Config>& array)
 {
-   Accum accum = 0;
-   auto f      = [&](T value) { accum += value; };
-   constarray_apply_function_inplace(array, f);
-   return accum;
+   return sum<T, N, Config, Accum>(array, Summation::pairwise);
 }
 
 /**
 @brief return the mean value of all the elements contained in the array
 */
-template <class T, size_t N, class Config, class Accum = T>
-Accum mean(const Array<T, N, Config>& array)
+template <class T, size_t N, class Config, class Accum = typename PromoteSum<T>::type>
+Accum mean(const Array<T, N, Config>& array, Summation summation = Summation::pairwise)
 {
-   return sum(array) / static_cast<T>(array.size());
+   return sum<T, N, Config, Accum>(array, summation) / static_cast<Accum>(array.size());
 }
 
 /**
@@ -365,13 +922,8 @@ Accum mean(const Array<T, N, Config>& array)
 template <class T, size_t N, class Config>
 typename PromoteFloating<T>::type norm2sqr(const Array<T, N, Config>& a1)
 {
-   using const_pointer_type = typename Array<T, N, Config>::const_pointer_type;
    using return_type = typename PromoteFloating<T>::type;
-   return_type accum = 0;
-   auto op = [&](const_pointer_type ptr, ui32 stride, ui32 elements) { accum += details::norm2_naive_sqr<T, return_type>(ptr, stride, elements); };
-
-   iterate_constarray(a1, op);
-   return accum;
+   return details::reduce_constarray(a1, details::ReducerNorm2sqr<T, return_type>(), Parallel());
 }
 
 /**
@@ -400,6 +952,16 @@ norm2_elementwise(const Array<T, N, Config>& array)
    return constarray_apply_function_strided_array_type_matched<output_type>(array, ptr);
 }
 
+/**
+@brief output = norm2_elementwise(array) without allocation
+*/
+template <class T2, size_t N, class Config2, class T, class Config>
+Array<T2, N, Config2>& norm2_elementwise(Array<T2, N, Config2>& output, const Array<T, N, Config>& array)
+{
+   void (*ptr)(T2*, ui32, const T*, ui32, ui32) = &details::norm2_elementwise<T2, T>;
+   return array_apply_function_strided_array(output, array, ptr);
+}
+
 
 /**
  @brief Stack arrays of a same shape into a higher dimensional array
@@ -445,62 +1007,35 @@ Array<T, N + 1, typename Config::template rebind_dim<N + 1>::other> stack(const
 
 /**
 @brief Return the index of the max element of the array
+
+The first max in memory order is returned and NaN are ignored. The array is reduced as in @ref max and only the position of the
+winning element is converted to an index.
 */
 template <class T, size_t N, class Config>
 typename Array<T, N, Config>::index_type argmax(const Array<T, N, Config>& array)
 {
-   using array_type         = Array<T, N, Config>;
-   using const_pointer_type = typename array_type::const_pointer_type;
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1(array, 0);
-
-   T max_value = std::numeric_limits<T>::lowest();
-   typename array_type::index_type max_value_index;
-
-   bool hasMoreElements = true;
-   while (hasMoreElements)
+   if (array.size() == 0)
    {
-      const_pointer_type ptr_a1(nullptr);
-      hasMoreElements     = processor_a1.accessMaxElements(ptr_a1);
-      auto pair_index_max = details::argmax(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess());
-      if (pair_index_max.second > max_value)
-      {
-         max_value       = pair_index_max.second;
-         max_value_index = processor_a1.getArrayIndex();
-         max_value_index[processor_a1.getVaryingIndex()] += pair_index_max.first;
-      }
+      return typename Array<T, N, Config>::index_type();
    }
-
-   return max_value_index;
+   const auto best = details::reduce_constarray(array, details::ReducerArg<T, true>(), Parallel());
+   return details::reduction_index(array, best.second);
 }
 
 /**
 @brief Return the index of the min element of the array
+
+The first min in memory order is returned and NaN are ignored, see @ref argmax
 */
 template <class T, size_t N, class Config>
 typename Array<T, N, Config>::index_type argmin(const Array<T, N, Config>& array)
 {
-   using array_type         = Array<T, N, Config>;
-   using const_pointer_type = typename array_type::const_pointer_type;
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1(array, 0);
-
-   T min_value = std::numeric_limits<T>::max();
-   typename array_type::index_type min_value_index;
-
-   bool hasMoreElements = true;
-   while (hasMoreElements)
+   if (array.size() == 0)
    {
-      const_pointer_type ptr_a1(nullptr);
-      hasMoreElements     = processor_a1.accessMaxElements(ptr_a1);
-      auto pair_index_min = details::argmin(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess());
-      if (pair_index_min.second < min_value)
-      {
-         min_value       = pair_index_min.second;
-         min_value_index = processor_a1.getArrayIndex();
-         min_value_index[processor_a1.getVaryingIndex()] += pair_index_min.first;
-      }
+      return typename Array<T, N, Config>::index_type();
    }
-
-   return min_value_index;
+   const auto best = details::reduce_constarray(array, details::ReducerArg<T, false>(), Parallel());
+   return details::reduction_index(array, best.second);
 }
 
 /**
@@ -0,0 +1,187 @@
+#pragma once
+
+#ifdef WITH_OMP
+#include <omp.h>
+#endif
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @file
+
+ This file defines how the memory lines visited by the array processors are distributed over several threads.
+
+ The traversal of an array is a sequence of memory line accesses (see @ref ArrayChunking_contiguous_base). In parallel mode,
+ this sequence is split into contiguous ranges of accesses, one per thread. Since the accesses are ordered from the fastest
+ to the slowest varying dimension, this is equivalent to partitioning the slowest varying dimensions of the array.
+ */
+
+namespace details
+{
+struct ParallelConfiguration
+{
+   ui32 nb_threads            = 0;       /// maximum number of threads. If 0, all the available cores are used
+   size_t min_elements_thread = 1 << 16; /// minimum number of elements a thread must process. Below this, the traversal stays serial
+   bool reproducible          = true;    /// if true, the parallel reductions don't depend on the number of threads
+};
+
+inline ParallelConfiguration& parallel_configuration()
+{
+   static ParallelConfiguration configuration;
+   return configuration;
+}
+}
+
+/**
+ @brief Set the maximum number of threads used by the parallel iterations. If 0, all the available cores are used
+ */
+inline void set_parallel_nb_threads(ui32 nb_threads)
+{
+   details::parallel_configuration().nb_threads = nb_threads;
+}
+
+/**
+ @brief Return the maximum number of threads used by the parallel iterations
+ */
+inline ui32 get_parallel_nb_threads()
+{
+   const ui32 nb_threads = details::parallel_configuration().nb_threads;
+   if (nb_threads)
+   {
+      return nb_threads;
+   }
+#ifdef WITH_OMP
+   return static_cast<ui32>(omp_get_max_threads());
+#else
+   return 1;
+#endif
+}
+
+/**
+ @brief Set the minimum number of elements each thread must process. Arrays with fewer elements than this are processed serially
+ */
+inline void set_parallel_min_elements(size_t min_elements_thread)
+{
+   details::parallel_configuration().min_elements_thread = std::max<size_t>(1, min_elements_thread);
+}
+
+inline size_t get_parallel_min_elements()
+{
+   return details::parallel_configuration().min_elements_thread;
+}
+
+/**
+ @brief Select how the parallel reductions (e.g., @ref sum, @ref norm2sqr) are split between the threads
+
+ In reproducible mode (the default), the array is split in fixed blocks that are combined in a fixed order so that the floating
+ point results are bit-identical whatever the number of threads. Else each thread combines the blocks of its own range and the
+ results of the threads are combined: less memory but the rounding of the floating point sums depends on the number of threads.
+ */
+inline void set_parallel_reproducible(bool reproducible)
+{
+   details::parallel_configuration().reproducible = reproducible;
+}
+
+inline bool get_parallel_reproducible()
+{
+   return details::parallel_configuration().reproducible;
+}
+
+/**
+ @brief Request a multithreaded traversal from the iterate_* functions
+
+ The operation provided to the iterate function will be called concurrently on different memory lines, so it
+ must only modify the memory it is given (e.g., no accumulation in a shared variable).
+
+ @code
+ auto op = [](float* y, ui32 y_stride, const float* x, ui32 x_stride, ui32 nb_elements) { ... };
+ iterate_array_constarray(a1, a2, op, Parallel());   // use the global settings
+ iterate_array_constarray(a1, a2, op, Parallel(4));  // use at most 4 threads
+ @endcode
+ */
+class Parallel
+{
+public:
+   /**
+    @param nb_threads the maximum number of threads. If 0, @ref get_parallel_nb_threads is used
+    @param min_elements_thread the minimum number of elements processed by a thread. If 0, @ref get_parallel_min_elements is used
+    */
+   explicit Parallel(ui32 nb_threads = 0, size_t min_elements_thread = 0) : _nb_threads(nb_threads), _min_elements_thread(min_elements_thread)
+   {
+   }
+
+   /**
+    @brief Return the number of threads to be used for a traversal of @p nb_elements elements split in @p nb_accesses accesses
+    */
+   ui32 nbThreads(size_t nb_elements, ui32 nb_accesses) const
+   {
+#ifdef WITH_OMP
+      if (omp_in_parallel())
+      {
+         // already in a parallel region: don't oversubscribe the cores
+         return 1;
+      }
+
+      const ui32 max_threads      = _nb_threads ? _nb_threads : get_parallel_nb_threads();
+      const size_t min_elements   = _min_elements_thread ? _min_elements_thread : get_parallel_min_elements();
+      const size_t threads_needed = std::max<size_t>(1, nb_elements / min_elements);
+      return static_cast<ui32>(std::min<size_t>(std::min<size_t>(max_threads, threads_needed), std::max<ui32>(1, nb_accesses)));
+#else
+      (void)nb_elements;
+      (void)nb_accesses;
+      return 1;
+#endif
+   }
+
+private:
+   ui32 _nb_threads;
+   size_t _min_elements_thread;
+};
+
+namespace details
+{
+/**
+ @brief Split [0, nb_accesses) in @p nb_threads contiguous ranges and call op(access_begin, access_end) for each range in its own thread
+ */
+template <class Op>
+void parallel_accesses(ui32 nb_threads, ui32 nb_accesses, Op& op)
+{
+   if (nb_threads <= 1)
+   {
+      op(0, nb_accesses);
+      return;
+   }
+
+#ifdef WITH_OMP
+#pragma omp parallel for num_threads(nb_threads) schedule(static, 1)
+   for (int thread = 0; thread < static_cast<int>(nb_threads); ++thread)
+   {
+      const ui32 access_begin = static_cast<ui32>(static_cast<size_t>(nb_accesses) * thread / nb_threads);
+      const ui32 access_end   = static_cast<ui32>(static_cast<size_t>(nb_accesses) * (thread + 1) / nb_threads);
+      if (access_begin != access_end)
+      {
+         op(access_begin, access_end);
+      }
+   }
+#else
+   op(0, nb_accesses);
+#endif
+}
+
+/**
+ @brief Split [0, nb_items) in @p nb_threads contiguous chunks and call op(chunk, item_begin, item_end) for each of them in parallel
+ */
+template <class Op>
+void parallel_chunks(ui32 nb_threads, size_t nb_items, Op& op)
+{
+   auto process = [&](ui32 chunk_begin, ui32 chunk_end) {
+      for (ui32 chunk = chunk_begin; chunk < chunk_end; ++chunk)
+      {
+         op(chunk, nb_items * chunk / nb_threads, nb_items * (chunk + 1) / nb_threads);
+      }
+   };
+   parallel_accesses(nb_threads, nb_threads, process);
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
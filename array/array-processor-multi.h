@@ -0,0 +1,366 @@
+#pragma once
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @file
+
+ This file defines the joint iteration of an array and any number of const arrays, possibly with different configurations
+ and data orderings, so that fused operations can read all their operands in a single pass
+ */
+
+namespace details
+{
+template <class Op, class Tuple, size_t... I>
+FORCE_INLINE void apply_tuple(Op& op, const Tuple& args, std::index_sequence<I...>)
+{
+   op(std::get<I>(args)...);
+}
+
+/**
+ @brief Call op(std::get<0>(args), std::get<1>(args), ...)
+ */
+template <class Op, class Tuple>
+FORCE_INLINE void apply_tuple(Op& op, const Tuple& args)
+{
+   apply_tuple(op, args, std::make_index_sequence<std::tuple_size<Tuple>::value>());
+}
+
+template <class Tuple, class F, size_t... I>
+FORCE_INLINE void for_each_tuple(Tuple& args, F& f, std::index_sequence<I...>)
+{
+   (void)std::initializer_list<int>{(f(std::get<I>(args)), 0)...};
+}
+
+/**
+ @brief Call f(element) for each element of the tuple
+ */
+template <class Tuple, class F>
+FORCE_INLINE void for_each_tuple(Tuple& args, F& f)
+{
+   for_each_tuple(args, f, std::make_index_sequence<std::tuple_size<Tuple>::value>());
+}
+
+/**
+ @brief Call op(ptrs[0], strides[0], ptrs[1], strides[1], ..., nb_elements)
+ */
+template <class Op, size_t... I, class... Pointers>
+FORCE_INLINE void call_interleaved(Op& op, const ui32* strides, ui32 nb_elements, std::index_sequence<I...>, Pointers... ptrs)
+{
+   apply_tuple(op, std::tuple_cat(std::make_tuple(ptrs, strides[I])..., std::make_tuple(nb_elements)));
+}
+
+/**
+ @brief Input of a tiled joint traversal
+
+ The tiles are defined over (d1, d2), the fastest varying dimension of the output and the second dimension of the tile.
+ The input is accessed according to its own fastest varying dimension:
+ - along d1: the memory lines are directly read from the input
+ - along d2: the tile is read along d2 and transposed in a buffer so that the buffer lines are along d1
+ - any other dimension: if possible, the memory lines along d1 are directly read (with a stride). Else, the tile is gathered
+   element by element in the buffer (e.g., d1 is the slice dimension of a slice based memory)
+ */
+template <class Memory>
+class TiledInput
+{
+public:
+   using value_type         = typename std::remove_const<typename Memory::value_type>::type;
+   using const_pointer_type = const value_type*;
+   using index_type         = typename Memory::index_type;
+
+   TiledInput(const Memory& memory, ui32 d1, ui32 d2, ui32 tile_size) : _memory(memory), _d1(d1), _d2(d2), _tile_size(tile_size)
+   {
+      const ui32 fastest = getFastestVaryingIndexesMemory(memory)[0];
+      _strides           = memory.getIndexMapper()._getPhysicalStrides();
+      if (fastest == d2 && d2 != d1)
+      {
+         _mode = TRANSPOSE;
+      }
+      else if (_strides[d1] != 0 || memory.shape()[d1] == 1)
+      {
+         _mode = DIRECT;
+      }
+      else
+      {
+         ensure(d1 != d2, "a tile with a second dimension is required!");
+         _mode = GATHER;
+      }
+
+      if (_mode != DIRECT)
+      {
+         _buffer.resize(tile_size * tile_size);
+      }
+   }
+
+   /**
+    @brief Load the tile starting at @p index with size (x_size, y_size) along (d1, d2)
+    */
+   void load(index_type index, ui32 x_size, ui32 y_size)
+   {
+      if (_mode == DIRECT)
+      {
+         return;
+      }
+
+      const ui32 x_begin = index[_d1];
+      const ui32 y_begin = index[_d2];
+      for (ui32 x = 0; x < x_size; ++x)
+      {
+         index[_d1] = x_begin + x;
+         if (_mode == TRANSPOSE)
+         {
+            index[_d2]             = y_begin;
+            const_pointer_type src = _memory.at(index);
+            value_type* dst        = _buffer.data() + x;
+            for (ui32 y = 0; y < y_size; ++y, src += _strides[_d2], dst += _tile_size)
+            {
+               *dst = *src;
+            }
+         }
+         else
+         {
+            for (ui32 y = 0; y < y_size; ++y)
+            {
+               index[_d2]                  = y_begin + y;
+               _buffer[y * _tile_size + x] = *_memory.at(index);
+            }
+         }
+      }
+   }
+
+   /**
+    @brief Return the pointer to the line @p y of the tile. @p index is the index of the first element of this line
+    */
+   const_pointer_type linePointer(const index_type& index, ui32 y) const
+   {
+      if (_mode == DIRECT)
+      {
+         return _memory.at(index);
+      }
+      return _buffer.data() + y * _tile_size;
+   }
+
+   ui32 lineStride() const
+   {
+      return _mode == DIRECT ? _strides[_d1] : 1;
+   }
+
+private:
+   enum Mode
+   {
+      DIRECT,
+      TRANSPOSE,
+      GATHER
+   };
+
+   const Memory& _memory;
+   ui32 _d1;
+   ui32 _d2;
+   ui32 _tile_size;
+   Mode _mode;
+   index_type _strides;
+   std::vector<value_type> _buffer;
+};
+
+template <class Op, class Pointer1, class Inputs, class index_type, size_t... I>
+FORCE_INLINE void call_tiled_line(Op& op, Pointer1 ptr_a1, ui32 stride_a1, const Inputs& inputs, const index_type& index, ui32 y, ui32 nb_elements,
+                                  std::index_sequence<I...>)
+{
+   apply_tuple(op, std::tuple_cat(std::make_tuple(ptr_a1, stride_a1), std::make_tuple(std::get<I>(inputs).linePointer(index, y), std::get<I>(inputs).lineStride())...,
+                                  std::make_tuple(nb_elements)));
+}
+
+/**
+ @brief Joint traversal by tiles. This handles any data ordering and memory
+
+ The tiles are grouped in accesses that only depend on the shape and data ordering of the memories. @p schedule is called
+ with (ui32 nb_accesses, process) and must call process(op, access_begin, access_end) to traverse the memory lines of the
+ accesses [access_begin, access_end) in order
+ */
+template <class Schedule, class Memory1, class... Memories>
+void iterate_memory_constmemories_tiled_accesses(Schedule& schedule, Memory1& a1, const Memories&... memories)
+{
+   using index_type            = typename Memory1::index_type;
+   using pointer_type          = typename Memory1::pointer_type;
+   static const size_t N       = Memory1::RANK;
+   static const ui32 tile_size = 32;
+
+   const auto& shape    = a1.shape();
+   const auto order_a1  = getFastestVaryingIndexesMemory(a1);
+   const ui32 d1        = order_a1[0];
+   const ui32 stride_a1 = a1.getIndexMapper()._getPhysicalStrides()[d1];
+
+   // the first input with a different fastest varying dimension defines the second dimension of the tiles
+   ui32 d2 = d1;
+   (void)std::initializer_list<int>{(d2 = (d2 == d1 ? getFastestVaryingIndexesMemory(memories)[0] : d2), 0)...};
+   const bool has_d2   = d2 != d1;
+   const ui32 tile_x   = has_d2 ? tile_size : shape[d1];
+   const ui32 tile_y   = has_d2 ? tile_size : 1;
+   const ui32 nb_tiles = has_d2 ? (shape[d2] + tile_size - 1) / tile_size : 1;
+
+   // the other dimensions are iterated in the order of a1
+   index_type outer_dims;
+   ui32 nb_outer_dims = 0;
+   size_t nb_outer    = 1;
+   for (ui32 n = 0; n < N; ++n)
+   {
+      const auto dim = order_a1[n];
+      if (dim != d1 && dim != d2)
+      {
+         outer_dims[nb_outer_dims++] = dim;
+         nb_outer *= shape[dim];
+      }
+   }
+
+   // an access is a strip of tiles covering d1
+   const ui32 nb_accesses = static_cast<ui32>(nb_outer * nb_tiles);
+   auto process           = [&](auto& op, ui32 access_begin, ui32 access_end) {
+      auto inputs = std::make_tuple(TiledInput<Memories>(memories, d1, d2, tile_size)...);
+      index_type index;
+      for (ui32 access = access_begin; access < access_end; ++access)
+      {
+         size_t outer = access / nb_tiles;
+         for (ui32 n = 0; n < nb_outer_dims; ++n)
+         {
+            const auto dim = outer_dims[n];
+            index[dim]     = static_cast<ui32>(outer % shape[dim]);
+            outer /= shape[dim];
+         }
+
+         const ui32 y_begin = (access % nb_tiles) * tile_y;
+         const ui32 y_size  = has_d2 ? std::min(tile_y, shape[d2] - y_begin) : 1;
+         for (ui32 x_begin = 0; x_begin < shape[d1]; x_begin += tile_x)
+         {
+            const ui32 x_size = std::min(tile_x, shape[d1] - x_begin);
+            index[d1]         = x_begin;
+            index[d2]         = has_d2 ? y_begin : x_begin;
+
+            auto load = [&](auto& input) { input.load(index, x_size, y_size); };
+            for_each_tuple(inputs, load);
+
+            for (ui32 y = 0; y < y_size; ++y)
+            {
+               if (has_d2)
+               {
+                  index[d2] = y_begin + y;
+               }
+               call_tiled_line(op, pointer_type(a1.at(index)), stride_a1, inputs, index, y, x_size, std::index_sequence_for<Memories...>());
+            }
+         }
+      }
+   };
+
+   schedule(nb_accesses, process);
+}
+
+/**
+ @brief Joint traversal by tiles. This handles any data ordering and memory
+ */
+template <class Op, class Memory1, class... Memories>
+void iterate_memory_constmemories_tiled(const Parallel& parallel, Op& op, Memory1& a1, const Memories&... memories)
+{
+   using pointer_type = typename Memory1::pointer_type;
+
+   auto schedule = [&](ui32 nb_accesses, auto& process) {
+      auto process_accesses = [&](ui32 access_begin, ui32 access_end) { process(op, access_begin, access_end); };
+      const ui32 nb_threads = getNbThreads<pointer_type>(parallel, a1.size(), nb_accesses);
+      parallel_accesses(nb_threads, nb_accesses, process_accesses);
+   };
+   iterate_memory_constmemories_tiled_accesses(schedule, a1, memories...);
+}
+
+/**
+ @brief Joint traversal of memories having the same data ordering with nested loops on the coalesced memory lines
+ @return false if the memories can't be traversed this way
+ */
+template <class Op, class Memory1, class... Memories>
+bool iterate_memory_constmemories_nested(Op& op, Memory1& a1, const Memories&... memories)
+{
+   using index_type      = typename Memory1::index_type;
+   static const size_t N = Memory1::RANK;
+
+   const auto order   = getFastestVaryingIndexesMemory(a1);
+   ui32 nb_dimensions = getNbContiguousDimensions(a1.shape(), a1.getIndexMapper()._getPhysicalStrides(), order);
+   (void)std::initializer_list<int>{
+       (nb_dimensions = std::min(nb_dimensions, getNbContiguousDimensions(memories.shape(), memories.getIndexMapper()._getPhysicalStrides(), order)), 0)...};
+
+   index_type sizeOrder;
+   for (size_t n = 0; n < N; ++n)
+   {
+      sizeOrder[n] = a1.shape()[order[n]];
+   }
+   for (size_t n = 1; n < nb_dimensions; ++n)
+   {
+      sizeOrder[0] *= sizeOrder[n];
+      sizeOrder[n] = 1;
+   }
+
+   const std::array<ui32, sizeof...(Memories) + 1> strides = {
+       {a1.getIndexMapper()._getPhysicalStrides()[order[0]], memories.getIndexMapper()._getPhysicalStrides()[order[0]]...}};
+   const ui32 line_size = sizeOrder[0];
+   auto line            = [&](auto... ptrs) { call_interleaved(op, strides.data(), line_size, std::index_sequence_for<decltype(ptrs)...>(), ptrs...); };
+   return iterate_memory_lines_nested(order, sizeOrder, line, a1, memories...);
+}
+
+/**
+ @brief iterate jointly a memory and any number of const memories
+ */
+template <class Op, class Memory1, class... Memories>
+void iterate_memory_constmemories(const Parallel& parallel, Op& op, Memory1& a1, const Memories&... memories)
+{
+   static_assert(are_pointers<typename Memory1::pointer_type, typename Memories::pointer_type...>::value, "only memories in main memory are handled!");
+   static_assert(is_same<std::integral_constant<size_t, Memory1::RANK>, std::integral_constant<size_t, Memories::RANK>...>::value,
+                 "must have the same rank!");
+
+   bool same_shape = true;
+   (void)std::initializer_list<int>{(same_shape = same_shape && memories.shape() == a1.shape(), 0)...};
+   ensure(same_shape, "must have the same shape!");
+
+   if (a1.size() == 0)
+   {
+      return;
+   }
+
+   const auto order   = getFastestVaryingIndexesMemory(a1);
+   bool same_ordering = true;
+   (void)std::initializer_list<int>{(same_ordering = same_ordering && getFastestVaryingIndexesMemory(memories) == order, 0)...};
+
+   const bool serial = parallel.nbThreads(a1.size(), std::numeric_limits<ui32>::max()) == 1;
+   if (same_ordering && serial && iterate_memory_constmemories_nested(op, a1, memories...))
+   {
+      return;
+   }
+   iterate_memory_constmemories_tiled(parallel, op, a1, memories...);
+}
+}
+
+/**
+ @brief iterate jointly an array and any number of const arrays. The arrays can have any configuration and data ordering
+
+ @tparam Op must be callable with (pointer_type1 a1, ui32 stride_a1, const_pointer_type2 a2, ui32 stride_a2, ..., ui32 nb_elements)
+ @note the memory lines of the const arrays may be read from a temporary buffer (i.e., arrays with a different data ordering)
+
+ @code
+ auto op = [](float* out, ui32 out_stride, const float* a, ui32 a_stride, const float* b, ui32 b_stride, const float* c, ui32 c_stride,
+              ui32 nb_elements) { ... };
+ iterate_array_constarrays(op, out, a, b, c);
+ @endcode
+ */
+template <class Op, class T, size_t N, class Config, class... Arrays,
+          typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_array_constarrays(Op& op, Array<T, N, Config>& a1, const Arrays&... arrays)
+{
+   details::iterate_memory_constmemories(Parallel(1), op, a1.getMemory(), arrays.getMemory()...);
+}
+
+/**
+ @brief iterate jointly an array and any number of const arrays using several threads. @p op must be safe to call concurrently
+ */
+template <class Op, class T, size_t N, class Config, class... Arrays,
+          typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_array_constarrays(const Parallel& parallel, Op& op, Array<T, N, Config>& a1, const Arrays&... arrays)
+{
+   details::iterate_memory_constmemories(parallel, op, a1.getMemory(), arrays.getMemory()...);
+}
+
+DECLARE_NAMESPACE_NLL_END
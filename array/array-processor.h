@@ -31,8 +31,6 @@ namespace details
    The only assumption for this iterator is that we have the fastest varying index has at
    least <maxAccessElements> contiguous memory elements. So this handle <Memory_contiguous>
    and <Memory_multislice> Memories
-
-   @todo if fastest varying dimension size = 1 -> skip this dimension for contiguous memory only
    */
 template <class Array>
 class ArrayProcessor_contiguous_base : public ArrayChunking_contiguous_base<Array>
@@ -113,6 +111,11 @@ public:
       return _processor.getIteratorIndex();
    }
 
+   const index_type& getIteratorShape() const
+   {
+      return _processor.getIteratorShape();
+   }
+
    const index_type getArrayIndex() const
    {
       return _processor.getArrayIndex();
@@ -138,6 +141,31 @@ public:
       return _processor.finished();
    }
 
+   ui32 getNbAccesses() const
+   {
+      return _processor.getNbAccesses();
+   }
+
+   void restrictAccesses(ui32 access_begin, ui32 access_end)
+   {
+      _processor.restrictAccesses(access_begin, access_end);
+   }
+
+   void coalesceDimensions(ui32 nbDimensions)
+   {
+      _processor.coalesceDimensions(nbDimensions);
+   }
+
+   void setNbElementsPerAccess(ui32 nbElementsToAccessPerIter)
+   {
+      _processor.setNbElementsPerAccess(nbElementsToAccessPerIter);
+   }
+
+   ui32 getNbElementsCurrentAccess() const
+   {
+      return _processor.getNbElementsCurrentAccess();
+   }
+
 protected:
    bool _accessElements(const_pointer_type& ptrToValue)
    {
@@ -160,12 +188,14 @@ StaticVector<ui32, Memory::RANK> getFastestVaryingIndexesMemory(const Memory& me
 
    // first, we want to iterate from the fastest->lowest varying index to avoid as much cache misses as possible
    // EXCEPT is stride is 0, which is a special case (different slices in memory, so this is actually the WORST dimension to iterate on)
-   auto strides = memory.getIndexMapper()._getPhysicalStrides();
-   for (auto& v : strides)
+   // dimensions of size 1 are iterated last: they would otherwise result in memory lines of a single element
+   auto strides      = memory.getIndexMapper()._getPhysicalStrides();
+   const auto& shape = memory.shape();
+   for (ui32 n = 0; n < N; ++n)
    {
-      if (v == 0)
+      if (strides[n] == 0 || shape[n] == 1)
       {
-         v = std::numeric_limits<typename index_type::value_type>::max();
+         strides[n] = std::numeric_limits<typename index_type::value_type>::max();
       }
    }
 
@@ -189,6 +219,155 @@ StaticVector<ui32, N> getFastestVaryingIndexes(const Array<T, N, ConfigT>& array
 {
    return getFastestVaryingIndexesMemory(array.getMemory());
 }
+
+/**
+ @brief Return the number of dimensions, in the traversal order @p indexesOrder, that can be accessed as a single memory line
+
+ Consecutive dimensions are folded as long as the stride of the next dimension is the stride of the current line times its size.
+ Dimensions of size 1 can always be folded.
+ */
+template <class index_type>
+ui32 getNbContiguousDimensions(const index_type& shape, const index_type& strides, const index_type& indexesOrder)
+{
+   size_t line_stride = static_cast<size_t>(strides[indexesOrder[0]]) * shape[indexesOrder[0]];
+   ui32 n             = 1;
+   for (; n < indexesOrder.size(); ++n)
+   {
+      const auto dim = indexesOrder[n];
+      if (shape[dim] != 1)
+      {
+         if (strides[dim] != line_stride)
+         {
+            break;
+         }
+         line_stride *= shape[dim];
+      }
+   }
+   return n;
+}
+
+/**
+ @brief Return the number of elements per access so that @p nb_lines memory lines of @p line_size elements are split in at least @p nb_threads accesses
+
+ This allows a parallel traversal of arrays having fewer memory lines than threads (e.g., a single coalesced memory line)
+ */
+template <class pointer_type>
+ui32 getNbElementsPerAccessParallel(ui32 nb_threads, ui32 nb_lines, ui32 line_size)
+{
+   if (nb_lines == 0 || nb_lines >= nb_threads)
+   {
+      return line_size;
+   }
+
+   // the accesses are multiples of 64 bytes: when the memory line starts on a cache line, the threads do not write the same cache lines
+   using value_type       = typename std::remove_pointer<pointer_type>::type;
+   const ui32 alignment   = static_cast<ui32>(std::max<size_t>(1, 64 / sizeof(value_type)));
+   const ui32 nb_splits   = (nb_threads + nb_lines - 1) / nb_lines;
+   const ui32 nb_elements = (line_size + nb_splits - 1) / nb_splits;
+   return std::min(line_size, (nb_elements + alignment - 1) / alignment * alignment);
+}
+
+/**
+ @brief Nested loops over the memory lines of several memories. D is the slowest varying dimension of the loop
+
+ The pointers to the next memory line are obtained by incrementing the pointers by the stride of the dimension
+ */
+template <int D>
+struct NestedLines
+{
+   template <class F, class Strides, size_t... I, class... Pointers>
+   FORCE_INLINE static void run(const ui32* size, const Strides& strides, F& f, std::index_sequence<I...> sequence, Pointers... ptrs)
+   {
+      for (ui32 i = 0; i < size[D]; ++i)
+      {
+         NestedLines<D - 1>::run(size, strides, f, sequence, ptrs...);
+         (void)std::initializer_list<int>{(ptrs += strides[I][D], 0)...};
+      }
+   }
+};
+
+template <>
+struct NestedLines<0>
+{
+   template <class F, class Strides, size_t... I, class... Pointers>
+   FORCE_INLINE static void run(const ui32*, const Strides&, F& f, std::index_sequence<I...>, Pointers... ptrs)
+   {
+      f(ptrs...);
+   }
+};
+
+template <class Memory>
+bool getStridesOrdered(const Memory& memory, const StaticVector<ui32, Memory::RANK>& indexesOrder, const StaticVector<ui32, Memory::RANK>& sizeOrder,
+                       StaticVector<ui32, Memory::RANK>& strides)
+{
+   const auto& physicalStrides = memory.getIndexMapper()._getPhysicalStrides();
+   for (size_t n = 0; n < Memory::RANK; ++n)
+   {
+      strides[n] = physicalStrides[indexesOrder[n]];
+      if (strides[n] == 0 && sizeOrder[n] > 1)
+      {
+         // slice based memory: the next memory line can't be reached using a stride
+         return false;
+      }
+   }
+   return true;
+}
+
+template <size_t N, class F, class... Memories>
+bool iterate_memory_lines_nested(std::false_type, const StaticVector<ui32, N>&, const StaticVector<ui32, N>&, F&, Memories&...)
+{
+   return false;
+}
+
+template <size_t N, class F, class... Memories>
+bool iterate_memory_lines_nested(std::true_type, const StaticVector<ui32, N>& indexesOrder, const StaticVector<ui32, N>& sizeOrder, F& f,
+                                 Memories&... memories)
+{
+   std::array<StaticVector<ui32, N>, sizeof...(Memories)> strides;
+   bool valid = true;
+   size_t k   = 0;
+   (void)std::initializer_list<int>{(valid = getStridesOrdered(memories, indexesOrder, sizeOrder, strides[k++]) && valid, 0)...};
+   if (!valid)
+   {
+      return false;
+   }
+
+   const StaticVector<ui32, N> origin;
+   NestedLines<static_cast<int>(N) - 1>::run(sizeOrder.begin(), strides, f, std::index_sequence_for<Memories...>(), memories.at(origin)...);
+   return true;
+}
+
+/**
+ @brief Call f(pointer_memory_1, ..., pointer_memory_n) for each memory line of the memories, for ranks 1 to 4
+
+ The memory lines are traversed with nested loops of pointer increments, avoiding the bookkeeping of the processors.
+ All the memories must have the same shape and be traversed in the same order.
+
+ @param indexesOrder the order of traversal of the dimensions
+ @param sizeOrder the size of the dimensions in traversal order. sizeOrder[0] is the size of the memory lines
+ @return false if the memories can't be traversed this way (e.g., higher rank, slice based memory or non raw pointers)
+ */
+template <size_t N, class F, class... Memories>
+bool iterate_memory_lines_nested(const StaticVector<ui32, N>& indexesOrder, const StaticVector<ui32, N>& sizeOrder, F& f, Memories&... memories)
+{
+   using enabled = std::integral_constant<bool, N <= 4 && are_pointers<typename Memories::pointer_type...>::value>;
+   return iterate_memory_lines_nested(enabled(), indexesOrder, sizeOrder, f, memories...);
+}
+
+/**
+ @brief Return the number of threads to be used to process @p nb_accesses memory accesses
+
+ Only raw pointers are processed in parallel (e.g., CUDA memory must be accessed serially)
+ */
+template <class pointer_type>
+ui32 getNbThreads(const Parallel& parallel, size_t nb_elements, ui32 nb_accesses)
+{
+   if (!std::is_pointer<pointer_type>::value)
+   {
+      return 1;
+   }
+   return parallel.nbThreads(nb_elements, nb_accesses);
+}
 }
 
 /**
@@ -208,7 +387,7 @@ public:
 
    ui32 getNbElementsPerAccess() const
    {
-      return this->_nbElementsToAccessPerIter;
+      return this->_nbElementsCurrentAccess;
    }
 
    ui32 stride() const
@@ -216,6 +395,15 @@ public:
       return this->_array.getMemory().getIndexMapper()._getPhysicalStrides()[this->getVaryingIndex()];
    }
 
+   /**
+    @brief Return the number of dimensions that can be merged in a single memory line using @ref coalesceDimensions
+    */
+   ui32 getNbContiguousDimensions() const
+   {
+      return details::getNbContiguousDimensions(this->_array.shape(), this->_array.getMemory().getIndexMapper()._getPhysicalStrides(),
+                                                this->getVaryingIndexOrder());
+   }
+
    /**
    @return true if more elements are to be processed
 
@@ -247,7 +435,7 @@ public:
 
    ui32 getNbElementsPerAccess() const
    {
-      return this->_nbElementsToAccessPerIter;
+      return this->_nbElementsCurrentAccess;
    }
 
    ui32 stride() const
@@ -255,6 +443,14 @@ public:
       return this->_array.getIndexMapper()._getPhysicalStrides()[this->getVaryingIndex()];
    }
 
+   /**
+    @brief Return the number of dimensions that can be merged in a single memory line using @ref coalesceDimensions
+    */
+   ui32 getNbContiguousDimensions() const
+   {
+      return details::getNbContiguousDimensions(this->_array.shape(), this->_array.getIndexMapper()._getPhysicalStrides(), this->getVaryingIndexOrder());
+   }
+
    /**
    @return true if more elements are to be processed
 
@@ -290,7 +486,7 @@ public:
 
    ui32 getNbElementsPerAccess() const
    {
-      return this->_processor._nbElementsToAccessPerIter;
+      return this->_processor._nbElementsCurrentAccess;
    }
 
    ui32 stride() const
@@ -298,6 +494,15 @@ public:
       return this->_processor._array.getIndexMapper()._getPhysicalStrides()[this->getVaryingIndex()];
    }
 
+   /**
+    @brief Return the number of dimensions that can be merged in a single memory line using @ref coalesceDimensions
+    */
+   ui32 getNbContiguousDimensions() const
+   {
+      return details::getNbContiguousDimensions(this->_processor._array.shape(), this->_processor._array.getIndexMapper()._getPhysicalStrides(),
+                                                this->getVaryingIndexOrder());
+   }
+
    /**
    @return true if more elements are to be processed
 
@@ -332,7 +537,7 @@ public:
 
    ui32 getNbElementsPerAccess() const
    {
-      return this->_processor._nbElementsToAccessPerIter;
+      return this->_processor._nbElementsCurrentAccess;
    }
 
    ui32 stride() const
@@ -340,6 +545,15 @@ public:
       return this->_processor._array.getMemory().getIndexMapper()._getPhysicalStrides()[this->getVaryingIndex()];
    }
 
+   /**
+    @brief Return the number of dimensions that can be merged in a single memory line using @ref coalesceDimensions
+    */
+   ui32 getNbContiguousDimensions() const
+   {
+      return details::getNbContiguousDimensions(this->_processor._array.shape(), this->_processor._array.getMemory().getIndexMapper()._getPhysicalStrides(),
+                                                this->getVaryingIndexOrder());
+   }
+
    /**
    @return true if more elements are to be processed
 
@@ -414,7 +628,7 @@ struct CompileError
 namespace impl
 {
 template <class Memory1, class Memory2, class Op, typename = typename std::enable_if<IsMemoryLayoutLinear<Memory1>::value>::type>
-void _iterate_memory_constmemory_same_ordering(Memory1& a1, const Memory2& a2, const Op& op)
+void _iterate_memory_constmemory_same_ordering(Memory1& a1, const Memory2& a2, const Op& op, const Parallel& parallel)
 {
    using pointer_T        = typename Memory1::pointer_type;
    using pointer_T2       = typename Memory2::pointer_type;
@@ -432,27 +646,61 @@ void _iterate_memory_constmemory_same_ordering(Memory1& a1, const Memory2& a2, c
    }
 
    // we MUST use processors: data may not be contiguous or with stride...
-   ConstMemoryProcessor_contiguous_byMemoryLocality<Memory2> processor_a2(a2, 0);
-   MemoryProcessor_contiguous_byMemoryLocality<Memory1> processor_a1(a1, 0);
-
-   bool hasMoreElements = true;
-   while (hasMoreElements)
-   {
-      pointer_T ptr_a1        = pointer_T(nullptr);
-      pointer_const_T2 ptr_a2 = pointer_const_T2(nullptr);
-      static_assert(std::is_same<pointer_const_T2, typename ConstMemoryProcessor_contiguous_byMemoryLocality<Memory2>::const_pointer_type>::value,
-                    "must be the same!");
+   ConstMemoryProcessor_contiguous_byMemoryLocality<Memory2> processor_a2_all(a2, 0);
+   MemoryProcessor_contiguous_byMemoryLocality<Memory1> processor_a1_all(a1, 0);
+
+   // the memory lines must be identical for both arrays
+   const ui32 nb_dimensions = std::min(processor_a1_all.getNbContiguousDimensions(), processor_a2_all.getNbContiguousDimensions());
+   processor_a1_all.coalesceDimensions(nb_dimensions);
+   processor_a2_all.coalesceDimensions(nb_dimensions);
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      auto processor_a1 = processor_a1_all;
+      auto processor_a2 = processor_a2_all;
+      processor_a1.restrictAccesses(access_begin, access_end);
+      processor_a2.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         pointer_T ptr_a1        = pointer_T(nullptr);
+         pointer_const_T2 ptr_a2 = pointer_const_T2(nullptr);
+         static_assert(std::is_same<pointer_const_T2, typename ConstMemoryProcessor_contiguous_byMemoryLocality<Memory2>::const_pointer_type>::value,
+                       "must be the same!");
 
-      hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
-      hasMoreElements = processor_a2.accessMaxElements(ptr_a2);
-      NLL_FAST_ASSERT(processor_a1.getNbElementsPerAccess() == processor_a2.getNbElementsPerAccess(), "memory line must have the same size");
+         hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
+         hasMoreElements = processor_a2.accessMaxElements(ptr_a2);
+         NLL_FAST_ASSERT(processor_a1.getNbElementsPerAccess() == processor_a2.getNbElementsPerAccess(), "memory line must have the same size");
 
-      op(ptr_a1, processor_a1.stride(), ptr_a2, processor_a2.stride(), processor_a1.getNbElementsPerAccess());
+         op(ptr_a1, processor_a1.stride(), ptr_a2, processor_a2.stride(), processor_a1.getNbElementsPerAccess());
+      }
+   };
+
+   // split the memory lines if there are fewer lines than threads
+   const ui32 nb_threads_max         = details::getNbThreads<pointer_T>(parallel, a1.size(), std::numeric_limits<ui32>::max());
+   const ui32 nb_elements_per_access = details::getNbElementsPerAccessParallel<pointer_T>(
+       nb_threads_max, processor_a1_all.getNbAccesses(), processor_a1_all.getNbElementsPerAccess());
+   processor_a1_all.setNbElementsPerAccess(nb_elements_per_access);
+   processor_a2_all.setNbElementsPerAccess(nb_elements_per_access);
+
+   const ui32 nb_accesses = processor_a1_all.getNbAccesses();
+   const ui32 nb_threads  = std::min(nb_threads_max, nb_accesses);
+   if (nb_threads == 1)
+   {
+      const ui32 stride_a1 = processor_a1_all.stride();
+      const ui32 stride_a2 = processor_a2_all.stride();
+      const ui32 line_size = processor_a1_all.getIteratorShape()[0];
+      auto line            = [&](pointer_T ptr_a1, pointer_const_T2 ptr_a2) { op(ptr_a1, stride_a1, ptr_a2, stride_a2, line_size); };
+      if (details::iterate_memory_lines_nested(processor_a1_all.getVaryingIndexOrder(), processor_a1_all.getIteratorShape(), line, a1, a2))
+      {
+         return;
+      }
    }
+   details::parallel_accesses(nb_threads, nb_accesses, process);
 }
 
 template <class Memory1, class Memory2, class Op, typename = typename std::enable_if<IsMemoryLayoutLinear<Memory1>::value>::type>
-void _iterate_memory_constmemory_different_ordering(Memory1& a1, const Memory2& a2, const Op& op)
+void _iterate_memory_constmemory_different_ordering(Memory1& a1, const Memory2& a2, const Op& op, const Parallel& parallel)
 {
    using pointer_T        = typename Memory1::pointer_type;
    using pointer_T2       = typename Memory2::pointer_type;
@@ -470,40 +718,175 @@ void _iterate_memory_constmemory_different_ordering(Memory1& a1, const Memory2&
       return;
    }
 
-   // we MUST use processors: data may not be contiguous or with stride...
-   // additionally the order of dimensions are different, so map the a2 order
-   ConstMemoryProcessor_contiguous_byMemoryLocality<Memory2> processor_a2(a2, 1);
-   auto functor_order = [&](const Memory1&) { return processor_a2.getVaryingIndexOrder(); };
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      // we MUST use processors: data may not be contiguous or with stride...
+      // additionally the order of dimensions are different, so map the a2 order
+      ConstMemoryProcessor_contiguous_byMemoryLocality<Memory2> processor_a2(a2, 1);
+      auto functor_order = [&](const Memory1&) { return processor_a2.getVaryingIndexOrder(); };
+
+      details::ArrayProcessor_contiguous_base<Memory1> processor_a1(a1, functor_order, 1);
+      processor_a1.restrictAccesses(access_begin, access_end);
+      processor_a2.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         pointer_T ptr_a1        = pointer_T(nullptr);
+         pointer_const_T2 ptr_a2 = pointer_const_T2(nullptr);
+         hasMoreElements         = processor_a1.accessSingleElement(ptr_a1);
+         hasMoreElements         = processor_a2.accessSingleElement(ptr_a2);
+         op(ptr_a1, 1, ptr_a2, 1, 1); // only single element, so actual stride value is not important, it just can't be 0
+      }
+   };
+
+   // single element accesses
+   const ui32 nb_accesses = static_cast<ui32>(a1.size());
+   const ui32 nb_threads  = details::getNbThreads<pointer_T>(parallel, a1.size(), nb_accesses);
+   details::parallel_accesses(nb_threads, nb_accesses, process);
+}
+
+/**
+ @brief Joint traversal of memories with different data ordering, by tiles
+
+ The memories are traversed by 2D tiles over their respective fastest varying dimensions (d1 for @p a1, d2 for @p a2).
+ Each tile of @p a2 is read along d2 and transposed in a small buffer, so that @p op is called with memory lines
+ along d1 for both @p a1 and the buffer. If d1 == d2, the memory lines of @p a1 and @p a2 are directly used.
+
+ The memory lines handed to @p op are at most the size of a tile.
+ */
+template <class Memory1, class Memory2, class Op, typename = typename std::enable_if<IsMemoryLayoutLinear<Memory1>::value>::type>
+void _iterate_memory_constmemory_different_ordering_tiled(Memory1& a1, const Memory2& a2, const Op& op, const Parallel& parallel, std::true_type)
+{
+   using pointer_T             = typename Memory1::pointer_type;
+   using pointer_T2            = typename Memory2::pointer_type;
+   using pointer_const_T2      = typename array_add_const<pointer_T2>::type;
+   using value_type2           = typename std::remove_const<typename Memory2::value_type>::type;
+   using index_type            = typename Memory1::index_type;
+   static const size_t N       = Memory1::RANK;
+   static const ui32 tile_size = 32; // a tile of double is 8KB, so it stays in L1 cache with the lines of a1
+
+   static_assert(is_callable_with<Op, pointer_T, ui32, pointer_const_T2, ui32, ui32>::value, "Op is not callable!");
+
+   ensure(Memory1::RANK == Memory2::RANK, "must have the same rank!");
+   ensure(a1.shape() == a2.shape(), "must have the same shape!");
+
+   if (a1.size() == 0)
+   {
+      return;
+   }
 
-   details::ArrayProcessor_contiguous_base<Memory1> processor_a1(a1, functor_order, 1);
+   const auto order_a1    = details::getFastestVaryingIndexesMemory(a1);
+   const ui32 d1          = order_a1[0];
+   const ui32 d2          = details::getFastestVaryingIndexesMemory(a2)[0];
+   const auto& shape      = a1.shape();
+   const ui32 stride_a1   = a1.getIndexMapper()._getPhysicalStrides()[d1];
+   const ui32 stride_a2   = a2.getIndexMapper()._getPhysicalStrides()[d2];
+   const ui32 stride_a2d1 = a2.getIndexMapper()._getPhysicalStrides()[d1];
+   if ((stride_a1 == 0 && shape[d1] > 1) || (stride_a2 == 0 && shape[d2] > 1) || (d1 == d2 && stride_a2d1 == 0 && shape[d1] > 1))
+   {
+      // a slice dimension can't be accessed with a stride
+      _iterate_memory_constmemory_different_ordering(a1, a2, op, parallel);
+      return;
+   }
 
-   bool hasMoreElements = true;
-   while (hasMoreElements)
+   // the other dimensions are iterated in the order of a1
+   index_type outer_dims;
+   ui32 nb_outer_dims = 0;
+   size_t nb_outer    = 1;
+   for (ui32 n = 0; n < N; ++n)
    {
-      pointer_T ptr_a1        = pointer_T(nullptr);
-      pointer_const_T2 ptr_a2 = pointer_const_T2(nullptr);
-      hasMoreElements         = processor_a1.accessSingleElement(ptr_a1);
-      hasMoreElements         = processor_a2.accessSingleElement(ptr_a2);
-      op(ptr_a1, 1, ptr_a2, 1, 1); // only single element, so actual stride value is not important, it just can't be 0
+      const auto dim = order_a1[n];
+      if (dim != d1 && dim != d2)
+      {
+         outer_dims[nb_outer_dims++] = dim;
+         nb_outer *= shape[dim];
+      }
    }
+
+   // an access is a strip of tiles covering d1
+   const ui32 nb_tiles_d2 = d1 == d2 ? 1 : (shape[d2] + tile_size - 1) / tile_size;
+   const ui32 nb_accesses = static_cast<ui32>(nb_outer * nb_tiles_d2);
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      std::vector<value_type2> buffer(d1 == d2 ? 0 : tile_size * tile_size);
+      index_type index;
+      for (ui32 access = access_begin; access < access_end; ++access)
+      {
+         size_t outer = access / nb_tiles_d2;
+         for (ui32 n = 0; n < nb_outer_dims; ++n)
+         {
+            const auto dim = outer_dims[n];
+            index[dim]     = static_cast<ui32>(outer % shape[dim]);
+            outer /= shape[dim];
+         }
+
+         if (d1 == d2)
+         {
+            index[d1] = 0;
+            op(a1.at(index), stride_a1, a2.at(index), stride_a2d1, shape[d1]);
+            continue;
+         }
+
+         const ui32 y_begin = (access % nb_tiles_d2) * tile_size;
+         const ui32 y_size  = std::min(tile_size, shape[d2] - y_begin);
+         for (ui32 x_begin = 0; x_begin < shape[d1]; x_begin += tile_size)
+         {
+            const ui32 x_size = std::min(tile_size, shape[d1] - x_begin);
+
+            // transpose the tile of a2: read it along d2 and write it along d1
+            index[d2] = y_begin;
+            for (ui32 x = 0; x < x_size; ++x)
+            {
+               index[d1]            = x_begin + x;
+               pointer_const_T2 src = a2.at(index);
+               value_type2* dst     = buffer.data() + x;
+               for (ui32 y = 0; y < y_size; ++y, src += stride_a2, dst += tile_size)
+               {
+                  *dst = *src;
+               }
+            }
+
+            index[d1] = x_begin;
+            for (ui32 y = 0; y < y_size; ++y)
+            {
+               index[d2] = y_begin + y;
+               op(a1.at(index), stride_a1, buffer.data() + y * tile_size, 1, x_size);
+            }
+         }
+      }
+   };
+
+   const ui32 nb_threads = details::getNbThreads<pointer_T>(parallel, a1.size(), nb_accesses);
+   details::parallel_accesses(nb_threads, nb_accesses, process);
+}
+
+/**
+ @brief The tiles are transposed through a buffer in main memory, so fall back to single element accesses for other memory types (e.g., CUDA)
+ */
+template <class Memory1, class Memory2, class Op, typename = typename std::enable_if<IsMemoryLayoutLinear<Memory1>::value>::type>
+void _iterate_memory_constmemory_different_ordering_tiled(Memory1& a1, const Memory2& a2, const Op& op, const Parallel& parallel, std::false_type)
+{
+   _iterate_memory_constmemory_different_ordering(a1, a2, op, parallel);
 }
 }
 
 /**
 @brief iterate array & const array jointly
 @tparam must be callable using (pointer_type a1_pointer, ui32 a1_stride, const_pointer_type a2_pointer, ui32 a2_stride, ui32 nb_elements)
+@param parallel if specified, the memory lines are processed by several threads. @p op must then be safe to call concurrently
 @note this is only instantiated for linear memory
 */
 template <class Memory1, class Memory2, class Op, typename = typename std::enable_if<IsMemoryLayoutLinear<Memory1>::value>::type>
-void iterate_memory_constmemory(Memory1& a1, const Memory2& a2, const Op& op)
+void iterate_memory_constmemory(Memory1& a1, const Memory2& a2, const Op& op, const Parallel& parallel = Parallel(1))
 {
    if (same_data_ordering_memory(a1, a2))
    {
-      impl::_iterate_memory_constmemory_same_ordering(a1, a2, op);
+      impl::_iterate_memory_constmemory_same_ordering(a1, a2, op, parallel);
    }
    else
    {
-      impl::_iterate_memory_constmemory_different_ordering(a1, a2, op);
+      using use_tiles = std::integral_constant<bool, std::is_pointer<typename Memory1::pointer_type>::value && std::is_pointer<typename Memory2::pointer_type>::value>;
+      impl::_iterate_memory_constmemory_different_ordering_tiled(a1, a2, op, parallel, use_tiles());
    }
 }
 
@@ -514,9 +897,9 @@ void iterate_memory_constmemory(Memory1& a1, const Memory2& a2, const Op& op)
 */
 template <class T, class T2, size_t N, class Config, class Config2, class Op,
           typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
-void iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op)
+void iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op, const Parallel& parallel = Parallel(1))
 {
-   iterate_memory_constmemory(a1.getMemory(), a2.getMemory(), op);
+   iterate_memory_constmemory(a1.getMemory(), a2.getMemory(), op, parallel);
 }
 
 /**
@@ -526,19 +909,19 @@ void iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Config
 */
 template <class T, class T2, size_t N, class Config, class Config2, class Op,
    typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
-   void iterate_constarray_constarray(const Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op)
+   void iterate_constarray_constarray(const Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op, const Parallel& parallel = Parallel(1))
 {
    iterate_memory_constmemory(
       const_cast<Array<T, N, Config>&>(a1).getMemory(), // const_cast to save implementation: we are not modifying it
-      a2.getMemory(), op);
+      a2.getMemory(), op, parallel);
 }
 
 namespace details
 {
 template <class T, class T2, size_t N, class Config, class Config2, class Op>
-void _iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op)
+void _iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op, const Parallel& parallel)
 {
-   iterate_memory_constmemory(a1.getMemory(), a2.getMemory(), op);
+   iterate_memory_constmemory(a1.getMemory(), a2.getMemory(), op, parallel);
 }
 }
 
@@ -548,21 +931,48 @@ void _iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Confi
 @note this is only instantiated for linear memory
 */
 template <class T, size_t N, class Config, class Op, typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
-void iterate_array(Array<T, N, Config>& a1, Op& op)
+void iterate_array(Array<T, N, Config>& a1, Op& op, const Parallel& parallel = Parallel(1))
 {
    using array_type   = Array<T, N, Config>;
    using pointer_type = typename array_type::pointer_type;
-   ArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1(a1, 0);
 
    static_assert(is_callable_with<Op, pointer_type, ui32, ui32>::value, "Op is not callable with the correct arguments!");
 
-   bool hasMoreElements = true;
-   while (hasMoreElements)
+   ArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1_all(a1, 0);
+   processor_a1_all.coalesceDimensions(processor_a1_all.getNbContiguousDimensions());
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      auto processor_a1 = processor_a1_all;
+      processor_a1.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         pointer_type ptr_a1(nullptr);
+         hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
+         op(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess());
+      }
+   };
+
+   // split the memory lines if there are fewer lines than threads
+   const ui32 nb_threads_max         = details::getNbThreads<pointer_type>(parallel, a1.size(), std::numeric_limits<ui32>::max());
+   const ui32 nb_elements_per_access = details::getNbElementsPerAccessParallel<pointer_type>(
+       nb_threads_max, processor_a1_all.getNbAccesses(), processor_a1_all.getNbElementsPerAccess());
+   processor_a1_all.setNbElementsPerAccess(nb_elements_per_access);
+
+   const ui32 nb_accesses = processor_a1_all.getNbAccesses();
+   const ui32 nb_threads  = std::min(nb_threads_max, nb_accesses);
+   if (nb_threads == 1)
    {
-      pointer_type ptr_a1(nullptr);
-      hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
-      op(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess());
+      const ui32 stride_a1 = processor_a1_all.stride();
+      const ui32 line_size = processor_a1_all.getIteratorShape()[0];
+      auto line            = [&](pointer_type ptr_a1) { op(ptr_a1, stride_a1, line_size); };
+      if (details::iterate_memory_lines_nested(processor_a1_all.getVaryingIndexOrder(), processor_a1_all.getIteratorShape(), line, a1.getMemory()))
+      {
+         return;
+      }
    }
+   details::parallel_accesses(nb_threads, nb_accesses, process);
 }
 
 /**
@@ -571,21 +981,140 @@ void iterate_array(Array<T, N, Config>& a1, Op& op)
 @note this is only instantiated for linear memory
 */
 template <class T, size_t N, class Config, class Op, typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
-void iterate_constarray(const Array<T, N, Config>& a1, Op& op)
+void iterate_constarray(const Array<T, N, Config>& a1, Op& op, const Parallel& parallel = Parallel(1))
 {
    using array_type         = Array<T, N, Config>;
+   using pointer_type       = typename array_type::pointer_type;
    using const_pointer_type = typename array_type::const_pointer_type;
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1(a1, 0);
 
    static_assert(is_callable_with<Op, const_pointer_type, ui32, ui32>::value, "Op is not callable with the correct arguments!");
 
-   bool hasMoreElements = true;
-   while (hasMoreElements)
+   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1_all(a1, 0);
+   processor_a1_all.coalesceDimensions(processor_a1_all.getNbContiguousDimensions());
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      auto processor_a1 = processor_a1_all;
+      processor_a1.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         const_pointer_type ptr_a1(nullptr);
+         hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
+         op(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess());
+      }
+   };
+
+   // split the memory lines if there are fewer lines than threads
+   const ui32 nb_threads_max         = details::getNbThreads<pointer_type>(parallel, a1.size(), std::numeric_limits<ui32>::max());
+   const ui32 nb_elements_per_access = details::getNbElementsPerAccessParallel<pointer_type>(
+       nb_threads_max, processor_a1_all.getNbAccesses(), processor_a1_all.getNbElementsPerAccess());
+   processor_a1_all.setNbElementsPerAccess(nb_elements_per_access);
+
+   const ui32 nb_accesses = processor_a1_all.getNbAccesses();
+   const ui32 nb_threads  = std::min(nb_threads_max, nb_accesses);
+   if (nb_threads == 1)
+   {
+      const ui32 stride_a1 = processor_a1_all.stride();
+      const ui32 line_size = processor_a1_all.getIteratorShape()[0];
+      auto line            = [&](const_pointer_type ptr_a1) { op(ptr_a1, stride_a1, line_size); };
+      if (details::iterate_memory_lines_nested(processor_a1_all.getVaryingIndexOrder(), processor_a1_all.getIteratorShape(), line, a1.getMemory()))
+      {
+         return;
+      }
+   }
+   details::parallel_accesses(nb_threads, nb_accesses, process);
+}
+
+/**
+@brief iterate array, memory line by memory line, with the index of the first element of each line
+@tparam must be callable using (pointer_type a1_pointer, ui32 a1_stride, ui32 nb_elements, const index_type& index, ui32 varying_index).
+        @p index is the index of a1_pointer in the array. The index of the element n of the line is @p index with n added to index[varying_index]
+@note the memory lines are not coalesced so that the index of the elements can be derived incrementally. The lines are visited in memory order
+@note this is only instantiated for linear memory
+*/
+template <class T, size_t N, class Config, class Op, typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_array_index(Array<T, N, Config>& a1, Op& op, const Parallel& parallel = Parallel(1))
+{
+   using array_type   = Array<T, N, Config>;
+   using pointer_type = typename array_type::pointer_type;
+   using index_type   = typename array_type::index_type;
+
+   static_assert(is_callable_with<Op, pointer_type, ui32, ui32, const index_type&, ui32>::value, "Op is not callable with the correct arguments!");
+
+   ArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1_all(a1, 0);
+   const ui32 varying_index = processor_a1_all.getVaryingIndex();
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      auto processor_a1 = processor_a1_all;
+      processor_a1.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         pointer_type ptr_a1(nullptr);
+         hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
+         op(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess(), processor_a1.getArrayIndex(), varying_index);
+      }
+   };
+
+   // split the memory lines if there are fewer lines than threads
+   const ui32 nb_threads_max   = details::getNbThreads<pointer_type>(parallel, a1.size(), std::numeric_limits<ui32>::max());
+   ui32 nb_elements_per_access = 1; // a slice dimension can't be accessed with a stride: access its elements one by one
+   if (processor_a1_all.stride() != 0)
+   {
+      nb_elements_per_access = details::getNbElementsPerAccessParallel<pointer_type>(
+          nb_threads_max, processor_a1_all.getNbAccesses(), processor_a1_all.getNbElementsPerAccess());
+   }
+   processor_a1_all.setNbElementsPerAccess(nb_elements_per_access);
+
+   const ui32 nb_accesses = processor_a1_all.getNbAccesses();
+   details::parallel_accesses(std::min(nb_threads_max, nb_accesses), nb_accesses, process);
+}
+
+/**
+@brief iterate const array, memory line by memory line, with the index of the first element of each line
+@tparam must be callable using (const_pointer_type a1_pointer, ui32 a1_stride, ui32 nb_elements, const index_type& index, ui32 varying_index)
+@see iterate_array_index
+*/
+template <class T, size_t N, class Config, class Op, typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+void iterate_constarray_index(const Array<T, N, Config>& a1, Op& op, const Parallel& parallel = Parallel(1))
+{
+   using array_type         = Array<T, N, Config>;
+   using pointer_type       = typename array_type::pointer_type;
+   using const_pointer_type = typename array_type::const_pointer_type;
+   using index_type         = typename array_type::index_type;
+
+   static_assert(is_callable_with<Op, const_pointer_type, ui32, ui32, const index_type&, ui32>::value, "Op is not callable with the correct arguments!");
+
+   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1_all(a1, 0);
+   const ui32 varying_index = processor_a1_all.getVaryingIndex();
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      auto processor_a1 = processor_a1_all;
+      processor_a1.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         const_pointer_type ptr_a1(nullptr);
+         hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
+         op(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess(), processor_a1.getArrayIndex(), varying_index);
+      }
+   };
+
+   // split the memory lines if there are fewer lines than threads
+   const ui32 nb_threads_max   = details::getNbThreads<pointer_type>(parallel, a1.size(), std::numeric_limits<ui32>::max());
+   ui32 nb_elements_per_access = 1; // a slice dimension can't be accessed with a stride: access its elements one by one
+   if (processor_a1_all.stride() != 0)
    {
-      const_pointer_type ptr_a1(nullptr);
-      hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
-      op(ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess());
+      nb_elements_per_access = details::getNbElementsPerAccessParallel<pointer_type>(
+          nb_threads_max, processor_a1_all.getNbAccesses(), processor_a1_all.getNbElementsPerAccess());
    }
+   processor_a1_all.setNbElementsPerAccess(nb_elements_per_access);
+
+   const ui32 nb_accesses = processor_a1_all.getNbAccesses();
+   details::parallel_accesses(std::min(nb_threads_max, nb_accesses), nb_accesses, process);
 }
 
 /**
@@ -593,7 +1122,8 @@ void iterate_constarray(const Array<T, N, Config>& a1, Op& op)
 */
 template <class T1, class T2, class T3, size_t N, class Config1, class Config2, class Config3, class Op,
           typename = typename std::enable_if<IsArrayLayoutLinear<Array<T1, N, Config1>>::value>::type>
-void iterate_array_constarray_constarray(Array<T1, N, Config1>& a1, const Array<T2, N, Config2>& a2, const Array<T3, N, Config3>& a3, Op& op)
+void iterate_array_constarray_constarray(Array<T1, N, Config1>& a1, const Array<T2, N, Config2>& a2, const Array<T3, N, Config3>& a3, Op& op,
+                                         const Parallel& parallel = Parallel(1))
 {
    ensure(a1.shape() == a2.shape(), "must have the same shape!");
    ensure(a1.shape() == a3.shape(), "must have the same shape!");
@@ -607,26 +1137,70 @@ void iterate_array_constarray_constarray(Array<T1, N, Config1>& a1, const Array<
    using pointer_type1       = typename array_type1::pointer_type;
    using const_pointer_type2 = typename array_type2::const_pointer_type;
    using const_pointer_type3 = typename array_type3::const_pointer_type;
-   ArrayProcessor_contiguous_byMemoryLocality<array_type1> processor_a1(a1, 0);
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_type2> processor_a2(a2, 0);
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_type3> processor_a3(a3, 0);
 
    static_assert(is_callable_with<Op, pointer_type1, ui32, const_pointer_type2, ui32, const_pointer_type3, ui32, ui32>::value,
                  "Op is not callable with the correct arguments!");
 
-   bool hasMoreElements = true;
-   while (hasMoreElements)
-   {
-      pointer_type1 ptr_a1(nullptr);
-      hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
+   ArrayProcessor_contiguous_byMemoryLocality<array_type1> processor_a1_all(a1, 0);
+   ConstArrayProcessor_contiguous_byMemoryLocality<array_type2> processor_a2_all(a2, 0);
+   ConstArrayProcessor_contiguous_byMemoryLocality<array_type3> processor_a3_all(a3, 0);
+
+   // the memory lines must be identical for all arrays
+   const ui32 nb_dimensions = std::min(std::min(processor_a1_all.getNbContiguousDimensions(), processor_a2_all.getNbContiguousDimensions()),
+                                       processor_a3_all.getNbContiguousDimensions());
+   processor_a1_all.coalesceDimensions(nb_dimensions);
+   processor_a2_all.coalesceDimensions(nb_dimensions);
+   processor_a3_all.coalesceDimensions(nb_dimensions);
+
+   auto process = [&](ui32 access_begin, ui32 access_end) {
+      auto processor_a1 = processor_a1_all;
+      auto processor_a2 = processor_a2_all;
+      auto processor_a3 = processor_a3_all;
+      processor_a1.restrictAccesses(access_begin, access_end);
+      processor_a2.restrictAccesses(access_begin, access_end);
+      processor_a3.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         pointer_type1 ptr_a1(nullptr);
+         hasMoreElements = processor_a1.accessMaxElements(ptr_a1);
 
-      const_pointer_type2 ptr_a2(nullptr);
-      processor_a2.accessMaxElements(ptr_a2);
+         const_pointer_type2 ptr_a2(nullptr);
+         processor_a2.accessMaxElements(ptr_a2);
 
-      const_pointer_type2 ptr_a3(nullptr);
-      processor_a3.accessMaxElements(ptr_a3);
+         const_pointer_type2 ptr_a3(nullptr);
+         processor_a3.accessMaxElements(ptr_a3);
 
-      op(ptr_a1, processor_a1.stride(), ptr_a2, processor_a2.stride(), ptr_a3, processor_a3.stride(), processor_a1.getNbElementsPerAccess());
+         op(ptr_a1, processor_a1.stride(), ptr_a2, processor_a2.stride(), ptr_a3, processor_a3.stride(), processor_a1.getNbElementsPerAccess());
+      }
+   };
+
+   // split the memory lines if there are fewer lines than threads
+   const ui32 nb_threads_max         = details::getNbThreads<pointer_type1>(parallel, a1.size(), std::numeric_limits<ui32>::max());
+   const ui32 nb_elements_per_access = details::getNbElementsPerAccessParallel<pointer_type1>(
+       nb_threads_max, processor_a1_all.getNbAccesses(), processor_a1_all.getNbElementsPerAccess());
+   processor_a1_all.setNbElementsPerAccess(nb_elements_per_access);
+   processor_a2_all.setNbElementsPerAccess(nb_elements_per_access);
+   processor_a3_all.setNbElementsPerAccess(nb_elements_per_access);
+
+   const ui32 nb_accesses = processor_a1_all.getNbAccesses();
+   const ui32 nb_threads  = std::min(nb_threads_max, nb_accesses);
+   if (nb_threads == 1)
+   {
+      const ui32 stride_a1 = processor_a1_all.stride();
+      const ui32 stride_a2 = processor_a2_all.stride();
+      const ui32 stride_a3 = processor_a3_all.stride();
+      const ui32 line_size = processor_a1_all.getIteratorShape()[0];
+      auto line            = [&](pointer_type1 ptr_a1, const_pointer_type2 ptr_a2, const_pointer_type3 ptr_a3) {
+         op(ptr_a1, stride_a1, ptr_a2, stride_a2, ptr_a3, stride_a3, line_size);
+      };
+      if (details::iterate_memory_lines_nested(processor_a1_all.getVaryingIndexOrder(), processor_a1_all.getIteratorShape(), line, a1.getMemory(),
+                                               a2.getMemory(), a3.getMemory()))
+      {
+         return;
+      }
    }
+   details::parallel_accesses(nb_threads, nb_accesses, process);
 }
 DECLARE_NAMESPACE_NLL_END
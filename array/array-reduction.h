@@ -0,0 +1,399 @@
+#pragma once
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @file
+
+ This file defines the traversal used by the reductions of an array (e.g., @ref sum, @ref min, @ref norm2sqr).
+
+ The memory lines of the array are split in blocks of at most @ref details::reduction_block_elements elements. Each block is
+ reduced independently, possibly in different threads, and the results of the blocks are then combined pairwise. Since the
+ blocks only depend on the geometry of the array, the result is identical whatever the number of threads (see
+ @ref set_parallel_reproducible). The pairwise combination of the blocks also bounds the growth of the rounding errors of the
+ floating point sums.
+ */
+
+/**
+ @brief The accumulation used by the floating point sums
+ */
+enum class Summation
+{
+   pairwise, /// independent accumulators combined pairwise
+   kahan     /// pairwise with Kahan's compensated summation. Slower but accurate to a few ULP whatever the number of elements
+};
+
+namespace details
+{
+/**
+ @brief Maximum number of elements of a block of a reduction. This must be a constant: it defines the order of the operations
+ */
+static const ui32 reduction_block_elements = 1 << 13;
+
+/**
+ @brief Merge a sequence of partial results pairwise, keeping a single partial result per level of the merge tree
+ */
+template <class Reducer>
+class PairwiseMerge
+{
+public:
+   using accumulator_type = typename Reducer::accumulator_type;
+
+   PairwiseMerge(const Reducer& reducer) : _reducer(reducer)
+   {
+   }
+
+   void add(accumulator_type partial)
+   {
+      size_t level = 0;
+      for (size_t count = _count; count & 1; count >>= 1, ++level)
+      {
+         _reducer.merge(_levels[level], partial);
+         partial = _levels[level];
+      }
+
+      if (level == _levels.size())
+      {
+         _levels.push_back(partial);
+      }
+      else
+      {
+         _levels[level] = partial;
+      }
+      ++_count;
+   }
+
+   accumulator_type result() const
+   {
+      accumulator_type result = _reducer.init();
+      for (size_t level = _levels.size(); level > 0; --level)
+      {
+         if ((_count >> (level - 1)) & 1)
+         {
+            _reducer.merge(result, _levels[level - 1]);
+         }
+      }
+      return result;
+   }
+
+private:
+   const Reducer& _reducer;
+   std::vector<accumulator_type> _levels;
+   size_t _count = 0;
+};
+
+/**
+ @brief Merge pairwise the partial results of consecutive blocks in block order
+ @return the merge of all the partial results. @p partials must not be empty
+ */
+template <class Reducer>
+typename Reducer::accumulator_type merge_blocks_pairwise(const Reducer& reducer, std::vector<typename Reducer::accumulator_type>& partials)
+{
+   for (size_t step = 1; step < partials.size(); step *= 2)
+   {
+      for (size_t block = 0; block + step < partials.size(); block += 2 * step)
+      {
+         reducer.merge(partials[block], partials[block + step]);
+      }
+   }
+   return partials[0];
+}
+
+/**
+ @brief Reduce the memory lines of an array with a reducer providing:
+ - accumulator_type: the partial result of the reduction
+ - accumulator_type init(): the neutral element
+ - void accumulate(accumulator_type& accum, const_pointer_type ptr, ui32 stride, ui32 nb_elements, size_t position): reduce a memory line in @p accum.
+   @p position is the position of the first element of the line in the traversal order, see @ref reduction_index
+ - void merge(accumulator_type& accum, const accumulator_type& other): merge the partial result @p other in @p accum
+
+ In reproducible mode (see @ref set_parallel_reproducible), the blocks of the array are reduced independently and merged pairwise. Else
+ each thread merges pairwise the blocks of its range and the results of the threads are merged.
+ */
+template <class T, size_t N, class Config, class Reducer, typename = typename std::enable_if<IsArrayLayoutLinear<Array<T, N, Config>>::value>::type>
+typename Reducer::accumulator_type reduce_constarray(const Array<T, N, Config>& a1, const Reducer& reducer, const Parallel& parallel = Parallel(1))
+{
+   using array_type         = Array<T, N, Config>;
+   using pointer_type       = typename array_type::pointer_type;
+   using const_pointer_type = typename array_type::const_pointer_type;
+   using accumulator_type   = typename Reducer::accumulator_type;
+
+   accumulator_type result = reducer.init();
+   if (a1.size() == 0)
+   {
+      return result;
+   }
+
+   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1_all(a1, 0);
+   processor_a1_all.coalesceDimensions(processor_a1_all.getNbContiguousDimensions());
+
+   // the memory lines are split in accesses of at most reduction_block_elements and the accesses grouped in blocks
+   const ui32 nb_elements_per_access = std::min(processor_a1_all.getNbElementsPerAccess(), reduction_block_elements);
+   processor_a1_all.setNbElementsPerAccess(nb_elements_per_access);
+   const ui32 nb_accesses           = processor_a1_all.getNbAccesses();
+   const ui32 nb_accesses_per_block = std::max<ui32>(1, reduction_block_elements / nb_elements_per_access);
+   const ui32 nb_blocks             = (nb_accesses + nb_accesses_per_block - 1) / nb_accesses_per_block;
+   const ui32 line_size             = processor_a1_all.getIteratorShape()[0];
+   const ui32 nb_accesses_per_line  = (line_size + nb_elements_per_access - 1) / nb_elements_per_access;
+
+   auto reduce_accesses = [&](ui32 access_begin, ui32 access_end, accumulator_type& accum) {
+      if (access_begin == access_end)
+      {
+         return;
+      }
+
+      auto processor_a1 = processor_a1_all;
+      processor_a1.restrictAccesses(access_begin, access_end);
+
+      bool hasMoreElements = true;
+      for (ui32 access = access_begin; hasMoreElements; ++access)
+      {
+         const_pointer_type ptr_a1(nullptr);
+         hasMoreElements       = processor_a1.accessMaxElements(ptr_a1);
+         const size_t position = static_cast<size_t>(access / nb_accesses_per_line) * line_size + (access % nb_accesses_per_line) * nb_elements_per_access;
+         reducer.accumulate(accum, ptr_a1, processor_a1.stride(), processor_a1.getNbElementsPerAccess(), position);
+      }
+   };
+
+   if (nb_blocks == 1)
+   {
+      reduce_accesses(0, nb_accesses, result);
+      return result;
+   }
+
+   const ui32 nb_threads = details::getNbThreads<pointer_type>(parallel, a1.size(), nb_blocks);
+   if (get_parallel_reproducible())
+   {
+      std::vector<accumulator_type> partials(nb_blocks, reducer.init());
+      auto process = [&](ui32 block_begin, ui32 block_end) {
+         for (ui32 block = block_begin; block < block_end; ++block)
+         {
+            const ui32 access_begin = block * nb_accesses_per_block;
+            reduce_accesses(access_begin, std::min(nb_accesses - access_begin, nb_accesses_per_block) + access_begin, partials[block]);
+         }
+      };
+      details::parallel_accesses(nb_threads, nb_blocks, process);
+      return merge_blocks_pairwise(reducer, partials);
+   }
+
+   std::vector<accumulator_type> partials(nb_threads, reducer.init());
+   auto process = [&](ui32 thread_begin, ui32 thread_end) {
+      for (ui32 thread = thread_begin; thread < thread_end; ++thread)
+      {
+         PairwiseMerge<Reducer> merge(reducer);
+         const ui32 block_begin = static_cast<ui32>(static_cast<size_t>(nb_blocks) * thread / nb_threads);
+         const ui32 block_end   = static_cast<ui32>(static_cast<size_t>(nb_blocks) * (thread + 1) / nb_threads);
+         for (ui32 block = block_begin; block < block_end; ++block)
+         {
+            accumulator_type accum  = reducer.init();
+            const ui32 access_begin = block * nb_accesses_per_block;
+            reduce_accesses(access_begin, std::min(nb_accesses - access_begin, nb_accesses_per_block) + access_begin, accum);
+            merge.add(accum);
+         }
+         partials[thread] = merge.result();
+      }
+   };
+   details::parallel_accesses(nb_threads, nb_threads, process);
+
+   for (const auto& partial : partials)
+   {
+      reducer.merge(result, partial);
+   }
+   return result;
+}
+
+template <class T, class Accum>
+struct ReducerSum
+{
+   using accumulator_type = Accum;
+
+   Accum init() const
+   {
+      return 0;
+   }
+
+   template <class Pointer>
+   void accumulate(Accum& accum, Pointer ptr, ui32 stride, ui32 nb_elements, size_t UNUSED(position)) const
+   {
+      accum += details::sum_naive<T, Accum>(ptr, stride, nb_elements);
+   }
+
+   void merge(Accum& accum, const Accum& other) const
+   {
+      accum += other;
+   }
+};
+
+template <class T, class Accum>
+struct ReducerSumKahan
+{
+   using accumulator_type = std::pair<Accum, Accum>; // sum and rounding error
+
+   accumulator_type init() const
+   {
+      return accumulator_type(0, 0);
+   }
+
+   template <class Pointer>
+   void accumulate(accumulator_type& accum, Pointer ptr, ui32 stride, ui32 nb_elements, size_t UNUSED(position)) const
+   {
+      Accum sum;
+      Accum error;
+      details::sum_kahan_naive<T, Accum>(ptr, stride, nb_elements, sum, error);
+      merge(accum, accumulator_type(sum, error));
+   }
+
+   void merge(accumulator_type& accum, const accumulator_type& other) const
+   {
+      details::sum_compensated_merge(accum.first, accum.second, other.first, other.second);
+   }
+};
+
+template <class T, class Accum>
+struct ReducerNorm2sqr : public ReducerSum<T, Accum>
+{
+   template <class Pointer>
+   void accumulate(Accum& accum, Pointer ptr, ui32 stride, ui32 nb_elements, size_t UNUSED(position)) const
+   {
+      accum += details::norm2_naive_sqr<T, Accum>(ptr, stride, nb_elements);
+   }
+};
+
+template <class T>
+struct ReducerMin
+{
+   using accumulator_type = T;
+
+   T init() const
+   {
+      return std::numeric_limits<T>::max();
+   }
+
+   template <class Pointer>
+   void accumulate(T& accum, Pointer ptr, ui32 stride, ui32 nb_elements, size_t UNUSED(position)) const
+   {
+      details::min_naive(ptr, stride, nb_elements, accum);
+   }
+
+   void merge(T& accum, const T& other) const
+   {
+      accum = std::min(accum, other);
+   }
+};
+
+template <class T>
+struct ReducerMax
+{
+   using accumulator_type = T;
+
+   T init() const
+   {
+      return std::numeric_limits<T>::lowest();
+   }
+
+   template <class Pointer>
+   void accumulate(T& accum, Pointer ptr, ui32 stride, ui32 nb_elements, size_t UNUSED(position)) const
+   {
+      details::max_naive(ptr, stride, nb_elements, accum);
+   }
+
+   void merge(T& accum, const T& other) const
+   {
+      accum = std::max(accum, other);
+   }
+};
+
+template <class T>
+struct ReducerMinMax
+{
+   using accumulator_type = std::pair<T, T>;
+
+   accumulator_type init() const
+   {
+      return accumulator_type(std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest());
+   }
+
+   template <class Pointer>
+   void accumulate(accumulator_type& accum, Pointer ptr, ui32 stride, ui32 nb_elements, size_t UNUSED(position)) const
+   {
+      details::minmax_naive(ptr, stride, nb_elements, accum.first, accum.second);
+   }
+
+   void merge(accumulator_type& accum, const accumulator_type& other) const
+   {
+      accum.first  = std::min(accum.first, other.first);
+      accum.second = std::max(accum.second, other.second);
+   }
+};
+
+/**
+ @brief First position of the min (Max = false) or max (Max = true) of the array, see @ref arg_naive
+ */
+template <class T, bool Max>
+struct ReducerArg
+{
+   using accumulator_type = std::pair<T, size_t>; // the value and its position in the traversal order
+
+   static size_t no_position()
+   {
+      return std::numeric_limits<size_t>::max();
+   }
+
+   accumulator_type init() const
+   {
+      return accumulator_type(T(), no_position());
+   }
+
+   template <class Pointer>
+   void accumulate(accumulator_type& accum, Pointer ptr, ui32 stride, ui32 nb_elements, size_t position) const
+   {
+      const auto line = arg_naive<Max>(ptr, stride, nb_elements);
+      merge(accum, accumulator_type(line.second, position + line.first));
+   }
+
+   void merge(accumulator_type& accum, const accumulator_type& other) const
+   {
+      if (other.second == no_position())
+      {
+         return;
+      }
+
+      // a NaN is only returned by a line of NaN and is replaced by any other value. The NaN are tested first: the
+      // comparisons are not reliable with NaN operands when built with -ffast-math
+      const bool accum_is_nan = is_nan(accum.first);
+      if (is_nan(other.first))
+      {
+         if (accum.second == no_position() || (accum_is_nan && accum.second > other.second))
+         {
+            accum = other;
+         }
+         return;
+      }
+
+      const bool is_better = Max ? other.first > accum.first : accum.first > other.first;
+      if (accum.second == no_position() || accum_is_nan || is_better || (other.first == accum.first && accum.second > other.second))
+      {
+         accum = other;
+      }
+   }
+};
+
+/**
+ @brief Return the index of the element at @p position in the traversal order of @ref reduce_constarray
+ */
+template <class T, size_t N, class Config>
+typename Array<T, N, Config>::index_type reduction_index(const Array<T, N, Config>& a1, size_t position)
+{
+   using array_type = Array<T, N, Config>;
+
+   ConstArrayProcessor_contiguous_byMemoryLocality<array_type> processor_a1(a1, 0);
+   processor_a1.coalesceDimensions(processor_a1.getNbContiguousDimensions());
+   processor_a1.setNbElementsPerAccess(1);
+
+   const ui32 access = static_cast<ui32>(position);
+   processor_a1.restrictAccesses(access, access + 1);
+   return processor_a1.getArrayIndex();
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
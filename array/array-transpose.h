@@ -41,32 +41,38 @@ Array<T, N, Config> transpose(const Array<T, N, Config>& m, const StaticVector<u
       return ir;
    };
 
-   const index_type new_shape = reorder(m.shape());
-   Array<T, N, Config> result(new_shape);
-   bool hasMoreElements = true;
-   ConstArrayProcessor_contiguous_byMemoryLocality<array_result> it_result(m, 0);
-   const auto varying_index = it_result.getVaryingIndex();
-   const auto dimension_to_copy = new_axis[varying_index];
-   while (hasMoreElements)
+   // the dimension n of the result is the dimension new_axis[n] of <m>
+   index_type new_axis_inv;
+   for (ui32 n = 0; n < N; ++n)
    {
-      // read a full memory line
-      const_pointer_type ptr(nullptr);
-      hasMoreElements = it_result.accessMaxElements(ptr);
-      const auto currentIndex = it_result.getArrayIndex();
+      new_axis_inv[new_axis[n]] = n;
+   }
 
-      // get the subarray's result for the corresponding line
-      index_type min_index = reorder(currentIndex);
-      index_type max_index = min_index;
-      min_index[dimension_to_copy] = 0;
-      max_index[dimension_to_copy] = m.shape()[varying_index] - 1;
-      auto sub = result(min_index, max_index);
+   const index_type new_shape = reorder(m.shape());
+   Array<T, N, Config> result(new_shape);
+   auto& result_memory        = result.getMemory();
+   const auto& result_strides = result_memory.getIndexMapper()._getPhysicalStrides();
 
-      // TODO only works for contiguous (not slice based arrays!)
-      const auto& stride_sub = sub.getMemory().getIndexMapper()._getPhysicalStrides();
-      auto stride = stride_sub[dimension_to_copy];
-      details::copy_naive(array_base_memory(sub), stride, ptr, 1, sub.size());
-   }
+   // read <m> memory line by memory line and write each line in the result
+   auto op = [&](const_pointer_type ptr, ui32 stride, ui32 nb_elements, const index_type& index, ui32 varying_index) {
+      const ui32 dimension_to_copy = new_axis_inv[varying_index];
+      const ui32 result_stride     = result_strides[dimension_to_copy];
+      index_type result_index      = reorder(index);
+      if (result_stride != 0 || nb_elements == 1)
+      {
+         details::copy_naive(result_memory.at(result_index), result_stride, ptr, stride, nb_elements);
+      }
+      else
+      {
+         // the line is along the slices of the result: each element is in a different slice
+         for (ui32 n = 0; n < nb_elements; ++n, ++result_index[dimension_to_copy])
+         {
+            details::copy_naive(result_memory.at(result_index), 1, ptr + n * stride, 1, 1);
+         }
+      }
+   };
 
+   iterate_constarray_index(m, op);
    return result;
 }
 
@@ -14,13 +14,16 @@ class ArrayRef;
 template <class A>
 class Expr;
 
+template <class Derived>
+class LazyExpression;
+
 template <class Array>
 class ArrayProcessor_contiguous_byDimension;
 
 namespace details
 {
 template <class T, class T2, size_t N, class Config, class Config2, class Op>
-void _iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op);
+void _iterate_array_constarray(Array<T, N, Config>& a1, const Array<T2, N, Config2>& a2, Op& op, const Parallel& parallel);
 
 template <class Array>
 class ArrayProcessor_contiguous_base;
@@ -30,8 +33,26 @@ void write(const Array<T, N, Config>& array, std::ostream& f);
 
 template <class T, size_t N, class Config>
 void read(Array<T, N, Config>& array, std::istream& f);
+
+template <class T, size_t N, class Config, class E>
+void lazy_evaluate(Array<T, N, Config>& output, const LazyExpression<E>& expression);
+
+template <class T, size_t N, class Config, class A>
+void expr_assign(Array<T, N, Config>& output, const Expr<A>& expression);
 }
 
+/**
+ @brief An array to be converted with a specific @ref Conversion when copied to an array of another type, see @ref saturated
+
+ Only holds a reference to the array: it must be used within the expression that created it
+ */
+template <class ArrayT>
+struct ArrayConversion
+{
+   const ArrayT& array;
+   Conversion conversion;
+};
+
 /**
  @brief Represents a multi-dimensional array with value based semantic
 
@@ -155,6 +176,37 @@ public:
       copy(array);
    }
 
+   /**
+    @brief Copy an array with a different type & configuration using a specific conversion
+
+    Array<ui8, 3> a = saturated(b);
+    */
+   template <class T2, class Config2>
+   Array(const ArrayConversion<Array<T2, N, Config2>>& converted) : Array(converted.array.shape())
+   {
+      copy(converted.array, converted.conversion);
+   }
+
+   /**
+    @brief Evaluate a lazy expression in a single pass, see @ref lazy
+
+    Array<float, 2> r = (lazy(a) - b) * 0.5f + c;
+    */
+   template <class E>
+   Array(const LazyExpression<E>& expression)
+   {
+      details::lazy_evaluate(*this, expression);
+   }
+
+   /**
+    @brief Evaluate an expression template with BLAS, see array-exp.h
+    */
+   template <class A>
+   Array(const Expr<A>& expression)
+   {
+      details::expr_assign(*this, expression);
+   }
+
    /**
     @brief construct an empty array
     */
@@ -202,6 +254,26 @@ public:
       return *this;
    }
 
+   /**
+    @brief Evaluate a lazy expression in a single pass. The expression may use this array, e.g., a = lazy(a) * 2 + b
+    */
+   template <class E>
+   Array& operator=(const LazyExpression<E>& expression)
+   {
+      details::lazy_evaluate(*this, expression);
+      return *this;
+   }
+
+   /**
+    @brief Evaluate an expression template with BLAS. The expression may use this array, e.g., c = alpha * a * b + beta * c is a single gemm
+    */
+   template <class A>
+   Array& operator=(const Expr<A>& expression)
+   {
+      details::expr_assign(*this, expression);
+      return *this;
+   }
+
    Array(Array&& other)
    {
       _move(std::forward<Array>(other));
@@ -596,7 +668,24 @@ public:
          details::static_cast_naive(a1_pointer, a1_stride, a2_pointer, a2_stride, nb_elements);
       };
 
-      _iterate_array_constarray(*this, array, op);
+      _iterate_array_constarray(*this, array, op, Parallel());
+   }
+
+   /**
+    @brief generic copy, converting each element, see @ref details::convert_value
+    */
+   template <class T2, class Config2>
+   void copy(const Array<T2, N, Config2>& array, Conversion conversion)
+   {
+      if (shape() != array.shape())
+      {
+         *this = Array(array.shape());
+      }
+
+      auto op = [&](pointer_type a1_pointer, ui32 a1_stride, typename Array<T2, N, Config2>::const_pointer_type a2_pointer, ui32 a2_stride,
+                    ui32 nb_elements) { details::convert_naive(a1_pointer, a1_stride, a2_pointer, a2_stride, nb_elements, conversion); };
+
+      _iterate_array_constarray(*this, array, op, Parallel());
    }
 
 protected:
@@ -739,7 +828,7 @@ public:
       auto op = [&](pointer_type y_pointer, ui32 y_stride, const_pointer_type x_pointer, ui32 x_stride, ui32 nb_elements) {
          details::copy_naive(y_pointer, y_stride, x_pointer, x_stride, nb_elements);
       };
-      iterate_array_constarray(*this, array, op);
+      iterate_array_constarray(*this, array, op, Parallel());
       return *this;
    }
    
@@ -760,10 +849,32 @@ public:
       return this->operator=(static_cast<const Base&>(array));
    }
 
+   /**
+    @brief Evaluate a lazy expression in the referenced array
+    */
+   template <class E>
+   ArrayRef& operator=(const LazyExpression<E>& expression)
+   {
+      ensure(expression.derived().shape() == this->shape(), "must have the same shape!");
+      details::lazy_evaluate(*this, expression);
+      return *this;
+   }
+
+   /**
+    @brief Evaluate an expression template in the referenced array
+    */
+   template <class A>
+   ArrayRef& operator=(const Expr<A>& expression)
+   {
+      ensure(expression.shape() == this->shape(), "must have the same shape!");
+      details::expr_assign(*this, expression);
+      return *this;
+   }
+
    ArrayRef& operator=(T value)
    {
       auto op = [&](pointer_type y_pointer, ui32 y_stride, ui32 nb_elements) { details::set_naive(y_pointer, y_stride, nb_elements, value); };
-      iterate_array(*this, op);
+      iterate_array(*this, op, Parallel());
       return *this;
    }
 
@@ -818,10 +929,17 @@ struct array_use_naive
    static const bool value = !array_use_vectorization<Array>::value && !array_use_blas<Array>::value;
 };
 
+/**
+@brief if value is false, the operators of the array build expression templates mapped to BLAS calls (see array-exp.h)
+instead of returning arrays (see array-noexp.h)
+
+Only the arrays using BLAS can use the expression templates, other arrays always use the naive operators
+*/
 #ifdef WITH_EXPRESSION_TEMPLATE
 template <class Array>
-struct array_use_naive_operator : public std::false_type
+struct array_use_naive_operator
 {
+   static const bool value = !array_use_blas<Array>::value;
 };
 #else
 template <class Array>
@@ -1018,4 +1136,18 @@ ArrayRef<T, N, Config> as_ref(Array<T, N, Config>& array)
    return ArrayRef<T, N, Config>(array);
 }
 
+namespace details
+{
+/**
+ @brief return true if the memory of a temporary array can be reused to store the result of an operation
+
+ A reference (e.g., a sub-array) doesn't own its memory: writing in it would modify the referenced array
+ */
+template <class T, size_t N, class Config>
+bool array_is_reusable(const Array<T, N, Config>& array)
+{
+   return array.getMemory().isDataAllocated();
+}
+}
+
 DECLARE_NAMESPACE_NLL_END
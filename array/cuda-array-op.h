@@ -47,6 +47,13 @@ Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> cos(const Array<T,
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+template <class T, size_t N, class Allocator>
+Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> cos(Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>&& array)
+{
+   void (*ptr)(cuda_ptr<T>, ui32, const cuda_ptr<T>, ui32, ui32) = &details::cos<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
 template <class T, size_t N, class Allocator>
 Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sin(const Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>& array)
 {
@@ -54,6 +61,13 @@ Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sin(const Array<T,
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+template <class T, size_t N, class Allocator>
+Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sin(Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>&& array)
+{
+   void (*ptr)(cuda_ptr<T>, ui32, const cuda_ptr<T>, ui32, ui32) = &details::sin<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
 template <class T, size_t N, class Allocator>
 Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> exp(const Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>& array)
 {
@@ -61,6 +75,13 @@ Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> exp(const Array<T,
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+template <class T, size_t N, class Allocator>
+Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> exp(Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>&& array)
+{
+   void (*ptr)(cuda_ptr<T>, ui32, const cuda_ptr<T>, ui32, ui32) = &details::exp<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
 template <class T, size_t N, class Allocator>
 Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> log(const Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>& array)
 {
@@ -68,6 +89,13 @@ Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> log(const Array<T,
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+template <class T, size_t N, class Allocator>
+Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> log(Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>&& array)
+{
+   void (*ptr)(cuda_ptr<T>, ui32, const cuda_ptr<T>, ui32, ui32) = &details::log<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
 template <class T, size_t N, class Allocator>
 Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sqr(const Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>& array)
 {
@@ -75,6 +103,13 @@ Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sqr(const Array<T,
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+template <class T, size_t N, class Allocator>
+Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sqr(Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>&& array)
+{
+   void (*ptr)(cuda_ptr<T>, ui32, const cuda_ptr<T>, ui32, ui32) = &details::sqr<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
 template <class T, size_t N, class Allocator>
 Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sqrt(const Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>& array)
 {
@@ -82,6 +117,13 @@ Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sqrt(const Array<T,
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+template <class T, size_t N, class Allocator>
+Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> sqrt(Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>&& array)
+{
+   void (*ptr)(cuda_ptr<T>, ui32, const cuda_ptr<T>, ui32, ui32) = &details::sqrt<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
 template <class T, size_t N, class Allocator>
 Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> abs(const Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>& array)
 {
@@ -89,6 +131,13 @@ Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> abs(const Array<T,
    return constarray_apply_function_strided_array(array, ptr);
 }
 
+template <class T, size_t N, class Allocator>
+Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>> abs(Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>&& array)
+{
+   void (*ptr)(cuda_ptr<T>, ui32, const cuda_ptr<T>, ui32, ui32) = &details::abs<T>;
+   return constarray_apply_function_strided_array(std::move(array), ptr);
+}
+
 template <class T, size_t N, class Allocator>
 T max(const Array<T, N, details::ArrayTraitsConfigCuda<T, N, Allocator>>& array)
 {
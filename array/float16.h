@@ -0,0 +1,371 @@
+#pragma once
+
+#include <array/config.h>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+/**
+ @file
+
+ 16-bit floating point element types: @ref float16 (IEEE 754 binary16) and @ref bfloat16 (the upper half of a float).
+
+ The values are only stored on 16 bits: the arithmetic is computed in float and the result is rounded to the
+ nearest representable value (ties to even) when it is stored back. The arrays of these types use the
+ vectorized conversions of @ref simd::convert and compute their elementwise arithmetic in float lanes.
+ */
+
+DECLARE_NAMESPACE_NLL
+
+namespace details
+{
+inline std::uint32_t float_to_bits(float value)
+{
+   std::uint32_t bits;
+   std::memcpy(&bits, &value, sizeof(bits));
+   return bits;
+}
+
+inline float bits_to_float(std::uint32_t bits)
+{
+   float value;
+   std::memcpy(&value, &bits, sizeof(value));
+   return value;
+}
+
+/**
+ @brief The binary16 encoding: 1 sign bit, 5 exponent bits, 10 mantissa bits
+
+ The conversions only use integer arithmetic so that they don't depend on the floating point environment
+ (e.g., flush to zero) and match the F16C instructions, including the NaN payloads.
+ */
+struct Binary16Format
+{
+   /// the bits of +infinity. The larger magnitudes are NaN
+   static const std::uint16_t infinity_bits = 0x7c00u;
+
+   static std::uint16_t fromFloat(float value)
+   {
+      const std::uint32_t bits      = float_to_bits(value);
+      const std::uint16_t sign      = static_cast<std::uint16_t>((bits >> 16) & 0x8000u);
+      const std::uint32_t magnitude = bits & 0x7fffffffu;
+      if (magnitude >= 0x7f800000u)
+      {
+         // infinity or NaN: the NaN are made quiet and keep the high bits of their payload
+         const std::uint32_t nan = magnitude > 0x7f800000u ? 0x0200u | ((magnitude >> 13) & 0x03ffu) : 0u;
+         return static_cast<std::uint16_t>(sign | 0x7c00u | nan);
+      }
+      if (magnitude >= 0x477ff000u)
+      {
+         // 65520 and above round to infinity
+         return static_cast<std::uint16_t>(sign | 0x7c00u);
+      }
+      if (magnitude >= 0x38800000u)
+      {
+         // normal: rebias the exponent and round the 13 dropped bits, a carry correctly increments the exponent
+         const std::uint32_t rebiased = magnitude - 0x38000000u;
+         return static_cast<std::uint16_t>(sign | ((rebiased + 0x0fffu + ((rebiased >> 13) & 1u)) >> 13));
+      }
+      if (magnitude <= 0x33000000u)
+      {
+         // at most half of the smallest denormal (2^-24)
+         return sign;
+      }
+
+      // denormal: the mantissa, with its implicit bit, in units of 2^-24
+      const std::uint32_t exponent  = magnitude >> 23;
+      const std::uint32_t mantissa  = (magnitude & 0x007fffffu) | 0x00800000u;
+      const std::uint32_t shift     = 126u - exponent;
+      const std::uint32_t truncated = mantissa >> shift;
+      const std::uint32_t remainder = mantissa & ((1u << shift) - 1u);
+      const std::uint32_t halfway   = 1u << (shift - 1u);
+      const std::uint32_t round_up  = remainder > halfway || (remainder == halfway && (truncated & 1u));
+      return static_cast<std::uint16_t>(sign | (truncated + round_up));
+   }
+
+   static float toFloat(std::uint16_t value)
+   {
+      const std::uint32_t sign     = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+      const std::uint32_t exponent = (value >> 10) & 0x1fu;
+      std::uint32_t mantissa       = value & 0x03ffu;
+      if (exponent == 0x1fu)
+      {
+         // infinity or NaN, the NaN are made quiet
+         return bits_to_float(sign | 0x7f800000u | (mantissa << 13) | (mantissa ? 0x00400000u : 0u));
+      }
+      if (exponent != 0)
+      {
+         return bits_to_float(sign | ((exponent + 112u) << 23) | (mantissa << 13));
+      }
+      if (mantissa == 0)
+      {
+         return bits_to_float(sign);
+      }
+
+      // denormal: normalize the mantissa
+      std::uint32_t float_exponent = 113;
+      while ((mantissa & 0x0400u) == 0)
+      {
+         mantissa <<= 1;
+         --float_exponent;
+      }
+      return bits_to_float(sign | (float_exponent << 23) | ((mantissa & 0x03ffu) << 13));
+   }
+};
+
+/**
+ @brief The bfloat16 encoding: the 16 high bits of a float (1 sign bit, 8 exponent bits, 7 mantissa bits)
+ */
+struct BFloat16Format
+{
+   /// the bits of +infinity. The larger magnitudes are NaN
+   static const std::uint16_t infinity_bits = 0x7f80u;
+
+   static std::uint16_t fromFloat(float value)
+   {
+      const std::uint32_t bits = float_to_bits(value);
+      if ((bits & 0x7fffffffu) > 0x7f800000u)
+      {
+         // NaN: made quiet, the payload is truncated
+         return static_cast<std::uint16_t>((bits | 0x00400000u) >> 16);
+      }
+      return static_cast<std::uint16_t>((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+   }
+
+   static float toFloat(std::uint16_t value)
+   {
+      return bits_to_float(static_cast<std::uint32_t>(value) << 16);
+   }
+};
+
+/**
+ @brief A 16-bit floating point value computed in float
+
+ The conversions from and to float are implicit so that the expressions mixing these types are evaluated in float:
+ @code
+ float16 a = 1.5f, b = 2;
+ float16 c = a * b + 1; // a * b + 1 is computed in float, then rounded to float16
+ a += b;                // a = float16(float(a) + float(b))
+ @endcode
+ */
+template <class Format>
+class Float16
+{
+public:
+   using format = Format;
+
+   /// uninitialized, unless value initialized (e.g., Float16()), which is +0
+   Float16() = default;
+
+   Float16(float value) : _bits(Format::fromFloat(value))
+   {
+   }
+
+   operator float() const
+   {
+      return Format::toFloat(_bits);
+   }
+
+   static Float16 fromBits(std::uint16_t bits)
+   {
+      Float16 value;
+      value._bits = bits;
+      return value;
+   }
+
+   std::uint16_t bits() const
+   {
+      return _bits;
+   }
+
+   Float16 operator-() const
+   {
+      return fromBits(static_cast<std::uint16_t>(_bits ^ 0x8000u));
+   }
+
+   Float16& operator+=(float value)
+   {
+      return *this = Float16(static_cast<float>(*this) + value);
+   }
+
+   Float16& operator-=(float value)
+   {
+      return *this = Float16(static_cast<float>(*this) - value);
+   }
+
+   Float16& operator*=(float value)
+   {
+      return *this = Float16(static_cast<float>(*this) * value);
+   }
+
+   Float16& operator/=(float value)
+   {
+      return *this = Float16(static_cast<float>(*this) / value);
+   }
+
+private:
+   std::uint16_t _bits;
+};
+
+/**
+ @brief true if @p value is a NaN, tested on the 16-bit pattern (std::isnan is folded with -ffast-math)
+ */
+template <class Format>
+bool is_nan(Float16<Format> value)
+{
+   return (value.bits() & 0x7fffu) > Format::infinity_bits;
+}
+
+/**
+ @brief true if @p value is +infinity or -infinity, tested on the 16-bit pattern
+ */
+template <class Format>
+bool is_inf(Float16<Format> value)
+{
+   return (value.bits() & 0x7fffu) == Format::infinity_bits;
+}
+}
+
+/**
+ @brief IEEE 754 half precision: 11 significant bits, normal range [6.1e-5, 65504]
+ */
+using float16 = details::Float16<details::Binary16Format>;
+
+/**
+ @brief bfloat16: 8 significant bits and the range of float
+ */
+using bfloat16 = details::Float16<details::BFloat16Format>;
+
+static_assert(sizeof(float16) == 2 && std::is_trivially_copyable<float16>::value, "float16 must be stored as its 16 bits");
+static_assert(sizeof(bfloat16) == 2 && std::is_trivially_copyable<bfloat16>::value, "bfloat16 must be stored as its 16 bits");
+
+/**
+ @brief True for the 16-bit floating point types stored in memory but computed in float
+ */
+template <class T>
+struct is_reduced_float : public std::false_type
+{
+};
+
+template <class Format>
+struct is_reduced_float<details::Float16<Format>> : public std::true_type
+{
+};
+
+DECLARE_NAMESPACE_NLL_END
+
+namespace std
+{
+template <>
+class numeric_limits<NAMESPACE_NLL::float16>
+{
+   using type = NAMESPACE_NLL::float16;
+
+public:
+   static const bool is_specialized    = true;
+   static const bool is_signed         = true;
+   static const bool is_integer        = false;
+   static const bool is_exact          = false;
+   static const bool has_infinity      = true;
+   static const bool has_quiet_NaN     = true;
+   static const bool has_signaling_NaN = true;
+   static const bool is_iec559         = true;
+   static const bool is_bounded        = true;
+   static const int digits             = 11;
+   static const int radix              = 2;
+   static const int min_exponent       = -13;
+   static const int max_exponent       = 16;
+
+   static type min()
+   {
+      return type::fromBits(0x0400);
+   }
+
+   static type lowest()
+   {
+      return type::fromBits(0xfbff);
+   }
+
+   static type max()
+   {
+      return type::fromBits(0x7bff);
+   }
+
+   static type epsilon()
+   {
+      return type::fromBits(0x1400);
+   }
+
+   static type infinity()
+   {
+      return type::fromBits(0x7c00);
+   }
+
+   static type quiet_NaN()
+   {
+      return type::fromBits(0x7e00);
+   }
+
+   static type denorm_min()
+   {
+      return type::fromBits(0x0001);
+   }
+};
+
+template <>
+class numeric_limits<NAMESPACE_NLL::bfloat16>
+{
+   using type = NAMESPACE_NLL::bfloat16;
+
+public:
+   static const bool is_specialized    = true;
+   static const bool is_signed         = true;
+   static const bool is_integer        = false;
+   static const bool is_exact          = false;
+   static const bool has_infinity      = true;
+   static const bool has_quiet_NaN     = true;
+   static const bool has_signaling_NaN = true;
+   static const bool is_iec559         = false;
+   static const bool is_bounded        = true;
+   static const int digits             = 8;
+   static const int radix              = 2;
+   static const int min_exponent       = -125;
+   static const int max_exponent       = 128;
+
+   static type min()
+   {
+      return type::fromBits(0x0080);
+   }
+
+   static type lowest()
+   {
+      return type::fromBits(0xff7f);
+   }
+
+   static type max()
+   {
+      return type::fromBits(0x7f7f);
+   }
+
+   static type epsilon()
+   {
+      return type::fromBits(0x3c00);
+   }
+
+   static type infinity()
+   {
+      return type::fromBits(0x7f80);
+   }
+
+   static type quiet_NaN()
+   {
+      return type::fromBits(0x7fc0);
+   }
+
+   static type denorm_min()
+   {
+      return type::fromBits(0x0001);
+   }
+};
+}
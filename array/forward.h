@@ -104,6 +104,8 @@ TODO nice to have functions:
 #include "wrapper-common.h"
 
 #include "traits.h"
+#include "float16.h"
+#include "op-naive-simd.h"
 #include "op-naive.h"
 #include "static-vector.h"
 #include "static-vector-math.h"
@@ -111,6 +113,7 @@ TODO nice to have functions:
 #include "cuda-utils.h"
 #include "cuda-kernel.cuh"
 #include "allocator-cuda.h"
+#include "array-parallel.h"
 #include "index-mapper.h"
 #include "allocator-static.h"
 #include "memory-contiguous.h"
@@ -122,6 +125,9 @@ TODO nice to have functions:
 #include "array-io.h"
 #include "array-chunking.h"
 #include "array-processor.h"
+#include "array-processor-multi.h"
+#include "array-iteration-plan.h"
+#include "array-reduction.h"
 #include "array-fill.h"
 #include "cuda-array-op.h"
 #include "array-op-impl-naive.h"
@@ -130,10 +136,12 @@ TODO nice to have functions:
 #include "array-op-impl-blas.h"
 #include "array-op.h"
 #include "array-op-logical.h"
+#include "array-bitmask.h"
 #include "array-op-axis.h"
 
 #include "array-exp.h"
 #include "array-noexp.h"
+#include "array-lazy.h"
 
 #include "matrix-op-impl-naive.h"
 #include "array-transpose.h"
@@ -157,3 +165,6 @@ TODO nice to have functions:
 #include "matrix-op-blas-cov.h"
 #include "matrix-op-blas-det.h"
 #include "matrix-op-trace.h"
+
+// deferred execution of the array operations
+#include "array-graph.h"
@@ -2,11 +2,38 @@
 
 DECLARE_NAMESPACE_NLL
 
+/**
+ @file
+
+ Read (gather) and write (scatter) the elements of an array at a list of positions.
+
+ @ref loopkup finds each element from its N-d index. For repeated or large lookups, convert the indexes once to memory
+ offsets with @ref memory_offsets: @ref gather, @ref scatter and @ref scatter_add then use the offsets directly, the
+ gathers of float and double using the gather instructions of AVX2 and AVX-512.
+
+ The offsets are relative to the first element of the array and take its physical strides into account: they are only
+ valid for this array or for arrays having the same memory layout. They require arrays based on a single slice of memory
+ (see @ref IsArrayLayoutContiguous): the slices of a multislice array are not at a fixed distance of each other, use
+ @ref loopkup for them.
+ */
+
+/**
+ @brief The strategy used by @ref scatter_add to accumulate the values in parallel
+ */
+enum class ScatterStrategy
+{
+   automatic,  /// partitioned if the result must be reproducible or if the destination elements receive many contributions, else atomic
+   atomic,     /// the values are split between threads and accumulated with atomic additions. The order of the additions is not defined
+   partitioned /// each thread owns a range of the destination and accumulates its values in order. The result doesn't depend on the number of threads
+};
+
 /**
 @brief Look up the array's element given a list of indexes
 
 array = [4, 3, 2, 5, 1]
 lookup(array, [1, 3]) = [3, 5]
+
+@see gather for the vectorized and parallel version using memory offsets
 */
 template <class T, size_t N, class Config>
 Array<T, 1, typename Config::template rebind_dim<1>::other> loopkup(const Array<T, N, Config>& array, const std::vector<StaticVector<ui32, N>>& indexes)
@@ -40,4 +67,283 @@ Array<T, 1, typename Config::template rebind_dim<1>::other> loopkup(const Array<
    return r;
 }
 
+namespace details
+{
+/**
+ @brief Number of memory elements spanned by the array: all its offsets are in [0, memory_span)
+ */
+template <class T, size_t N, class Config>
+size_t memory_span(const Array<T, N, Config>& array)
+{
+   const auto& strides = array.getMemory().getIndexMapper()._getPhysicalStrides();
+   size_t span         = 1;
+   for (size_t n = 0; n < N; ++n)
+   {
+      span += static_cast<size_t>(array.shape()[n] - 1) * strides[n];
+   }
+   return span;
+}
+
+/**
+ @brief Compute offsets[i] = memory offset of the i-th index, index(i, n) returning the coordinate n of the i-th index
+ */
+template <class T, size_t N, class Config, class IndexAt>
+std::vector<size_t> memory_offsets(const Array<T, N, Config>& array, size_t nb_indexes, IndexAt index, const Parallel& parallel)
+{
+   std::vector<size_t> offsets(nb_indexes);
+   const auto& strides = array.getMemory().getIndexMapper()._getPhysicalStrides();
+   auto convert        = [&](ui32, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i)
+      {
+         size_t offset = 0;
+         for (size_t n = 0; n < N; ++n)
+         {
+            const ui32 coordinate = index(i, n);
+            NLL_FAST_ASSERT(coordinate < array.shape()[n], "index out of bounds!");
+            offset += static_cast<size_t>(coordinate) * strides[n];
+         }
+         offsets[i] = offset;
+      }
+   };
+
+   const ui32 nb_threads = parallel.nbThreads(nb_indexes, std::numeric_limits<ui32>::max());
+   parallel_chunks(nb_threads, nb_indexes, convert);
+   return offsets;
+}
+
+template <class T>
+void scatter_add_atomic(T* base, const size_t* offsets, const T* values, ui32 values_stride, size_t begin, size_t end, std::true_type UNUSED(arithmetic))
+{
+   for (size_t i = begin; i < end; ++i)
+   {
+      T& destination = base[offsets[i]];
+      const T value  = values[i * values_stride];
+#ifdef WITH_OMP
+#pragma omp atomic
+#endif
+      destination += value;
+   }
+}
+
+template <class T>
+void scatter_add_atomic(T*, const size_t*, const T*, ui32, size_t, size_t, std::false_type UNUSED(arithmetic))
+{
+   ensure(0, "atomic additions are only supported for arithmetic types!");
+}
+
+/**
+ @brief Apply op(base[offsets[i]], values[i]) for all the values
+
+ With several threads, each thread owns a contiguous range of the memory of the destination and processes the values falling
+ in its range in order: the elements are updated in the same order as the serial loop, whatever the number of threads.
+ The values are first distributed to the ranges with a counting sort, so that each value is only read by its owner.
+ */
+template <class T, size_t N, class Config, class T2, class Config2, class Op>
+void scatter_partitioned(Array<T, N, Config>& array, const std::vector<size_t>& offsets, const Array<T2, 1, Config2>& values, Op op,
+                         ui32 nb_threads)
+{
+   static_assert(IsArrayLayoutContiguous<Array<T, N, Config>>::value, "the offsets are relative to a single slice of memory");
+   T* base                  = &array(StaticVector<ui32, N>());
+   const T2* values_ptr     = &values(vector1ui{0});
+   const ui32 values_stride = values.getMemory().getIndexMapper()._getPhysicalStrides()[0];
+   const size_t nb_values   = offsets.size();
+
+   if (nb_threads <= 1)
+   {
+      for (size_t i = 0; i < nb_values; ++i)
+      {
+         op(base[offsets[i]], values_ptr[i * values_stride]);
+      }
+      return;
+   }
+
+   // the chunk c of the values has counts[c * nb_threads + p] values in the range owned by the thread p
+   const size_t range_size = (memory_span(array) + nb_threads - 1) / nb_threads;
+   std::vector<size_t> counts(static_cast<size_t>(nb_threads) * nb_threads);
+   auto count = [&](ui32 chunk, size_t begin, size_t end) {
+      size_t* chunk_counts = counts.data() + static_cast<size_t>(chunk) * nb_threads;
+      for (size_t i = begin; i < end; ++i)
+      {
+         ++chunk_counts[offsets[i] / range_size];
+      }
+   };
+   parallel_chunks(nb_threads, nb_values, count);
+
+   // the bucket of a range lists the values of the chunks in order: counts becomes the position of the next value
+   std::vector<size_t> buckets(nb_threads + 1);
+   size_t position = 0;
+   for (ui32 range = 0; range < nb_threads; ++range)
+   {
+      buckets[range] = position;
+      for (ui32 chunk = 0; chunk < nb_threads; ++chunk)
+      {
+         const size_t nb = counts[static_cast<size_t>(chunk) * nb_threads + range];
+         counts[static_cast<size_t>(chunk) * nb_threads + range] = position;
+         position += nb;
+      }
+   }
+   buckets[nb_threads] = position;
+
+   std::vector<size_t> sorted(nb_values);
+   auto distribute = [&](ui32 chunk, size_t begin, size_t end) {
+      size_t* chunk_positions = counts.data() + static_cast<size_t>(chunk) * nb_threads;
+      for (size_t i = begin; i < end; ++i)
+      {
+         sorted[chunk_positions[offsets[i] / range_size]++] = i;
+      }
+   };
+   parallel_chunks(nb_threads, nb_values, distribute);
+
+   auto process = [&](ui32 range, size_t, size_t) {
+      for (size_t n = buckets[range]; n < buckets[range + 1]; ++n)
+      {
+         const size_t i = sorted[n];
+         op(base[offsets[i]], values_ptr[i * values_stride]);
+      }
+   };
+   parallel_chunks(nb_threads, nb_threads, process);
+}
+
+template <class T, size_t N, class Config>
+void check_offsets(const Array<T, N, Config>& array, const std::vector<size_t>& offsets)
+{
+#ifndef NDEBUG
+   const size_t span = array.size() ? memory_span(array) : 0;
+   for (auto offset : offsets)
+   {
+      NLL_FAST_ASSERT(offset < span, "offset out of bounds!");
+   }
+#else
+   (void)array;
+   (void)offsets;
+#endif
+}
+}
+
+/**
+ @brief Convert a list of indexes to memory offsets, relative to the element (0, ..., 0)
+
+ array(indexes[i]) is the element at &array(0, ..., 0) + offsets[i]
+ */
+template <class T, size_t N, class Config, typename = typename std::enable_if<IsArrayLayoutContiguous<Array<T, N, Config>>::value>::type>
+std::vector<size_t> memory_offsets(const Array<T, N, Config>& array, const std::vector<StaticVector<ui32, N>>& indexes,
+                                   const Parallel& parallel = Parallel())
+{
+   return details::memory_offsets(array, indexes.size(), [&](size_t i, size_t n) { return indexes[i][n]; }, parallel);
+}
+
+/**
+ @brief Convert a coordinate array per dimension (e.g., the result of @ref where_coordinates) to memory offsets, relative to
+        the element (0, ..., 0)
+ */
+template <class T, size_t N, class Config, typename = typename std::enable_if<IsArrayLayoutContiguous<Array<T, N, Config>>::value>::type>
+std::vector<size_t> memory_offsets(const Array<T, N, Config>& array, const std::array<std::vector<ui32>, N>& coordinates,
+                                   const Parallel& parallel = Parallel())
+{
+   for (size_t n = 1; n < N; ++n)
+   {
+      ensure(coordinates[n].size() == coordinates[0].size(), "the coordinates must have the same size!");
+   }
+   return details::memory_offsets(array, coordinates[0].size(), [&](size_t i, size_t n) { return coordinates[n][i]; }, parallel);
+}
+
+/**
+ @brief Return the elements at the given memory offsets (see @ref memory_offsets)
+
+ gather(array, memory_offsets(array, indexes)) == loopkup(array, indexes)
+ */
+template <class T, size_t N, class Config, typename = typename std::enable_if<IsArrayLayoutContiguous<Array<T, N, Config>>::value>::type>
+Array<T, 1, typename Config::template rebind_dim<1>::other> gather(const Array<T, N, Config>& array, const std::vector<size_t>& offsets,
+                                                                   const Parallel& parallel = Parallel())
+{
+   using result_type = Array<T, 1, typename Config::template rebind_dim<1>::other>;
+   using value_type  = typename std::remove_cv<T>::type;
+
+   result_type r(offsets.size());
+   if (offsets.empty())
+   {
+      return r;
+   }
+   details::check_offsets(array, offsets);
+
+   const value_type* base = &array(StaticVector<ui32, N>());
+   value_type* output     = &r(vector1ui{0});
+   auto process           = [&](ui32, size_t begin, size_t end) {
+      if (!details::simd::gather(output + begin, base, offsets.data() + begin, end - begin))
+      {
+         for (size_t i = begin; i < end; ++i)
+         {
+            output[i] = base[offsets[i]];
+         }
+      }
+   };
+
+   const ui32 nb_threads = parallel.nbThreads(offsets.size(), std::numeric_limits<ui32>::max());
+   details::parallel_chunks(nb_threads, offsets.size(), process);
+   return r;
+}
+
+/**
+ @brief Write values[i] at the memory offset offsets[i] of the array (see @ref memory_offsets)
+
+ If an offset is repeated, the last value is written, whatever the number of threads
+ */
+template <class T, size_t N, class Config, class T2, class Config2,
+          typename = typename std::enable_if<IsArrayLayoutContiguous<Array<T, N, Config>>::value>::type>
+void scatter(Array<T, N, Config>& array, const std::vector<size_t>& offsets, const Array<T2, 1, Config2>& values, const Parallel& parallel = Parallel())
+{
+   ensure(offsets.size() == values.size(), "must have a value per offset!");
+   if (offsets.empty())
+   {
+      return;
+   }
+   details::check_offsets(array, offsets);
+
+   const ui32 nb_threads = parallel.nbThreads(offsets.size(), std::numeric_limits<ui32>::max());
+   details::scatter_partitioned(array, offsets, values, [](T& destination, T value) { destination = value; }, nb_threads);
+}
+
+/**
+ @brief Add values[i] to the element at the memory offset offsets[i] of the array (see @ref memory_offsets). The offsets may be repeated.
+
+ With @ref ScatterStrategy::automatic, the values are accumulated with atomic additions if there are fewer values than
+ elements in the array (few collisions). Otherwise, or if the parallel results must be reproducible (see @ref set_parallel_reproducible)
+ for floating point values, the destination is partitioned between the threads.
+ */
+template <class T, size_t N, class Config, class T2, class Config2,
+          typename = typename std::enable_if<IsArrayLayoutContiguous<Array<T, N, Config>>::value>::type>
+void scatter_add(Array<T, N, Config>& array, const std::vector<size_t>& offsets, const Array<T2, 1, Config2>& values,
+                 const Parallel& parallel = Parallel(), ScatterStrategy strategy = ScatterStrategy::automatic)
+{
+   static_assert(std::is_same<typename std::remove_cv<T2>::type, T>::value, "must have the same type!");
+   ensure(offsets.size() == values.size(), "must have a value per offset!");
+   if (offsets.empty())
+   {
+      return;
+   }
+   details::check_offsets(array, offsets);
+
+   const ui32 nb_threads = parallel.nbThreads(offsets.size(), std::numeric_limits<ui32>::max());
+   if (strategy == ScatterStrategy::automatic)
+   {
+      const bool reproducible = std::is_floating_point<T>::value && get_parallel_reproducible();
+      const bool high_density = offsets.size() >= array.size();
+      strategy = (reproducible || high_density || !std::is_arithmetic<T>::value) ? ScatterStrategy::partitioned : ScatterStrategy::atomic;
+   }
+
+   if (strategy == ScatterStrategy::partitioned || nb_threads <= 1)
+   {
+      details::scatter_partitioned(array, offsets, values, [](T& destination, T value) { destination += value; }, nb_threads);
+      return;
+   }
+
+   T* base                  = &array(StaticVector<ui32, N>());
+   const T2* values_ptr     = &values(vector1ui{0});
+   const ui32 values_stride = values.getMemory().getIndexMapper()._getPhysicalStrides()[0];
+   auto process             = [&](ui32, size_t begin, size_t end) {
+      details::scatter_add_atomic<T>(base, offsets.data(), values_ptr, values_stride, begin, end, std::is_arithmetic<T>());
+   };
+   details::parallel_chunks(nb_threads, offsets.size(), process);
+}
+
 DECLARE_NAMESPACE_NLL_END
@@ -147,6 +147,30 @@ void gemm(T alpha, const Array<T, 2, Config>& opa, const Array<T, 2, Config2>& o
    gemm(false, false, alpha, opa, opb, beta, opc);
 }
 
+/**
+@brief Compute y = alpha * op(opa) * x + beta * y
+
+Only call this methods for BLAS supported types (float/double) with Matrix based arrays
+*/
+template <class T, class Config, class Config2, class Config3>
+void gemv(bool trans_a, T alpha, const Array<T, 2, Config>& opa, const Array<T, 1, Config2>& x, T beta, Array<T, 1, Config3>& y)
+{
+   const auto memory_order_a = getMatrixMemoryOrder(opa);
+   ensure(memory_order_a != CBLAS_ORDER::UnkwownMajor, "unkown memory order!");
+
+   // M and N are the number of rows and columns of opa, not op(opa)
+   const blas::BlasInt lda = leading_dimension<T, Config>(opa);
+   const auto m            = rows_nb(opa);
+   const auto n            = columns_nb(opa);
+   ensure(static_cast<blas::BlasInt>(x.size()) == (trans_a ? m : n), "x must have op(opa).columns() elements");
+   ensure(static_cast<blas::BlasInt>(y.size()) == (trans_a ? n : m), "y must have op(opa).rows() elements");
+
+   const blas::BlasInt incx = x.getMemory().getIndexMapper()._getPhysicalStrides()[0];
+   const blas::BlasInt incy = y.getMemory().getIndexMapper()._getPhysicalStrides()[0];
+   const auto trans_a_blas  = trans_a ? blas::CblasTrans : blas::CblasNoTrans;
+   blas::gemv<T>(memory_order_a, trans_a_blas, m, n, alpha, array_base_memory(opa), lda, array_base_memory(x), incx, beta, array_base_memory(y), incy);
+}
+
 template <class T, class Config, class Config2>
 Matrix_BlasEnabled<T, 2, Config> array_mul_array(const Array<T, 2, Config>& opa, const Array<T, 2, Config2>& opb)
 {
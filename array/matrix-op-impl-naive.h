@@ -6,8 +6,16 @@ DECLARE_NAMESPACE_NLL
 @brief Simplify the std::enable_if expression so that it is readable
 */
 template <class T, size_t N, class Config>
-using Matrix_NaiveEnabled =
-    typename std::enable_if<array_use_naive<Array<T, N, Config>>::value && is_matrix<Array<T, N, Config>>::value, Array<T, N, Config>>::type;
+using Matrix_NaiveEnabled = typename std::enable_if<array_use_naive<Array<T, N, Config>>::value && is_matrix<Array<T, N, Config>>::value &&
+                                                        !is_reduced_float<T>::value,
+                                                    Array<T, N, Config>>::type;
+
+/**
+@brief Matrix of 16-bit floating point values (@ref float16, @ref bfloat16), computed in float
+*/
+template <class T, size_t N, class Config>
+using Matrix_ReducedFloatEnabled =
+    typename std::enable_if<is_reduced_float<T>::value && is_matrix<Array<T, N, Config>>::value, Array<T, N, Config>>::type;
 
 template <class T, size_t N, class Config>
 using Matrix_Enabled = typename std::enable_if<is_matrix<Array<T, N, Config>>::value, Array<T, N, Config>>::type;
@@ -41,6 +49,88 @@ Matrix_NaiveEnabled<T, 2, Config> array_mul_array(const Array<T, 2, Config>& op1
    }
    return m;
 }
+
+/**
+   @brief Convert the elements (row, column) to (row, column + nb_elements - 1) of a matrix to float
+   */
+template <class T, class Config>
+void matrix_row_to_float(const Array<T, 2, Config>& m, size_t row, size_t column, size_t nb_elements, float* output)
+{
+   const size_t stride = m.getMemory().getIndexMapper()._getPhysicalStrides()[1];
+   convert_naive(output, 1, &m(row, column), stride, nb_elements, Conversion::cast);
+}
+
+/**
+   @brief Round float values to the elements (row, column) to (row, column + nb_elements - 1) of a matrix
+   */
+template <class T, class Config>
+void matrix_row_from_float(Array<T, 2, Config>& m, size_t row, size_t column, size_t nb_elements, const float* input)
+{
+   const size_t stride = m.getMemory().getIndexMapper()._getPhysicalStrides()[1];
+   convert_naive(&m(row, column), stride, input, 1, nb_elements, Conversion::cast);
+}
+
+/**
+   @brief Matrix * Matrix for the 16-bit floating point types
+
+   The operands are converted to float by blocks and the products are accumulated in float: the result is rounded
+   only once to T and the temporary memory is limited to a block of op2 and a block of columns of the result.
+   */
+template <class T, class Config, class Config2>
+Matrix_ReducedFloatEnabled<T, 2, Config> array_mul_array(const Array<T, 2, Config>& op1, const Array<T, 2, Config2>& op2)
+{
+   static const size_t block_inner   = 256;
+   static const size_t block_columns = 256;
+
+   const size_t nb_rows    = op1.shape()[0];
+   const size_t nb_inner   = op1.shape()[1];
+   const size_t nb_columns = op2.shape()[1];
+   ensure(op2.shape()[0] == nb_inner, "op1.columns() must be equal to op2.rows()");
+
+   Array<T, 2, Config> m({nb_rows, nb_columns});
+   std::vector<float> op2_block(block_inner * block_columns);
+   std::vector<float> result_block(nb_rows * block_columns);
+   for (size_t column_begin = 0; column_begin < nb_columns; column_begin += block_columns)
+   {
+      const size_t nb_block_columns = std::min(block_columns, nb_columns - column_begin);
+      std::fill(result_block.begin(), result_block.end(), 0.0f);
+      for (size_t inner_begin = 0; inner_begin < nb_inner; inner_begin += block_inner)
+      {
+         const size_t nb_block_inner = std::min(block_inner, nb_inner - inner_begin);
+         for (size_t n = 0; n < nb_block_inner; ++n)
+         {
+            matrix_row_to_float(op2, inner_begin + n, column_begin, nb_block_columns, op2_block.data() + n * nb_block_columns);
+         }
+
+         // the rows of the result are independent
+         auto multiply = [&](ui32, size_t row_begin, size_t row_end) {
+            float op1_row[block_inner];
+            for (size_t row = row_begin; row < row_end; ++row)
+            {
+               matrix_row_to_float(op1, row, inner_begin, nb_block_inner, op1_row);
+               float* result_row = result_block.data() + row * nb_block_columns;
+               for (size_t n = 0; n < nb_block_inner; ++n)
+               {
+                  const float value    = op1_row[n];
+                  const float* op2_row = op2_block.data() + n * nb_block_columns;
+                  for (size_t column = 0; column < nb_block_columns; ++column)
+                  {
+                     result_row[column] += value * op2_row[column];
+                  }
+               }
+            }
+         };
+         const ui32 nb_threads = Parallel().nbThreads(nb_rows * nb_block_inner * nb_block_columns, static_cast<ui32>(nb_rows));
+         parallel_chunks(nb_threads, nb_rows, multiply);
+      }
+
+      for (size_t row = 0; row < nb_rows; ++row)
+      {
+         matrix_row_from_float(m, row, column_begin, nb_block_columns, result_block.data() + row * nb_block_columns);
+      }
+   }
+   return m;
+}
 }
 
 DECLARE_NAMESPACE_NLL_END
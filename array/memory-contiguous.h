@@ -559,7 +559,7 @@ private:
             NLL_FAST_ASSERT(!std::is_const<value_type>::value, "type is CONST!");
             details::copy_naive(unconst_pointer(y_pointer), y_stride, x_pointer, x_stride, nb_elements);
          };
-         iterate_memory_constmemory(*this, other, op_cpy);
+         iterate_memory_constmemory(*this, other, op_cpy, Parallel());
       }
    }
 
@@ -672,6 +672,14 @@ public:
       return _allocator;
    }
 
+   /**
+   @brief return true if the data is allocated by this memory, false if it references existing data (e.g., a sub-array)
+   */
+   bool isDataAllocated() const
+   {
+      return _dataAllocated;
+   }
+
    size_t size() const
    {
       size_t s = 1;
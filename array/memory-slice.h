@@ -61,7 +61,7 @@ public:
       typedef typename Base::pointer pointer;
 
    public:
-      diterator_t() : _p(nullptr), _slices(nullptr)
+      diterator_t() : _slice(0), _offset(0), _stride(0), _slices(nullptr), _p(nullptr)
       {
       }
 
@@ -70,9 +70,10 @@ public:
          _p = slices[slice] + offset;
       }
 
-      diterator_t(const diterator_t<typename std::remove_const<TT>::type>& other) : diterator_t(other._slice, other._offset, other._stride, other._slices)
+      // the iterator may not point to a slice yet (e.g., processor not started), so the slices must not be dereferenced
+      diterator_t(const diterator_t<typename std::remove_const<TT>::type>& other)
+          : _slice(other._slice), _offset(other._offset), _stride(other._stride), _slices(const_cast<TT**>(other._slices)), _p(other._p)
       {
-         _p = other._p;
       }
 
       diterator_t& operator++()
@@ -225,6 +226,14 @@ public:
       return _allocator;
    }
 
+   /**
+   @brief return true if the slices are allocated by this memory, false if they reference existing data (e.g., a sub-array)
+   */
+   bool isDataAllocated() const
+   {
+      return _slicesAllocated;
+   }
+
    diterator beginDim(ui32 dim, const index_type& indexN)
    {
       return diterator(indexN[Z_INDEX], _indexMapper.offset(indexN), _indexMapper._getPhysicalStrides()[dim], &_slices[0]);
@@ -428,7 +437,7 @@ private:
             /// @TODO add the BLAS copy
             details::copy_naive(y_pointer, y_stride, x_pointer, x_stride, nb_elements);
          };
-         iterate_memory_constmemory(*this, other, op_cpy);
+         iterate_memory_constmemory(*this, other, op_cpy, Parallel());
       }
    }
 
@@ -0,0 +1,725 @@
+#include "op-naive-simd-kernels.h"
+
+// the AVX2 kernels also use the F16C conversions and the FMA instructions: all the AVX2 processors support them
+#if defined(__AVX2__) && ((defined(__F16C__) && defined(__FMA__)) || defined(_MSC_VER))
+#include <immintrin.h>
+#define NLL_SIMD_AVX2_ENABLED
+#endif
+
+DECLARE_NAMESPACE_NLL
+
+namespace details
+{
+namespace simd
+{
+namespace avx2
+{
+#ifdef NLL_SIMD_AVX2_ENABLED
+template <class T>
+struct Vec;
+
+template <>
+struct Vec<float>
+{
+   using value_type              = float;
+   using type                    = __m256;
+   using mask_type               = __m256i;
+   static const size_t width     = 8;
+   static const size_t alignment = 32;
+   static const bool masked      = true;
+
+   static type load(const float* p)
+   {
+      return _mm256_loadu_ps(p);
+   }
+   static void store(float* p, type v)
+   {
+      _mm256_storeu_ps(p, v);
+   }
+   static type gather(const float* base, const size_t* offsets)
+   {
+      // 64-bit offsets: 4 elements per instruction
+      const __m128 low  = _mm256_i64gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets)), 4);
+      const __m128 high = _mm256_i64gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + 4)), 4);
+      return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+   }
+   static mask_type mask(size_t nb_elements)
+   {
+      return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(nb_elements)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+   }
+   static type load_masked(const float* p, mask_type mask)
+   {
+      return _mm256_maskload_ps(p, mask);
+   }
+   static void store_masked(float* p, mask_type mask, type v)
+   {
+      _mm256_maskstore_ps(p, mask, v);
+   }
+   static type set1(float v)
+   {
+      return _mm256_set1_ps(v);
+   }
+   static type add(type a, type b)
+   {
+      return _mm256_add_ps(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm256_sub_ps(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm256_mul_ps(a, b);
+   }
+   static type div(type a, type b)
+   {
+      return _mm256_div_ps(a, b);
+   }
+   static type fma(type a, type b, type c)
+   {
+      return _mm256_fmadd_ps(a, b, c);
+   }
+   static type fms(type a, type b, type c)
+   {
+      return _mm256_fmsub_ps(a, b, c);
+   }
+   static type min(type a, type b)
+   {
+      return _mm256_min_ps(a, b);
+   }
+   static type max(type a, type b)
+   {
+      return _mm256_max_ps(a, b);
+   }
+
+   using compare_type = __m256;
+   static compare_type lt(type a, type b)
+   {
+      return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+   }
+   static compare_type gt(type a, type b)
+   {
+      return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+   }
+   static compare_type eq(type a, type b)
+   {
+      return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+   }
+   static compare_type is_nan(type a)
+   {
+      return _mm256_cmp_ps(a, a, _CMP_UNORD_Q);
+   }
+   static type select(compare_type c, type if_true, type if_false)
+   {
+      return _mm256_blendv_ps(if_false, if_true, c);
+   }
+   static bool any(compare_type c)
+   {
+      return _mm256_movemask_ps(c) != 0;
+   }
+   static std::uint64_t bits(compare_type c)
+   {
+      return static_cast<std::uint64_t>(_mm256_movemask_ps(c));
+   }
+
+   static type abs(type a)
+   {
+      return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);
+   }
+   static type sqrt(type a)
+   {
+      return _mm256_sqrt_ps(a);
+   }
+   static type round(type a)
+   {
+      return _mm256_cvtepi32_ps(_mm256_cvtps_epi32(a));
+   }
+   static type trunc(type a)
+   {
+      return _mm256_cvtepi32_ps(_mm256_cvttps_epi32(a));
+   }
+   static type pow2n(type n)
+   {
+      return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23));
+   }
+   static type frexp(type x, type& exponent)
+   {
+      const __m256i bits = _mm256_castps_si256(x);
+      exponent           = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(bits, 23)), _mm256_set1_ps(126.0f));
+      return _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x807fffff)), _mm256_set1_epi32(0x3f000000)));
+   }
+};
+
+template <>
+struct Vec<double>
+{
+   using value_type              = double;
+   using type                    = __m256d;
+   using mask_type               = __m256i;
+   static const size_t width     = 4;
+   static const size_t alignment = 32;
+   static const bool masked      = true;
+
+   static type load(const double* p)
+   {
+      return _mm256_loadu_pd(p);
+   }
+   static void store(double* p, type v)
+   {
+      _mm256_storeu_pd(p, v);
+   }
+   static type gather(const double* base, const size_t* offsets)
+   {
+      return _mm256_i64gather_pd(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets)), 8);
+   }
+   static mask_type mask(size_t nb_elements)
+   {
+      return _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(nb_elements)), _mm256_setr_epi64x(0, 1, 2, 3));
+   }
+   static type load_masked(const double* p, mask_type mask)
+   {
+      return _mm256_maskload_pd(p, mask);
+   }
+   static void store_masked(double* p, mask_type mask, type v)
+   {
+      _mm256_maskstore_pd(p, mask, v);
+   }
+   static type set1(double v)
+   {
+      return _mm256_set1_pd(v);
+   }
+   static type add(type a, type b)
+   {
+      return _mm256_add_pd(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm256_sub_pd(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm256_mul_pd(a, b);
+   }
+   static type div(type a, type b)
+   {
+      return _mm256_div_pd(a, b);
+   }
+   static type fma(type a, type b, type c)
+   {
+      return _mm256_fmadd_pd(a, b, c);
+   }
+   static type fms(type a, type b, type c)
+   {
+      return _mm256_fmsub_pd(a, b, c);
+   }
+   static type min(type a, type b)
+   {
+      return _mm256_min_pd(a, b);
+   }
+   static type max(type a, type b)
+   {
+      return _mm256_max_pd(a, b);
+   }
+
+   using compare_type = __m256d;
+   static compare_type lt(type a, type b)
+   {
+      return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+   }
+   static compare_type gt(type a, type b)
+   {
+      return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+   }
+   static compare_type eq(type a, type b)
+   {
+      return _mm256_cmp_pd(a, b, _CMP_EQ_OQ);
+   }
+   static compare_type is_nan(type a)
+   {
+      return _mm256_cmp_pd(a, a, _CMP_UNORD_Q);
+   }
+   static type select(compare_type c, type if_true, type if_false)
+   {
+      return _mm256_blendv_pd(if_false, if_true, c);
+   }
+   static bool any(compare_type c)
+   {
+      return _mm256_movemask_pd(c) != 0;
+   }
+   static std::uint64_t bits(compare_type c)
+   {
+      return static_cast<std::uint64_t>(_mm256_movemask_pd(c));
+   }
+
+   static type abs(type a)
+   {
+      return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+   }
+   static type sqrt(type a)
+   {
+      return _mm256_sqrt_pd(a);
+   }
+   static type round(type a)
+   {
+      return _mm256_cvtepi32_pd(_mm256_cvtpd_epi32(a));
+   }
+   static type trunc(type a)
+   {
+      return _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(a));
+   }
+   static type pow2n(type n)
+   {
+      const __m256i e = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)), _mm256_set1_epi64x(1023));
+      return _mm256_castsi256_pd(_mm256_slli_epi64(e, 52));
+   }
+   static type frexp(type x, type& exponent)
+   {
+      // the exponent bits are converted to double using the 2^52 magic number
+      const __m256i bits  = _mm256_castpd_si256(x);
+      const __m256i magic = _mm256_set1_epi64x(0x4330000000000000ll);
+      exponent = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(bits, 52), magic)), _mm256_set1_pd(4503599627370496.0 + 1022.0));
+      return _mm256_castsi256_pd(
+          _mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi64x(0x800fffffffffffffll)), _mm256_set1_epi64x(0x3fe0000000000000ll)));
+   }
+};
+
+/**
+ @brief Common to all integer vectors. Masked loads/stores are only available for 32 & 64-bit elements
+ */
+template <class T, size_t Width>
+struct VecInteger
+{
+   using value_type              = T;
+   using type                    = __m256i;
+   static const size_t width     = Width;
+   static const size_t alignment = 32;
+   static const bool masked      = false;
+
+   static type load(const T* p)
+   {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+   }
+   static void store(T* p, type v)
+   {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+   }
+   static type add_u64(type a, type b)
+   {
+      return _mm256_add_epi64(a, b);
+   }
+   static std::uint64_t reduce_u64(type a)
+   {
+      alignas(alignment) std::uint64_t lanes[4];
+      _mm256_store_si256(reinterpret_cast<type*>(lanes), a);
+      return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+   }
+};
+
+template <>
+struct Vec<std::uint32_t> : public VecInteger<std::uint32_t, 8>
+{
+   using mask_type          = __m256i;
+   static const bool masked = true;
+
+   static mask_type mask(size_t nb_elements)
+   {
+      return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(nb_elements)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+   }
+   static type load_masked(const std::uint32_t* p, mask_type mask)
+   {
+      return _mm256_maskload_epi32(reinterpret_cast<const int*>(p), mask);
+   }
+   static void store_masked(std::uint32_t* p, mask_type mask, type v)
+   {
+      _mm256_maskstore_epi32(reinterpret_cast<int*>(p), mask, v);
+   }
+   static type set1(std::uint32_t v)
+   {
+      return _mm256_set1_epi32(static_cast<int>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm256_add_epi32(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm256_sub_epi32(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm256_mullo_epi32(a, b);
+   }
+};
+
+template <>
+struct Vec<std::uint16_t> : public VecInteger<std::uint16_t, 16>
+{
+   static type set1(std::uint16_t v)
+   {
+      return _mm256_set1_epi16(static_cast<short>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm256_add_epi16(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm256_sub_epi16(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm256_mullo_epi16(a, b);
+   }
+   static type add_saturated(type a, type b)
+   {
+      return _mm256_adds_epu16(a, b);
+   }
+   static type add_saturated_signed(type a, type b)
+   {
+      return _mm256_adds_epi16(a, b);
+   }
+   static type sub_saturated(type a, type b)
+   {
+      return _mm256_subs_epu16(a, b);
+   }
+   static type sub_saturated_signed(type a, type b)
+   {
+      return _mm256_subs_epi16(a, b);
+   }
+   static type abs_diff(type a, type b)
+   {
+      return _mm256_or_si256(_mm256_subs_epu16(a, b), _mm256_subs_epu16(b, a));
+   }
+   static type abs_diff_signed(type a, type b)
+   {
+      // max - min is in [0, 65535]: saturated to the signed range
+      return _mm256_subs_epi16(_mm256_max_epi16(a, b), _mm256_min_epi16(a, b));
+   }
+   static type mul_high(type a, type b)
+   {
+      return _mm256_mulhi_epu16(a, b);
+   }
+   static type mul_high_signed(type a, type b)
+   {
+      return _mm256_mulhi_epi16(a, b);
+   }
+   static type flip_sign(type a)
+   {
+      return _mm256_xor_si256(a, _mm256_set1_epi16(static_cast<short>(0x8000)));
+   }
+   static type sum_u64(type a)
+   {
+      // zero extend to 32 then 64 bits: the order of the lanes doesn't matter for the sum
+      const __m256i zero  = _mm256_setzero_si256();
+      const __m256i sum32 = _mm256_add_epi32(_mm256_unpacklo_epi16(a, zero), _mm256_unpackhi_epi16(a, zero));
+      return _mm256_add_epi64(_mm256_unpacklo_epi32(sum32, zero), _mm256_unpackhi_epi32(sum32, zero));
+   }
+};
+
+template <>
+struct Vec<std::uint8_t> : public VecInteger<std::uint8_t, 32>
+{
+   static type set1(std::uint8_t v)
+   {
+      return _mm256_set1_epi8(static_cast<char>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm256_add_epi8(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm256_sub_epi8(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      // no 8-bit multiplication: multiply the even and odd bytes as 16-bit and merge the low bytes
+      const __m256i even = _mm256_mullo_epi16(a, b);
+      const __m256i odd  = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+      return _mm256_or_si256(_mm256_slli_epi16(odd, 8), _mm256_and_si256(even, _mm256_set1_epi16(0xff)));
+   }
+   static type add_saturated(type a, type b)
+   {
+      return _mm256_adds_epu8(a, b);
+   }
+   static type add_saturated_signed(type a, type b)
+   {
+      return _mm256_adds_epi8(a, b);
+   }
+   static type sub_saturated(type a, type b)
+   {
+      return _mm256_subs_epu8(a, b);
+   }
+   static type sub_saturated_signed(type a, type b)
+   {
+      return _mm256_subs_epi8(a, b);
+   }
+   static type abs_diff(type a, type b)
+   {
+      return _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+   }
+   static type abs_diff_signed(type a, type b)
+   {
+      return _mm256_subs_epi8(_mm256_max_epi8(a, b), _mm256_min_epi8(a, b));
+   }
+   static type mul_high(type a, type b)
+   {
+      // the 16-bit products of the even and odd bytes, their high bytes merged
+      const __m256i low_bytes = _mm256_set1_epi16(0xff);
+      const __m256i even      = _mm256_mullo_epi16(_mm256_and_si256(a, low_bytes), _mm256_and_si256(b, low_bytes));
+      const __m256i odd       = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+      return _mm256_or_si256(_mm256_srli_epi16(even, 8), _mm256_andnot_si256(low_bytes, odd));
+   }
+   static type mul_high_signed(type a, type b)
+   {
+      // same as mul_high with the bytes sign extended
+      const __m256i even = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_slli_epi16(a, 8), 8), _mm256_srai_epi16(_mm256_slli_epi16(b, 8), 8));
+      const __m256i odd  = _mm256_mullo_epi16(_mm256_srai_epi16(a, 8), _mm256_srai_epi16(b, 8));
+      return _mm256_or_si256(_mm256_srli_epi16(even, 8), _mm256_andnot_si256(_mm256_set1_epi16(0xff), odd));
+   }
+   static type flip_sign(type a)
+   {
+      return _mm256_xor_si256(a, _mm256_set1_epi8(static_cast<char>(0x80)));
+   }
+   static type sum_u64(type a)
+   {
+      return _mm256_sad_epu8(a, _mm256_setzero_si256());
+   }
+};
+
+/**
+ @brief The conversion traits: 8 elements in int32, float or double lanes
+ */
+struct Convert
+{
+   static const size_t width = 8;
+
+   using vi = __m256i;
+   using vf = __m256;
+
+   struct vd
+   {
+      __m256d low;
+      __m256d high;
+   };
+
+   static vi load(const std::int32_t* p)
+   {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+   }
+   static vi load(const std::int16_t* p)
+   {
+      return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+   }
+   static vi load(const std::uint16_t* p)
+   {
+      return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+   }
+   static vi load(const std::int8_t* p)
+   {
+      return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+   }
+   static vi load(const std::uint8_t* p)
+   {
+      return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+   }
+   static vf load(const float* p)
+   {
+      return _mm256_loadu_ps(p);
+   }
+   static vd load(const double* p)
+   {
+      return {_mm256_loadu_pd(p), _mm256_loadu_pd(p + 4)};
+   }
+   static vf load(const float16* p)
+   {
+      return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+   }
+   static vf load(const bfloat16* p)
+   {
+      return _mm256_castsi256_ps(_mm256_slli_epi32(load(reinterpret_cast<const std::uint16_t*>(p)), 16));
+   }
+
+   static void store(std::int32_t* p, vi v)
+   {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+   }
+   static void store(std::int16_t* p, vi v)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), low16(v));
+   }
+   static void store(std::uint16_t* p, vi v)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), low16(v));
+   }
+   static void store(std::int8_t* p, vi v)
+   {
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(p), low8(v));
+   }
+   static void store(std::uint8_t* p, vi v)
+   {
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(p), low8(v));
+   }
+   static void store(float* p, vf v)
+   {
+      _mm256_storeu_ps(p, v);
+   }
+   static void store(double* p, vd v)
+   {
+      _mm256_storeu_pd(p, v.low);
+      _mm256_storeu_pd(p + 4, v.high);
+   }
+   static void store(float16* p, vf v)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+   }
+   static void store(bfloat16* p, vf v)
+   {
+      // round the low 16 bits to nearest even, the NaN are made quiet instead
+      const __m256i bits    = _mm256_castps_si256(v);
+      const __m256i odd     = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+      const __m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(odd, _mm256_set1_epi32(0x7fff)));
+      const __m256i quiet   = _mm256_or_si256(bits, _mm256_set1_epi32(0x00400000));
+      const __m256i nan     = _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+      store(reinterpret_cast<std::uint16_t*>(p), _mm256_srli_epi32(_mm256_blendv_epi8(rounded, quiet, nan), 16));
+   }
+
+   static vf add(vf a, vf b)
+   {
+      return _mm256_add_ps(a, b);
+   }
+   static vf sub(vf a, vf b)
+   {
+      return _mm256_sub_ps(a, b);
+   }
+   static vf mul(vf a, vf b)
+   {
+      return _mm256_mul_ps(a, b);
+   }
+   static vf div(vf a, vf b)
+   {
+      return _mm256_div_ps(a, b);
+   }
+
+   static vf to_float(vi v)
+   {
+      return _mm256_cvtepi32_ps(v);
+   }
+   static vf to_float(vd v)
+   {
+      return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(v.low)), _mm256_cvtpd_ps(v.high), 1);
+   }
+   static vd to_double(vi v)
+   {
+      return {_mm256_cvtepi32_pd(_mm256_castsi256_si128(v)), _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1))};
+   }
+   static vd to_double(vf v)
+   {
+      return {_mm256_cvtps_pd(_mm256_castps256_ps128(v)), _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1))};
+   }
+   static vi to_int(vf v)
+   {
+      return _mm256_cvttps_epi32(v);
+   }
+   static vi to_int(vd v)
+   {
+      return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm256_cvttpd_epi32(v.low)), _mm256_cvttpd_epi32(v.high), 1);
+   }
+   static vi to_int_saturated(vf v)
+   {
+      // the out of range values are converted to INT_MIN: fix the positive ones
+      const vf no_nan   = zero_nan(v);
+      const __m256 over = _mm256_cmp_ps(no_nan, _mm256_set1_ps(2147483648.0f), _CMP_GE_OQ);
+      return _mm256_blendv_epi8(_mm256_cvttps_epi32(no_nan), _mm256_set1_epi32(0x7fffffff), _mm256_castps_si256(over));
+   }
+
+   static vf round(vf v)
+   {
+      const __m256 truncated = _mm256_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      const __m256 fraction  = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_sub_ps(v, truncated));
+      const __m256 one       = _mm256_or_ps(_mm256_and_ps(v, _mm256_set1_ps(-0.0f)), _mm256_set1_ps(1.0f));
+      const __m256 half_up   = _mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+      return _mm256_blendv_ps(truncated, _mm256_add_ps(truncated, one), half_up);
+   }
+   static vd round(vd v)
+   {
+      return {round(v.low), round(v.high)};
+   }
+
+   static vi clamp(vi v, int lo, int hi)
+   {
+      return _mm256_min_epi32(_mm256_max_epi32(v, _mm256_set1_epi32(lo)), _mm256_set1_epi32(hi));
+   }
+   static vf clamp(vf v, float lo, float hi)
+   {
+      // min & max return their second operand if one is NaN
+      return _mm256_max_ps(_mm256_set1_ps(lo), _mm256_min_ps(_mm256_set1_ps(hi), v));
+   }
+   static vd clamp(vd v, double lo, double hi)
+   {
+      return {clamp(v.low, lo, hi), clamp(v.high, lo, hi)};
+   }
+
+   static vf zero_nan(vf v)
+   {
+      return _mm256_and_ps(v, _mm256_cmp_ps(v, v, _CMP_ORD_Q));
+   }
+   static vd zero_nan(vd v)
+   {
+      return {zero_nan(v.low), zero_nan(v.high)};
+   }
+
+private:
+   static __m256d round(__m256d v)
+   {
+      const __m256d truncated = _mm256_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      const __m256d fraction  = _mm256_andnot_pd(_mm256_set1_pd(-0.0), _mm256_sub_pd(v, truncated));
+      const __m256d one       = _mm256_or_pd(_mm256_and_pd(v, _mm256_set1_pd(-0.0)), _mm256_set1_pd(1.0));
+      const __m256d half_up   = _mm256_cmp_pd(fraction, _mm256_set1_pd(0.5), _CMP_GE_OQ);
+      return _mm256_blendv_pd(truncated, _mm256_add_pd(truncated, one), half_up);
+   }
+   static __m256d clamp(__m256d v, double lo, double hi)
+   {
+      return _mm256_max_pd(_mm256_set1_pd(lo), _mm256_min_pd(_mm256_set1_pd(hi), v));
+   }
+   static __m256d zero_nan(__m256d v)
+   {
+      return _mm256_and_pd(v, _mm256_cmp_pd(v, v, _CMP_ORD_Q));
+   }
+
+   // the low 16 bits of the int32 lanes: pack each 128-bit lane, then the two lanes
+   static __m128i low16(vi v)
+   {
+      const __m256i shuffle = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1,
+                                               -1, -1, -1, -1, -1);
+      return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, shuffle), 0x08));
+   }
+
+   // the low 8 bits of the int32 lanes, in the low 64 bits
+   static __m128i low8(vi v)
+   {
+      const __m256i shuffle = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1, -1,
+                                               -1, -1, -1, -1, -1, -1, -1);
+      return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, shuffle), _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0)));
+   }
+};
+
+bool registerKernels(KernelTables& kernels)
+{
+   register_kernels<Vec>(kernels);
+   register_conversions<Convert>(std::get<ConversionKernels>(kernels));
+   register_reduced_float<Convert>(std::get<Kernels<float16>>(kernels));
+   register_reduced_float<Convert>(std::get<Kernels<bfloat16>>(kernels));
+   return true;
+}
+#else
+bool registerKernels(KernelTables&)
+{
+   return false;
+}
+#endif
+}
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
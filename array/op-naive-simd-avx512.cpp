@@ -0,0 +1,738 @@
+#include "op-naive-simd-kernels.h"
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+#include <immintrin.h>
+#define NLL_SIMD_AVX512_ENABLED
+#endif
+
+DECLARE_NAMESPACE_NLL
+
+namespace details
+{
+namespace simd
+{
+namespace avx512
+{
+#ifdef NLL_SIMD_AVX512_ENABLED
+template <class T>
+struct Vec;
+
+template <>
+struct Vec<float>
+{
+   using value_type              = float;
+   using type                    = __m512;
+   using mask_type               = __mmask16;
+   static const size_t width     = 16;
+   static const size_t alignment = 64;
+   static const bool masked      = true;
+
+   static type load(const float* p)
+   {
+      return _mm512_loadu_ps(p);
+   }
+   static void store(float* p, type v)
+   {
+      _mm512_storeu_ps(p, v);
+   }
+   static type gather(const float* base, const size_t* offsets)
+   {
+      // 64-bit offsets: 8 elements per instruction
+      const __m256 low  = _mm512_i64gather_ps(_mm512_loadu_si512(offsets), base, 4);
+      const __m256 high = _mm512_i64gather_ps(_mm512_loadu_si512(offsets + 8), base, 4);
+      return _mm512_castpd_ps(_mm512_insertf64x4(_mm512_castps_pd(_mm512_castps256_ps512(low)), _mm256_castps_pd(high), 1));
+   }
+   static mask_type mask(size_t nb_elements)
+   {
+      return static_cast<mask_type>((1u << nb_elements) - 1);
+   }
+   static type load_masked(const float* p, mask_type mask)
+   {
+      return _mm512_maskz_loadu_ps(mask, p);
+   }
+   static void store_masked(float* p, mask_type mask, type v)
+   {
+      _mm512_mask_storeu_ps(p, mask, v);
+   }
+   static type set1(float v)
+   {
+      return _mm512_set1_ps(v);
+   }
+   static type add(type a, type b)
+   {
+      return _mm512_add_ps(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm512_sub_ps(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm512_mul_ps(a, b);
+   }
+   static type div(type a, type b)
+   {
+      return _mm512_div_ps(a, b);
+   }
+   static type fma(type a, type b, type c)
+   {
+      return _mm512_fmadd_ps(a, b, c);
+   }
+   static type fms(type a, type b, type c)
+   {
+      return _mm512_fmsub_ps(a, b, c);
+   }
+   static type min(type a, type b)
+   {
+      return _mm512_min_ps(a, b);
+   }
+   static type max(type a, type b)
+   {
+      return _mm512_max_ps(a, b);
+   }
+
+   using compare_type = __mmask16;
+   static compare_type lt(type a, type b)
+   {
+      return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+   }
+   static compare_type gt(type a, type b)
+   {
+      return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+   }
+   static compare_type eq(type a, type b)
+   {
+      return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+   }
+   static compare_type is_nan(type a)
+   {
+      return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q);
+   }
+   static type select(compare_type c, type if_true, type if_false)
+   {
+      return _mm512_mask_blend_ps(c, if_false, if_true);
+   }
+   static bool any(compare_type c)
+   {
+      return c != 0;
+   }
+   static std::uint64_t bits(compare_type c)
+   {
+      return static_cast<std::uint64_t>(c);
+   }
+
+   static type abs(type a)
+   {
+      return _mm512_abs_ps(a);
+   }
+   static type sqrt(type a)
+   {
+      return _mm512_sqrt_ps(a);
+   }
+   static type round(type a)
+   {
+      return _mm512_cvtepi32_ps(_mm512_cvtps_epi32(a));
+   }
+   static type trunc(type a)
+   {
+      return _mm512_cvtepi32_ps(_mm512_cvttps_epi32(a));
+   }
+   static type pow2n(type n)
+   {
+      return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(n), _mm512_set1_epi32(127)), 23));
+   }
+   static type frexp(type x, type& exponent)
+   {
+      const __m512i bits = _mm512_castps_si512(x);
+      exponent           = _mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(bits, 23)), _mm512_set1_ps(126.0f));
+      return _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi32(0x807fffff)), _mm512_set1_epi32(0x3f000000)));
+   }
+};
+
+template <>
+struct Vec<double>
+{
+   using value_type              = double;
+   using type                    = __m512d;
+   using mask_type               = __mmask8;
+   static const size_t width     = 8;
+   static const size_t alignment = 64;
+   static const bool masked      = true;
+
+   static type load(const double* p)
+   {
+      return _mm512_loadu_pd(p);
+   }
+   static void store(double* p, type v)
+   {
+      _mm512_storeu_pd(p, v);
+   }
+   static type gather(const double* base, const size_t* offsets)
+   {
+      return _mm512_i64gather_pd(_mm512_loadu_si512(offsets), base, 8);
+   }
+   static mask_type mask(size_t nb_elements)
+   {
+      return static_cast<mask_type>((1u << nb_elements) - 1);
+   }
+   static type load_masked(const double* p, mask_type mask)
+   {
+      return _mm512_maskz_loadu_pd(mask, p);
+   }
+   static void store_masked(double* p, mask_type mask, type v)
+   {
+      _mm512_mask_storeu_pd(p, mask, v);
+   }
+   static type set1(double v)
+   {
+      return _mm512_set1_pd(v);
+   }
+   static type add(type a, type b)
+   {
+      return _mm512_add_pd(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm512_sub_pd(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm512_mul_pd(a, b);
+   }
+   static type div(type a, type b)
+   {
+      return _mm512_div_pd(a, b);
+   }
+   static type fma(type a, type b, type c)
+   {
+      return _mm512_fmadd_pd(a, b, c);
+   }
+   static type fms(type a, type b, type c)
+   {
+      return _mm512_fmsub_pd(a, b, c);
+   }
+   static type min(type a, type b)
+   {
+      return _mm512_min_pd(a, b);
+   }
+   static type max(type a, type b)
+   {
+      return _mm512_max_pd(a, b);
+   }
+
+   using compare_type = __mmask8;
+   static compare_type lt(type a, type b)
+   {
+      return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+   }
+   static compare_type gt(type a, type b)
+   {
+      return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+   }
+   static compare_type eq(type a, type b)
+   {
+      return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+   }
+   static compare_type is_nan(type a)
+   {
+      return _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q);
+   }
+   static type select(compare_type c, type if_true, type if_false)
+   {
+      return _mm512_mask_blend_pd(c, if_false, if_true);
+   }
+   static bool any(compare_type c)
+   {
+      return c != 0;
+   }
+   static std::uint64_t bits(compare_type c)
+   {
+      return static_cast<std::uint64_t>(c);
+   }
+
+   static type abs(type a)
+   {
+      return _mm512_abs_pd(a);
+   }
+   static type sqrt(type a)
+   {
+      return _mm512_sqrt_pd(a);
+   }
+   static type round(type a)
+   {
+      return _mm512_cvtepi32_pd(_mm512_cvtpd_epi32(a));
+   }
+   static type trunc(type a)
+   {
+      return _mm512_cvtepi32_pd(_mm512_cvttpd_epi32(a));
+   }
+   static type pow2n(type n)
+   {
+      const __m512i e = _mm512_add_epi64(_mm512_cvtepi32_epi64(_mm512_cvtpd_epi32(n)), _mm512_set1_epi64(1023));
+      return _mm512_castsi512_pd(_mm512_slli_epi64(e, 52));
+   }
+   static type frexp(type x, type& exponent)
+   {
+      // the exponent bits are converted to double using the 2^52 magic number
+      const __m512i bits  = _mm512_castpd_si512(x);
+      const __m512i magic = _mm512_set1_epi64(0x4330000000000000ll);
+      exponent = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(bits, 52), magic)), _mm512_set1_pd(4503599627370496.0 + 1022.0));
+      return _mm512_castsi512_pd(
+          _mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi64(0x800fffffffffffffll)), _mm512_set1_epi64(0x3fe0000000000000ll)));
+   }
+};
+
+/**
+ @brief Common to all integer vectors
+ */
+template <class T, size_t Width>
+struct VecInteger
+{
+   using value_type              = T;
+   using type                    = __m512i;
+   static const size_t width     = Width;
+   static const size_t alignment = 64;
+   static const bool masked      = true;
+
+   static type load(const T* p)
+   {
+      return _mm512_loadu_si512(p);
+   }
+   static void store(T* p, type v)
+   {
+      _mm512_storeu_si512(p, v);
+   }
+   static type add_u64(type a, type b)
+   {
+      return _mm512_add_epi64(a, b);
+   }
+   static std::uint64_t reduce_u64(type a)
+   {
+      return static_cast<std::uint64_t>(_mm512_reduce_add_epi64(a));
+   }
+};
+
+template <>
+struct Vec<std::uint32_t> : public VecInteger<std::uint32_t, 16>
+{
+   using mask_type = __mmask16;
+
+   static mask_type mask(size_t nb_elements)
+   {
+      return static_cast<mask_type>((1u << nb_elements) - 1);
+   }
+   static type load_masked(const std::uint32_t* p, mask_type mask)
+   {
+      return _mm512_maskz_loadu_epi32(mask, p);
+   }
+   static void store_masked(std::uint32_t* p, mask_type mask, type v)
+   {
+      _mm512_mask_storeu_epi32(p, mask, v);
+   }
+   static type set1(std::uint32_t v)
+   {
+      return _mm512_set1_epi32(static_cast<int>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm512_add_epi32(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm512_sub_epi32(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm512_mullo_epi32(a, b);
+   }
+};
+
+template <>
+struct Vec<std::uint16_t> : public VecInteger<std::uint16_t, 32>
+{
+   using mask_type = __mmask32;
+
+   static mask_type mask(size_t nb_elements)
+   {
+      return static_cast<mask_type>((1u << nb_elements) - 1);
+   }
+   static type load_masked(const std::uint16_t* p, mask_type mask)
+   {
+      return _mm512_maskz_loadu_epi16(mask, p);
+   }
+   static void store_masked(std::uint16_t* p, mask_type mask, type v)
+   {
+      _mm512_mask_storeu_epi16(p, mask, v);
+   }
+   static type set1(std::uint16_t v)
+   {
+      return _mm512_set1_epi16(static_cast<short>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm512_add_epi16(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm512_sub_epi16(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm512_mullo_epi16(a, b);
+   }
+   static type add_saturated(type a, type b)
+   {
+      return _mm512_adds_epu16(a, b);
+   }
+   static type add_saturated_signed(type a, type b)
+   {
+      return _mm512_adds_epi16(a, b);
+   }
+   static type sub_saturated(type a, type b)
+   {
+      return _mm512_subs_epu16(a, b);
+   }
+   static type sub_saturated_signed(type a, type b)
+   {
+      return _mm512_subs_epi16(a, b);
+   }
+   static type abs_diff(type a, type b)
+   {
+      return _mm512_or_si512(_mm512_subs_epu16(a, b), _mm512_subs_epu16(b, a));
+   }
+   static type abs_diff_signed(type a, type b)
+   {
+      // max - min is in [0, 65535]: saturated to the signed range
+      return _mm512_subs_epi16(_mm512_max_epi16(a, b), _mm512_min_epi16(a, b));
+   }
+   static type mul_high(type a, type b)
+   {
+      return _mm512_mulhi_epu16(a, b);
+   }
+   static type mul_high_signed(type a, type b)
+   {
+      return _mm512_mulhi_epi16(a, b);
+   }
+   static type flip_sign(type a)
+   {
+      return _mm512_xor_si512(a, _mm512_set1_epi16(static_cast<short>(0x8000)));
+   }
+   static type sum_u64(type a)
+   {
+      // zero extend to 32 then 64 bits: the order of the lanes doesn't matter for the sum
+      const __m512i zero  = _mm512_setzero_si512();
+      const __m512i sum32 = _mm512_add_epi32(_mm512_unpacklo_epi16(a, zero), _mm512_unpackhi_epi16(a, zero));
+      return _mm512_add_epi64(_mm512_unpacklo_epi32(sum32, zero), _mm512_unpackhi_epi32(sum32, zero));
+   }
+};
+
+template <>
+struct Vec<std::uint8_t> : public VecInteger<std::uint8_t, 64>
+{
+   using mask_type = __mmask64;
+
+   static mask_type mask(size_t nb_elements)
+   {
+      return static_cast<mask_type>((1ull << nb_elements) - 1);
+   }
+   static type load_masked(const std::uint8_t* p, mask_type mask)
+   {
+      return _mm512_maskz_loadu_epi8(mask, p);
+   }
+   static void store_masked(std::uint8_t* p, mask_type mask, type v)
+   {
+      _mm512_mask_storeu_epi8(p, mask, v);
+   }
+   static type set1(std::uint8_t v)
+   {
+      return _mm512_set1_epi8(static_cast<char>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm512_add_epi8(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm512_sub_epi8(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      // no 8-bit multiplication: multiply the even and odd bytes as 16-bit and merge the low bytes
+      const __m512i even = _mm512_mullo_epi16(a, b);
+      const __m512i odd  = _mm512_mullo_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8));
+      return _mm512_or_si512(_mm512_slli_epi16(odd, 8), _mm512_and_si512(even, _mm512_set1_epi16(0xff)));
+   }
+   static type add_saturated(type a, type b)
+   {
+      return _mm512_adds_epu8(a, b);
+   }
+   static type add_saturated_signed(type a, type b)
+   {
+      return _mm512_adds_epi8(a, b);
+   }
+   static type sub_saturated(type a, type b)
+   {
+      return _mm512_subs_epu8(a, b);
+   }
+   static type sub_saturated_signed(type a, type b)
+   {
+      return _mm512_subs_epi8(a, b);
+   }
+   static type abs_diff(type a, type b)
+   {
+      return _mm512_or_si512(_mm512_subs_epu8(a, b), _mm512_subs_epu8(b, a));
+   }
+   static type abs_diff_signed(type a, type b)
+   {
+      return _mm512_subs_epi8(_mm512_max_epi8(a, b), _mm512_min_epi8(a, b));
+   }
+   static type mul_high(type a, type b)
+   {
+      // the 16-bit products of the even and odd bytes, their high bytes merged
+      const __m512i low_bytes = _mm512_set1_epi16(0xff);
+      const __m512i even      = _mm512_mullo_epi16(_mm512_and_si512(a, low_bytes), _mm512_and_si512(b, low_bytes));
+      const __m512i odd       = _mm512_mullo_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8));
+      return _mm512_or_si512(_mm512_srli_epi16(even, 8), _mm512_andnot_si512(low_bytes, odd));
+   }
+   static type mul_high_signed(type a, type b)
+   {
+      // same as mul_high with the bytes sign extended
+      const __m512i even = _mm512_mullo_epi16(_mm512_srai_epi16(_mm512_slli_epi16(a, 8), 8), _mm512_srai_epi16(_mm512_slli_epi16(b, 8), 8));
+      const __m512i odd  = _mm512_mullo_epi16(_mm512_srai_epi16(a, 8), _mm512_srai_epi16(b, 8));
+      return _mm512_or_si512(_mm512_srli_epi16(even, 8), _mm512_andnot_si512(_mm512_set1_epi16(0xff), odd));
+   }
+   static type flip_sign(type a)
+   {
+      return _mm512_xor_si512(a, _mm512_set1_epi8(static_cast<char>(0x80)));
+   }
+   static type sum_u64(type a)
+   {
+      return _mm512_sad_epu8(a, _mm512_setzero_si512());
+   }
+};
+
+/**
+ @brief The conversion traits: 16 elements in int32, float or double lanes
+ */
+struct Convert
+{
+   static const size_t width = 16;
+
+   using vi = __m512i;
+   using vf = __m512;
+
+   struct vd
+   {
+      __m512d low;
+      __m512d high;
+   };
+
+   static vi load(const std::int32_t* p)
+   {
+      return _mm512_loadu_si512(p);
+   }
+   static vi load(const std::int16_t* p)
+   {
+      return _mm512_cvtepi16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+   }
+   static vi load(const std::uint16_t* p)
+   {
+      return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+   }
+   static vi load(const std::int8_t* p)
+   {
+      return _mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+   }
+   static vi load(const std::uint8_t* p)
+   {
+      return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+   }
+   static vf load(const float* p)
+   {
+      return _mm512_loadu_ps(p);
+   }
+   static vd load(const double* p)
+   {
+      return {_mm512_loadu_pd(p), _mm512_loadu_pd(p + 8)};
+   }
+   static vf load(const float16* p)
+   {
+      return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+   }
+   static vf load(const bfloat16* p)
+   {
+      return _mm512_castsi512_ps(_mm512_slli_epi32(load(reinterpret_cast<const std::uint16_t*>(p)), 16));
+   }
+
+   // the narrowing stores keep the low bits of the int32 lanes
+   static void store(std::int32_t* p, vi v)
+   {
+      _mm512_storeu_si512(p, v);
+   }
+   static void store(std::int16_t* p, vi v)
+   {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtepi32_epi16(v));
+   }
+   static void store(std::uint16_t* p, vi v)
+   {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtepi32_epi16(v));
+   }
+   static void store(std::int8_t* p, vi v)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm512_cvtepi32_epi8(v));
+   }
+   static void store(std::uint8_t* p, vi v)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm512_cvtepi32_epi8(v));
+   }
+   static void store(float* p, vf v)
+   {
+      _mm512_storeu_ps(p, v);
+   }
+   static void store(double* p, vd v)
+   {
+      _mm512_storeu_pd(p, v.low);
+      _mm512_storeu_pd(p + 8, v.high);
+   }
+   static void store(float16* p, vf v)
+   {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+   }
+   static void store(bfloat16* p, vf v)
+   {
+      // round the low 16 bits to nearest even, the NaN are made quiet instead
+      const __m512i bits    = _mm512_castps_si512(v);
+      const __m512i odd     = _mm512_and_si512(_mm512_srli_epi32(bits, 16), _mm512_set1_epi32(1));
+      const __m512i rounded = _mm512_add_epi32(bits, _mm512_add_epi32(odd, _mm512_set1_epi32(0x7fff)));
+      const __mmask16 nan   = _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q);
+      const __m512i result  = _mm512_mask_or_epi32(rounded, nan, bits, _mm512_set1_epi32(0x00400000));
+      store(reinterpret_cast<std::uint16_t*>(p), _mm512_srli_epi32(result, 16));
+   }
+
+   static vf add(vf a, vf b)
+   {
+      return _mm512_add_ps(a, b);
+   }
+   static vf sub(vf a, vf b)
+   {
+      return _mm512_sub_ps(a, b);
+   }
+   static vf mul(vf a, vf b)
+   {
+      return _mm512_mul_ps(a, b);
+   }
+   static vf div(vf a, vf b)
+   {
+      return _mm512_div_ps(a, b);
+   }
+
+   static vf to_float(vi v)
+   {
+      return _mm512_cvtepi32_ps(v);
+   }
+   static vf to_float(vd v)
+   {
+      const __m512d low = _mm512_castps_pd(_mm512_castps256_ps512(_mm512_cvtpd_ps(v.low)));
+      return _mm512_castpd_ps(_mm512_insertf64x4(low, _mm256_castps_pd(_mm512_cvtpd_ps(v.high)), 1));
+   }
+   static vd to_double(vi v)
+   {
+      return {_mm512_cvtepi32_pd(_mm512_castsi512_si256(v)), _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(v, 1))};
+   }
+   static vd to_double(vf v)
+   {
+      const __m256 high = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1));
+      return {_mm512_cvtps_pd(_mm512_castps512_ps256(v)), _mm512_cvtps_pd(high)};
+   }
+   static vi to_int(vf v)
+   {
+      return _mm512_cvttps_epi32(v);
+   }
+   static vi to_int(vd v)
+   {
+      return _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvttpd_epi32(v.low)), _mm512_cvttpd_epi32(v.high), 1);
+   }
+   static vi to_int_saturated(vf v)
+   {
+      // the out of range values are converted to INT_MIN: fix the positive ones
+      const vf no_nan      = zero_nan(v);
+      const __mmask16 over = _mm512_cmp_ps_mask(no_nan, _mm512_set1_ps(2147483648.0f), _CMP_GE_OQ);
+      return _mm512_mask_mov_epi32(_mm512_cvttps_epi32(no_nan), over, _mm512_set1_epi32(0x7fffffff));
+   }
+
+   static vf round(vf v)
+   {
+      const __m512 truncated  = _mm512_roundscale_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      const __m512 fraction   = _mm512_abs_ps(_mm512_sub_ps(v, truncated));
+      const __m512i sign      = _mm512_and_si512(_mm512_castps_si512(v), _mm512_set1_epi32(static_cast<int>(0x80000000)));
+      const __m512 one        = _mm512_castsi512_ps(_mm512_or_si512(sign, _mm512_castps_si512(_mm512_set1_ps(1.0f))));
+      const __mmask16 half_up = _mm512_cmp_ps_mask(fraction, _mm512_set1_ps(0.5f), _CMP_GE_OQ);
+      return _mm512_mask_add_ps(truncated, half_up, truncated, one);
+   }
+   static vd round(vd v)
+   {
+      return {round(v.low), round(v.high)};
+   }
+
+   static vi clamp(vi v, int lo, int hi)
+   {
+      return _mm512_min_epi32(_mm512_max_epi32(v, _mm512_set1_epi32(lo)), _mm512_set1_epi32(hi));
+   }
+   static vf clamp(vf v, float lo, float hi)
+   {
+      // min & max return their second operand if one is NaN
+      return _mm512_max_ps(_mm512_set1_ps(lo), _mm512_min_ps(_mm512_set1_ps(hi), v));
+   }
+   static vd clamp(vd v, double lo, double hi)
+   {
+      return {clamp(v.low, lo, hi), clamp(v.high, lo, hi)};
+   }
+
+   static vf zero_nan(vf v)
+   {
+      return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(v, v, _CMP_ORD_Q), v);
+   }
+   static vd zero_nan(vd v)
+   {
+      return {zero_nan(v.low), zero_nan(v.high)};
+   }
+
+private:
+   static __m512d round(__m512d v)
+   {
+      const __m512d truncated = _mm512_roundscale_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+      const __m512d fraction  = _mm512_abs_pd(_mm512_sub_pd(v, truncated));
+      const __m512i sign      = _mm512_and_si512(_mm512_castpd_si512(v), _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull)));
+      const __m512d one       = _mm512_castsi512_pd(_mm512_or_si512(sign, _mm512_castpd_si512(_mm512_set1_pd(1.0))));
+      const __mmask8 half_up  = _mm512_cmp_pd_mask(fraction, _mm512_set1_pd(0.5), _CMP_GE_OQ);
+      return _mm512_mask_add_pd(truncated, half_up, truncated, one);
+   }
+   static __m512d clamp(__m512d v, double lo, double hi)
+   {
+      return _mm512_max_pd(_mm512_set1_pd(lo), _mm512_min_pd(_mm512_set1_pd(hi), v));
+   }
+   static __m512d zero_nan(__m512d v)
+   {
+      return _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(v, v, _CMP_ORD_Q), v);
+   }
+};
+
+bool registerKernels(KernelTables& kernels)
+{
+   register_kernels<Vec>(kernels);
+   register_conversions<Convert>(std::get<ConversionKernels>(kernels));
+   register_reduced_float<Convert>(std::get<Kernels<float16>>(kernels));
+   register_reduced_float<Convert>(std::get<Kernels<bfloat16>>(kernels));
+   return true;
+}
+#else
+bool registerKernels(KernelTables&)
+{
+   return false;
+}
+#endif
+}
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
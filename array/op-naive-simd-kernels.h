@@ -0,0 +1,1969 @@
+#pragma once
+
+#include "op-naive-simd.h"
+#include <cfloat>
+#include <math.h>
+
+/**
+ @file
+
+ Generic implementation of the SIMD kernels. This file must only be included by the instruction set specific
+ translation units (op-naive-simd-*.cpp), each of them providing a vector traits class V with:
+ - value_type: the scalar type
+ - type: the vector type
+ - width: the number of elements of a vector
+ - alignment: the preferred alignment of the vector memory accesses in bytes
+ - masked: true if the traits supports masked loads/stores (mask_type, mask(nb_elements), load_masked, store_masked)
+ - load, store (unaligned), set1 and the arithmetic operations add, sub, mul, div when supported
+ - gather(base, offsets): the elements base[offsets[n]], if the instruction set has gather instructions
+ - fma(a, b, c) and fms(a, b, c): a * b + c and a * b - c with a single rounding, if the instruction set has FMA instructions
+   (only for the floating point traits: the integer fused kernels use mul and add)
+
+ The 8 and 16-bit integer traits also provide the primitives of the saturated arithmetic (@ref KernelSaturated), the "_signed"
+ versions interpreting the elements as signed integers:
+ - add_saturated, sub_saturated, abs_diff (|a - b|, saturated), mul_high (high half of the product, see @ref SaturatedArithmetic)
+ - flip_sign(a): a xor the sign bit, the signed elements mapped to the unsigned range in the same order
+ - sum_u64(a): the partial sums of the unsigned elements in 64-bit lanes, add_u64 and reduce_u64 (sum of the 64-bit lanes)
+
+ The floating point traits also provide the primitives of the elementwise functions (@ref VectorMath):
+ - abs, sqrt, round (to nearest), trunc: round & trunc are only valid in the int32 range
+ - pow2n(n): 2^n for integral n in the normal exponent range
+ - frexp(x, exponent): mantissa in [0.5, 1) and exponent of a positive normal x
+ - compare_type, lt, gt, eq, is_nan, select(compare, if_true, if_false) and any(compare)
+ - bits(compare): the comparison packed in the low bits of an integer, bit n being the lane n
+ - min(a, b) and max(a, b): return b if a or b is NaN (the semantics of the x86 instructions)
+
+ The conversion kernels (@ref KernelConvert) use a separate traits class C processing C::width elements of any type in
+ int32 lanes (C::vi, for all the integer types), float lanes (C::vf) or double lanes (C::vd):
+ - load(const T*) and store(T*, lanes) for the types of @ref conversion_types. The integers are sign or zero extended to
+   int32 and the narrowing stores keep the low bits of the int32 lanes
+ - to_float, to_double and to_int (truncation toward zero, INT_MIN if out of range) between the lanes
+ - round(vf | vd): nearest integer, halfway cases away from zero
+ - clamp(lanes, lo, hi): keep NaN for vf & vd, zero_nan(vf | vd) and to_int_saturated(vf): the float to int32 saturation
+ - load & store of the 16-bit floating point types from and to float lanes (rounded to nearest, ties to even) and
+   add, sub, mul, div of float lanes, used by the arithmetic of these types (@ref KernelReducedFloat)
+
+ The traits classes must be defined in a namespace specific to the instruction set so that the kernels
+ of the different instruction sets are different template instantiations. For the same reason, the kernels
+ only call the C library and no inline function shared with the other translation units.
+ */
+
+DECLARE_NAMESPACE_NLL
+
+namespace details
+{
+namespace simd
+{
+/**
+ @brief Process the end of the memory line that doesn't fill a vector with scalar code
+ */
+template <class V, bool Masked = V::masked>
+struct KernelTail
+{
+   using T = typename V::value_type;
+
+   template <class Op, class ScalarOp>
+   static void binary(T* v1, const T* v2, size_t size, Op, ScalarOp scalar_op)
+   {
+      for (size_t n = 0; n < size; ++n)
+      {
+         scalar_op(v1[n], v2[n]);
+      }
+   }
+
+   template <class Op, class ScalarOp>
+   static void unary(T* v1, size_t size, Op, ScalarOp scalar_op)
+   {
+      for (size_t n = 0; n < size; ++n)
+      {
+         scalar_op(v1[n]);
+      }
+   }
+
+   template <class Op, class ScalarOp>
+   static void function(T* output, const T* input, size_t size, Op, ScalarOp scalar_op)
+   {
+      for (size_t n = 0; n < size; ++n)
+      {
+         output[n] = scalar_op(input[n]);
+      }
+   }
+
+   template <class Op, class ScalarOp, class... Inputs>
+   static void function_n(T* output, size_t size, Op, ScalarOp scalar_op, const Inputs*... inputs)
+   {
+      for (size_t n = 0; n < size; ++n)
+      {
+         output[n] = scalar_op(inputs[n]...);
+      }
+   }
+};
+
+/**
+ @brief Process the end of the memory line that doesn't fill a vector with masked loads/stores
+ */
+template <class V>
+struct KernelTail<V, true>
+{
+   using T = typename V::value_type;
+
+   template <class Op, class ScalarOp>
+   static void binary(T* v1, const T* v2, size_t size, Op op, ScalarOp)
+   {
+      if (size)
+      {
+         const auto mask = V::mask(size);
+         V::store_masked(v1, mask, op(V::load_masked(v1, mask), V::load_masked(v2, mask)));
+      }
+   }
+
+   template <class Op, class ScalarOp>
+   static void unary(T* v1, size_t size, Op op, ScalarOp)
+   {
+      if (size)
+      {
+         const auto mask = V::mask(size);
+         V::store_masked(v1, mask, op(V::load_masked(v1, mask)));
+      }
+   }
+
+   template <class Op, class ScalarOp>
+   static void function(T* output, const T* input, size_t size, Op op, ScalarOp)
+   {
+      if (size)
+      {
+         const auto mask = V::mask(size);
+         V::store_masked(output, mask, op(V::load_masked(input, mask)));
+      }
+   }
+
+   template <class Op, class ScalarOp, class... Inputs>
+   static void function_n(T* output, size_t size, Op op, ScalarOp, const Inputs*... inputs)
+   {
+      if (size)
+      {
+         const auto mask = V::mask(size);
+         V::store_masked(output, mask, op(V::load_masked(inputs, mask)...));
+      }
+   }
+};
+
+/**
+ @brief Number of scalar elements to process so that v1 is aligned on V::alignment
+ */
+template <class V>
+size_t nb_elements_to_align(const typename V::value_type* v1, size_t size)
+{
+   using T                   = typename V::value_type;
+   const size_t misalignment = reinterpret_cast<size_t>(v1) % V::alignment;
+   if (misalignment == 0 || misalignment % sizeof(T) != 0)
+   {
+      // either already aligned or can't be aligned at all
+      return 0;
+   }
+   const size_t nb_elements = (V::alignment - misalignment) / sizeof(T);
+   return nb_elements < size ? nb_elements : size;
+}
+
+/**
+ @brief v1[n] = op(v1[n], v2[n])
+
+ The first elements are processed with scalar code until v1 is aligned, then full vectors and
+ finally the tail (masked if supported by the instruction set)
+ */
+template <class V, class Op, class ScalarOp>
+void apply_binary(typename V::value_type* v1, const typename V::value_type* v2, size_t size, Op op, ScalarOp scalar_op)
+{
+   size_t n          = 0;
+   const size_t peel = nb_elements_to_align<V>(v1, size);
+   for (; n < peel; ++n)
+   {
+      scalar_op(v1[n], v2[n]);
+   }
+
+   for (; n + V::width <= size; n += V::width)
+   {
+      V::store(v1 + n, op(V::load(v1 + n), V::load(v2 + n)));
+   }
+
+   KernelTail<V>::binary(v1 + n, v2 + n, size - n, op, scalar_op);
+}
+
+/**
+ @brief v1[n] = op(v1[n])
+ */
+template <class V, class Op, class ScalarOp>
+void apply_unary(typename V::value_type* v1, size_t size, Op op, ScalarOp scalar_op)
+{
+   size_t n          = 0;
+   const size_t peel = nb_elements_to_align<V>(v1, size);
+   for (; n < peel; ++n)
+   {
+      scalar_op(v1[n]);
+   }
+
+   for (; n + V::width <= size; n += V::width)
+   {
+      V::store(v1 + n, op(V::load(v1 + n)));
+   }
+
+   KernelTail<V>::unary(v1 + n, size - n, op, scalar_op);
+}
+
+/**
+ @brief output[n] = op(input[n])
+
+ output and input may be the same memory (in place) but must not partially overlap
+ */
+template <class V, class Op, class ScalarOp>
+void apply_function(typename V::value_type* output, const typename V::value_type* input, size_t size, Op op, ScalarOp scalar_op)
+{
+   size_t n          = 0;
+   const size_t peel = nb_elements_to_align<V>(output, size);
+   for (; n < peel; ++n)
+   {
+      output[n] = scalar_op(input[n]);
+   }
+
+   for (; n + V::width <= size; n += V::width)
+   {
+      V::store(output + n, op(V::load(input + n)));
+   }
+
+   KernelTail<V>::function(output + n, input + n, size - n, op, scalar_op);
+}
+
+/**
+ @brief output[n] = op(inputs[n]...), the multi-operand @ref apply_function
+
+ output may be the same memory as any of the inputs but must not partially overlap them
+ */
+template <class V, class Op, class ScalarOp, class... Inputs>
+void apply_function_n(typename V::value_type* output, size_t size, Op op, ScalarOp scalar_op, const Inputs*... inputs)
+{
+   size_t n          = 0;
+   const size_t peel = nb_elements_to_align<V>(output, size);
+   for (; n < peel; ++n)
+   {
+      output[n] = scalar_op(inputs[n]...);
+   }
+
+   for (; n + V::width <= size; n += V::width)
+   {
+      V::store(output + n, op(V::load(inputs + n)...));
+   }
+
+   KernelTail<V>::function_n(output + n, size - n, op, scalar_op, (inputs + n)...);
+}
+
+/**
+ @brief Evaluate the polynomial c[0] * x^(N-1) + ... + c[N-1] using Horner's scheme
+ */
+template <class V, size_t N>
+typename V::type polynomial(typename V::type x, const typename V::value_type (&coefficients)[N])
+{
+   auto y = V::set1(coefficients[0]);
+   for (size_t n = 1; n < N; ++n)
+   {
+      y = V::add(V::mul(y, x), V::set1(coefficients[n]));
+   }
+   return y;
+}
+
+/**
+ @brief Vectorized elementwise functions, adapted from the Cephes library
+
+ Accuracy measured against a higher precision reference, in ULP:
+ - exp: float <= 1, double <= 2
+ - log: float <= 1, double <= 1
+ - sin, cos: float <= 2 for |x| <= 10 and <= 2.5 for |x| <= 8192, double <= 2 for |x| <= 2^26.
+   Beyond these, the elements are computed with the scalar C library functions
+ - sqrt: correctly rounded
+
+ Special values (NaN, infinities, zeros, denormals) are handled as the C library does. This relies on the kernel translation units
+ being compiled without the fast-math flags of the project.
+ */
+template <class V, class T = typename V::value_type>
+struct VectorMath;
+
+template <class V>
+struct VectorMath<V, float>
+{
+   using vector = typename V::type;
+
+   static vector exp(vector x)
+   {
+      static const float p[] = {1.9875691500E-4f, 1.3981999507E-3f, 8.3334519073E-3f, 4.1665795894E-2f, 1.6666665459E-1f, 5.0000001201E-1f};
+
+      // x = n * ln(2) + r, with |r| <= ln(2) / 2
+      const vector n = V::round(V::mul(x, V::set1(1.44269504088896341f)));
+      vector r       = V::sub(x, V::mul(n, V::set1(0.693359375f)));
+      r              = V::sub(r, V::mul(n, V::set1(-2.12194440e-4f)));
+
+      const vector r2 = V::mul(r, r);
+      vector y        = V::add(V::add(V::mul(polynomial<V>(r, p), r2), r), V::set1(1.0f));
+
+      // 2^n in two steps so that the denormal results & 2^128 are correctly handled
+      const vector n1 = V::trunc(V::mul(n, V::set1(0.5f)));
+      y               = V::mul(V::mul(y, V::pow2n(n1)), V::pow2n(V::sub(n, n1)));
+
+      y = V::select(V::gt(x, V::set1(88.72283935546875f)), V::set1(HUGE_VALF), y);
+      y = V::select(V::lt(x, V::set1(-103.972084045410f)), V::set1(0.0f), y);
+      return V::select(V::is_nan(x), x, y);
+   }
+
+   static vector log(vector x)
+   {
+      static const float p[] = {7.0376836292E-2f,  -1.1514610310E-1f, 1.1676998740E-1f,  -1.2420140846E-1f, 1.4249322787E-1f,
+                                -1.6668057665E-1f, 2.0000714765E-1f,  -2.4999993993E-1f, 3.3333331174E-1f};
+
+      // denormals are normalized first
+      const auto denormal = V::lt(x, V::set1(FLT_MIN));
+      const vector xn     = V::select(denormal, V::mul(x, V::set1(33554432.0f)), x); // 2^25
+
+      vector e;
+      vector m = V::frexp(xn, e);
+      e        = V::sub(e, V::select(denormal, V::set1(25.0f), V::set1(0.0f)));
+
+      // m in [sqrt(0.5), sqrt(2)) - 1
+      const auto small = V::lt(m, V::set1(0.707106781186547524f));
+      e                = V::sub(e, V::select(small, V::set1(1.0f), V::set1(0.0f)));
+      m                = V::add(V::sub(m, V::set1(1.0f)), V::select(small, m, V::set1(0.0f)));
+
+      const vector z = V::mul(m, m);
+      vector y       = V::mul(V::mul(polynomial<V>(m, p), m), z);
+      y              = V::add(y, V::mul(e, V::set1(-2.12194440e-4f)));
+      y              = V::sub(y, V::mul(z, V::set1(0.5f)));
+      y              = V::add(V::add(m, y), V::mul(e, V::set1(0.693359375f)));
+
+      y = V::select(V::eq(x, V::set1(HUGE_VALF)), x, y);
+      y = V::select(V::lt(x, V::set1(0.0f)), V::set1(NAN), y);
+      y = V::select(V::eq(x, V::set1(0.0f)), V::set1(-HUGE_VALF), y);
+      return V::select(V::is_nan(x), x, y);
+   }
+
+   static vector sin(vector x)
+   {
+      return sincos(x, false);
+   }
+
+   static vector cos(vector x)
+   {
+      return sincos(x, true);
+   }
+
+   static vector sincos(vector x, bool is_cos)
+   {
+      static const float sin_p[] = {-1.9515295891E-4f, 8.3321608736E-3f, -1.6666654611E-1f};
+      static const float cos_p[] = {2.443315711809948E-005f, -1.388731625493765E-003f, 4.166664568298827E-002f};
+      static const float limit   = 8192.0f;
+
+      const vector ax = V::abs(x);
+      if (V::any(V::gt(ax, V::set1(limit))))
+      {
+         // the range reduction is not accurate enough
+         return apply_scalar(x, is_cos ? &::cosf : &::sinf);
+      }
+
+      // octant j of |x|, rounded to the next even octant
+      const vector two = V::set1(2.0f);
+      vector j         = V::trunc(V::mul(ax, V::set1(1.27323954473516f)));
+      j                = V::add(j, V::sub(j, V::mul(V::trunc(V::mul(j, V::set1(0.5f))), two)));
+
+      // extended precision modular arithmetic
+      vector z = V::sub(ax, V::mul(j, V::set1(0.78515625f)));
+      z        = V::sub(z, V::mul(j, V::set1(2.4187564849853515625e-4f)));
+      z        = V::sub(z, V::mul(j, V::set1(3.7747668102383613586e-8f)));
+      z        = V::sub(z, V::mul(j, V::set1(1.2816720341285448015e-12f)));
+
+      const vector zz         = V::mul(z, z);
+      const vector sin_approx = V::add(V::mul(V::mul(polynomial<V>(zz, sin_p), zz), z), z);
+      const vector cos_approx =
+          V::add(V::sub(V::mul(V::mul(polynomial<V>(zz, cos_p), zz), zz), V::mul(zz, V::set1(0.5f))), V::set1(1.0f));
+
+      // octant in [0, 4) and the sign of the result
+      const vector octant = V::sub(j, V::mul(V::trunc(V::mul(j, V::set1(0.125f))), V::set1(8.0f)));
+      const auto flip     = V::gt(octant, V::set1(3.0f));
+      const vector q      = V::select(flip, V::sub(octant, V::set1(4.0f)), octant);
+      const auto swap     = V::gt(q, V::set1(1.0f));
+
+      const vector minus_one = V::set1(-1.0f);
+      const vector one       = V::set1(1.0f);
+      vector sign            = V::select(flip, minus_one, one);
+      vector y;
+      if (is_cos)
+      {
+         sign = V::mul(sign, V::select(swap, minus_one, one));
+         y    = V::select(swap, sin_approx, cos_approx);
+      }
+      else
+      {
+         sign = V::mul(sign, V::select(V::lt(x, V::set1(0.0f)), minus_one, one));
+         y    = V::select(swap, cos_approx, sin_approx);
+      }
+      return V::mul(y, sign);
+   }
+
+   static vector apply_scalar(vector x, float (*f)(float))
+   {
+      float values[V::width];
+      V::store(values, x);
+      for (size_t n = 0; n < V::width; ++n)
+      {
+         values[n] = f(values[n]);
+      }
+      return V::load(values);
+   }
+};
+
+template <class V>
+struct VectorMath<V, double>
+{
+   using vector = typename V::type;
+
+   static vector exp(vector x)
+   {
+      static const double p[] = {1.26177193074810590878E-4, 3.02994407707441961300E-2, 9.99999999999999999910E-1};
+      static const double q[] = {3.00198505138664455042E-6, 2.52448340349684104192E-3, 2.27265548208155028766E-1, 2.00000000000000000009E0};
+
+      // x = n * ln(2) + r, with |r| <= ln(2) / 2
+      const vector n = V::round(V::mul(x, V::set1(1.4426950408889634073599)));
+      vector r       = V::sub(x, V::mul(n, V::set1(6.93145751953125E-1)));
+      r              = V::sub(r, V::mul(n, V::set1(1.42860682030941723212E-6)));
+
+      // Pade approximation: exp(r) = 1 + 2 r P(r^2) / (Q(r^2) - r P(r^2))
+      const vector r2 = V::mul(r, r);
+      const vector rp = V::mul(r, polynomial<V>(r2, p));
+      vector y        = V::div(rp, V::sub(polynomial<V>(r2, q), rp));
+      y               = V::add(V::mul(y, V::set1(2.0)), V::set1(1.0));
+
+      // 2^n in two steps so that the denormal results & 2^1024 are correctly handled
+      const vector n1 = V::trunc(V::mul(n, V::set1(0.5)));
+      y               = V::mul(V::mul(y, V::pow2n(n1)), V::pow2n(V::sub(n, n1)));
+
+      y = V::select(V::gt(x, V::set1(7.09782712893383996843E2)), V::set1(HUGE_VAL), y);
+      y = V::select(V::lt(x, V::set1(-7.45133219101941108420E2)), V::set1(0.0), y);
+      return V::select(V::is_nan(x), x, y);
+   }
+
+   static vector log(vector x)
+   {
+      static const double p[] = {1.01875663804580931796E-4, 4.97494994976747001425E-1, 4.70579119878881725854E0,
+                                 1.44989225341610930846E1,  1.79368678507819816313E1,  7.70838733755885391666E0};
+      static const double q[] = {1.0,                      1.12873587189167450590E1, 4.52279145837532221105E1,
+                                 8.29875266912776603211E1, 7.11544750618563894466E1, 2.31251620126765340583E1};
+
+      // denormals are normalized first
+      const auto denormal = V::lt(x, V::set1(DBL_MIN));
+      const vector xn     = V::select(denormal, V::mul(x, V::set1(18014398509481984.0)), x); // 2^54
+
+      vector e;
+      vector m = V::frexp(xn, e);
+      e        = V::sub(e, V::select(denormal, V::set1(54.0), V::set1(0.0)));
+
+      // m in [sqrt(0.5), sqrt(2)) - 1
+      const auto small = V::lt(m, V::set1(0.70710678118654752440));
+      e                = V::sub(e, V::select(small, V::set1(1.0), V::set1(0.0)));
+      m                = V::add(V::sub(m, V::set1(1.0)), V::select(small, m, V::set1(0.0)));
+
+      const vector z = V::mul(m, m);
+      vector y       = V::mul(m, V::div(V::mul(z, polynomial<V>(m, p)), polynomial<V>(m, q)));
+      y              = V::sub(y, V::mul(e, V::set1(2.121944400546905827679e-4)));
+      y              = V::sub(y, V::mul(z, V::set1(0.5)));
+      y              = V::add(V::add(m, y), V::mul(e, V::set1(0.693359375)));
+
+      y = V::select(V::eq(x, V::set1(HUGE_VAL)), x, y);
+      y = V::select(V::lt(x, V::set1(0.0)), V::set1(static_cast<double>(NAN)), y);
+      y = V::select(V::eq(x, V::set1(0.0)), V::set1(-HUGE_VAL), y);
+      return V::select(V::is_nan(x), x, y);
+   }
+
+   static vector sin(vector x)
+   {
+      return sincos(x, false);
+   }
+
+   static vector cos(vector x)
+   {
+      return sincos(x, true);
+   }
+
+   static vector sincos(vector x, bool is_cos)
+   {
+      static const double sin_p[] = {1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+                                     -1.98412698295895385996E-4, 8.33333333332211858878E-3,  -1.66666666666666307295E-1};
+      static const double cos_p[] = {-1.13585365213876817300E-11, 2.08757008419747316778E-9,  -2.75573141792967388112E-7,
+                                     2.48015872888517045348E-5,   -1.38888888888730564116E-3, 4.16666666666665929218E-2};
+      static const double limit = 67108864.0; // 2^26
+
+      const vector ax = V::abs(x);
+      if (V::any(V::gt(ax, V::set1(limit))))
+      {
+         // the range reduction is not accurate enough
+         return apply_scalar(x, is_cos ? static_cast<double (*)(double)>(&::cos) : static_cast<double (*)(double)>(&::sin));
+      }
+
+      // octant j of |x|, rounded to the next even octant
+      const vector two = V::set1(2.0);
+      vector j         = V::trunc(V::mul(ax, V::set1(1.27323954473516268615)));
+      j                = V::add(j, V::sub(j, V::mul(V::trunc(V::mul(j, V::set1(0.5))), two)));
+
+      // extended precision modular arithmetic
+      vector z = V::sub(ax, V::mul(j, V::set1(7.85398125648498535156E-1)));
+      z        = V::sub(z, V::mul(j, V::set1(3.77489470793079817668E-8)));
+      z        = V::sub(z, V::mul(j, V::set1(2.69515142907905952645E-15)));
+
+      const vector zz         = V::mul(z, z);
+      const vector sin_approx = V::add(V::mul(V::mul(polynomial<V>(zz, sin_p), zz), z), z);
+      const vector cos_approx = V::add(V::sub(V::mul(V::mul(polynomial<V>(zz, cos_p), zz), zz), V::mul(zz, V::set1(0.5))), V::set1(1.0));
+
+      // octant in [0, 4) and the sign of the result
+      const vector octant = V::sub(j, V::mul(V::trunc(V::mul(j, V::set1(0.125))), V::set1(8.0)));
+      const auto flip     = V::gt(octant, V::set1(3.0));
+      const vector q      = V::select(flip, V::sub(octant, V::set1(4.0)), octant);
+      const auto swap     = V::gt(q, V::set1(1.0));
+
+      const vector minus_one = V::set1(-1.0);
+      const vector one       = V::set1(1.0);
+      vector sign            = V::select(flip, minus_one, one);
+      vector y;
+      if (is_cos)
+      {
+         sign = V::mul(sign, V::select(swap, minus_one, one));
+         y    = V::select(swap, sin_approx, cos_approx);
+      }
+      else
+      {
+         sign = V::mul(sign, V::select(V::lt(x, V::set1(0.0)), minus_one, one));
+         y    = V::select(swap, cos_approx, sin_approx);
+      }
+      return V::mul(y, sign);
+   }
+
+   static vector apply_scalar(vector x, double (*f)(double))
+   {
+      double values[V::width];
+      V::store(values, x);
+      for (size_t n = 0; n < V::width; ++n)
+      {
+         values[n] = f(values[n]);
+      }
+      return V::load(values);
+   }
+};
+
+/**
+ @brief Reductions of a memory line
+
+ The sums use the lane layout of @ref reduction_lanes: the accumulators are not aligned on the memory
+ so that the order of the operations only depends on the position of the elements in the line. The
+ compensated sums use the same operations as @ref SummationKahan.
+ */
+template <class V>
+struct KernelReduce
+{
+   using T      = typename V::value_type;
+   using vector = typename V::type;
+
+   static const size_t nb_lanes     = reduction_lanes<T>::value;
+   static const size_t nb_registers = nb_lanes / V::width;
+   static_assert(nb_registers * V::width == nb_lanes, "the lanes must fill the registers");
+
+   static void sum(const T* v, T* result, size_t size)
+   {
+      vector s[nb_registers];
+      for (size_t r = 0; r < nb_registers; ++r)
+      {
+         s[r] = V::set1(0);
+      }
+
+      size_t n = 0;
+      for (; n + nb_lanes <= size; n += nb_lanes)
+      {
+         for (size_t r = 0; r < nb_registers; ++r)
+         {
+            s[r] = V::add(s[r], V::load(v + n + r * V::width));
+         }
+      }
+
+      T lanes[nb_lanes];
+      for (size_t r = 0; r < nb_registers; ++r)
+      {
+         V::store(lanes + r * V::width, s[r]);
+      }
+      for (size_t lane = 0; n < size; ++n, ++lane)
+      {
+         lanes[lane] += v[n];
+      }
+
+      for (size_t step = nb_lanes / 2; step > 0; step /= 2)
+      {
+         for (size_t lane = 0; lane < step; ++lane)
+         {
+            lanes[lane] += lanes[lane + step];
+         }
+      }
+      result[0] = lanes[0];
+   }
+
+   static void norm2sqr(const T* v, T* result, size_t size)
+   {
+      vector s[nb_registers];
+      for (size_t r = 0; r < nb_registers; ++r)
+      {
+         s[r] = V::set1(0);
+      }
+
+      size_t n = 0;
+      for (; n + nb_lanes <= size; n += nb_lanes)
+      {
+         for (size_t r = 0; r < nb_registers; ++r)
+         {
+            const vector x = V::load(v + n + r * V::width);
+            s[r]           = V::add(s[r], V::mul(x, x));
+         }
+      }
+
+      T lanes[nb_lanes];
+      for (size_t r = 0; r < nb_registers; ++r)
+      {
+         V::store(lanes + r * V::width, s[r]);
+      }
+      for (size_t lane = 0; n < size; ++n, ++lane)
+      {
+         const T x  = v[n];
+         const T x2 = x * x;
+         lanes[lane] += x2;
+      }
+
+      for (size_t step = nb_lanes / 2; step > 0; step /= 2)
+      {
+         for (size_t lane = 0; lane < step; ++lane)
+         {
+            lanes[lane] += lanes[lane + step];
+         }
+      }
+      result[0] = lanes[0];
+   }
+
+   static void sum_kahan(const T* v, T* result, size_t size)
+   {
+      vector s[nb_registers];
+      vector c[nb_registers];
+      for (size_t r = 0; r < nb_registers; ++r)
+      {
+         s[r] = V::set1(0);
+         c[r] = V::set1(0);
+      }
+
+      size_t n = 0;
+      for (; n + nb_lanes <= size; n += nb_lanes)
+      {
+         for (size_t r = 0; r < nb_registers; ++r)
+         {
+            const vector y = V::add(V::load(v + n + r * V::width), c[r]);
+            const vector t = V::add(s[r], y);
+            c[r]           = V::sub(y, V::sub(t, s[r]));
+            s[r]           = t;
+         }
+      }
+
+      T lanes_s[nb_lanes];
+      T lanes_c[nb_lanes];
+      for (size_t r = 0; r < nb_registers; ++r)
+      {
+         V::store(lanes_s + r * V::width, s[r]);
+         V::store(lanes_c + r * V::width, c[r]);
+      }
+      for (size_t lane = 0; n < size; ++n, ++lane)
+      {
+         const T y     = v[n] + lanes_c[lane];
+         const T t     = lanes_s[lane] + y;
+         lanes_c[lane] = y - (t - lanes_s[lane]);
+         lanes_s[lane] = t;
+      }
+
+      for (size_t step = nb_lanes / 2; step > 0; step /= 2)
+      {
+         for (size_t lane = 0; lane < step; ++lane)
+         {
+            // error free transformation of the sum of the lanes
+            const T a     = lanes_s[lane];
+            const T b     = lanes_s[lane + step];
+            const T sum   = a + b;
+            const T b_err = sum - a;
+            const T error = (a - (sum - b_err)) + (b - b_err);
+            lanes_s[lane] = sum;
+            lanes_c[lane] = (lanes_c[lane] + lanes_c[lane + step]) + error;
+         }
+      }
+      result[0] = lanes_s[0];
+      result[1] = lanes_c[0];
+   }
+
+   static void min(const T* v, T* result, size_t size)
+   {
+      T min_value;
+      T max_value;
+      min_max<true, false>(v, size, min_value, max_value);
+      result[0] = min_value;
+   }
+
+   static void max(const T* v, T* result, size_t size)
+   {
+      T min_value;
+      T max_value;
+      min_max<false, true>(v, size, min_value, max_value);
+      result[0] = max_value;
+   }
+
+   static void minmax(const T* v, T* result, size_t size)
+   {
+      min_max<true, true>(v, size, result[0], result[1]);
+   }
+
+   /**
+    @brief min & max are exact, the order of the operations doesn't matter
+    */
+   template <bool Min, bool Max>
+   static void min_max(const T* v, size_t size, T& min_value, T& max_value)
+   {
+      static const size_t nb_accumulators = 4;
+
+      vector min_v[nb_accumulators];
+      vector max_v[nb_accumulators];
+      for (size_t r = 0; r < nb_accumulators; ++r)
+      {
+         min_v[r] = V::set1(static_cast<T>(HUGE_VAL));
+         max_v[r] = V::set1(static_cast<T>(-HUGE_VAL));
+      }
+
+      size_t n = 0;
+      for (; n + nb_accumulators * V::width <= size; n += nb_accumulators * V::width)
+      {
+         for (size_t r = 0; r < nb_accumulators; ++r)
+         {
+            const vector x = V::load(v + n + r * V::width);
+            if (Min)
+            {
+               min_v[r] = V::min(x, min_v[r]);
+            }
+            if (Max)
+            {
+               max_v[r] = V::max(x, max_v[r]);
+            }
+         }
+      }
+
+      T mins[nb_accumulators * V::width];
+      T maxs[nb_accumulators * V::width];
+      for (size_t r = 0; r < nb_accumulators; ++r)
+      {
+         V::store(mins + r * V::width, min_v[r]);
+         V::store(maxs + r * V::width, max_v[r]);
+      }
+
+      min_value = static_cast<T>(HUGE_VAL);
+      max_value = static_cast<T>(-HUGE_VAL);
+      for (size_t i = 0; i < nb_accumulators * V::width; ++i)
+      {
+         min_value = mins[i] < min_value ? mins[i] : min_value;
+         max_value = maxs[i] > max_value ? maxs[i] : max_value;
+      }
+      for (; n < size; ++n)
+      {
+         min_value = v[n] < min_value ? v[n] : min_value;
+         max_value = v[n] > max_value ? v[n] : max_value;
+      }
+   }
+
+   static void argmin(const T* v, T* value, size_t* index, size_t size)
+   {
+      arg_best<false>(v, size, *value, *index);
+   }
+
+   static void argmax(const T* v, T* value, size_t* index, size_t size)
+   {
+      arg_best<true>(v, size, *value, *index);
+   }
+
+   /**
+    @brief Each lane keeps its best value and the iteration it was found at. Among the lanes having the
+           best value, the smallest position wins so that the first occurrence is returned as in @ref details::argmax
+    */
+   template <bool Max>
+   static void arg_best(const T* v, size_t size, T& best_value, size_t& best_index)
+   {
+      static const size_t nb_accumulators = 2;
+      static const size_t step            = nb_accumulators * V::width;
+      // the iterations are counted in T: exact up to 2^24 for float
+      static const size_t max_iterations = size_t(1) << 22;
+
+      const T none = static_cast<T>(Max ? -HUGE_VAL : HUGE_VAL);
+      best_value   = none;
+      best_index   = size;
+
+      const vector one = V::set1(1);
+      size_t n         = 0;
+      while (n + step <= size)
+      {
+         const size_t chunk_begin   = n;
+         const size_t nb_iterations = std::min((size - n) / step, max_iterations);
+
+         vector best_v[nb_accumulators];
+         vector iteration_v[nb_accumulators];
+         for (size_t r = 0; r < nb_accumulators; ++r)
+         {
+            best_v[r]      = V::set1(none);
+            iteration_v[r] = V::set1(0);
+         }
+
+         vector iteration = V::set1(0);
+         for (size_t i = 0; i < nb_iterations; ++i, n += step)
+         {
+            for (size_t r = 0; r < nb_accumulators; ++r)
+            {
+               const vector x      = V::load(v + n + r * V::width);
+               const auto is_better = Max ? V::gt(x, best_v[r]) : V::lt(x, best_v[r]); // false for NaN
+               best_v[r]           = V::select(is_better, x, best_v[r]);
+               iteration_v[r]      = V::select(is_better, iteration, iteration_v[r]);
+            }
+            iteration = V::add(iteration, one);
+         }
+
+         T values[step];
+         T iterations[step];
+         for (size_t r = 0; r < nb_accumulators; ++r)
+         {
+            V::store(values + r * V::width, best_v[r]);
+            V::store(iterations + r * V::width, iteration_v[r]);
+         }
+
+         for (size_t lane = 0; lane < step; ++lane)
+         {
+            if (values[lane] == none)
+            {
+               continue; // nothing found by this lane
+            }
+
+            const size_t position = chunk_begin + static_cast<size_t>(iterations[lane]) * step + lane;
+            if ((Max ? values[lane] > best_value : values[lane] < best_value) || (values[lane] == best_value && position < best_index))
+            {
+               best_value = values[lane];
+               best_index = position;
+            }
+         }
+      }
+
+      for (; n < size; ++n)
+      {
+         if (Max ? v[n] > best_value : v[n] < best_value)
+         {
+            best_value = v[n];
+            best_index = n;
+         }
+      }
+
+      if (best_index == size)
+      {
+         // only infinities of the wrong sign and NaN: return the first element that is not a NaN
+         best_index = 0;
+         while (best_index + 1 < size && v[best_index] != v[best_index])
+         {
+            ++best_index;
+         }
+         if (v[best_index] != v[best_index])
+         {
+            best_index = 0;
+         }
+         best_value = v[best_index];
+      }
+   }
+};
+
+/**
+ @brief |value| as an unsigned integer: the NaN and infinities of the scalar tails are classified on the bit pattern, which doesn't
+        depend on the floating point flags
+ */
+inline std::uint32_t magnitude_bits(float value)
+{
+   std::uint32_t bits;
+   std::memcpy(&bits, &value, sizeof(bits));
+   return bits & 0x7fffffffu;
+}
+
+inline std::uint64_t magnitude_bits(double value)
+{
+   std::uint64_t bits;
+   std::memcpy(&bits, &value, sizeof(bits));
+   return bits & 0x7fffffffffffffffull;
+}
+
+/**
+ @brief Elementwise comparisons packed in 64-bit words and search of the first element satisfying a predicate
+ */
+template <class V>
+struct KernelCompare
+{
+   using T      = typename V::value_type;
+   using vector = typename V::type;
+   using word   = std::uint64_t;
+
+   static const size_t word_bits = 64;
+   static_assert(word_bits % V::width == 0, "a word must be filled by vectors");
+
+   static void compare(word* bits, const T* v1, const T* v2, T value, Comparison comparison, size_t size)
+   {
+      switch (comparison)
+      {
+      case Comparison::less:
+         compare_impl<Less>(bits, v1, v2, value, size);
+         break;
+      case Comparison::less_equal:
+         compare_impl<LessEqual>(bits, v1, v2, value, size);
+         break;
+      case Comparison::greater:
+         compare_impl<Greater>(bits, v1, v2, value, size);
+         break;
+      case Comparison::greater_equal:
+         compare_impl<GreaterEqual>(bits, v1, v2, value, size);
+         break;
+      case Comparison::equal:
+         compare_impl<Equal>(bits, v1, v2, value, size);
+         break;
+      case Comparison::not_equal:
+         compare_impl<NotEqual>(bits, v1, v2, value, size);
+         break;
+      }
+   }
+
+   // the comparisons not provided by the traits are combined so that NaN compare as in the scalar code
+   struct Less
+   {
+      static word vector_bits(vector a, vector b)
+      {
+         return V::bits(V::lt(a, b));
+      }
+      static bool scalar(T a, T b)
+      {
+         return a < b;
+      }
+   };
+
+   struct LessEqual
+   {
+      static word vector_bits(vector a, vector b)
+      {
+         return V::bits(V::lt(a, b)) | V::bits(V::eq(a, b));
+      }
+      static bool scalar(T a, T b)
+      {
+         return a <= b;
+      }
+   };
+
+   struct Greater
+   {
+      static word vector_bits(vector a, vector b)
+      {
+         return V::bits(V::gt(a, b));
+      }
+      static bool scalar(T a, T b)
+      {
+         return a > b;
+      }
+   };
+
+   struct GreaterEqual
+   {
+      static word vector_bits(vector a, vector b)
+      {
+         return V::bits(V::gt(a, b)) | V::bits(V::eq(a, b));
+      }
+      static bool scalar(T a, T b)
+      {
+         return a >= b;
+      }
+   };
+
+   struct Equal
+   {
+      static word vector_bits(vector a, vector b)
+      {
+         return V::bits(V::eq(a, b));
+      }
+      static bool scalar(T a, T b)
+      {
+         return a == b;
+      }
+   };
+
+   struct NotEqual
+   {
+      static word vector_bits(vector a, vector b)
+      {
+         return ~V::bits(V::eq(a, b)) & ((word(1) << V::width) - 1);
+      }
+      static bool scalar(T a, T b)
+      {
+         return a != b;
+      }
+   };
+
+   static void find(const T* v, const LinePredicate<T>* predicate, bool expected, size_t* position, size_t size)
+   {
+      using Test = typename LinePredicate<T>::Test;
+      switch (predicate->test)
+      {
+      case Test::compare:
+         switch (predicate->comparison)
+         {
+         case Comparison::less:
+            *position = find_impl(v, size, expected, CompareTo<Less>(predicate->value));
+            break;
+         case Comparison::less_equal:
+            *position = find_impl(v, size, expected, CompareTo<LessEqual>(predicate->value));
+            break;
+         case Comparison::greater:
+            *position = find_impl(v, size, expected, CompareTo<Greater>(predicate->value));
+            break;
+         case Comparison::greater_equal:
+            *position = find_impl(v, size, expected, CompareTo<GreaterEqual>(predicate->value));
+            break;
+         case Comparison::equal:
+            *position = find_impl(v, size, expected, CompareTo<Equal>(predicate->value));
+            break;
+         case Comparison::not_equal:
+            *position = find_impl(v, size, expected, CompareTo<NotEqual>(predicate->value));
+            break;
+         }
+         break;
+      case Test::nan:
+         *position = find_impl(v, size, expected, IsNan());
+         break;
+      case Test::finite:
+         *position = find_impl(v, size, expected, IsFinite());
+         break;
+      case Test::approx_equal:
+         *position = find_impl(v, size, expected, ApproxEqual(predicate->value, predicate->tolerance));
+         break;
+      }
+   }
+
+   // the tests of find: bits(a) for a vector, scalar(a) for the tail
+   template <class Op>
+   struct CompareTo
+   {
+      explicit CompareTo(T value) : value(value), value_v(V::set1(value))
+      {
+      }
+      word bits(vector a) const
+      {
+         return Op::vector_bits(a, value_v);
+      }
+      bool scalar(T a) const
+      {
+         return Op::scalar(a, value);
+      }
+
+      T value;
+      vector value_v;
+   };
+
+   struct IsNan
+   {
+      word bits(vector a) const
+      {
+         return V::bits(V::is_nan(a));
+      }
+      bool scalar(T a) const
+      {
+         return magnitude_bits(a) > magnitude_bits(std::numeric_limits<T>::infinity());
+      }
+   };
+
+   struct IsFinite
+   {
+      // a - a is NaN for infinite and NaN values, 0 else
+      word bits(vector a) const
+      {
+         return V::bits(V::eq(V::sub(a, a), V::set1(T(0))));
+      }
+      bool scalar(T a) const
+      {
+         return magnitude_bits(a) < magnitude_bits(std::numeric_limits<T>::infinity());
+      }
+   };
+
+   struct ApproxEqual
+   {
+      ApproxEqual(T value, T tolerance) : value(value), tolerance(tolerance), value_v(V::set1(value)), tolerance_v(V::set1(tolerance))
+      {
+      }
+      word bits(vector a) const
+      {
+         return LessEqual::vector_bits(V::abs(V::sub(a, value_v)), tolerance_v);
+      }
+      bool scalar(T a) const
+      {
+         // a - value and value - a are exact opposites: same result as the vector abs
+         return (a > value ? a - value : value - a) <= tolerance;
+      }
+
+      T value;
+      T tolerance;
+      vector value_v;
+      vector tolerance_v;
+   };
+
+   static size_t first_bit(word w)
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<size_t>(__builtin_ctzll(w));
+#else
+      size_t n = 0;
+      for (; (w & 1) == 0; w >>= 1)
+      {
+         ++n;
+      }
+      return n;
+#endif
+   }
+
+   template <class Test>
+   static size_t find_impl(const T* v, size_t size, bool expected, const Test& test)
+   {
+      // 4 vectors are tested per iteration, their bits packed in a single word
+      static const size_t step = 4 * V::width;
+      static_assert(step <= word_bits, "the bits of an iteration must fit in a word");
+      const word flip = expected ? word(0) : ~word(0) >> (word_bits - step);
+
+      size_t n = 0;
+      for (; n + step <= size; n += step)
+      {
+         const word w = (test.bits(V::load(v + n)) | (test.bits(V::load(v + n + V::width)) << V::width) |
+                         (test.bits(V::load(v + n + 2 * V::width)) << (2 * V::width)) | (test.bits(V::load(v + n + 3 * V::width)) << (3 * V::width))) ^
+                        flip;
+         if (w)
+         {
+            return n + first_bit(w);
+         }
+      }
+
+      for (; n < size; ++n)
+      {
+         if (test.scalar(v[n]) == expected)
+         {
+            return n;
+         }
+      }
+      return size;
+   }
+
+   template <class Op>
+   static void compare_impl(word* bits, const T* v1, const T* v2, T value, size_t size)
+   {
+      const vector value_v = V::set1(value);
+
+      size_t n = 0;
+      for (; n + word_bits <= size; n += word_bits, ++bits)
+      {
+         word w = 0;
+         for (size_t i = 0; i < word_bits; i += V::width)
+         {
+            const vector b = v2 ? V::load(v2 + n + i) : value_v;
+            w |= Op::vector_bits(V::load(v1 + n + i), b) << i;
+         }
+         *bits = w;
+      }
+
+      if (n < size)
+      {
+         word w = 0;
+         for (size_t i = 0; n + i < size; ++i)
+         {
+            w |= word(Op::scalar(v1[n + i], v2 ? v2[n + i] : value)) << i;
+         }
+         *bits = w;
+      }
+   }
+};
+
+/**
+ @brief The kernels expressed with the vector traits V
+ */
+template <class V>
+struct KernelImpl
+{
+   using T      = typename V::value_type;
+   using vector = typename V::type;
+
+   // small integers are promoted to int by the multiplications: use unsigned arithmetic to avoid signed overflows
+   using scalar_mul_t = typename std::conditional<std::is_integral<T>::value, unsigned, T>::type;
+
+   static void add(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::add(a, b); }, [](T& a, T b) { a += b; });
+   }
+
+   static void sub(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::sub(a, b); }, [](T& a, T b) { a -= b; });
+   }
+
+   static void add_cte(T* v1, T value, size_t size)
+   {
+      const vector value_v = V::set1(value);
+      apply_unary<V>(v1, size, [&](vector a) { return V::add(a, value_v); }, [&](T& a) { a += value; });
+   }
+
+   static void mul(T* v1, T value, size_t size)
+   {
+      const vector value_v = V::set1(value);
+      apply_unary<V>(v1, size, [&](vector a) { return V::mul(a, value_v); },
+                     [&](T& a) { a = static_cast<T>(scalar_mul_t(a) * scalar_mul_t(value)); });
+   }
+
+   static void div(T* v1, T value, size_t size)
+   {
+      const vector value_v = V::set1(value);
+      apply_unary<V>(v1, size, [&](vector a) { return V::div(a, value_v); }, [&](T& a) { a /= value; });
+   }
+
+   static void mul_elementwise(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::mul(a, b); },
+                      [](T& a, T b) { a = static_cast<T>(scalar_mul_t(a) * scalar_mul_t(b)); });
+   }
+
+   static void div_elementwise(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::div(a, b); }, [](T& a, T b) { a /= b; });
+   }
+
+   static void sqrt(T* output, const T* input, size_t size)
+   {
+      apply_function<V>(output, input, size, [](vector a) { return V::sqrt(a); },
+                        [](T a) { return static_cast<T>(::sqrt(static_cast<double>(a))); });
+   }
+
+   static void abs(T* output, const T* input, size_t size)
+   {
+      apply_function<V>(output, input, size, [](vector a) { return V::abs(a); },
+                        [](T a) { return static_cast<T>(::fabs(static_cast<double>(a))); });
+   }
+
+   static void exp(T* output, const T* input, size_t size)
+   {
+      apply_function<V>(output, input, size, [](vector a) { return VectorMath<V>::exp(a); },
+                        [](T a) { return static_cast<T>(::exp(static_cast<double>(a))); });
+   }
+
+   static void log(T* output, const T* input, size_t size)
+   {
+      apply_function<V>(output, input, size, [](vector a) { return VectorMath<V>::log(a); },
+                        [](T a) { return static_cast<T>(::log(static_cast<double>(a))); });
+   }
+
+   static void sin(T* output, const T* input, size_t size)
+   {
+      apply_function<V>(output, input, size, [](vector a) { return VectorMath<V>::sin(a); },
+                        [](T a) { return static_cast<T>(::sin(static_cast<double>(a))); });
+   }
+
+   static void cos(T* output, const T* input, size_t size)
+   {
+      apply_function<V>(output, input, size, [](vector a) { return VectorMath<V>::cos(a); },
+                        [](T a) { return static_cast<T>(::cos(static_cast<double>(a))); });
+   }
+
+   static void addmul(T* v1, const T* v2, T value, size_t size)
+   {
+      const vector value_v = V::set1(value);
+      apply_binary<V>(v1, v2, size, [&](vector a, vector b) { return V::sub(a, V::mul(b, value_v)); },
+                      [&](T& a, T b) { a = static_cast<T>(scalar_mul_t(a) - scalar_mul_t(b) * scalar_mul_t(value)); });
+   }
+
+   static void gather(T* output, const T* input, const size_t* offsets, size_t size)
+   {
+      size_t n = 0;
+      for (; n + V::width <= size; n += V::width)
+      {
+         V::store(output + n, V::gather(input, offsets + n));
+      }
+      for (; n < size; ++n)
+      {
+         output[n] = input[offsets[n]];
+      }
+   }
+
+   static void fma(T* output, const T* a, const T* b, const T* c, size_t size)
+   {
+      apply_function_n<V>(output, size, [](vector va, vector vb, vector vc) { return fused_mul_add(va, vb, vc, std::is_integral<T>()); },
+                          [](T va, T vb, T vc) { return scalar_fma(va, vb, vc); }, a, b, c);
+   }
+
+   static void fms(T* output, const T* a, const T* b, const T* c, size_t size)
+   {
+      apply_function_n<V>(output, size, [](vector va, vector vb, vector vc) { return fused_mul_sub(va, vb, vc, std::is_integral<T>()); },
+                          [](T va, T vb, T vc) { return scalar_fms(va, vb, vc); }, a, b, c);
+   }
+
+   static void axpby(T* output, const T* x, T alpha, const T* y, T beta, size_t size)
+   {
+      const vector alpha_v = V::set1(alpha);
+      const vector beta_v  = V::set1(beta);
+      apply_function_n<V>(output, size,
+                          [&](vector vx, vector vy) { return fused_mul_add(alpha_v, vx, V::mul(beta_v, vy), std::is_integral<T>()); },
+                          [&](T vx, T vy) { return scalar_fma(alpha, vx, static_cast<T>(scalar_mul_t(beta) * scalar_mul_t(vy))); }, x, y);
+   }
+
+private:
+   // the integers wrap around: multiply then add. The floating point types must use the FMA instructions
+   static vector fused_mul_add(vector a, vector b, vector c, std::true_type)
+   {
+      return V::add(V::mul(a, b), c);
+   }
+
+   static vector fused_mul_add(vector a, vector b, vector c, std::false_type)
+   {
+      return V::fma(a, b, c);
+   }
+
+   static vector fused_mul_sub(vector a, vector b, vector c, std::true_type)
+   {
+      return V::sub(V::mul(a, b), c);
+   }
+
+   static vector fused_mul_sub(vector a, vector b, vector c, std::false_type)
+   {
+      return V::fms(a, b, c);
+   }
+
+   static float scalar_fma(float a, float b, float c)
+   {
+      return ::fmaf(a, b, c);
+   }
+
+   static double scalar_fma(double a, double b, double c)
+   {
+      return ::fma(a, b, c);
+   }
+
+   template <class U>
+   static U scalar_fma(U a, U b, U c)
+   {
+      return static_cast<U>(scalar_mul_t(a) * scalar_mul_t(b) + scalar_mul_t(c));
+   }
+
+   static float scalar_fms(float a, float b, float c)
+   {
+      return ::fmaf(a, b, -c);
+   }
+
+   static double scalar_fms(double a, double b, double c)
+   {
+      return ::fma(a, b, -c);
+   }
+
+   template <class U>
+   static U scalar_fms(U a, U b, U c)
+   {
+      return static_cast<U>(scalar_mul_t(a) * scalar_mul_t(b) - scalar_mul_t(c));
+   }
+};
+
+/**
+ @brief The saturated arithmetic and widened sums of the 8 and 16-bit integers, identical to @ref SaturatedArithmetic
+ */
+template <class V>
+struct KernelSaturated
+{
+   using T        = typename V::value_type;
+   using signed_t = typename std::make_signed<T>::type;
+   using vector   = typename V::type;
+
+   static_assert(std::is_unsigned<T>::value && sizeof(T) <= 2, "8 and 16-bit storage types only");
+   static const int bits = 8 * sizeof(T);
+
+   static void add_saturated(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::add_saturated(a, b); },
+                      [](T& a, T b) { a = saturate(static_cast<int>(a) + b); });
+   }
+
+   static void add_saturated_signed(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::add_saturated_signed(a, b); },
+                      [](T& a, T b) { a = saturate_signed(static_cast<int>(signed_t(a)) + signed_t(b)); });
+   }
+
+   static void sub_saturated(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::sub_saturated(a, b); },
+                      [](T& a, T b) { a = saturate(static_cast<int>(a) - b); });
+   }
+
+   static void sub_saturated_signed(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::sub_saturated_signed(a, b); },
+                      [](T& a, T b) { a = saturate_signed(static_cast<int>(signed_t(a)) - signed_t(b)); });
+   }
+
+   static void abs_diff(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::abs_diff(a, b); }, [](T& a, T b) { a = static_cast<T>(a > b ? a - b : b - a); });
+   }
+
+   static void abs_diff_signed(T* v1, const T* v2, size_t size)
+   {
+      apply_binary<V>(v1, v2, size, [](vector a, vector b) { return V::abs_diff_signed(a, b); }, [](T& a, T b) {
+         const int difference = static_cast<int>(signed_t(a)) - signed_t(b);
+         a                    = saturate_signed(difference < 0 ? -difference : difference);
+      });
+   }
+
+   static void mul_high(T* v1, T value, size_t size)
+   {
+      const vector value_v = V::set1(value);
+      apply_unary<V>(v1, size, [&](vector a) { return V::mul_high(a, value_v); },
+                     [&](T& a) { a = static_cast<T>((static_cast<unsigned>(a) * value) >> bits); });
+   }
+
+   static void mul_high_signed(T* v1, T value, size_t size)
+   {
+      const vector value_v = V::set1(value);
+      apply_unary<V>(v1, size, [&](vector a) { return V::mul_high_signed(a, value_v); },
+                     [&](T& a) { a = static_cast<T>((static_cast<int>(signed_t(a)) * signed_t(value)) >> bits); });
+   }
+
+   static void sum_widened(const T* v, std::uint64_t* result, size_t size)
+   {
+      size_t n            = 0;
+      std::uint64_t total = V::reduce_u64(sum_vectors(v, size, n, [](vector a) { return a; }));
+      for (; n < size; ++n)
+      {
+         total += v[n];
+      }
+      result[0] = total;
+   }
+
+   static void sum_widened_signed(const T* v, std::uint64_t* result, size_t size)
+   {
+      // the flipped elements are offset by 2^(bits - 1)
+      size_t n            = 0;
+      std::uint64_t total = V::reduce_u64(sum_vectors(v, size, n, [](vector a) { return V::flip_sign(a); }));
+      total -= static_cast<std::uint64_t>(n) << (bits - 1);
+      for (; n < size; ++n)
+      {
+         total += static_cast<std::uint64_t>(static_cast<std::int64_t>(signed_t(v[n])));
+      }
+      result[0] = total;
+   }
+
+private:
+   static T saturate(int value)
+   {
+      const int max_value = (1 << bits) - 1;
+      return static_cast<T>(value < 0 ? 0 : (value > max_value ? max_value : value));
+   }
+
+   static T saturate_signed(int value)
+   {
+      const int max_value = (1 << (bits - 1)) - 1;
+      return static_cast<T>(value < -max_value - 1 ? -max_value - 1 : (value > max_value ? max_value : value));
+   }
+
+   /// sum the full vectors in 64-bit lanes, n is set to the number of elements processed
+   template <class Op>
+   static vector sum_vectors(const T* v, size_t size, size_t& n, Op op)
+   {
+      vector sum = V::set1(0);
+      for (n = 0; n + V::width <= size; n += V::width)
+      {
+         sum = V::add_u64(sum, V::sum_u64(op(V::load(v + n))));
+      }
+      return sum;
+   }
+};
+
+/**
+ @brief Register the additive kernels (add, sub, add_cte)
+ */
+template <class V>
+void register_additive(Kernels<typename V::value_type>& kernels)
+{
+   kernels.add     = &KernelImpl<V>::add;
+   kernels.sub     = &KernelImpl<V>::sub;
+   kernels.add_cte = &KernelImpl<V>::add_cte;
+}
+
+/**
+ @brief Register the multiplicative kernels (mul, mul_elementwise, addmul)
+ */
+template <class V>
+void register_multiplicative(Kernels<typename V::value_type>& kernels)
+{
+   kernels.mul             = &KernelImpl<V>::mul;
+   kernels.mul_elementwise = &KernelImpl<V>::mul_elementwise;
+   kernels.addmul          = &KernelImpl<V>::addmul;
+}
+
+/**
+ @brief Register the division kernels (div, div_elementwise)
+ */
+template <class V>
+void register_division(Kernels<typename V::value_type>& kernels)
+{
+   kernels.div             = &KernelImpl<V>::div;
+   kernels.div_elementwise = &KernelImpl<V>::div_elementwise;
+}
+
+/**
+ @brief Register the elementwise functions (sqrt, abs, exp, log, sin, cos)
+ */
+template <class V>
+void register_math(Kernels<typename V::value_type>& kernels)
+{
+   kernels.sqrt = &KernelImpl<V>::sqrt;
+   kernels.abs  = &KernelImpl<V>::abs;
+   kernels.exp  = &KernelImpl<V>::exp;
+   kernels.log  = &KernelImpl<V>::log;
+   kernels.sin  = &KernelImpl<V>::sin;
+   kernels.cos  = &KernelImpl<V>::cos;
+}
+
+/**
+ @brief Register the reductions (sum, sum_kahan, norm2sqr, min, max, minmax)
+ */
+template <class V>
+void register_reductions(Kernels<typename V::value_type>& kernels)
+{
+   kernels.sum       = &KernelReduce<V>::sum;
+   kernels.sum_kahan = &KernelReduce<V>::sum_kahan;
+   kernels.norm2sqr  = &KernelReduce<V>::norm2sqr;
+   kernels.min       = &KernelReduce<V>::min;
+   kernels.max       = &KernelReduce<V>::max;
+   kernels.minmax    = &KernelReduce<V>::minmax;
+   kernels.argmin    = &KernelReduce<V>::argmin;
+   kernels.argmax    = &KernelReduce<V>::argmax;
+   kernels.compare   = &KernelCompare<V>::compare;
+   kernels.find      = &KernelCompare<V>::find;
+}
+
+/**
+ @brief The conversion kernels, see @ref convert_value for the semantics
+
+ All the elements go through the vector code: the tail of the line is copied to a full vector
+ */
+template <class C>
+struct KernelConvert
+{
+   using vi = typename C::vi;
+   using vf = typename C::vf;
+   using vd = typename C::vd;
+
+   template <class T>
+   struct Tag
+   {
+   };
+
+   // the largest finite values of the 16-bit floating point types
+   static float max_value(Tag<float16>)
+   {
+      return 65504.0f;
+   }
+
+   static float max_value(Tag<bfloat16>)
+   {
+      return 3.38953139e38f;
+   }
+
+   template <bool Round, bool Saturate>
+   struct Lanes
+   {
+      // integer sources: exact in the int32 lanes, nothing to round
+      static vf apply(vi v, Tag<float>)
+      {
+         return C::to_float(v);
+      }
+
+      static vd apply(vi v, Tag<double>)
+      {
+         return C::to_double(v);
+      }
+
+      template <class To>
+      static vi apply(vi v, Tag<To>)
+      {
+         return Saturate ? C::clamp(v, std::numeric_limits<To>::lowest(), std::numeric_limits<To>::max()) : v;
+      }
+
+      // the 16-bit floating point types are stored from float lanes
+      template <class Format>
+      static vf apply(vi v, Tag<Float16<Format>> tag)
+      {
+         const vf f = C::to_float(v);
+         return Saturate ? C::clamp(f, -max_value(tag), max_value(tag)) : f;
+      }
+
+      template <class Format>
+      static vf apply(vf v, Tag<Float16<Format>> tag)
+      {
+         v = Round ? C::round(v) : v;
+         return Saturate ? C::clamp(v, -max_value(tag), max_value(tag)) : v;
+      }
+
+      template <class Format>
+      static vf apply(vd v, Tag<Float16<Format>> tag)
+      {
+         v = Round ? C::round(v) : v;
+         return C::to_float(Saturate ? C::clamp(v, -static_cast<double>(max_value(tag)), static_cast<double>(max_value(tag))) : v);
+      }
+
+      static vf apply(vf v, Tag<float>)
+      {
+         v = Round ? C::round(v) : v;
+         return Saturate ? C::clamp(v, -FLT_MAX, FLT_MAX) : v;
+      }
+
+      static vd apply(vf v, Tag<double>)
+      {
+         const vd d = C::to_double(Round ? C::round(v) : v);
+         return Saturate ? C::clamp(d, -DBL_MAX, DBL_MAX) : d;
+      }
+
+      template <class To>
+      static vi apply(vf v, Tag<To>)
+      {
+         v = Round ? C::round(v) : v;
+         if (!Saturate)
+         {
+            return C::to_int(v);
+         }
+         if (sizeof(To) == 4)
+         {
+            // INT_MAX is not representable in float
+            return C::to_int_saturated(v);
+         }
+         return C::to_int(C::clamp(C::zero_nan(v), static_cast<float>(std::numeric_limits<To>::lowest()),
+                                   static_cast<float>(std::numeric_limits<To>::max())));
+      }
+
+      static vf apply(vd v, Tag<float>)
+      {
+         v = Round ? C::round(v) : v;
+         return C::to_float(Saturate ? C::clamp(v, -FLT_MAX, FLT_MAX) : v);
+      }
+
+      static vd apply(vd v, Tag<double>)
+      {
+         v = Round ? C::round(v) : v;
+         return Saturate ? C::clamp(v, -DBL_MAX, DBL_MAX) : v;
+      }
+
+      template <class To>
+      static vi apply(vd v, Tag<To>)
+      {
+         v = Round ? C::round(v) : v;
+         if (!Saturate)
+         {
+            return C::to_int(v);
+         }
+         return C::to_int(C::clamp(C::zero_nan(v), static_cast<double>(std::numeric_limits<To>::lowest()),
+                                   static_cast<double>(std::numeric_limits<To>::max())));
+      }
+   };
+
+   template <class To, class From, bool Round, bool Saturate>
+   static void convert(void* output_void, const void* input_void, size_t size)
+   {
+      using lanes       = Lanes<Round, Saturate>;
+      To* output        = static_cast<To*>(output_void);
+      const From* input = static_cast<const From*>(input_void);
+
+      size_t n = 0;
+      for (; n + C::width <= size; n += C::width)
+      {
+         C::store(output + n, lanes::apply(C::load(input + n), Tag<To>()));
+      }
+
+      if (n < size)
+      {
+         From input_tail[C::width] = {};
+         To output_tail[C::width];
+         memcpy(input_tail, input + n, (size - n) * sizeof(From));
+         C::store(output_tail, lanes::apply(C::load(input_tail), Tag<To>()));
+         memcpy(output + n, output_tail, (size - n) * sizeof(To));
+      }
+   }
+};
+
+/**
+ @brief The arithmetic of the 16-bit floating point types T, computed in the float lanes of the conversion traits C
+
+ As for the scalar operators of @ref float16, each result is computed in float and rounded once to T
+ */
+template <class C, class T>
+struct KernelReducedFloat
+{
+   using vf = typename C::vf;
+
+   template <class Op>
+   static void binary(T* v1, const T* v2, size_t size, Op op)
+   {
+      size_t n = 0;
+      for (; n + C::width <= size; n += C::width)
+      {
+         C::store(v1 + n, op(C::load(v1 + n), C::load(v2 + n)));
+      }
+
+      if (n < size)
+      {
+         T v1_tail[C::width] = {};
+         T v2_tail[C::width] = {};
+         memcpy(v1_tail, v1 + n, (size - n) * sizeof(T));
+         memcpy(v2_tail, v2 + n, (size - n) * sizeof(T));
+         C::store(v1_tail, op(C::load(v1_tail), C::load(v2_tail)));
+         memcpy(v1 + n, v1_tail, (size - n) * sizeof(T));
+      }
+   }
+
+   template <class Op>
+   static void unary(T* v1, size_t size, Op op)
+   {
+      size_t n = 0;
+      for (; n + C::width <= size; n += C::width)
+      {
+         C::store(v1 + n, op(C::load(v1 + n)));
+      }
+
+      if (n < size)
+      {
+         T v1_tail[C::width] = {};
+         memcpy(v1_tail, v1 + n, (size - n) * sizeof(T));
+         C::store(v1_tail, op(C::load(v1_tail)));
+         memcpy(v1 + n, v1_tail, (size - n) * sizeof(T));
+      }
+   }
+
+   static vf broadcast(T value)
+   {
+      T values[C::width];
+      for (size_t n = 0; n < C::width; ++n)
+      {
+         values[n] = value;
+      }
+      return C::load(values);
+   }
+
+   static void add(T* v1, const T* v2, size_t size)
+   {
+      binary(v1, v2, size, [](vf a, vf b) { return C::add(a, b); });
+   }
+
+   static void sub(T* v1, const T* v2, size_t size)
+   {
+      binary(v1, v2, size, [](vf a, vf b) { return C::sub(a, b); });
+   }
+
+   static void mul_elementwise(T* v1, const T* v2, size_t size)
+   {
+      binary(v1, v2, size, [](vf a, vf b) { return C::mul(a, b); });
+   }
+
+   static void div_elementwise(T* v1, const T* v2, size_t size)
+   {
+      binary(v1, v2, size, [](vf a, vf b) { return C::div(a, b); });
+   }
+
+   static void add_cte(T* v1, T value, size_t size)
+   {
+      const vf value_v = broadcast(value);
+      unary(v1, size, [&](vf a) { return C::add(a, value_v); });
+   }
+
+   static void mul(T* v1, T value, size_t size)
+   {
+      const vf value_v = broadcast(value);
+      unary(v1, size, [&](vf a) { return C::mul(a, value_v); });
+   }
+
+   static void div(T* v1, T value, size_t size)
+   {
+      const vf value_v = broadcast(value);
+      unary(v1, size, [&](vf a) { return C::div(a, value_v); });
+   }
+
+   static void addmul(T* v1, const T* v2, T value, size_t size)
+   {
+      const vf value_v = broadcast(value);
+      binary(v1, v2, size, [&](vf a, vf b) { return C::sub(a, C::mul(b, value_v)); });
+   }
+};
+
+/**
+ @brief Register the arithmetic kernels of a 16-bit floating point type T given the conversion traits C
+ */
+template <class C, class T>
+void register_reduced_float(Kernels<T>& kernels)
+{
+   using impl              = KernelReducedFloat<C, T>;
+   kernels.add             = &impl::add;
+   kernels.sub             = &impl::sub;
+   kernels.add_cte         = &impl::add_cte;
+   kernels.mul             = &impl::mul;
+   kernels.div             = &impl::div;
+   kernels.mul_elementwise = &impl::mul_elementwise;
+   kernels.div_elementwise = &impl::div_elementwise;
+   kernels.addmul          = &impl::addmul;
+}
+
+template <class C, size_t To, size_t From>
+int register_conversion(ConversionKernels& kernels)
+{
+   using to_type   = typename std::tuple_element<To, conversion_types>::type;
+   using from_type = typename std::tuple_element<From, conversion_types>::type;
+   static_assert(conversion_type<to_type>::value == static_cast<int>(To), "conversion_type doesn't match conversion_types");
+
+   auto& convert                                            = kernels.convert[To][From];
+   convert[static_cast<size_t>(Conversion::cast)]           = &KernelConvert<C>::template convert<to_type, from_type, false, false>;
+   convert[static_cast<size_t>(Conversion::saturate)]       = &KernelConvert<C>::template convert<to_type, from_type, false, true>;
+   convert[static_cast<size_t>(Conversion::round)]          = &KernelConvert<C>::template convert<to_type, from_type, true, false>;
+   convert[static_cast<size_t>(Conversion::round_saturate)] = &KernelConvert<C>::template convert<to_type, from_type, true, true>;
+   return 0;
+}
+
+template <class C, size_t To, size_t... From>
+int register_conversions_to(ConversionKernels& kernels, std::index_sequence<From...>)
+{
+   const int registered[] = {register_conversion<C, To, From>(kernels)...};
+   (void)registered;
+   return 0;
+}
+
+template <class C, size_t... To>
+void register_conversions(ConversionKernels& kernels, std::index_sequence<To...>)
+{
+   const int registered[] = {register_conversions_to<C, To>(kernels, std::make_index_sequence<nb_conversion_types>())...};
+   (void)registered;
+}
+
+/**
+ @brief Register the conversion kernels between all the @ref conversion_types given the conversion traits C
+ */
+template <class C>
+void register_conversions(ConversionKernels& kernels)
+{
+   register_conversions<C>(kernels, std::make_index_sequence<nb_conversion_types>());
+}
+
+/**
+ @brief The gather kernel is only registered if the traits provide gather()
+ */
+template <class V>
+auto register_gather(Kernels<typename V::value_type>& kernels, int) -> decltype(V::gather(nullptr, nullptr), void())
+{
+   static_assert(sizeof(size_t) == 8, "the gather instructions use 64-bit offsets");
+   kernels.gather = &KernelImpl<V>::gather;
+}
+
+template <class V>
+void register_gather(Kernels<typename V::value_type>&, long)
+{
+}
+
+/**
+ @brief True if the fused kernels of V round as @ref FusedArithmetic: the integers, and the floating point types with V::fma
+ */
+template <class V, class = void>
+struct has_fused_kernels : public std::is_integral<typename V::value_type>
+{
+};
+
+template <class V>
+struct has_fused_kernels<V, decltype(V::fma(V::set1(0), V::set1(0), V::set1(0)), void())> : public std::true_type
+{
+};
+
+/**
+ @brief Register the fused kernels (fma, fms, axpby) if they are supported by V
+ */
+template <class V>
+void register_fused(Kernels<typename V::value_type>& kernels, std::true_type)
+{
+   kernels.fma   = &KernelImpl<V>::fma;
+   kernels.fms   = &KernelImpl<V>::fms;
+   kernels.axpby = &KernelImpl<V>::axpby;
+}
+
+template <class V>
+void register_fused(Kernels<typename V::value_type>&, std::false_type)
+{
+}
+
+template <class V>
+void register_fused(Kernels<typename V::value_type>& kernels)
+{
+   register_fused<V>(kernels, has_fused_kernels<V>());
+}
+
+/**
+ @brief Register the saturated arithmetic and the widened sums of the 8 and 16-bit integers
+ */
+template <class V>
+void register_saturated(Kernels<typename V::value_type>& kernels)
+{
+   kernels.add_saturated        = &KernelSaturated<V>::add_saturated;
+   kernels.add_saturated_signed = &KernelSaturated<V>::add_saturated_signed;
+   kernels.sub_saturated        = &KernelSaturated<V>::sub_saturated;
+   kernels.sub_saturated_signed = &KernelSaturated<V>::sub_saturated_signed;
+   kernels.abs_diff             = &KernelSaturated<V>::abs_diff;
+   kernels.abs_diff_signed      = &KernelSaturated<V>::abs_diff_signed;
+   kernels.mul_high             = &KernelSaturated<V>::mul_high;
+   kernels.mul_high_signed      = &KernelSaturated<V>::mul_high_signed;
+   kernels.sum_widened          = &KernelSaturated<V>::sum_widened;
+   kernels.sum_widened_signed   = &KernelSaturated<V>::sum_widened_signed;
+}
+
+/**
+ @brief Register all the kernels of an instruction set given its vector traits Vec<T>
+ */
+template <template <class> class Vec>
+void register_kernels(KernelTables& kernels)
+{
+   register_additive<Vec<float>>(std::get<Kernels<float>>(kernels));
+   register_multiplicative<Vec<float>>(std::get<Kernels<float>>(kernels));
+   register_division<Vec<float>>(std::get<Kernels<float>>(kernels));
+   register_math<Vec<float>>(std::get<Kernels<float>>(kernels));
+   register_reductions<Vec<float>>(std::get<Kernels<float>>(kernels));
+   register_gather<Vec<float>>(std::get<Kernels<float>>(kernels), 0);
+   register_fused<Vec<float>>(std::get<Kernels<float>>(kernels));
+
+   register_additive<Vec<double>>(std::get<Kernels<double>>(kernels));
+   register_multiplicative<Vec<double>>(std::get<Kernels<double>>(kernels));
+   register_division<Vec<double>>(std::get<Kernels<double>>(kernels));
+   register_math<Vec<double>>(std::get<Kernels<double>>(kernels));
+   register_reductions<Vec<double>>(std::get<Kernels<double>>(kernels));
+   register_gather<Vec<double>>(std::get<Kernels<double>>(kernels), 0);
+   register_fused<Vec<double>>(std::get<Kernels<double>>(kernels));
+
+   // no integer division instruction
+   register_additive<Vec<std::uint32_t>>(std::get<Kernels<std::uint32_t>>(kernels));
+   register_multiplicative<Vec<std::uint32_t>>(std::get<Kernels<std::uint32_t>>(kernels));
+   register_fused<Vec<std::uint32_t>>(std::get<Kernels<std::uint32_t>>(kernels));
+
+   register_additive<Vec<std::uint16_t>>(std::get<Kernels<std::uint16_t>>(kernels));
+   register_multiplicative<Vec<std::uint16_t>>(std::get<Kernels<std::uint16_t>>(kernels));
+   register_fused<Vec<std::uint16_t>>(std::get<Kernels<std::uint16_t>>(kernels));
+   register_saturated<Vec<std::uint16_t>>(std::get<Kernels<std::uint16_t>>(kernels));
+
+   register_additive<Vec<std::uint8_t>>(std::get<Kernels<std::uint8_t>>(kernels));
+   register_multiplicative<Vec<std::uint8_t>>(std::get<Kernels<std::uint8_t>>(kernels));
+   register_fused<Vec<std::uint8_t>>(std::get<Kernels<std::uint8_t>>(kernels));
+   register_saturated<Vec<std::uint8_t>>(std::get<Kernels<std::uint8_t>>(kernels));
+}
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
@@ -0,0 +1,441 @@
+#include "op-naive-simd-kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NLL_SIMD_SSE2_ENABLED
+#endif
+
+DECLARE_NAMESPACE_NLL
+
+namespace details
+{
+namespace simd
+{
+namespace sse2
+{
+#ifdef NLL_SIMD_SSE2_ENABLED
+template <class T>
+struct Vec;
+
+template <>
+struct Vec<float>
+{
+   using value_type              = float;
+   using type                    = __m128;
+   static const size_t width     = 4;
+   static const size_t alignment = 16;
+   static const bool masked      = false;
+
+   static type load(const float* p)
+   {
+      return _mm_loadu_ps(p);
+   }
+   static void store(float* p, type v)
+   {
+      _mm_storeu_ps(p, v);
+   }
+   static type set1(float v)
+   {
+      return _mm_set1_ps(v);
+   }
+   static type add(type a, type b)
+   {
+      return _mm_add_ps(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm_sub_ps(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm_mul_ps(a, b);
+   }
+   static type div(type a, type b)
+   {
+      return _mm_div_ps(a, b);
+   }
+   static type min(type a, type b)
+   {
+      return _mm_min_ps(a, b);
+   }
+   static type max(type a, type b)
+   {
+      return _mm_max_ps(a, b);
+   }
+
+   using compare_type = __m128;
+   static compare_type lt(type a, type b)
+   {
+      return _mm_cmplt_ps(a, b);
+   }
+   static compare_type gt(type a, type b)
+   {
+      return _mm_cmpgt_ps(a, b);
+   }
+   static compare_type eq(type a, type b)
+   {
+      return _mm_cmpeq_ps(a, b);
+   }
+   static compare_type is_nan(type a)
+   {
+      return _mm_cmpunord_ps(a, a);
+   }
+   static type select(compare_type c, type if_true, type if_false)
+   {
+      return _mm_or_ps(_mm_and_ps(c, if_true), _mm_andnot_ps(c, if_false));
+   }
+   static bool any(compare_type c)
+   {
+      return _mm_movemask_ps(c) != 0;
+   }
+   static std::uint64_t bits(compare_type c)
+   {
+      return static_cast<std::uint64_t>(_mm_movemask_ps(c));
+   }
+
+   static type abs(type a)
+   {
+      return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);
+   }
+   static type sqrt(type a)
+   {
+      return _mm_sqrt_ps(a);
+   }
+   static type round(type a)
+   {
+      return _mm_cvtepi32_ps(_mm_cvtps_epi32(a));
+   }
+   static type trunc(type a)
+   {
+      return _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+   }
+   static type pow2n(type n)
+   {
+      return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23));
+   }
+   static type frexp(type x, type& exponent)
+   {
+      const __m128i bits = _mm_castps_si128(x);
+      exponent           = _mm_sub_ps(_mm_cvtepi32_ps(_mm_srli_epi32(bits, 23)), _mm_set1_ps(126.0f));
+      return _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x807fffff)), _mm_set1_epi32(0x3f000000)));
+   }
+};
+
+template <>
+struct Vec<double>
+{
+   using value_type              = double;
+   using type                    = __m128d;
+   static const size_t width     = 2;
+   static const size_t alignment = 16;
+   static const bool masked      = false;
+
+   static type load(const double* p)
+   {
+      return _mm_loadu_pd(p);
+   }
+   static void store(double* p, type v)
+   {
+      _mm_storeu_pd(p, v);
+   }
+   static type set1(double v)
+   {
+      return _mm_set1_pd(v);
+   }
+   static type add(type a, type b)
+   {
+      return _mm_add_pd(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm_sub_pd(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm_mul_pd(a, b);
+   }
+   static type div(type a, type b)
+   {
+      return _mm_div_pd(a, b);
+   }
+   static type min(type a, type b)
+   {
+      return _mm_min_pd(a, b);
+   }
+   static type max(type a, type b)
+   {
+      return _mm_max_pd(a, b);
+   }
+
+   using compare_type = __m128d;
+   static compare_type lt(type a, type b)
+   {
+      return _mm_cmplt_pd(a, b);
+   }
+   static compare_type gt(type a, type b)
+   {
+      return _mm_cmpgt_pd(a, b);
+   }
+   static compare_type eq(type a, type b)
+   {
+      return _mm_cmpeq_pd(a, b);
+   }
+   static compare_type is_nan(type a)
+   {
+      return _mm_cmpunord_pd(a, a);
+   }
+   static type select(compare_type c, type if_true, type if_false)
+   {
+      return _mm_or_pd(_mm_and_pd(c, if_true), _mm_andnot_pd(c, if_false));
+   }
+   static bool any(compare_type c)
+   {
+      return _mm_movemask_pd(c) != 0;
+   }
+   static std::uint64_t bits(compare_type c)
+   {
+      return static_cast<std::uint64_t>(_mm_movemask_pd(c));
+   }
+
+   static type abs(type a)
+   {
+      return _mm_andnot_pd(_mm_set1_pd(-0.0), a);
+   }
+   static type sqrt(type a)
+   {
+      return _mm_sqrt_pd(a);
+   }
+   static type round(type a)
+   {
+      return _mm_cvtepi32_pd(_mm_cvtpd_epi32(a));
+   }
+   static type trunc(type a)
+   {
+      return _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
+   }
+   static type pow2n(type n)
+   {
+      // the biased exponents are duplicated in both halves of the 64-bit lanes, the high half is shifted out
+      const __m128i e = _mm_add_epi32(_mm_shuffle_epi32(_mm_cvtpd_epi32(n), _MM_SHUFFLE(1, 1, 0, 0)), _mm_set1_epi32(1023));
+      return _mm_castsi128_pd(_mm_slli_epi64(e, 52));
+   }
+   static type frexp(type x, type& exponent)
+   {
+      // the exponent bits are converted to double using the 2^52 magic number
+      const __m128i bits  = _mm_castpd_si128(x);
+      const __m128i magic = _mm_set1_epi64x(0x4330000000000000ll);
+      exponent = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(bits, 52), magic)), _mm_set1_pd(4503599627370496.0 + 1022.0));
+      return _mm_castsi128_pd(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi64x(0x800fffffffffffffll)), _mm_set1_epi64x(0x3fe0000000000000ll)));
+   }
+};
+
+/**
+ @brief Common to all integer vectors
+ */
+template <class T, size_t Width>
+struct VecInteger
+{
+   using value_type              = T;
+   using type                    = __m128i;
+   static const size_t width     = Width;
+   static const size_t alignment = 16;
+   static const bool masked      = false;
+
+   static type load(const T* p)
+   {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+   }
+   static void store(T* p, type v)
+   {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+   }
+   static type add_u64(type a, type b)
+   {
+      return _mm_add_epi64(a, b);
+   }
+   static std::uint64_t reduce_u64(type a)
+   {
+      alignas(alignment) std::uint64_t lanes[2];
+      _mm_store_si128(reinterpret_cast<type*>(lanes), a);
+      return lanes[0] + lanes[1];
+   }
+};
+
+template <>
+struct Vec<std::uint32_t> : public VecInteger<std::uint32_t, 4>
+{
+   static type set1(std::uint32_t v)
+   {
+      return _mm_set1_epi32(static_cast<int>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm_add_epi32(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm_sub_epi32(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      // no 32-bit multiplication in SSE2: multiply the even and odd elements as 64-bit and interleave the low parts
+      const __m128i even = _mm_mul_epu32(a, b);
+      const __m128i odd  = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+      return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+   }
+};
+
+template <>
+struct Vec<std::uint16_t> : public VecInteger<std::uint16_t, 8>
+{
+   static type set1(std::uint16_t v)
+   {
+      return _mm_set1_epi16(static_cast<short>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm_add_epi16(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm_sub_epi16(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      return _mm_mullo_epi16(a, b);
+   }
+   static type add_saturated(type a, type b)
+   {
+      return _mm_adds_epu16(a, b);
+   }
+   static type add_saturated_signed(type a, type b)
+   {
+      return _mm_adds_epi16(a, b);
+   }
+   static type sub_saturated(type a, type b)
+   {
+      return _mm_subs_epu16(a, b);
+   }
+   static type sub_saturated_signed(type a, type b)
+   {
+      return _mm_subs_epi16(a, b);
+   }
+   static type abs_diff(type a, type b)
+   {
+      return _mm_or_si128(_mm_subs_epu16(a, b), _mm_subs_epu16(b, a));
+   }
+   static type abs_diff_signed(type a, type b)
+   {
+      // max - min is in [0, 65535]: saturated to the signed range
+      return _mm_subs_epi16(_mm_max_epi16(a, b), _mm_min_epi16(a, b));
+   }
+   static type mul_high(type a, type b)
+   {
+      return _mm_mulhi_epu16(a, b);
+   }
+   static type mul_high_signed(type a, type b)
+   {
+      return _mm_mulhi_epi16(a, b);
+   }
+   static type flip_sign(type a)
+   {
+      return _mm_xor_si128(a, _mm_set1_epi16(static_cast<short>(0x8000)));
+   }
+   static type sum_u64(type a)
+   {
+      // zero extend to 32 then 64 bits: the order of the lanes doesn't matter for the sum
+      const __m128i zero  = _mm_setzero_si128();
+      const __m128i sum32 = _mm_add_epi32(_mm_unpacklo_epi16(a, zero), _mm_unpackhi_epi16(a, zero));
+      return _mm_add_epi64(_mm_unpacklo_epi32(sum32, zero), _mm_unpackhi_epi32(sum32, zero));
+   }
+};
+
+template <>
+struct Vec<std::uint8_t> : public VecInteger<std::uint8_t, 16>
+{
+   static type set1(std::uint8_t v)
+   {
+      return _mm_set1_epi8(static_cast<char>(v));
+   }
+   static type add(type a, type b)
+   {
+      return _mm_add_epi8(a, b);
+   }
+   static type sub(type a, type b)
+   {
+      return _mm_sub_epi8(a, b);
+   }
+   static type mul(type a, type b)
+   {
+      // no 8-bit multiplication: multiply the even and odd bytes as 16-bit and merge the low bytes
+      const __m128i even = _mm_mullo_epi16(a, b);
+      const __m128i odd  = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+      return _mm_or_si128(_mm_slli_epi16(odd, 8), _mm_and_si128(even, _mm_set1_epi16(0xff)));
+   }
+   static type add_saturated(type a, type b)
+   {
+      return _mm_adds_epu8(a, b);
+   }
+   static type add_saturated_signed(type a, type b)
+   {
+      return _mm_adds_epi8(a, b);
+   }
+   static type sub_saturated(type a, type b)
+   {
+      return _mm_subs_epu8(a, b);
+   }
+   static type sub_saturated_signed(type a, type b)
+   {
+      return _mm_subs_epi8(a, b);
+   }
+   static type abs_diff(type a, type b)
+   {
+      return _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+   }
+   static type abs_diff_signed(type a, type b)
+   {
+      // the difference is exact in the unsigned range, then saturated to the signed range
+      const __m128i difference = abs_diff(flip_sign(a), flip_sign(b));
+      return _mm_min_epu8(difference, _mm_set1_epi8(127));
+   }
+   static type mul_high(type a, type b)
+   {
+      // the 16-bit products of the even and odd bytes, their high bytes merged
+      const __m128i low_bytes = _mm_set1_epi16(0xff);
+      const __m128i even      = _mm_mullo_epi16(_mm_and_si128(a, low_bytes), _mm_and_si128(b, low_bytes));
+      const __m128i odd       = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+      return _mm_or_si128(_mm_srli_epi16(even, 8), _mm_andnot_si128(low_bytes, odd));
+   }
+   static type mul_high_signed(type a, type b)
+   {
+      // same as mul_high with the bytes sign extended
+      const __m128i even = _mm_mullo_epi16(_mm_srai_epi16(_mm_slli_epi16(a, 8), 8), _mm_srai_epi16(_mm_slli_epi16(b, 8), 8));
+      const __m128i odd  = _mm_mullo_epi16(_mm_srai_epi16(a, 8), _mm_srai_epi16(b, 8));
+      return _mm_or_si128(_mm_srli_epi16(even, 8), _mm_andnot_si128(_mm_set1_epi16(0xff), odd));
+   }
+   static type flip_sign(type a)
+   {
+      return _mm_xor_si128(a, _mm_set1_epi8(static_cast<char>(0x80)));
+   }
+   static type sum_u64(type a)
+   {
+      return _mm_sad_epu8(a, _mm_setzero_si128());
+   }
+};
+
+bool registerKernels(KernelTables& kernels)
+{
+   register_kernels<Vec>(kernels);
+   return true;
+}
+#else
+bool registerKernels(KernelTables&)
+{
+   return false;
+}
+#endif
+}
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
@@ -0,0 +1,158 @@
+#include "op-naive-simd.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define NLL_SIMD_X86
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define NLL_SIMD_X86
+#endif
+
+DECLARE_NAMESPACE_NLL
+
+namespace details
+{
+namespace simd
+{
+// implemented in the instruction set specific translation units. Return false if the instruction set was not compiled
+namespace sse2
+{
+bool registerKernels(KernelTables& kernels);
+}
+
+namespace avx2
+{
+bool registerKernels(KernelTables& kernels);
+}
+
+namespace avx512
+{
+bool registerKernels(KernelTables& kernels);
+}
+
+namespace
+{
+#ifdef NLL_SIMD_X86
+void cpuid(unsigned leaf, unsigned subleaf, unsigned registers[4])
+{
+#ifdef _MSC_VER
+   int r[4];
+   __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+   for (int n = 0; n < 4; ++n)
+   {
+      registers[n] = static_cast<unsigned>(r[n]);
+   }
+#else
+   __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+/**
+ @brief Read the XCR0 register: the register states saved by the OS on context switches
+ */
+unsigned long long xgetbv0()
+{
+#ifdef _MSC_VER
+   return _xgetbv(0);
+#else
+   unsigned eax = 0;
+   unsigned edx = 0;
+   __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+   return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+Isa detectIsa()
+{
+   unsigned registers[4];
+   cpuid(0, 0, registers);
+   const unsigned max_leaf = registers[0];
+
+   cpuid(1, 0, registers);
+   const bool has_sse2    = (registers[3] & (1u << 26)) != 0;
+   const bool has_osxsave = (registers[2] & (1u << 27)) != 0;
+   const bool has_fma     = (registers[2] & (1u << 12)) != 0;
+   const bool has_avx     = (registers[2] & (1u << 28)) != 0;
+   const bool has_f16c    = (registers[2] & (1u << 29)) != 0;
+   if (!has_sse2)
+   {
+      return Isa::none;
+   }
+   if (!has_osxsave || !has_avx || max_leaf < 7)
+   {
+      return Isa::sse2;
+   }
+
+   // the OS must save the XMM & YMM states
+   const unsigned long long xcr0 = xgetbv0();
+   if ((xcr0 & 0x6) != 0x6)
+   {
+      return Isa::sse2;
+   }
+
+   cpuid(7, 0, registers);
+   const bool has_avx2     = (registers[1] & (1u << 5)) != 0;
+   const bool has_avx512f  = (registers[1] & (1u << 16)) != 0;
+   const bool has_avx512bw = (registers[1] & (1u << 30)) != 0;
+   if (!has_avx2 || !has_f16c || !has_fma)
+   {
+      return Isa::sse2;
+   }
+
+   // the OS must also save the opmask & ZMM states
+   if (has_avx512f && has_avx512bw && (xcr0 & 0xe6) == 0xe6)
+   {
+      return Isa::avx512;
+   }
+   return Isa::avx2;
+}
+#else
+Isa detectIsa()
+{
+   return Isa::none;
+}
+#endif
+}
+
+SimdDispatcher& SimdDispatcher::instance()
+{
+   static SimdDispatcher i;
+   return i;
+}
+
+SimdDispatcher::SimdDispatcher() : _supportedIsa(detectIsa()), _isa(Isa::none)
+{
+   setIsa(_supportedIsa);
+
+   // the instruction sets supported by the CPU may not all be compiled
+   _supportedIsa = _isa;
+}
+
+void SimdDispatcher::setIsa(Isa isa)
+{
+   if (isa > _supportedIsa)
+   {
+      isa = _supportedIsa;
+   }
+
+   // register the kernels from the least to the most capable instruction set so that
+   // an operation not vectorized by an instruction set uses the previous one
+   _kernels = KernelTables();
+   _isa     = Isa::none;
+   if (isa >= Isa::sse2 && sse2::registerKernels(_kernels))
+   {
+      _isa = Isa::sse2;
+   }
+   if (isa >= Isa::avx2 && avx2::registerKernels(_kernels))
+   {
+      _isa = Isa::avx2;
+   }
+   if (isa >= Isa::avx512 && avx512::registerKernels(_kernels))
+   {
+      _isa = Isa::avx512;
+   }
+}
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
@@ -0,0 +1,672 @@
+#pragma once
+
+#include <array/array-api.h>
+#include <array/config.h>
+#include "float16.h"
+#include <cstdint>
+#include <tuple>
+
+/**
+ @file
+
+ Runtime dispatched SIMD kernels for the building blocks of op-naive.h.
+
+ The kernels are compiled for several instruction sets (SSE2, AVX2, AVX-512) in separate translation units
+ and the best one supported by the CPU is selected once at startup using CPUID. The building blocks
+ of op-naive.h forward unit-stride memory lines to these kernels so that all the naive operators benefit
+ from the vectorization without any change in their API.
+ */
+
+DECLARE_NAMESPACE_NLL
+
+/**
+ @brief The elementwise comparisons, see @ref bitmask
+ */
+enum class Comparison
+{
+   less,
+   less_equal,
+   greater,
+   greater_equal,
+   equal,
+   not_equal
+};
+
+/**
+ @brief The conversions between arithmetic types, see @ref details::convert_value for the exact semantics
+ */
+enum class Conversion
+{
+   cast,          /// static_cast: truncation toward zero from floating point to integer, the low bits are kept by the integer narrowing
+   saturate,      /// the values are clamped to the range of the destination type (NaN is converted to 0 for integers), then cast
+   round,         /// rounded to the nearest integer, halfway cases away from zero (std::round), then cast
+   round_saturate /// rounded, then saturated
+};
+
+namespace details
+{
+namespace simd
+{
+/**
+ @brief The instruction sets the kernels are compiled for, ordered by capability
+ */
+enum class Isa
+{
+   none = 0, /// scalar code only
+   sse2,
+   avx2,
+   avx512 /// AVX-512 F + BW
+};
+
+/**
+ @brief Placeholder storage type for the types that are not vectorized
+ */
+struct not_vectorized
+{
+};
+
+/**
+ @brief The type the kernels are operating on for a given type T
+
+ Integral types are mapped to the unsigned type of the same size: additions, subtractions and
+ the low part of the multiplications are identical for signed and unsigned types (and the kernels
+ do not have to deal with signed overflows).
+ */
+template <class T, size_t Size = sizeof(T), bool Integral = std::is_integral<T>::value && !std::is_same<T, bool>::value>
+struct storage_type
+{
+   using type = not_vectorized;
+};
+
+template <>
+struct storage_type<float, sizeof(float), false>
+{
+   using type = float;
+};
+
+template <>
+struct storage_type<double, sizeof(double), false>
+{
+   using type = double;
+};
+
+/**
+ @brief The 16-bit floating point types are converted to float in the kernels
+ */
+template <>
+struct storage_type<float16, sizeof(float16), false>
+{
+   using type = float16;
+};
+
+template <>
+struct storage_type<bfloat16, sizeof(bfloat16), false>
+{
+   using type = bfloat16;
+};
+
+template <class T>
+struct storage_type<T, 4, true>
+{
+   using type = std::uint32_t;
+};
+
+template <class T>
+struct storage_type<T, 2, true>
+{
+   using type = std::uint16_t;
+};
+
+template <class T>
+struct storage_type<T, 1, true>
+{
+   using type = std::uint8_t;
+};
+
+template <class T>
+using storage_t = typename storage_type<T>::type;
+
+/**
+ @brief Number of independent accumulators of the sum reductions (128 bytes of accumulators)
+
+ The element n of a memory line is accumulated in the lane n % value and the lanes are then combined pairwise.
+ The vectorized kernels and the scalar code (see @ref sum_naive) follow exactly this order of operations so
+ that the sums don't depend on the instruction set. This requires the compiler not to fuse the multiplications
+ and additions (e.g., GCC's -ffp-contract=off).
+ */
+template <class T>
+struct reduction_lanes
+{
+   static const size_t value = 128 / sizeof(T);
+};
+
+/**
+ @brief A test of the elements of a memory line that can be evaluated by the kernels, see @ref Kernels::find
+ */
+template <class T>
+struct LinePredicate
+{
+   enum class Test
+   {
+      compare,     /// element comparison value
+      nan,         /// the element is NaN
+      finite,      /// the element is neither NaN nor infinite
+      approx_equal /// |element - value| <= tolerance
+   };
+
+   Test test             = Test::compare;
+   Comparison comparison = Comparison::equal;
+   T value               = T(0);
+   T tolerance           = T(0);
+};
+
+/**
+ @brief The kernels available for a storage type T. Operations not vectorized for T are nullptr.
+
+ All kernels are operating on unit-stride memory.
+ */
+template <class T>
+struct Kernels
+{
+   using binary_t       = void (*)(T* v1, const T* v2, size_t size);
+   using constant_t     = void (*)(T* v1, T value, size_t size);
+   using binary_const_t = void (*)(T* v1, const T* v2, T value, size_t size);
+   using function_t     = void (*)(T* output, const T* input, size_t size);
+   using reduce_t       = void (*)(const T* v, T* result, size_t size);
+   using arg_reduce_t   = void (*)(const T* v, T* value, size_t* index, size_t size);
+   using compare_t      = void (*)(std::uint64_t* bits, const T* v1, const T* v2, T value, Comparison comparison, size_t size);
+   using find_t         = void (*)(const T* v, const LinePredicate<T>* predicate, bool expected, size_t* position, size_t size);
+   using gather_t       = void (*)(T* output, const T* input, const size_t* offsets, size_t size);
+   using ternary_t      = void (*)(T* output, const T* a, const T* b, const T* c, size_t size);
+   using axpby_t        = void (*)(T* output, const T* x, T alpha, const T* y, T beta, size_t size);
+   using sum_widened_t  = void (*)(const T* v, std::uint64_t* result, size_t size);
+
+   binary_t add             = nullptr; /// v1 += v2
+   binary_t sub             = nullptr; /// v1 -= v2
+   constant_t add_cte       = nullptr; /// v1 += value
+   constant_t mul           = nullptr; /// v1 *= value
+   constant_t div           = nullptr; /// v1 /= value
+   binary_t mul_elementwise = nullptr; /// v1 *= v2
+   binary_t div_elementwise = nullptr; /// v1 /= v2
+   binary_const_t addmul    = nullptr; /// v1 -= v2 * value, see @ref addmul_naive
+
+   // elementwise functions, output = f(input). Can be used in place (output == input)
+   function_t sqrt = nullptr; /// correctly rounded
+   function_t abs  = nullptr; /// exact
+   function_t exp  = nullptr; /// see @ref VectorMath for the accuracy
+   function_t log  = nullptr;
+   function_t sin  = nullptr;
+   function_t cos  = nullptr;
+
+   // reductions of a memory line, the result is overwritten. NaN are ignored by min & max
+   reduce_t sum       = nullptr; /// result[0] = sum(v), see @ref reduction_lanes
+   reduce_t sum_kahan = nullptr; /// result[0] + result[1] = sum(v), result[1] being the compensation term
+   reduce_t norm2sqr  = nullptr; /// result[0] = sum(v^2), see @ref reduction_lanes
+   reduce_t min       = nullptr; /// result[0] = min(v)
+   reduce_t max       = nullptr; /// result[0] = max(v)
+   reduce_t minmax    = nullptr; /// result[0] = min(v), result[1] = max(v)
+
+   // first position of the min or max of a memory line, see @ref argmax for the handling of NaN
+   arg_reduce_t argmin = nullptr; /// *value = v[*index] = min(v)
+   arg_reduce_t argmax = nullptr; /// *value = v[*index] = max(v)
+
+   // bit n of bits is (v1[n] comparison v2[n]), or (v1[n] comparison value) if v2 is nullptr. The bits after size are set to 0
+   compare_t compare = nullptr;
+
+   // *position is the first n such that predicate(v[n]) == expected, size if there is none
+   find_t find = nullptr;
+
+   // output[n] = input[offsets[n]], only available with gather instructions
+   gather_t gather = nullptr;
+
+   // fused elementwise operations in a single pass, identical to @ref FusedArithmetic: the floating point types
+   // are only available with FMA instructions. output may be the same memory as any of the inputs (in place)
+   ternary_t fma = nullptr; /// output = a * b + c
+   ternary_t fms = nullptr; /// output = a * b - c
+   axpby_t axpby = nullptr; /// output = alpha * x + beta * y
+
+   // 8 and 16-bit integers, see @ref SaturatedArithmetic. The storage type being unsigned, the kernels of the signed
+   // types are separate
+   binary_t add_saturated           = nullptr; /// v1 = saturate(v1 + v2)
+   binary_t add_saturated_signed    = nullptr;
+   binary_t sub_saturated           = nullptr; /// v1 = saturate(v1 - v2)
+   binary_t sub_saturated_signed    = nullptr;
+   binary_t abs_diff                = nullptr; /// v1 = saturate(|v1 - v2|)
+   binary_t abs_diff_signed         = nullptr;
+   constant_t mul_high              = nullptr; /// v1 = (v1 * value) >> bits, the high half of the product
+   constant_t mul_high_signed       = nullptr;
+   sum_widened_t sum_widened        = nullptr; /// result[0] = sum(v) in 64 bits (two's complement for the signed types)
+   sum_widened_t sum_widened_signed = nullptr;
+};
+
+/**
+ @brief The types supported by the conversion kernels
+ */
+using conversion_types = std::tuple<float, double, std::int32_t, std::int16_t, std::uint16_t, std::uint8_t, std::int8_t, float16, bfloat16>;
+
+static const size_t nb_conversion_types = std::tuple_size<conversion_types>::value;
+static const size_t nb_conversions      = 4;
+
+/**
+ @brief The index of T in @ref conversion_types (e.g., char is mapped to std::int8_t or std::uint8_t), -1 if not supported
+ */
+template <class T, bool Integral = std::is_integral<T>::value && !std::is_same<T, bool>::value>
+struct conversion_type
+{
+   static const int value = std::is_same<T, float>::value      ? 0
+                          : std::is_same<T, double>::value   ? 1
+                          : std::is_same<T, float16>::value  ? 7
+                          : std::is_same<T, bfloat16>::value ? 8 : -1;
+};
+
+template <class T>
+struct conversion_type<T, true>
+{
+   static const int value = sizeof(T) == 4 ? (std::is_signed<T>::value ? 2 : -1)
+                          : sizeof(T) == 2 ? (std::is_signed<T>::value ? 3 : 4)
+                          : sizeof(T) == 1 ? (std::is_signed<T>::value ? 6 : 5) : -1;
+};
+
+/**
+ @brief The conversion kernels, output[n] = conversion(input[n])
+
+ The kernels are indexed by the destination type, the source type (see @ref conversion_type) and the conversion
+ */
+struct ConversionKernels
+{
+   using convert_t = void (*)(void* output, const void* input, size_t size);
+
+   convert_t convert[nb_conversion_types][nb_conversion_types][nb_conversions] = {};
+};
+
+using KernelTables =
+    std::tuple<Kernels<float>, Kernels<double>, Kernels<std::uint32_t>, Kernels<std::uint16_t>, Kernels<std::uint8_t>, Kernels<float16>,
+               Kernels<bfloat16>, ConversionKernels>;
+
+/**
+ @brief Hold the kernels of the selected instruction set
+ */
+class ARRAY_API SimdDispatcher
+{
+public:
+   static SimdDispatcher& instance();
+
+   /**
+    @brief The best instruction set supported by this CPU (and compiled in the library)
+    */
+   Isa getSupportedIsa() const
+   {
+      return _supportedIsa;
+   }
+
+   /**
+    @brief The instruction set currently used by the kernels
+    */
+   Isa getIsa() const
+   {
+      return _isa;
+   }
+
+   /**
+    @brief Select the kernels of a given instruction set. If the instruction set is not supported, the best
+           supported one below is selected instead.
+
+    This is intended for testing & benchmarking and must not be called while arrays are being processed.
+    */
+   void setIsa(Isa isa);
+
+   template <class T>
+   const Kernels<T>& get() const
+   {
+      return std::get<Kernels<T>>(_kernels);
+   }
+
+   const ConversionKernels& getConversions() const
+   {
+      return std::get<ConversionKernels>(_kernels);
+   }
+
+private:
+   SimdDispatcher();
+
+private:
+   Isa _supportedIsa;
+   Isa _isa;
+   KernelTables _kernels;
+};
+
+/**
+ @brief Below this number of elements, the dispatch overhead is not worth it and the scalar loops are used
+ */
+static const size_t min_elements_vectorized = 16;
+
+template <class T>
+using is_vectorized = std::integral_constant<bool, !std::is_same<storage_t<T>, not_vectorized>::value>;
+
+template <class T, typename = typename std::enable_if<is_vectorized<T>::value>::type>
+storage_t<T>* to_storage(T* v)
+{
+   return reinterpret_cast<storage_t<T>*>(v);
+}
+
+template <class T, typename = typename std::enable_if<is_vectorized<T>::value>::type>
+const storage_t<T>* to_storage(const T* v)
+{
+   return reinterpret_cast<const storage_t<T>*>(v);
+}
+
+template <class T, typename = typename std::enable_if<is_vectorized<T>::value>::type>
+storage_t<T> to_storage(T value)
+{
+   return static_cast<storage_t<T>>(value);
+}
+
+/**
+ @brief The other arguments of the kernels (e.g., indices, bits, enumerations) are not converted
+ */
+template <class T, typename = typename std::enable_if<!is_vectorized<typename std::remove_cv<typename std::remove_pointer<T>::type>::type>::value>::type,
+          typename = void>
+T to_storage(T value)
+{
+   return value;
+}
+
+template <class T, class Kernel, class... Args>
+bool run_kernel(std::false_type, Kernel, size_t, Args...)
+{
+   return false;
+}
+
+template <class T, class Kernel, class... Args>
+bool run_kernel(std::true_type, Kernel kernel, size_t size, Args... args)
+{
+   if (size < min_elements_vectorized)
+   {
+      return false;
+   }
+
+   const auto f = SimdDispatcher::instance().get<storage_t<T>>().*kernel;
+   if (f == nullptr)
+   {
+      return false;
+   }
+   f(to_storage(args)..., size);
+   return true;
+}
+
+/**
+ @brief Run a kernel on unit-stride memory
+
+ @return false if the kernel is not available for T, in which case nothing was done
+ */
+template <class T, class Kernel, class... Args>
+bool run_kernel(Kernel kernel, size_t size, Args... args)
+{
+   return run_kernel<T>(is_vectorized<T>(), kernel, size, args...);
+}
+
+template <class T>
+using kernels_t = Kernels<storage_t<T>>;
+
+template <class T>
+bool add(T* v1, const T* v2, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::add, size, v1, v2);
+}
+
+template <class T>
+bool sub(T* v1, const T* v2, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::sub, size, v1, v2);
+}
+
+template <class T>
+bool add_cte(T* v1, T value, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::add_cte, size, v1, value);
+}
+
+template <class T>
+bool mul(T* v1, T value, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::mul, size, v1, value);
+}
+
+template <class T>
+bool div(T* v1, T value, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::div, size, v1, value);
+}
+
+template <class T>
+bool mul_elementwise(T* v1, const T* v2, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::mul_elementwise, size, v1, v2);
+}
+
+/**
+ @brief Mixed types are not vectorized
+ */
+template <class T, class T2>
+bool mul_elementwise(T*, const T2*, size_t)
+{
+   return false;
+}
+
+template <class T>
+bool div_elementwise(T* v1, const T* v2, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::div_elementwise, size, v1, v2);
+}
+
+/**
+ @brief Mixed types are not vectorized
+ */
+template <class T, class T2>
+bool div_elementwise(T*, const T2*, size_t)
+{
+   return false;
+}
+
+template <class T>
+bool addmul(T* v1, const T* v2, T value, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::addmul, size, v1, v2, value);
+}
+
+template <class T>
+bool sqrt(T* output, const T* input, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::sqrt, size, output, input);
+}
+
+template <class T>
+bool abs(T* output, const T* input, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::abs, size, output, input);
+}
+
+template <class T>
+bool exp(T* output, const T* input, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::exp, size, output, input);
+}
+
+template <class T>
+bool log(T* output, const T* input, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::log, size, output, input);
+}
+
+template <class T>
+bool sin(T* output, const T* input, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::sin, size, output, input);
+}
+
+template <class T>
+bool cos(T* output, const T* input, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::cos, size, output, input);
+}
+
+template <class T>
+bool sum(const T* v, T* result, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::sum, size, v, result);
+}
+
+template <class T>
+bool sum_kahan(const T* v, T* result, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::sum_kahan, size, v, result);
+}
+
+template <class T>
+bool norm2sqr(const T* v, T* result, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::norm2sqr, size, v, result);
+}
+
+template <class T>
+bool min(const T* v, T* result, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::min, size, v, result);
+}
+
+template <class T>
+bool max(const T* v, T* result, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::max, size, v, result);
+}
+
+template <class T>
+bool minmax(const T* v, T* result, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::minmax, size, v, result);
+}
+
+template <class T>
+bool argmin(const T* v, T* value, size_t* index, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::argmin, size, v, value, index);
+}
+
+template <class T>
+bool argmax(const T* v, T* value, size_t* index, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::argmax, size, v, value, index);
+}
+
+template <class T>
+bool compare(std::uint64_t* bits, const T* v1, const T* v2, T value, Comparison comparison, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::compare, size, bits, v1, v2, value, comparison);
+}
+
+/**
+ @brief Find the first element of a memory line for which (predicate(v[n]) == expected). Only floating point types are supported
+
+ @param position set to the position of the element, size if there is none
+ */
+template <class T>
+bool find(const T* v, const LinePredicate<T>& predicate, bool expected, size_t size, size_t& position)
+{
+   return run_kernel<T>(std::is_floating_point<T>(), &kernels_t<T>::find, size, v, &predicate, expected, &position);
+}
+
+template <class T>
+bool gather(T* output, const T* input, const size_t* offsets, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::gather, size, output, input, offsets);
+}
+
+template <class T>
+bool fma(T* output, const T* a, const T* b, const T* c, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::fma, size, output, a, b, c);
+}
+
+template <class T>
+bool fms(T* output, const T* a, const T* b, const T* c, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::fms, size, output, a, b, c);
+}
+
+template <class T>
+bool axpby(T* output, const T* x, T alpha, const T* y, T beta, size_t size)
+{
+   return run_kernel<T>(&kernels_t<T>::axpby, size, output, x, alpha, y, beta);
+}
+
+/**
+ @brief The saturated arithmetic is only vectorized for the 8 and 16-bit integers
+ */
+template <class T>
+using is_small_integer = std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 2>;
+
+template <class T>
+bool add_saturated(T* v1, const T* v2, size_t size)
+{
+   return run_kernel<T>(is_small_integer<T>(), std::is_signed<T>::value ? &kernels_t<T>::add_saturated_signed : &kernels_t<T>::add_saturated,
+                        size, v1, v2);
+}
+
+template <class T>
+bool sub_saturated(T* v1, const T* v2, size_t size)
+{
+   return run_kernel<T>(is_small_integer<T>(), std::is_signed<T>::value ? &kernels_t<T>::sub_saturated_signed : &kernels_t<T>::sub_saturated,
+                        size, v1, v2);
+}
+
+template <class T>
+bool abs_diff(T* v1, const T* v2, size_t size)
+{
+   return run_kernel<T>(is_small_integer<T>(), std::is_signed<T>::value ? &kernels_t<T>::abs_diff_signed : &kernels_t<T>::abs_diff, size,
+                        v1, v2);
+}
+
+template <class T>
+bool mul_high(T* v1, T value, size_t size)
+{
+   return run_kernel<T>(is_small_integer<T>(), std::is_signed<T>::value ? &kernels_t<T>::mul_high_signed : &kernels_t<T>::mul_high, size,
+                        v1, value);
+}
+
+/**
+ @brief result = sum(v) computed in 64 bits, for the 8 and 16-bit integers
+
+ @param result the sum modulo 2^64, i.e., the two's complement of the sum for the signed types
+ */
+template <class T>
+bool sum_widened(const T* v, std::uint64_t& result, size_t size)
+{
+   return run_kernel<T>(is_small_integer<T>(), std::is_signed<T>::value ? &kernels_t<T>::sum_widened_signed : &kernels_t<T>::sum_widened,
+                        size, v, &result);
+}
+
+/**
+ @brief output[n] = conversion(input[n]), identical to @ref details::convert_value
+ */
+template <class To, class From>
+bool convert(To* output, const From* input, Conversion conversion, size_t size)
+{
+   const int to   = conversion_type<To>::value;
+   const int from = conversion_type<From>::value;
+   if (to < 0 || from < 0 || size < min_elements_vectorized)
+   {
+      return false;
+   }
+
+   const auto f = SimdDispatcher::instance().getConversions().convert[to][from][static_cast<size_t>(conversion)];
+   if (f == nullptr)
+   {
+      return false;
+   }
+   f(output, input, size);
+   return true;
+}
+}
+}
+
+DECLARE_NAMESPACE_NLL_END
@@ -9,6 +9,8 @@
 
  We should as much as possible use these building blocks so that once more specialized operations are implemented,
  (e.g., loop enrolling, SSE, BLAS..) it will benefit the whole library.
+
+ Unit-stride memory lines are forwarded to the SIMD kernels of op-naive-simd.h when available for the type.
 */
 
 DECLARE_NAMESPACE_NLL
@@ -21,9 +23,91 @@ T norm2sqr(const T& v)
 
 namespace details
 {
+/**
+ @brief Classification of the floating point values on their bit pattern
+
+ The project is built with -ffast-math (/fp:fast) which assumes there is no NaN or infinity: std::isnan(x), std::isinf(x)
+ and x != x are folded by the compiler. The integral types are always finite.
+ */
+inline uint32_t float_bits(float value)
+{
+   uint32_t bits;
+   std::memcpy(&bits, &value, sizeof(bits));
+   return bits & 0x7fffffffu;
+}
+
+inline uint64_t float_bits(double value)
+{
+   uint64_t bits;
+   std::memcpy(&bits, &value, sizeof(bits));
+   return bits & 0x7fffffffffffffffull;
+}
+
+/**
+@brief true if @p value is a NaN. Always false for the integral and other types
+*/
+inline bool is_nan(float value)
+{
+   return float_bits(value) > 0x7f800000u;
+}
+
+inline bool is_nan(double value)
+{
+   return float_bits(value) > 0x7ff0000000000000ull;
+}
+
+inline bool is_nan(long double value)
+{
+   return is_nan(static_cast<double>(value));
+}
+
+template <class T>
+bool is_nan(T)
+{
+   return false;
+}
+
+/**
+@brief true if @p value is +infinity or -infinity
+*/
+inline bool is_inf(float value)
+{
+   return float_bits(value) == 0x7f800000u;
+}
+
+inline bool is_inf(double value)
+{
+   return float_bits(value) == 0x7ff0000000000000ull;
+}
+
+inline bool is_inf(long double value)
+{
+   return is_inf(static_cast<double>(value));
+}
+
+template <class T>
+bool is_inf(T)
+{
+   return false;
+}
+
+/**
+@brief true if @p value is neither a NaN nor an infinity
+*/
+template <class T>
+bool is_finite(T value)
+{
+   return !is_nan(value) && !is_inf(value);
+}
+
 template <class T>
 void add_naive(T* v1, size_t stride_v1, const T* v2, const size_t stride_v2, size_t size)
 {
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::add(v1, v2, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
    {
@@ -34,6 +118,11 @@ void add_naive(T* v1, size_t stride_v1, const T* v2, const size_t stride_v2, siz
 template <class T>
 void add_naive_cte(T* v1, size_t stride_v1, size_t size, T value)
 {
+   if (stride_v1 == 1 && simd::add_cte(v1, value, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1)
    {
@@ -44,6 +133,11 @@ void add_naive_cte(T* v1, size_t stride_v1, size_t size, T value)
 template <class T>
 void sub_naive(T* v1, size_t stride_v1, const T* v2, size_t stride_v2, size_t size)
 {
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::sub(v1, v2, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
    {
@@ -54,6 +148,11 @@ void sub_naive(T* v1, size_t stride_v1, const T* v2, size_t stride_v2, size_t si
 template <class T>
 void mul_naive(T* v1, size_t stride_v1, const T value, size_t size)
 {
+   if (stride_v1 == 1 && simd::mul(v1, value, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1)
    {
@@ -65,6 +164,11 @@ template <class T>
 void div_naive(T* v1, size_t stride_v1, const T value, size_t size)
 {
    NLL_FAST_ASSERT(value != T(0), "div by 0");
+   if (stride_v1 == 1 && simd::div(v1, value, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1)
    {
@@ -78,6 +182,11 @@ void div_naive(T* v1, size_t stride_v1, const T value, size_t size)
 template <class T, class T2>
 void div_naive_elementwise(T* v1, size_t stride_v1, const T2* v2, size_t stride_v2, size_t size)
 {
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::div_elementwise(v1, v2, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
    {
@@ -91,6 +200,11 @@ void div_naive_elementwise(T* v1, size_t stride_v1, const T2* v2, size_t stride_
 template <class T, class T2>
 void mul_naive_elementwise(T* v1, size_t stride_v1, const T2* v2, size_t stride_v2, size_t size)
 {
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::mul_elementwise(v1, v2, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
    {
@@ -104,6 +218,11 @@ void mul_naive_elementwise(T* v1, size_t stride_v1, const T2* v2, size_t stride_
 template <class T>
 void addmul_naive(T* v1, size_t stride_v1, const T* v2, size_t stride_v2, T mul, size_t size)
 {
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::addmul(v1, v2, mul, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
    {
@@ -117,6 +236,11 @@ void addmul_naive(T* v1, size_t stride_v1, const T* v2, size_t stride_v2, T mul,
 template <class T, class T2>
 void static_cast_naive(T* v1, size_t stride_v1, const T2* v2, size_t stride_v2, size_t size)
 {
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::convert(v1, v2, Conversion::cast, size))
+   {
+      return;
+   }
+
    const T* end = v1 + size * stride_v1;
    for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
    {
@@ -125,10 +249,533 @@ void static_cast_naive(T* v1, size_t stride_v1, const T2* v2, size_t stride_v2,
 }
 
 /**
-@brief compute sum(v1^2)
+ @brief The floating point types, including the 16-bit floating point types computed in float
+ */
+template <class T>
+using is_floating = std::integral_constant<bool, std::is_floating_point<T>::value || is_reduced_float<T>::value>;
+
+template <class To, class From>
+To round_value(From value, std::true_type UNUSED(floating_point))
+{
+   return static_cast<To>(std::round(value));
+}
+
+template <class To, class From>
+To round_value(From value, std::false_type UNUSED(floating_point))
+{
+   return static_cast<To>(value);
+}
+
+/**
+ @brief Clamp a value to the range of To. NaN is converted to 0 for integers and kept for floating point types
+ */
+template <class To, class From>
+To saturate_to(From value)
+{
+   using limits = std::numeric_limits<To>;
+   if (is_floating<From>::value || is_floating<To>::value)
+   {
+      // tested on the bit pattern: value != value is folded with -ffast-math
+      if (is_nan(static_cast<double>(value)))
+      {
+         return std::is_integral<To>::value ? To(0) : static_cast<To>(value);
+      }
+      if (static_cast<double>(value) <= static_cast<double>(limits::lowest()))
+      {
+         return limits::lowest();
+      }
+      if (static_cast<double>(value) >= static_cast<double>(limits::max()))
+      {
+         return limits::max();
+      }
+      return static_cast<To>(value);
+   }
+
+   // integer to integer
+   if (std::is_signed<From>::value && value < From(0))
+   {
+      return static_cast<std::intmax_t>(value) < static_cast<std::intmax_t>(limits::lowest()) ? limits::lowest() : static_cast<To>(value);
+   }
+   return static_cast<std::uintmax_t>(value) > static_cast<std::uintmax_t>(limits::max()) ? limits::max() : static_cast<To>(value);
+}
+
+/**
+ @brief Convert a value, the scalar reference of the conversion kernels (see @ref simd::convert)
+
+ - cast: static_cast
+ - saturate: the values are clamped to [lowest, max] of To. NaN is converted to 0 for integers and kept for floating point types.
+   The floating point values are then truncated toward zero
+ - round: std::round (nearest integer, halfway cases away from zero) for floating point values, then cast
+ - round_saturate: rounded, then saturated
+
+ The 16-bit floating point types (@ref float16, @ref bfloat16) go through float: e.g., a double or an int32 is first
+ rounded to float, then to float16.
+ */
+template <class To, class From>
+To convert_value(From value, Conversion conversion)
+{
+   static_assert((std::is_arithmetic<To>::value || is_reduced_float<To>::value) && (std::is_arithmetic<From>::value || is_reduced_float<From>::value),
+                 "must be arithmetic types!");
+   const bool round    = conversion == Conversion::round || conversion == Conversion::round_saturate;
+   const bool saturate = conversion == Conversion::saturate || conversion == Conversion::round_saturate;
+   if (round)
+   {
+      value = round_value<From>(value, is_floating<From>());
+   }
+   return saturate ? saturate_to<To>(value) : static_cast<To>(value);
+}
+
+/**
+ @brief compute v1 = convert_value<T>(v2, conversion)
+ */
+template <class T, class T2>
+void convert_naive(T* v1, size_t stride_v1, const T2* v2, size_t stride_v2, size_t size, Conversion conversion)
+{
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::convert(v1, v2, conversion, size))
+   {
+      return;
+   }
+
+   const T* end = v1 + size * stride_v1;
+   for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
+   {
+      *v1 = convert_value<T>(*v2, conversion);
+   }
+}
+
+/**
+ @brief The scalar fused operations, reference of the fused kernels (e.g., @ref simd::fma)
+
+ The floating point types are computed with a single rounding (std::fma), in float for the 16-bit floating point types.
+ The integers wrap around (computed in unsigned arithmetic, as the multiplication kernels) and any other type uses its operators.
+ */
+template <class T, bool Floating = is_floating<T>::value, bool Integral = std::is_integral<T>::value && !std::is_same<T, bool>::value>
+struct FusedArithmetic
+{
+   static T fma(T a, T b, T c)
+   {
+      return a * b + c;
+   }
+
+   static T fms(T a, T b, T c)
+   {
+      return a * b - c;
+   }
+
+   static T axpby(T alpha, T x, T beta, T y)
+   {
+      return alpha * x + beta * y;
+   }
+};
+
+template <class T>
+struct FusedArithmetic<T, true, false>
+{
+   using compute_type = typename std::conditional<std::is_floating_point<T>::value, T, float>::type;
+
+   static T fma(T a, T b, T c)
+   {
+      return static_cast<T>(std::fma(static_cast<compute_type>(a), static_cast<compute_type>(b), static_cast<compute_type>(c)));
+   }
+
+   static T fms(T a, T b, T c)
+   {
+      return static_cast<T>(std::fma(static_cast<compute_type>(a), static_cast<compute_type>(b), -static_cast<compute_type>(c)));
+   }
+
+   /// beta * y is rounded, then fused with alpha * x
+   static T axpby(T alpha, T x, T beta, T y)
+   {
+      const compute_type beta_y = static_cast<compute_type>(beta) * static_cast<compute_type>(y);
+      return static_cast<T>(std::fma(static_cast<compute_type>(alpha), static_cast<compute_type>(x), beta_y));
+   }
+};
+
+template <class T>
+struct FusedArithmetic<T, false, true>
+{
+   using unsigned_type = decltype(typename std::make_unsigned<T>::type() + 0u);
+
+   static T fma(T a, T b, T c)
+   {
+      return static_cast<T>(static_cast<unsigned_type>(a) * static_cast<unsigned_type>(b) + static_cast<unsigned_type>(c));
+   }
+
+   static T fms(T a, T b, T c)
+   {
+      return static_cast<T>(static_cast<unsigned_type>(a) * static_cast<unsigned_type>(b) - static_cast<unsigned_type>(c));
+   }
+
+   static T axpby(T alpha, T x, T beta, T y)
+   {
+      return static_cast<T>(static_cast<unsigned_type>(alpha) * static_cast<unsigned_type>(x) +
+                            static_cast<unsigned_type>(beta) * static_cast<unsigned_type>(y));
+   }
+};
+
+/**
+ @brief compute output = a * b + c elementwise, see @ref FusedArithmetic. output may be the same memory as any of the inputs
+ */
+template <class T>
+void fma_naive(T* output, size_t stride_output, const T* a, size_t stride_a, const T* b, size_t stride_b, const T* c, size_t stride_c, size_t size)
+{
+   if (stride_output == 1 && stride_a == 1 && stride_b == 1 && stride_c == 1 && simd::fma(output, a, b, c, size))
+   {
+      return;
+   }
+
+   const T* end = output + size * stride_output;
+   for (; output != end; output += stride_output, a += stride_a, b += stride_b, c += stride_c)
+   {
+      *output = FusedArithmetic<T>::fma(*a, *b, *c);
+   }
+}
+
+/**
+ @brief compute output = a * b - c elementwise, see @ref FusedArithmetic. output may be the same memory as any of the inputs
+ */
+template <class T>
+void fms_naive(T* output, size_t stride_output, const T* a, size_t stride_a, const T* b, size_t stride_b, const T* c, size_t stride_c, size_t size)
+{
+   if (stride_output == 1 && stride_a == 1 && stride_b == 1 && stride_c == 1 && simd::fms(output, a, b, c, size))
+   {
+      return;
+   }
+
+   const T* end = output + size * stride_output;
+   for (; output != end; output += stride_output, a += stride_a, b += stride_b, c += stride_c)
+   {
+      *output = FusedArithmetic<T>::fms(*a, *b, *c);
+   }
+}
+
+/**
+ @brief compute output = alpha * x + beta * y elementwise, see @ref FusedArithmetic. output may be the same memory as x or y
+ */
+template <class T>
+void axpby_naive(T* output, size_t stride_output, const T* x, size_t stride_x, T alpha, const T* y, size_t stride_y, T beta, size_t size)
+{
+   if (stride_output == 1 && stride_x == 1 && stride_y == 1 && simd::axpby(output, x, alpha, y, beta, size))
+   {
+      return;
+   }
+
+   const T* end = output + size * stride_output;
+   for (; output != end; output += stride_output, x += stride_x, y += stride_y)
+   {
+      *output = FusedArithmetic<T>::axpby(alpha, *x, beta, *y);
+   }
+}
+
+/**
+ @brief The scalar saturated integer arithmetic, reference of the kernels (e.g., @ref simd::add_saturated)
+
+ The results are clamped to the range of T. Only the absolute difference is defined for the floating point types.
+ */
+template <class T, bool Integral = std::is_integral<T>::value && !std::is_same<T, bool>::value>
+struct SaturatedArithmetic
+{
+   static T abs_diff(T a, T b)
+   {
+      return a > b ? a - b : b - a;
+   }
+};
+
+template <class T>
+struct SaturatedArithmetic<T, true>
+{
+   static_assert(sizeof(T) <= 4, "computed in 64 bits");
+   using wide_type = typename std::conditional<std::is_signed<T>::value, std::int64_t, std::uint64_t>::type;
+
+   static T saturate(std::int64_t value)
+   {
+      const std::int64_t min_value = static_cast<std::int64_t>(std::numeric_limits<T>::min());
+      const std::int64_t max_value = static_cast<std::int64_t>(std::numeric_limits<T>::max());
+      return static_cast<T>(value < min_value ? min_value : (value > max_value ? max_value : value));
+   }
+
+   static T add(T a, T b)
+   {
+      return saturate(static_cast<std::int64_t>(a) + static_cast<std::int64_t>(b));
+   }
+
+   static T sub(T a, T b)
+   {
+      return saturate(static_cast<std::int64_t>(a) - static_cast<std::int64_t>(b));
+   }
+
+   static T abs_diff(T a, T b)
+   {
+      const std::int64_t difference = static_cast<std::int64_t>(a) - static_cast<std::int64_t>(b);
+      return saturate(difference < 0 ? -difference : difference);
+   }
+
+   /// the high half of the product, rounded toward negative infinity: e.g., mul_high(a, ui8(0.75 * 256)) is floor(a * 0.75)
+   static T mul_high(T a, T b)
+   {
+      return static_cast<T>((static_cast<wide_type>(a) * static_cast<wide_type>(b)) >> (8 * sizeof(T)));
+   }
+};
+
+/**
+ @brief compute v1 = saturate(v1 + v2), see @ref SaturatedArithmetic
+ */
+template <class T>
+void add_saturated_naive(T* v1, size_t stride_v1, const T* v2, size_t stride_v2, size_t size)
+{
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::add_saturated(v1, v2, size))
+   {
+      return;
+   }
+
+   const T* end = v1 + size * stride_v1;
+   for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
+   {
+      *v1 = SaturatedArithmetic<T>::add(*v1, *v2);
+   }
+}
+
+/**
+ @brief compute v1 = saturate(v1 - v2), see @ref SaturatedArithmetic
+ */
+template <class T>
+void sub_saturated_naive(T* v1, size_t stride_v1, const T* v2, size_t stride_v2, size_t size)
+{
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::sub_saturated(v1, v2, size))
+   {
+      return;
+   }
+
+   const T* end = v1 + size * stride_v1;
+   for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
+   {
+      *v1 = SaturatedArithmetic<T>::sub(*v1, *v2);
+   }
+}
+
+/**
+ @brief compute v1 = |v1 - v2|, saturated for the signed integers (e.g., |-128 - 127| is 127 for an int8)
+ */
+template <class T>
+void abs_diff_naive(T* v1, size_t stride_v1, const T* v2, size_t stride_v2, size_t size)
+{
+   if (stride_v1 == 1 && stride_v2 == 1 && simd::abs_diff(v1, v2, size))
+   {
+      return;
+   }
+
+   const T* end = v1 + size * stride_v1;
+   for (; v1 != end; v1 += stride_v1, v2 += stride_v2)
+   {
+      *v1 = SaturatedArithmetic<T>::abs_diff(*v1, *v2);
+   }
+}
+
+/**
+ @brief compute v1 = (v1 * value) >> bits(T), the scaling of integers by the fixed point fraction value / 2^bits(T)
+ */
+template <class T>
+void mul_high_naive(T* v1, size_t stride_v1, T value, size_t size)
+{
+   if (stride_v1 == 1 && simd::mul_high(v1, value, size))
+   {
+      return;
+   }
+
+   const T* end = v1 + size * stride_v1;
+   for (; v1 != end; v1 += stride_v1)
+   {
+      *v1 = SaturatedArithmetic<T>::mul_high(*v1, value);
+   }
+}
+
+/**
+ @brief True if the sums of T in Accum are computed in the lanes of @ref simd::reduction_lanes
+ */
+template <class T, class Accum>
+using use_reduction_lanes = std::integral_constant<bool, std::is_same<T, Accum>::value && std::is_floating_point<T>::value>;
+
+/**
+ @brief Combine the lanes of a reduction pairwise
+ */
+template <class T, size_t NbLanes>
+T sum_lanes_pairwise(T (&lanes)[NbLanes])
+{
+   for (size_t step = NbLanes / 2; step > 0; step /= 2)
+   {
+      for (size_t lane = 0; lane < step; ++lane)
+      {
+         lanes[lane] += lanes[lane + step];
+      }
+   }
+   return lanes[0];
+}
+
+/**
+ @brief Return @p value, hiding how it was computed from the compiler
+
+ The compensated summations rely on the rounding of each operation. With -ffast-math, the compiler may reassociate
+ (a + b) - a to b and remove the compensation: the intermediate results are stored to a volatile to prevent it.
+ */
+template <class T>
+T fp_opaque(T value)
+{
+   volatile T opaque = value;
+   return opaque;
+}
+
+/**
+ @brief sum += other using an error free transformation: @p error accumulates the rounding errors of @p sum
+ */
+template <class T>
+void sum_compensated_merge(T& sum, T& error, T other_sum, T other_error)
+{
+   const T a          = sum;
+   const T s          = fp_opaque(a + other_sum);
+   const T other_part = fp_opaque(s - a);
+   const T s_error    = fp_opaque(a - fp_opaque(s - other_part)) + fp_opaque(other_sum - other_part);
+   sum                = s;
+   error              = fp_opaque(error + other_error) + s_error;
+}
+
+/**
+ @brief True if the sums of T in Accum can use the exact 64-bit sums of @ref simd::sum_widened: the result is identical to the
+        accumulation in Accum (modulo 2^bits for the integers, exact for double)
+ */
+template <class T, class Accum>
+using use_sum_widened =
+    std::integral_constant<bool, simd::is_small_integer<T>::value && ((std::is_integral<Accum>::value && !std::is_same<Accum, bool>::value) ||
+                                                                     std::is_same<Accum, double>::value)>;
+
+template <class T, class Accum>
+Accum sum_widened_to(std::uint64_t sum, std::true_type UNUSED(is_signed))
+{
+   return static_cast<Accum>(static_cast<std::int64_t>(sum));
+}
+
+template <class T, class Accum>
+Accum sum_widened_to(std::uint64_t sum, std::false_type UNUSED(is_signed))
+{
+   return static_cast<Accum>(sum);
+}
+
+template <class T, class Accum>
+Accum sum_naive(std::false_type, const T* v1, size_t stride_v1, size_t nb_elements)
+{
+   std::uint64_t sum = 0;
+   if (use_sum_widened<T, Accum>::value && stride_v1 == 1 && simd::sum_widened(v1, sum, nb_elements))
+   {
+      return sum_widened_to<T, Accum>(sum, std::is_signed<T>());
+   }
+
+   const T* end = v1 + nb_elements * stride_v1;
+   Accum accum  = 0;
+   for (; v1 != end; v1 += stride_v1)
+   {
+      accum += *v1;
+   }
+   return accum;
+}
+
+template <class T, class Accum>
+Accum sum_naive(std::true_type, const T* v1, size_t stride_v1, size_t nb_elements)
+{
+   T result[1];
+   if (stride_v1 == 1 && simd::sum(v1, result, nb_elements))
+   {
+      return result[0];
+   }
+
+   // same order of operations as the vectorized kernels
+   static const size_t nb_lanes = simd::reduction_lanes<T>::value;
+   T lanes[nb_lanes]            = {};
+   for (size_t n = 0; n < nb_elements; n += nb_lanes)
+   {
+      const size_t nb_lanes_used = std::min(nb_lanes, nb_elements - n);
+      for (size_t lane = 0; lane < nb_lanes_used; ++lane)
+      {
+         lanes[lane] += v1[(n + lane) * stride_v1];
+      }
+   }
+   return sum_lanes_pairwise(lanes);
+}
+
+/**
+@brief compute sum(v1)
+
+ Floating point values accumulated in their own type are summed in the independent lanes of
+ @ref simd::reduction_lanes, combined pairwise. The result doesn't depend on the instruction set.
 */
 template <class T, class Accum = T>
-Accum norm2_naive_sqr(const T* v1, size_t stride_v1, size_t nb_elements)
+Accum sum_naive(const T* v1, size_t stride_v1, size_t nb_elements)
+{
+   return sum_naive<T, Accum>(use_reduction_lanes<T, Accum>(), v1, stride_v1, nb_elements);
+}
+
+template <class T, class Accum>
+void sum_kahan_naive(std::false_type, const T* v1, size_t stride_v1, size_t nb_elements, Accum& sum, Accum& error)
+{
+   const T* end = v1 + nb_elements * stride_v1;
+   sum          = 0;
+   error        = 0;
+   for (; v1 != end; v1 += stride_v1)
+   {
+      const Accum y = fp_opaque(static_cast<Accum>(*v1) + error);
+      const Accum t = fp_opaque(sum + y);
+      error         = y - fp_opaque(t - sum);
+      sum           = t;
+   }
+}
+
+template <class T, class Accum>
+void sum_kahan_naive(std::true_type, const T* v1, size_t stride_v1, size_t nb_elements, Accum& sum, Accum& error)
+{
+   T result[2];
+   if (stride_v1 == 1 && simd::sum_kahan(v1, result, nb_elements))
+   {
+      sum   = result[0];
+      error = result[1];
+      return;
+   }
+
+   // same order of operations as the vectorized kernels
+   static const size_t nb_lanes = simd::reduction_lanes<T>::value;
+   T lanes_sum[nb_lanes]        = {};
+   T lanes_error[nb_lanes]      = {};
+   for (size_t n = 0; n < nb_elements; n += nb_lanes)
+   {
+      const size_t nb_lanes_used = std::min(nb_lanes, nb_elements - n);
+      for (size_t lane = 0; lane < nb_lanes_used; ++lane)
+      {
+         const T y         = fp_opaque(v1[(n + lane) * stride_v1] + lanes_error[lane]);
+         const T t         = fp_opaque(lanes_sum[lane] + y);
+         lanes_error[lane] = y - fp_opaque(t - lanes_sum[lane]);
+         lanes_sum[lane]   = t;
+      }
+   }
+
+   for (size_t step = nb_lanes / 2; step > 0; step /= 2)
+   {
+      for (size_t lane = 0; lane < step; ++lane)
+      {
+         sum_compensated_merge(lanes_sum[lane], lanes_error[lane], lanes_sum[lane + step], lanes_error[lane + step]);
+      }
+   }
+   sum   = lanes_sum[0];
+   error = lanes_error[0];
+}
+
+/**
+@brief compute sum(v1) with Kahan's compensated summation: sum(v1) = @p sum + @p error
+*/
+template <class T, class Accum = T>
+void sum_kahan_naive(const T* v1, size_t stride_v1, size_t nb_elements, Accum& sum, Accum& error)
+{
+   sum_kahan_naive<T, Accum>(use_reduction_lanes<T, Accum>(), v1, stride_v1, nb_elements, sum, error);
+}
+
+template <class T, class Accum>
+Accum norm2_naive_sqr(std::false_type, const T* v1, size_t stride_v1, size_t nb_elements)
 {
    const T* end = v1 + nb_elements * stride_v1;
    Accum accum  = 0;
@@ -139,6 +786,118 @@ Accum norm2_naive_sqr(const T* v1, size_t stride_v1, size_t nb_elements)
    return accum;
 }
 
+template <class T, class Accum>
+Accum norm2_naive_sqr(std::true_type, const T* v1, size_t stride_v1, size_t nb_elements)
+{
+   T result[1];
+   if (stride_v1 == 1 && simd::norm2sqr(v1, result, nb_elements))
+   {
+      return result[0];
+   }
+
+   // same order of operations as the vectorized kernels
+   static const size_t nb_lanes = simd::reduction_lanes<T>::value;
+   T lanes[nb_lanes]            = {};
+   for (size_t n = 0; n < nb_elements; n += nb_lanes)
+   {
+      const size_t nb_lanes_used = std::min(nb_lanes, nb_elements - n);
+      for (size_t lane = 0; lane < nb_lanes_used; ++lane)
+      {
+         // separate statements: the product must not be fused with the addition
+         const T x  = v1[(n + lane) * stride_v1];
+         const T x2 = x * x;
+         lanes[lane] += x2;
+      }
+   }
+   return sum_lanes_pairwise(lanes);
+}
+
+/**
+@brief compute sum(v1^2)
+
+ See @ref sum_naive for the order of the operations
+*/
+template <class T, class Accum = T>
+Accum norm2_naive_sqr(const T* v1, size_t stride_v1, size_t nb_elements)
+{
+   return norm2_naive_sqr<T, Accum>(use_reduction_lanes<T, Accum>(), v1, stride_v1, nb_elements);
+}
+
+/**
+@brief update @p min_value and @p max_value with the min & max of v1. NaN are ignored
+*/
+template <class T>
+void minmax_naive(const T* v1, size_t stride_v1, size_t nb_elements, T& min_value, T& max_value)
+{
+   T result[2];
+   if (stride_v1 == 1 && simd::minmax(v1, result, nb_elements))
+   {
+      min_value = !is_nan(result[0]) && result[0] < min_value ? result[0] : min_value;
+      max_value = !is_nan(result[1]) && result[1] > max_value ? result[1] : max_value;
+      return;
+   }
+
+   // the NaN are tested explicitly: with -ffast-math, the comparisons may return the NaN
+   const T* end = v1 + nb_elements * stride_v1;
+   for (; v1 != end; v1 += stride_v1)
+   {
+      const T value = *v1;
+      if (!is_nan(value))
+      {
+         min_value = value < min_value ? value : min_value;
+         max_value = value > max_value ? value : max_value;
+      }
+   }
+}
+
+/**
+@brief update @p min_value with the min of v1. NaN are ignored
+*/
+template <class T>
+void min_naive(const T* v1, size_t stride_v1, size_t nb_elements, T& min_value)
+{
+   T result[1];
+   if (stride_v1 == 1 && simd::min(v1, result, nb_elements))
+   {
+      min_value = !is_nan(result[0]) && result[0] < min_value ? result[0] : min_value;
+      return;
+   }
+
+   const T* end = v1 + nb_elements * stride_v1;
+   for (; v1 != end; v1 += stride_v1)
+   {
+      const T value = *v1;
+      if (!is_nan(value))
+      {
+         min_value = value < min_value ? value : min_value;
+      }
+   }
+}
+
+/**
+@brief update @p max_value with the max of v1. NaN are ignored
+*/
+template <class T>
+void max_naive(const T* v1, size_t stride_v1, size_t nb_elements, T& max_value)
+{
+   T result[1];
+   if (stride_v1 == 1 && simd::max(v1, result, nb_elements))
+   {
+      max_value = !is_nan(result[0]) && result[0] > max_value ? result[0] : max_value;
+      return;
+   }
+
+   const T* end = v1 + nb_elements * stride_v1;
+   for (; v1 != end; v1 += stride_v1)
+   {
+      const T value = *v1;
+      if (!is_nan(value))
+      {
+         max_value = value > max_value ? value : max_value;
+      }
+   }
+}
+
 /**
  @brief y = x
 
@@ -280,45 +1039,64 @@ void set_naive(T* y_pointer, ui32 y_stride, ui32 nb_elements, T value)
 }
 
 /**
-@brief In a strided array, return the max index
+@brief In a strided array, return the position and value of the first min (Max = false) or max (Max = true) element
+
+NaN are ignored, unless all the elements are NaN in which case the first element is returned
 */
-template <class T>
-std::pair<ui32, T> argmax(const T* ptr_start, ui32 stride, ui32 nb_elements)
+template <bool Max, class T>
+std::pair<ui32, T> arg_naive(const T* ptr_start, ui32 stride, ui32 nb_elements)
 {
-   ui32 index       = 0;
-   T max_value      = ptr_start[0];
+   size_t index = 0;
+   T best_value = T();
+   if (nb_elements == 0)
+   {
+      return std::make_pair(0u, best_value);
+   }
+   if (stride == 1 && (Max ? simd::argmax(ptr_start, &best_value, &index, nb_elements) : simd::argmin(ptr_start, &best_value, &index, nb_elements)))
+   {
+      return std::make_pair(static_cast<ui32>(index), best_value);
+   }
+
+   // start from the first element which is not a NaN
+   while (index + 1 < nb_elements && is_nan(ptr_start[index * stride]))
+   {
+      ++index;
+   }
+   if (index + 1 == nb_elements && is_nan(ptr_start[index * stride]))
+   {
+      index = 0;
+   }
+
+   best_value       = ptr_start[index * stride];
    const T* end_ptr = ptr_start + nb_elements * stride;
-   for (const T* ptr = ptr_start; ptr != end_ptr; ptr += stride)
+   for (const T* ptr = ptr_start + (index + 1) * stride; ptr < end_ptr; ptr += stride)
    {
-      auto value = *ptr;
-      if (max_value < value)
+      const auto value = *ptr;
+      if (!is_nan(value) && (Max ? best_value < value : best_value > value))
       {
-         max_value = value;
-         index     = static_cast<ui32>((ptr - ptr_start) / stride);
+         best_value = value;
+         index      = static_cast<ui32>((ptr - ptr_start) / stride);
       }
    }
-   return std::make_pair(index, max_value);
+   return std::make_pair(static_cast<ui32>(index), best_value);
 }
 
 /**
-@brief In a strided array, return the min index
+@brief In a strided array, return the max index. NaN are ignored, see @ref arg_naive
+*/
+template <class T>
+std::pair<ui32, T> argmax(const T* ptr_start, ui32 stride, ui32 nb_elements)
+{
+   return arg_naive<true>(ptr_start, stride, nb_elements);
+}
+
+/**
+@brief In a strided array, return the min index. NaN are ignored, see @ref arg_naive
 */
 template <class T>
 std::pair<ui32, T> argmin(const T* ptr_start, ui32 stride, ui32 nb_elements)
 {
-   ui32 index       = 0;
-   T min_value      = ptr_start[0];
-   const T* end_ptr = ptr_start + nb_elements * stride;
-   for (const T* ptr = ptr_start; ptr != end_ptr; ptr += stride)
-   {
-      auto value = *ptr;
-      if (min_value > value)
-      {
-         min_value = value;
-         index     = static_cast<ui32>((ptr - ptr_start) / stride);
-      }
-   }
-   return std::make_pair(index, min_value);
+   return arg_naive<false>(ptr_start, stride, nb_elements);
 }
 }
 
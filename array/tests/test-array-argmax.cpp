@@ -104,6 +104,150 @@ struct TestArrayArg
       TESTER_ASSERT(array(result(0)) == 5);
    }
 
+   void test_argmax_large()
+   {
+      // several blocks of the reduction, split between threads
+      const ui32 nb_threads     = get_parallel_nb_threads();
+      const size_t min_elements = get_parallel_min_elements();
+      set_parallel_min_elements(1);
+      for (ui32 threads = 1; threads <= 4; threads += 3)
+      {
+         set_parallel_nb_threads(threads);
+         test_argmax_large_impl<Array<float, 3>>();
+         test_argmax_large_impl<Array_column_major<double, 3>>();
+         test_argmax_large_impl<Array_row_major_multislice<float, 3>>();
+         test_argmax_large_impl<Array<int, 3>>();
+      }
+      set_parallel_nb_threads(nb_threads);
+      set_parallel_min_elements(min_elements);
+   }
+
+   template <class array_type>
+   void test_argmax_large_impl()
+   {
+      using T = typename array_type::value_type;
+
+      array_type array(vector3ui(70, 151, 9));
+      int index = 0;
+      fill_index(array, [&](const vector3ui&) { return static_cast<T>((index++ * 7919) % 1000); });
+      array(vector3ui(13, 100, 5)) = static_cast<T>(2000);
+      array(vector3ui(61, 7, 2))   = static_cast<T>(-2000);
+
+      TESTER_ASSERT(argmax(array) == vector3ui(13, 100, 5));
+      TESTER_ASSERT(argmin(array) == vector3ui(61, 7, 2));
+
+      auto sub = array(vector3ui(2, 1, 1), vector3ui(65, 149, 7));
+      TESTER_ASSERT(argmax(sub) == vector3ui(11, 99, 4));
+      TESTER_ASSERT(argmin(sub) == vector3ui(59, 6, 1));
+   }
+
+   void test_argmax_first()
+   {
+      // ties: the first element in memory order is returned
+      test_argmax_first_impl<Array<float, 3>>();
+      test_argmax_first_impl<Array_column_major<float, 3>>();
+      test_argmax_first_impl<Array<double, 3>>();
+      test_argmax_first_impl<Array<short, 3>>();
+   }
+
+   template <class array_type>
+   void test_argmax_first_impl()
+   {
+      using T = typename array_type::value_type;
+
+      array_type array(vector3ui(37, 40, 11));
+      int index = 0;
+      fill_index(array, [&](const vector3ui&) { return static_cast<T>((index++ * 7919) % 13); });
+
+      auto check = [](const array_type& a) {
+         const T* max_ptr = nullptr;
+         const T* min_ptr = nullptr;
+         for (ui32 z = 0; z < a.shape()[2]; ++z)
+         {
+            for (ui32 y = 0; y < a.shape()[1]; ++y)
+            {
+               for (ui32 x = 0; x < a.shape()[0]; ++x)
+               {
+                  const T* ptr = &a(x, y, z);
+                  if (max_ptr == nullptr || *ptr > *max_ptr || (*ptr == *max_ptr && ptr < max_ptr))
+                  {
+                     max_ptr = ptr;
+                  }
+                  if (min_ptr == nullptr || *ptr < *min_ptr || (*ptr == *min_ptr && ptr < min_ptr))
+                  {
+                     min_ptr = ptr;
+                  }
+               }
+            }
+         }
+         TESTER_ASSERT(&a(argmax(a)) == max_ptr);
+         TESTER_ASSERT(&a(argmin(a)) == min_ptr);
+      };
+
+      check(array);
+      check(array(vector3ui(3, 2, 1), vector3ui(36, 30, 9)));
+   }
+
+   void test_argmax_nan()
+   {
+      using array_type = Array<float, 2>;
+      array_type array(vector2ui(100, 3), std::numeric_limits<float>::quiet_NaN());
+      TESTER_ASSERT(argmax(array) == vector2ui(0, 0));
+
+      array(50, 1) = -std::numeric_limits<float>::infinity();
+      array(20, 2) = -std::numeric_limits<float>::infinity();
+      TESTER_ASSERT(argmax(array) == vector2ui(50, 1));
+
+      array(10, 2) = 1.0f;
+      TESTER_ASSERT(argmax(array) == vector2ui(10, 2));
+      TESTER_ASSERT(argmin(array) == vector2ui(50, 1));
+   }
+
+   void test_argmax_axis_large()
+   {
+      // per-slice peaks: the contiguous arrays are computed directly from the memory
+      test_argmax_axis_large_impl<Array<float, 3>>();
+      test_argmax_axis_large_impl<Array_column_major<double, 3>>();
+      test_argmax_axis_large_impl<Array_row_major_multislice<float, 3>>();
+   }
+
+   template <class array_type>
+   void test_argmax_axis_large_impl()
+   {
+      using T = typename array_type::value_type;
+
+      array_type array(vector3ui(40, 21, 17));
+      int index = 0;
+      fill_index(array, [&](const vector3ui&) { return static_cast<T>((index++ * 7919) % 101); });
+
+      for (ui32 axis = 0; axis < 3; ++axis)
+      {
+         const auto result_max = argmax(array, axis);
+         const auto result_min = argmin(array, axis);
+         for (ui32 j = 0; j < result_max.shape()[1]; ++j)
+         {
+            for (ui32 i = 0; i < result_max.shape()[0]; ++i)
+            {
+               const auto index_max = result_max(i, j);
+               const auto index_min = result_min(i, j);
+
+               // expected: the first max / min along the axis
+               auto line_index   = index_max;
+               line_index[axis]  = 0;
+               auto expected_max = line_index;
+               auto expected_min = line_index;
+               for (ui32 n = 0; n < array.shape()[axis]; ++n, ++line_index[axis])
+               {
+                  expected_max = array(line_index) > array(expected_max) ? line_index : expected_max;
+                  expected_min = array(line_index) < array(expected_min) ? line_index : expected_min;
+               }
+               TESTER_ASSERT(index_max == expected_max);
+               TESTER_ASSERT(index_min == expected_min);
+            }
+         }
+      }
+   }
+
    void test_axis_return_type()
    {
       using array_type = Array<float, 2>;
@@ -119,4 +263,8 @@ TESTER_TEST(test_simple_argmax);
 TESTER_TEST(test_simple_argmin);
 TESTER_TEST(test_simple_argmax_axis);
 TESTER_TEST(test_simple_argmin_axis);
+TESTER_TEST(test_argmax_large);
+TESTER_TEST(test_argmax_first);
+TESTER_TEST(test_argmax_nan);
+TESTER_TEST(test_argmax_axis_large);
 TESTER_TEST_SUITE_END();
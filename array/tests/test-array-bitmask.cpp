@@ -0,0 +1,165 @@
+#include <array/forward.h>
+#include <tester/register.h>
+
+using namespace NAMESPACE_NLL;
+
+struct TestArrayBitMask
+{
+   template <class array_type>
+   static array_type create(const vector3ui& shape, int modulo)
+   {
+      using T = typename array_type::value_type;
+      array_type a(shape);
+      int index = 0;
+      fill_index(a, [&](const vector3ui&) { return static_cast<T>((index++ * 7919) % modulo); });
+      return a;
+   }
+
+   template <class array_type, class Mask>
+   static bool equal(const array_type& expected, const Mask& mask)
+   {
+      if (expected.shape() != mask.shape())
+      {
+         return false;
+      }
+      for (ui32 z = 0; z < expected.shape()[2]; ++z)
+      {
+         for (ui32 y = 0; y < expected.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < expected.shape()[0]; ++x)
+            {
+               if ((expected(x, y, z) != 0) != mask(x, y, z))
+               {
+                  return false;
+               }
+            }
+         }
+      }
+      return true;
+   }
+
+   void test_comparisons()
+   {
+      test_comparisons_impl<Array_row_major<float, 3>>();
+      test_comparisons_impl<Array_column_major<double, 3>>();
+      test_comparisons_impl<Array_row_major_multislice<float, 3>>();
+      test_comparisons_impl<Array_row_major<int, 3>>();
+      test_comparisons_impl<Array_column_major<ui8, 3>>();
+   }
+
+   template <class array_type>
+   void test_comparisons_impl()
+   {
+      using T = typename array_type::value_type;
+
+      // odd sizes so that the lines don't start on a word boundary
+      const auto a1 = create<array_type>(vector3ui(71, 13, 3), 11);
+      const auto a2 = create<array_type>(vector3ui(71, 13, 3), 7);
+      check_comparisons(a1, a2, T(5));
+
+      const auto sub1 = a1(vector3ui(1, 2, 0), vector3ui(69, 12, 2));
+      const auto sub2 = a2(vector3ui(2, 0, 0), vector3ui(70, 10, 2));
+      check_comparisons(sub1, sub2, T(3));
+
+      // lines longer than a block
+      const auto large1 = create<array_type>(vector3ui(5003, 2, 2), 11);
+      const auto large2 = create<array_type>(vector3ui(5003, 2, 2), 7);
+      check_comparisons(large1, large2, T(5));
+   }
+
+   template <class array_type1, class array_type2, class T>
+   void check_comparisons(const array_type1& a1, const array_type2& a2, T value)
+   {
+      TESTER_ASSERT(equal(a1 < value, bitmask(a1, Comparison::less, value)));
+      TESTER_ASSERT(equal(a1 <= value, bitmask(a1, Comparison::less_equal, value)));
+      TESTER_ASSERT(equal(a1 > value, bitmask(a1, Comparison::greater, value)));
+      TESTER_ASSERT(equal(a1 >= value, bitmask(a1, Comparison::greater_equal, value)));
+      TESTER_ASSERT(equal((a1 <= value) & (a1 >= value), bitmask(a1, Comparison::equal, value)));
+      TESTER_ASSERT(equal(!((a1 <= value) & (a1 >= value)), bitmask(a1, Comparison::not_equal, value)));
+
+      TESTER_ASSERT(equal(a1 < a2, bitmask(a1, Comparison::less, a2)));
+      TESTER_ASSERT(equal(a1 <= a2, bitmask(a1, Comparison::less_equal, a2)));
+      TESTER_ASSERT(equal(a1 > a2, bitmask(a1, Comparison::greater, a2)));
+      TESTER_ASSERT(equal(a1 >= a2, bitmask(a1, Comparison::greater_equal, a2)));
+      TESTER_ASSERT(equal(equal_elementwise(a1, a2), bitmask(a1, Comparison::equal, a2)));
+      TESTER_ASSERT(equal(different_elementwise(a1, a2), bitmask(a1, Comparison::not_equal, a2)));
+   }
+
+   void test_logical()
+   {
+      using array_type = Array<float, 3>;
+      const auto a1    = create<array_type>(vector3ui(67, 5, 3), 11);
+      const auto a2    = create<array_type>(vector3ui(67, 5, 3), 7);
+
+      const auto r1 = a1 < 5.0f;
+      const auto r2 = a2 >= 3.0f;
+      const auto m1 = bitmask(a1, Comparison::less, 5.0f);
+      const auto m2 = bitmask(a2, Comparison::greater_equal, 3.0f);
+      const auto is_set = [](ui8 value) { return value != 0; };
+
+      TESTER_ASSERT(equal(r1 & r2, m1 & m2));
+      TESTER_ASSERT(equal(r1 | r2, m1 | m2));
+      TESTER_ASSERT(equal(!r1, ~m1));
+      TESTER_ASSERT(equal(!r1, !m1));
+      TESTER_ASSERT(equal((r1 | r2) & !(r1 & r2), m1 ^ m2));
+      TESTER_ASSERT(count_nonzero(m1) == count(r1, is_set));
+      TESTER_ASSERT(count_nonzero(m1 & m2) == count(r1 & r2, is_set));
+
+      // the padding bits are not counted
+      const auto all_set = ~BitMask<3>(a1.shape());
+      TESTER_ASSERT(count_nonzero(all_set) == a1.size());
+      TESTER_ASSERT(count_nonzero(BitMask<3>(a1.shape(), true)) == a1.size());
+      TESTER_ASSERT(all_set == BitMask<3>(a1.shape(), true));
+
+      auto m = m1;
+      m &= m2;
+      TESTER_ASSERT(m == (m1 & m2));
+      m |= m1;
+      TESTER_ASSERT(m == m1);
+      m ^= m1;
+      TESTER_ASSERT(count_nonzero(m) == 0);
+
+      m.set(vector3ui(66, 4, 2), true);
+      TESTER_ASSERT(m(66, 4, 2));
+      TESTER_ASSERT(count_nonzero(m) == 1);
+      m.set(vector3ui(66, 4, 2), false);
+      TESTER_ASSERT(count_nonzero(m) == 0);
+   }
+
+   void test_conversion()
+   {
+      using array_type = Array<float, 3>;
+      const auto a     = create<array_type>(vector3ui(67, 5, 3), 11);
+      const auto r     = a > 4.0f;
+
+      const auto mask = as_bitmask(r);
+      TESTER_ASSERT(equal(r, mask));
+      TESTER_ASSERT(mask == bitmask(a, Comparison::greater, 4.0f));
+
+      const Array<ui8, 3> back = as_array(mask);
+      TESTER_ASSERT(back == r);
+   }
+
+   void test_nan()
+   {
+      using array_type = Array<double, 3>;
+      array_type a(vector3ui(100, 1, 1));
+      for (ui32 n = 0; n < a.size(); ++n)
+      {
+         a(n, 0u, 0u) = n % 3 ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(n);
+      }
+
+      // NaN compares false, except for not_equal
+      TESTER_ASSERT(count_nonzero(bitmask(a, Comparison::less, 1000.0)) == 34);
+      TESTER_ASSERT(count_nonzero(bitmask(a, Comparison::greater_equal, -1.0)) == 34);
+      TESTER_ASSERT(count_nonzero(bitmask(a, Comparison::equal, a)) == 34);
+      TESTER_ASSERT(count_nonzero(bitmask(a, Comparison::not_equal, a)) == 66);
+   }
+};
+
+TESTER_TEST_SUITE(TestArrayBitMask);
+TESTER_TEST(test_comparisons);
+TESTER_TEST(test_logical);
+TESTER_TEST(test_conversion);
+TESTER_TEST(test_nan);
+TESTER_TEST_SUITE_END();
@@ -117,6 +117,72 @@ struct TestArrayChunking
       TESTER_ASSERT(chunking.getArrayIndex() == vector2ui(1, 0));
       TESTER_ASSERT(!done);
    }
+
+   void test_partial()
+   {
+      using Array = Array_row_major<float, 2>;
+
+      Array a(5, 2);
+      ArrayChunking_contiguous_base<Array> chunking(a.shape(), vector2ui(0, 1), 2);
+      TESTER_ASSERT(chunking.getNbAccesses() == 6);
+
+      const vector2ui expected_index[] = {vector2ui(0, 0), vector2ui(2, 0), vector2ui(4, 0), vector2ui(0, 1), vector2ui(2, 1), vector2ui(4, 1)};
+      const ui32 expected_size[]       = {2, 2, 1, 2, 2, 1};
+      for (ui32 n = 0; n < 6; ++n)
+      {
+         const bool done = chunking._accessElements();
+         TESTER_ASSERT(chunking.getArrayIndex() == expected_index[n]);
+         TESTER_ASSERT(chunking.getNbElementsCurrentAccess() == expected_size[n]);
+         TESTER_ASSERT(done == (n + 1 < 6));
+      }
+   }
+
+   void test_partial_restrict()
+   {
+      using Array = Array_row_major<float, 2>;
+
+      Array a(5, 2);
+      ArrayChunking_contiguous_base<Array> chunking(a.shape(), vector2ui(0, 1), 2);
+      chunking.restrictAccesses(2, 4);
+
+      bool done;
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector2ui(4, 0));
+      TESTER_ASSERT(chunking.getNbElementsCurrentAccess() == 1);
+      TESTER_ASSERT(done);
+
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector2ui(0, 1));
+      TESTER_ASSERT(chunking.getNbElementsCurrentAccess() == 2);
+      TESTER_ASSERT(!done);
+   }
+
+   void test_coalesce()
+   {
+      using Array = Array_row_major<float, 3>;
+
+      Array a(2, 3, 4);
+      ArrayChunking_contiguous_base<Array> chunking(a.shape(), vector3ui(0, 1, 2), 0);
+      chunking.coalesceDimensions(2);
+      TESTER_ASSERT(chunking.getNbAccesses() == 4);
+
+      bool done;
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector3ui(0, 0, 0));
+      TESTER_ASSERT(done);
+
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector3ui(0, 0, 1));
+      TESTER_ASSERT(done);
+
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector3ui(0, 0, 2));
+      TESTER_ASSERT(done);
+
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector3ui(0, 0, 3));
+      TESTER_ASSERT(!done);
+   }
 };
 
 TESTER_TEST_SUITE(TestArrayChunking);
@@ -124,4 +190,7 @@ TESTER_TEST(test_rowMajor);
 TESTER_TEST(test_rowMajor_max);
 TESTER_TEST(test_colMajor);
 TESTER_TEST(test_colMajor_max);
+TESTER_TEST(test_partial);
+TESTER_TEST(test_partial_restrict);
+TESTER_TEST(test_coalesce);
 TESTER_TEST_SUITE_END();
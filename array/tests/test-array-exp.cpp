@@ -4,6 +4,196 @@
 
 using namespace NAMESPACE_NLL;
 
+namespace
+{
+/**
+ The arrays using this allocator use BLAS and the expression templates, whatever the configuration of the build
+ */
+template <class T>
+class AllocatorExpr : public std::allocator<T>
+{
+public:
+   template <class U>
+   struct rebind
+   {
+      using other = AllocatorExpr<U>;
+   };
+
+   AllocatorExpr() = default;
+
+   template <class U>
+   AllocatorExpr(const AllocatorExpr<U>&)
+   {
+   }
+};
+
+/**
+ Record the BLAS calls in the order they are made and compute them with a reference implementation
+ */
+class BlasRecorder
+{
+public:
+   struct Call
+   {
+      std::string name;
+      double alpha;
+      double beta;
+   };
+
+   BlasRecorder()
+   {
+      install<blas::details::BlasFunction::sgemm>(&BlasRecorder::gemm<float>);
+      install<blas::details::BlasFunction::dgemm>(&BlasRecorder::gemm<double>);
+      install<blas::details::BlasFunction::sgemv>(&BlasRecorder::gemv<float>);
+      install<blas::details::BlasFunction::dgemv>(&BlasRecorder::gemv<double>);
+      install<blas::details::BlasFunction::saxpy>(&BlasRecorder::axpy<float>);
+      install<blas::details::BlasFunction::daxpy>(&BlasRecorder::axpy<double>);
+      install<blas::details::BlasFunction::sscal>(&BlasRecorder::scal<float>);
+      install<blas::details::BlasFunction::dscal>(&BlasRecorder::scal<double>);
+   }
+
+   ~BlasRecorder()
+   {
+      uninstall<blas::details::BlasFunction::sgemm>();
+      uninstall<blas::details::BlasFunction::dgemm>();
+      uninstall<blas::details::BlasFunction::sgemv>();
+      uninstall<blas::details::BlasFunction::dgemv>();
+      uninstall<blas::details::BlasFunction::saxpy>();
+      uninstall<blas::details::BlasFunction::daxpy>();
+      uninstall<blas::details::BlasFunction::sscal>();
+      uninstall<blas::details::BlasFunction::dscal>();
+   }
+
+   /// the names of the calls made since the previous call to @ref calls, e.g., "gemm axpy"
+   std::string calls()
+   {
+      std::string names;
+      for (const auto& call : _calls)
+      {
+         names += (names.empty() ? "" : " ") + call.name;
+      }
+      _last = _calls;
+      _calls.clear();
+      return names;
+   }
+
+   /// the calls returned by the previous @ref calls
+   const std::vector<Call>& last() const
+   {
+      return _last;
+   }
+
+private:
+   // the recorder is the first function tried by the dispatcher
+   template <blas::details::BlasFunction F, class Function>
+   void install(Function function)
+   {
+      auto& functions = blas::BlasDispatcher::instance().get<F>();
+      functions.insert(functions.begin(), [this, function](auto... args) { return (this->*function)(args...); });
+   }
+
+   template <blas::details::BlasFunction F>
+   void uninstall()
+   {
+      auto& functions = blas::BlasDispatcher::instance().get<F>();
+      functions.erase(functions.begin());
+   }
+
+   template <class T>
+   static T& element(T* m, CBLAS_ORDER order, blas::BlasInt ld, blas::BlasInt row, blas::BlasInt column)
+   {
+      return order == CBLAS_ORDER::CblasRowMajor ? m[row * ld + column] : m[row + column * ld];
+   }
+
+   template <class T>
+   blas::BlasInt gemm(CBLAS_ORDER order, blas::CBLAS_TRANSPOSE trans_a, blas::CBLAS_TRANSPOSE trans_b, blas::BlasInt m, blas::BlasInt n,
+                      blas::BlasInt k, T alpha, const T* a, blas::BlasInt lda, const T* b, blas::BlasInt ldb, T beta, T* c, blas::BlasInt ldc)
+   {
+      _calls.push_back({"gemm", alpha, beta});
+      for (blas::BlasInt i = 0; i < m; ++i)
+      {
+         for (blas::BlasInt j = 0; j < n; ++j)
+         {
+            T sum = 0;
+            for (blas::BlasInt p = 0; p < k; ++p)
+            {
+               const T a_ip = trans_a == blas::CblasNoTrans ? element(a, order, lda, i, p) : element(a, order, lda, p, i);
+               const T b_pj = trans_b == blas::CblasNoTrans ? element(b, order, ldb, p, j) : element(b, order, ldb, j, p);
+               sum += a_ip * b_pj;
+            }
+
+            // beta == 0: the content of C is ignored
+            T& c_ij = element(c, order, ldc, i, j);
+            c_ij    = alpha * sum + (beta == 0 ? T(0) : beta * c_ij);
+         }
+      }
+      return 0;
+   }
+
+   template <class T>
+   blas::BlasInt gemv(CBLAS_ORDER order, blas::CBLAS_TRANSPOSE trans_a, blas::BlasInt m, blas::BlasInt n, T alpha, const T* a, blas::BlasInt lda,
+                      const T* x, blas::BlasInt incx, T beta, T* y, blas::BlasInt incy)
+   {
+      _calls.push_back({"gemv", alpha, beta});
+      const bool trans = trans_a != blas::CblasNoTrans;
+      for (blas::BlasInt i = 0; i < (trans ? n : m); ++i)
+      {
+         T sum = 0;
+         for (blas::BlasInt p = 0; p < (trans ? m : n); ++p)
+         {
+            sum += (trans ? element(a, order, lda, p, i) : element(a, order, lda, i, p)) * x[p * incx];
+         }
+         y[i * incy] = alpha * sum + (beta == 0 ? T(0) : beta * y[i * incy]);
+      }
+      return 0;
+   }
+
+   template <class T>
+   blas::BlasInt axpy(blas::BlasInt n, T alpha, const T* x, blas::BlasInt incx, T* y, blas::BlasInt incy)
+   {
+      _calls.push_back({"axpy", alpha, 0});
+      for (blas::BlasInt i = 0; i < n; ++i)
+      {
+         y[i * incy] += alpha * x[i * incx];
+      }
+      return 0;
+   }
+
+   template <class T>
+   blas::BlasInt scal(blas::BlasInt n, T alpha, T* x, blas::BlasInt incx)
+   {
+      _calls.push_back({"scal", alpha, 0});
+      for (blas::BlasInt i = 0; i < n; ++i)
+      {
+         x[i * incx] *= alpha;
+      }
+      return 0;
+   }
+
+   std::vector<Call> _calls;
+   std::vector<Call> _last;
+};
+}
+
+DECLARE_NAMESPACE_NLL
+
+template <size_t N, class Memory>
+struct array_use_blas<Array<float, N, ArrayTraitsConfig<float, N, AllocatorExpr<float>, Memory>>> : public std::true_type
+{
+};
+
+template <size_t N, class Memory>
+struct array_use_blas<Array<double, N, ArrayTraitsConfig<double, N, AllocatorExpr<double>, Memory>>> : public std::true_type
+{
+};
+
+template <class T, size_t N, class Memory>
+struct array_use_naive_operator<Array<T, N, ArrayTraitsConfig<T, N, AllocatorExpr<T>, Memory>>> : public std::false_type
+{
+};
+
+DECLARE_NAMESPACE_NLL_END
+
 struct TestArrayExp
 {
    void test_expr_add_array_array_impl()
@@ -28,8 +218,224 @@ struct TestArrayExp
       TESTER_ASSERT(result(1, 0) == 3 * 4 + 1 - 3);
       TESTER_ASSERT(result(1, 1) == 4 * 4 + 1 - 3);
    }
+
+   template <class matrix_type>
+   static matrix_type create(size_t rows, size_t columns, double seed)
+   {
+      matrix_type m(vector2ui(static_cast<ui32>(rows), static_cast<ui32>(columns)));
+      for (size_t i = 0; i < rows; ++i)
+      {
+         for (size_t j = 0; j < columns; ++j)
+         {
+            m(i, j) = static_cast<typename matrix_type::value_type>(std::sin(seed + i * 0.7 + j * 0.37));
+         }
+      }
+      return m;
+   }
+
+   template <class vector_type>
+   static vector_type create_vector(size_t size, double seed)
+   {
+      vector_type v(vector1ui(static_cast<ui32>(size)));
+      for (size_t i = 0; i < size; ++i)
+      {
+         v(i) = static_cast<typename vector_type::value_type>(std::cos(seed + i * 0.53));
+      }
+      return v;
+   }
+
+   template <class matrix_type>
+   static double max_difference(const matrix_type& m, const std::function<double(size_t, size_t)>& expected)
+   {
+      double difference = 0;
+      for (size_t i = 0; i < m.rows(); ++i)
+      {
+         for (size_t j = 0; j < m.columns(); ++j)
+         {
+            difference = std::max(difference, std::abs(m(i, j) - expected(i, j)));
+         }
+      }
+      return difference;
+   }
+
+   template <class matrix_type>
+   static double product(const matrix_type& a, const matrix_type& b, size_t i, size_t j)
+   {
+      double sum = 0;
+      for (size_t p = 0; p < a.columns(); ++p)
+      {
+         sum += static_cast<double>(a(i, p)) * b(p, j);
+      }
+      return sum;
+   }
+
+   void test_gemm()
+   {
+      test_gemm_impl<Matrix_row_major<float, AllocatorExpr<float>>>();
+      test_gemm_impl<Matrix_column_major<float, AllocatorExpr<float>>>();
+      test_gemm_impl<Matrix_row_major<double, AllocatorExpr<double>>>();
+      test_gemm_impl<Matrix_column_major<double, AllocatorExpr<double>>>();
+   }
+
+   template <class matrix_type>
+   void test_gemm_impl()
+   {
+      using T = typename matrix_type::value_type;
+      BlasRecorder recorder;
+
+      const auto a      = create<matrix_type>(5, 3, 0);
+      const auto b      = create<matrix_type>(3, 4, 1);
+      const auto d      = create<matrix_type>(5, 4, 2);
+      auto c            = create<matrix_type>(5, 4, 3);
+      const auto c_copy = c;
+
+      // C = alpha * A * B + beta * C: a single gemm
+      const T alpha = 2;
+      const T beta  = 3;
+      c             = alpha * a * b + beta * c;
+      TESTER_ASSERT(recorder.calls() == "gemm");
+      TESTER_ASSERT(recorder.last()[0].alpha == 2 && recorder.last()[0].beta == 3);
+      TESTER_ASSERT(max_difference(c, [&](size_t i, size_t j) { return 2 * product(a, b, i, j) + 3 * c_copy(i, j); }) < 1e-4);
+
+      // the scalars can be anywhere in the expression
+      c = c_copy;
+      c = a * (b * T(2)) / T(4) - c * T(0.5);
+      TESTER_ASSERT(recorder.calls() == "gemm");
+      TESTER_ASSERT(recorder.last()[0].alpha == 0.5 && recorder.last()[0].beta == -0.5);
+      TESTER_ASSERT(max_difference(c, [&](size_t i, size_t j) { return 0.5 * product(a, b, i, j) - 0.5 * c_copy(i, j); }) < 1e-4);
+
+      // the result is allocated: the content is ignored by gemm
+      matrix_type r = a * b;
+      TESTER_ASSERT(recorder.calls() == "gemm");
+      TESTER_ASSERT(recorder.last()[0].beta == 0);
+      TESTER_ASSERT(max_difference(r, [&](size_t i, size_t j) { return product(a, b, i, j); }) < 1e-4);
+
+      // a term that is not the result
+      r = a * b - T(2) * d;
+      TESTER_ASSERT(recorder.calls() == "gemm axpy");
+      TESTER_ASSERT(recorder.last()[0].beta == 0 && recorder.last()[1].alpha == -2);
+
+      r += a * b;
+      TESTER_ASSERT(recorder.calls() == "gemm");
+      TESTER_ASSERT(recorder.last()[0].beta == 1);
+      TESTER_ASSERT(max_difference(r, [&](size_t i, size_t j) { return 2 * product(a, b, i, j) - 2 * d(i, j); }) < 1e-4);
+
+      // the operand of a product is an expression: evaluated first
+      const matrix_type r2 = (a + a) * b;
+      TESTER_ASSERT(recorder.calls() == "axpy gemm");
+      TESTER_ASSERT(max_difference(r2, [&](size_t i, size_t j) { return 2 * product(a, b, i, j); }) < 1e-4);
+   }
+
+   void test_gemv()
+   {
+      test_gemv_impl<Matrix_row_major<float, AllocatorExpr<float>>, Vector<float, AllocatorExpr<float>>>();
+      test_gemv_impl<Matrix_column_major<float, AllocatorExpr<float>>, Vector<float, AllocatorExpr<float>>>();
+      test_gemv_impl<Matrix_column_major<double, AllocatorExpr<double>>, Vector<double, AllocatorExpr<double>>>();
+   }
+
+   template <class matrix_type, class vector_type>
+   void test_gemv_impl()
+   {
+      using T = typename matrix_type::value_type;
+      BlasRecorder recorder;
+
+      const auto a      = create<matrix_type>(5, 3, 0);
+      const auto x      = create_vector<vector_type>(3, 1);
+      auto y            = create_vector<vector_type>(5, 2);
+      const auto y_copy = y;
+
+      // y = A * x + y: a single gemv
+      y = a * x + y;
+      TESTER_ASSERT(recorder.calls() == "gemv");
+      TESTER_ASSERT(recorder.last()[0].alpha == 1 && recorder.last()[0].beta == 1);
+
+      vector_type z = T(2) * a * x;
+      TESTER_ASSERT(recorder.calls() == "gemv");
+      TESTER_ASSERT(recorder.last()[0].alpha == 2 && recorder.last()[0].beta == 0);
+
+      for (size_t i = 0; i < y.size(); ++i)
+      {
+         double expected = 0;
+         for (size_t p = 0; p < x.size(); ++p)
+         {
+            expected += static_cast<double>(a(i, p)) * x(p);
+         }
+         TESTER_ASSERT(std::abs(y(i) - (expected + y_copy(i))) < 1e-4);
+         TESTER_ASSERT(std::abs(z(i) - 2 * expected) < 1e-4);
+      }
+   }
+
+   void test_axpy()
+   {
+      test_axpy_impl<Matrix_row_major<float, AllocatorExpr<float>>>();
+      test_axpy_impl<Matrix_column_major<double, AllocatorExpr<double>>>();
+   }
+
+   template <class matrix_type>
+   void test_axpy_impl()
+   {
+      using T = typename matrix_type::value_type;
+      BlasRecorder recorder;
+
+      const auto x      = create<matrix_type>(6, 5, 0);
+      auto y            = create<matrix_type>(6, 5, 1);
+      const auto y_copy = y;
+
+      // Y += a * X: a single axpy
+      y += T(3) * x;
+      TESTER_ASSERT(recorder.calls() == "axpy");
+      TESTER_ASSERT(recorder.last()[0].alpha == 3);
+
+      y -= x / T(2);
+      TESTER_ASSERT(recorder.calls() == "axpy");
+      TESTER_ASSERT(recorder.last()[0].alpha == -0.5);
+
+      // the result is scaled once
+      y = T(2) * y + x;
+      TESTER_ASSERT(recorder.calls() == "scal axpy");
+      TESTER_ASSERT(recorder.last()[0].alpha == 2 && recorder.last()[1].alpha == 1);
+      TESTER_ASSERT(max_difference(y, [&](size_t i, size_t j) { return 2 * (y_copy(i, j) + 2.5 * x(i, j)) + x(i, j); }) < 1e-4);
+
+      // the first term is copied
+      const matrix_type z = x - y_copy;
+      TESTER_ASSERT(recorder.calls() == "axpy");
+      TESTER_ASSERT(recorder.last()[0].alpha == -1);
+      TESTER_ASSERT(max_difference(z, [&](size_t i, size_t j) { return x(i, j) - y_copy(i, j); }) < 1e-6);
+   }
+
+   void test_aliasing()
+   {
+      test_aliasing_impl<Matrix_row_major<float, AllocatorExpr<float>>>();
+      test_aliasing_impl<Matrix_column_major<float, AllocatorExpr<float>>>();
+   }
+
+   template <class matrix_type>
+   void test_aliasing_impl()
+   {
+      using T = typename matrix_type::value_type;
+      BlasRecorder recorder;
+
+      const auto a      = create<matrix_type>(4, 4, 0);
+      auto c            = create<matrix_type>(4, 4, 1);
+      const auto c_copy = c;
+
+      // the result is an operand of the product: evaluated in a temporary
+      c = a * c;
+      TESTER_ASSERT(recorder.calls() == "gemm");
+      TESTER_ASSERT(max_difference(c, [&](size_t i, size_t j) { return product(a, c_copy, i, j); }) < 1e-4);
+
+      // the temporaries of an expression are owned by the expression
+      const auto e = a + create<matrix_type>(4, 4, 2) * T(2);
+      const matrix_type r = e;
+      const auto b        = create<matrix_type>(4, 4, 2);
+      TESTER_ASSERT(max_difference(r, [&](size_t i, size_t j) { return a(i, j) + 2 * b(i, j); }) < 1e-6);
+   }
 };
 
 TESTER_TEST_SUITE(TestArrayExp);
 TESTER_TEST(test_expr_add_array_array_impl);
+TESTER_TEST(test_gemm);
+TESTER_TEST(test_gemv);
+TESTER_TEST(test_axpy);
+TESTER_TEST(test_aliasing);
 TESTER_TEST_SUITE_END();
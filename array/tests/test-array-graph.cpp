@@ -0,0 +1,287 @@
+#include <array/forward.h>
+#include <tester/register.h>
+
+using namespace NAMESPACE_NLL;
+
+struct TestArrayGraph
+{
+   template <class array_type>
+   static array_type create(const typename array_type::index_type& shape, int offset)
+   {
+      using T = typename array_type::value_type;
+      array_type a(shape);
+      int index = offset;
+      fill_index(a, [&](const typename array_type::index_type&) { return static_cast<T>(index++ % 23 + 1); });
+      return a;
+   }
+
+   void test_elementwise()
+   {
+      test_elementwise_impl<Array_row_major<float, 3>>();
+      test_elementwise_impl<Array_column_major<double, 3>>();
+   }
+
+   template <class array_type>
+   void test_elementwise_impl()
+   {
+      using T = typename array_type::value_type;
+
+      // more elements than a block of the evaluation
+      const vector3ui shape(600, 7, 3);
+      const auto a = create<array_type>(shape, 0);
+      const auto b = create<array_type>(shape, 1);
+      const auto c = create<array_type>(shape, 2);
+
+      ArrayGraph graph;
+      const auto ga = graph.input(a);
+      const auto gb = graph.input(b);
+      const auto gc = graph.input(c);
+      const auto r  = sqrt(sqr(ga) + sqr(gb)) * T(0.5) + gc;
+      const auto r2 = T(3) * abs(ga - gb) / gc - T(1);
+      graph.output(r);
+      graph.output(r2);
+      graph.run();
+
+      // a single pass for each output, identical to the operators
+      TESTER_ASSERT(graph.statistics().nb_tasks == 2);
+      TESTER_ASSERT(graph.statistics().nb_fused == 9);
+      TESTER_ASSERT(graph.statistics().nb_levels == 1);
+      TESTER_ASSERT(r.value() == sqrt(sqr(a) + sqr(b)) * T(0.5) + c);
+      TESTER_ASSERT(r2.value() == T(3) * abs(a - b) / c - T(1));
+   }
+
+   void test_scalar_types()
+   {
+      // the scalar is converted to the element type before being negated
+      using array_type = Array<float, 2>;
+      const auto a     = create<array_type>(vector2ui(40, 30), 0);
+
+      ArrayGraph graph;
+      const auto ga = graph.input(a);
+      const auto r  = ga - 1u;
+      const auto r2 = (ga + 2u) * 3u;
+      graph.output(r);
+      graph.output(r2);
+      graph.run();
+
+      TESTER_ASSERT(r.value() == a - 1.0f);
+      TESTER_ASSERT(r2.value() == (a + 2.0f) * 3.0f);
+   }
+
+   void test_integers()
+   {
+      using array_type = Array<int, 2>;
+      const auto a     = create<array_type>(vector2ui(300, 5), 0);
+      const auto b     = create<array_type>(vector2ui(300, 5), 3);
+
+      ArrayGraph graph;
+      const auto ga = graph.input(a);
+      const auto gb = graph.input(b);
+      const auto r  = (mul_elementwise(ga, gb) + 7) / gb - ga / 2;
+      graph.output(r);
+      graph.run();
+
+      bool all_equal = true;
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            all_equal &= r.value()(x, y) == (a(x, y) * b(x, y) + 7) / b(x, y) - a(x, y) / 2;
+         }
+      }
+      TESTER_ASSERT(all_equal);
+   }
+
+   void test_common_subexpressions()
+   {
+      using array_type = Array<float, 2>;
+      const auto a     = create<array_type>(vector2ui(40, 30), 0);
+      const auto b     = create<array_type>(vector2ui(40, 30), 1);
+
+      ArrayGraph graph;
+      const auto ga = graph.input(a);
+      const auto gb = graph.input(b);
+      TESTER_ASSERT(graph.input(a).id() == ga.id());
+
+      const auto s            = sqr(ga) + sqr(gb);
+      const size_t nb_nodes   = graph.size();
+      const auto s_commutated = sqr(gb) + sqr(ga);
+      TESTER_ASSERT(s_commutated.id() == s.id());
+      TESTER_ASSERT(graph.size() == nb_nodes);
+
+      // different parameters are different nodes
+      TESTER_ASSERT((s * 2.0f).id() == (2.0f * s).id());
+      TESTER_ASSERT((s * 2.0f).id() != (s * 3.0f).id());
+      TESTER_ASSERT((ga - gb).id() != (gb - ga).id());
+      TESTER_ASSERT(sum(s, 0).id() == sum(s, 0).id());
+      TESTER_ASSERT(sum(s, 0).id() != sum(s, 1).id());
+      TESTER_ASSERT(sqrt(s).id() != exp(s).id());
+
+      // s is read by two nodes: it is computed once
+      const auto r1 = sqrt(s);
+      const auto r2 = s * 2.0f;
+      graph.output(r1);
+      graph.output(r2);
+      graph.run();
+
+      TESTER_ASSERT(graph.statistics().nb_tasks == 3);
+      TESTER_ASSERT(graph.statistics().nb_fused == 2);
+      TESTER_ASSERT(graph.statistics().nb_levels == 2);
+      TESTER_ASSERT(r1.value() == sqrt(sqr(a) + sqr(b)));
+      TESTER_ASSERT(r2.value() == (sqr(a) + sqr(b)) * 2.0f);
+
+      // the other nodes were not executed
+      TESTER_ASSERT(graph.statistics().nb_nodes == graph.size());
+      TESTER_ASSERT(graph.statistics().nb_tasks < graph.size());
+   }
+
+   void test_buffers()
+   {
+      using array_type = Array<int, 2>;
+      const auto a     = create<array_type>(vector2ui(40, 30), 0);
+
+      ArrayGraph graph;
+      const auto ga = graph.input(a);
+      const auto s  = ga * 2;
+      const auto t  = s + s;
+      const auto u  = t + t;
+      graph.output(u);
+      graph.run();
+
+      // s is recycled once t is computed and reused for u
+      TESTER_ASSERT(graph.statistics().nb_tasks == 3);
+      TESTER_ASSERT(graph.statistics().nb_allocations == 2);
+      TESTER_ASSERT(graph.statistics().nb_reuses == 1);
+      TESTER_ASSERT(u.value() == a * 8);
+
+      // only the outputs are available
+      TESTER_ASSERT(ga.value() == a);
+      bool thrown = false;
+      try
+      {
+         t.value();
+      }
+      catch (const std::exception&)
+      {
+         thrown = true;
+      }
+      TESTER_ASSERT(thrown);
+
+      // the inputs are referenced: a new execution reads their current values
+      array_type a2 = a;
+      ArrayGraph graph2;
+      const auto r = graph2.input(a2) + 1;
+      graph2.output(r);
+      graph2.run();
+      TESTER_ASSERT(r.value() == a + 1);
+      a2 += a;
+      graph2.run();
+      TESTER_ASSERT(r.value() == a * 2 + 1);
+   }
+
+   void test_operations()
+   {
+      using matrix_type = Matrix_row_major<float>;
+      using array_type  = Array<float, 3>;
+      const auto m      = create<matrix_type>(vector2ui(20, 30), 0);
+      const auto n      = create<matrix_type>(vector2ui(20, 30), 5);
+      const auto a      = create<array_type>(vector3ui(40, 30, 5), 0);
+      const auto b      = create<array_type>(vector3ui(40, 30, 5), 1);
+
+      ArrayGraph graph;
+      const auto gm      = graph.input(m);
+      const auto gn      = graph.input(n);
+      const auto ga      = graph.input(a);
+      const auto gb      = graph.input(b);
+      const auto product = transpose(gm + gn) * gm;
+      const auto sums    = sum(sqr(ga) - gb, 2);
+      const auto maxs    = max(ga, 0) + min(gb, 0) + mean(ga, 0);
+      graph.output(product);
+      graph.output(sums);
+      graph.output(maxs);
+      graph.run();
+
+      TESTER_ASSERT(product.value() == transpose(m + n) * m);
+      TESTER_ASSERT(sums.value() == sum(sqr(a) - b, 2));
+      TESTER_ASSERT(maxs.value() == max(a, 0) + min(b, 0) + mean(a, 0));
+   }
+
+   void test_sub_arrays()
+   {
+      using array_type = Array<float, 2>;
+      auto a           = create<array_type>(vector2ui(40, 30), 0);
+      const auto b     = create<array_type>(vector2ui(40, 30), 1);
+
+      // a strided sub-array is copied before being read
+      const auto a_sub       = a(vector2ui(2, 3), vector2ui(21, 15));
+      const array_type b_sub = b(vector2ui(5, 5), vector2ui(24, 17));
+
+      ArrayGraph graph;
+      const auto r = mul_elementwise(graph.input(a_sub), graph.input(b_sub)) + 1.0f;
+      graph.output(r);
+      graph.run();
+
+      const array_type a_sub_copy = a_sub;
+      TESTER_ASSERT(r.value() == details::array_mul_elementwise(a_sub_copy, b_sub) + 1.0f);
+   }
+
+   void test_parallel()
+   {
+      const ui32 nb_threads = get_parallel_nb_threads();
+      for (ui32 threads : {1u, 4u})
+      {
+         set_parallel_nb_threads(threads);
+         test_parallel_impl();
+      }
+      set_parallel_nb_threads(nb_threads);
+   }
+
+   void test_parallel_impl()
+   {
+      using array_type  = Array<float, 2>;
+      using vector_type = Array<float, 1>;
+      using matrix_type = Matrix_row_major<float>;
+      const auto m      = create<matrix_type>(vector2ui(50, 50), 0);
+
+      std::vector<array_type> arrays;
+      for (int n = 0; n < 8; ++n)
+      {
+         arrays.push_back(create<array_type>(vector2ui(500, 40), n));
+      }
+
+      // independent branches, executed concurrently
+      ArrayGraph graph;
+      std::vector<GraphArray<vector_type>> outputs;
+      for (size_t n = 0; n + 1 < arrays.size(); ++n)
+      {
+         const auto branch = sqrt(abs(graph.input(arrays[n]) - graph.input(arrays[n + 1]))) * 2.0f;
+         outputs.push_back(sum(branch, 1) + sum(branch, 1) * 2.0f);
+         graph.output(outputs.back());
+      }
+      const auto product = graph.input(m) * graph.input(m);
+      graph.output(product);
+      graph.run();
+
+      // the branches, their 2 identical sums then the additions of the sums
+      TESTER_ASSERT(graph.statistics().nb_tasks == 3 * (arrays.size() - 1) + 1);
+      TESTER_ASSERT(graph.statistics().nb_levels == 3);
+      for (size_t n = 0; n + 1 < arrays.size(); ++n)
+      {
+         const auto branch   = sqrt(abs(arrays[n] - arrays[n + 1])) * 2.0f;
+         const auto expected = sum(branch, 1) + sum(branch, 1) * 2.0f;
+         TESTER_ASSERT(max(abs(outputs[n].value() - expected)) < 1e-3f);
+      }
+      TESTER_ASSERT(product.value() == m * m);
+   }
+};
+
+TESTER_TEST_SUITE(TestArrayGraph);
+TESTER_TEST(test_elementwise);
+TESTER_TEST(test_scalar_types);
+TESTER_TEST(test_integers);
+TESTER_TEST(test_common_subexpressions);
+TESTER_TEST(test_buffers);
+TESTER_TEST(test_operations);
+TESTER_TEST(test_sub_arrays);
+TESTER_TEST(test_parallel);
+TESTER_TEST_SUITE_END();
@@ -0,0 +1,190 @@
+#include <array/forward.h>
+#include <tester/register.h>
+
+using namespace NAMESPACE_NLL;
+
+struct TestArrayIterationPlan
+{
+   template <class array_type>
+   static array_type create(const vector3ui& shape, int offset)
+   {
+      array_type a(shape);
+      int index = offset;
+      fill_index(a, [&](const vector3ui&) { return index++ % 19; });
+      return a;
+   }
+
+   // r = a * b + c
+   static void op_fma(int* r, ui32 r_stride, const int* a, ui32 a_stride, const int* b, ui32 b_stride, const int* c, ui32 c_stride, ui32 nb_elements)
+   {
+      for (ui32 n = 0; n < nb_elements; ++n)
+      {
+         r[n * r_stride] = a[n * a_stride] * b[n * b_stride] + c[n * c_stride];
+      }
+   }
+
+   template <class R, class A, class B, class C>
+   static bool check_fma(const R& r, const A& a, const B& b, const C& c)
+   {
+      for (ui32 z = 0; z < r.shape()[2]; ++z)
+      {
+         for (ui32 y = 0; y < r.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < r.shape()[0]; ++x)
+            {
+               if (r(x, y, z) != a(x, y, z) * b(x, y, z) + c(x, y, z))
+               {
+                  return false;
+               }
+            }
+         }
+      }
+      return true;
+   }
+
+   void test_plan()
+   {
+      test_plan_impl<Array_row_major<int, 3>>();
+      test_plan_impl<Array_column_major<int, 3>>();
+   }
+
+   template <class array_type>
+   void test_plan_impl()
+   {
+      const vector3ui shape(21, 32, 11);
+      const auto a = create<array_type>(shape, 0);
+      const auto b = create<array_type>(shape, 1);
+      const auto c = create<array_type>(shape, 2);
+
+      array_type r(shape);
+      const auto plan = make_iteration_plan(r, a, b, c);
+      TESTER_ASSERT(plan.isValid());
+      TESTER_ASSERT(plan.getNbLines() == 1); // fully contiguous arrays are a single memory line
+      TESTER_ASSERT(plan.getLineSize() == r.size());
+
+      iterate_array_constarrays(plan, op_fma, r, a, b, c);
+      TESTER_ASSERT(check_fma(r, a, b, c));
+
+      // the plan is replayable on any arrays with the same geometry
+      const auto a2 = create<array_type>(shape, 5);
+      array_type r2(shape);
+      TESTER_ASSERT(plan.matches(r2.getMemory(), a2.getMemory(), b.getMemory(), c.getMemory()));
+      iterate_array_constarrays(plan, op_fma, r2, a2, b, c);
+      TESTER_ASSERT(check_fma(r2, a2, b, c));
+
+      array_type r_parallel(shape);
+      iterate_array_constarrays(plan, Parallel(4, 1), op_fma, r_parallel, a2, b, c);
+      TESTER_ASSERT(r_parallel == r2);
+   }
+
+   void test_plan_sub_arrays()
+   {
+      using array_type = Array_row_major<int, 3>;
+      const vector3ui shape(30, 20, 10);
+      const auto a = create<array_type>(shape, 0);
+      const auto b = create<array_type>(shape, 1);
+      const auto c = create<array_type>(shape, 2);
+      array_type r(shape);
+
+      const vector3ui min_index(2, 3, 1);
+      const vector3ui max_index(20, 15, 8);
+      auto r_sub       = r(min_index, max_index);
+      const auto a_sub = const_cast<array_type&>(a)(min_index, max_index);
+      const auto b_sub = const_cast<array_type&>(b)(min_index, max_index);
+      const auto c_sub = const_cast<array_type&>(c)(min_index, max_index);
+
+      const auto plan = make_iteration_plan(r_sub, a_sub, b_sub, c_sub);
+      TESTER_ASSERT(plan.isValid());
+      TESTER_ASSERT(plan.getLineSize() == 19);
+      TESTER_ASSERT(plan.getNbLines() == 13 * 8);
+      iterate_array_constarrays(plan, op_fma, r_sub, a_sub, b_sub, c_sub);
+      TESTER_ASSERT(check_fma(r_sub, a_sub, b_sub, c_sub));
+
+      // another region with the same geometry
+      auto r_sub2       = r(vector3ui(0, 0, 0), max_index - min_index);
+      const auto a_sub2 = const_cast<array_type&>(a)(vector3ui(0, 0, 0), max_index - min_index);
+      TESTER_ASSERT(plan.matches(r_sub2.getMemory(), a_sub2.getMemory(), b_sub.getMemory(), c_sub.getMemory()));
+      iterate_array_constarrays(plan, op_fma, r_sub2, a_sub2, b_sub, c_sub);
+      TESTER_ASSERT(check_fma(r_sub2, a_sub2, b_sub, c_sub));
+
+      // different geometry
+      TESTER_ASSERT(!plan.matches(r.getMemory(), a.getMemory(), b.getMemory(), c.getMemory()));
+   }
+
+   void test_plan_invalid()
+   {
+      const vector3ui shape(7, 6, 5);
+
+      // slice based memory
+      const auto a = create<Array_row_major_multislice<int, 3>>(shape, 0);
+      Array_row_major_multislice<int, 3> r(shape);
+      TESTER_ASSERT(!make_iteration_plan(r, a).isValid());
+
+      // different data ordering
+      const auto b = create<Array_column_major<int, 3>>(shape, 0);
+      Array_row_major<int, 3> r2(shape);
+      TESTER_ASSERT(!make_iteration_plan(r2, b).isValid());
+   }
+
+   void test_cached()
+   {
+      test_cached_impl<Array_row_major<int, 3>, Array_row_major<int, 3>>();
+      test_cached_impl<Array_row_major_multislice<int, 3>, Array_row_major_multislice<int, 3>>();
+      test_cached_impl<Array_row_major<int, 3>, Array_column_major<int, 3>>();
+   }
+
+   template <class array_type1, class array_type2>
+   void test_cached_impl()
+   {
+      auto& cache = details::iteration_plan_cache<3, 4>();
+      cache.clear();
+
+      const vector3ui shape(13, 12, 7);
+      for (int n = 0; n < 3; ++n)
+      {
+         const auto a = create<array_type2>(shape, n);
+         const auto b = create<array_type2>(shape, n + 1);
+         const auto c = create<array_type2>(shape, n + 2);
+         array_type1 r(shape);
+         iterate_array_constarrays_cached(op_fma, r, a, b, c);
+         TESTER_ASSERT(check_fma(r, a, b, c));
+
+         array_type1 r_parallel(shape);
+         iterate_array_constarrays_cached(Parallel(4, 1), op_fma, r_parallel, a, b, c);
+         TESTER_ASSERT(r_parallel == r);
+      }
+
+      // a single plan for the same geometry
+      TESTER_ASSERT(cache.size() == 1);
+   }
+
+   void test_cached_capacity()
+   {
+      using array_type = Array_row_major<int, 2>;
+      auto& cache      = details::iteration_plan_cache<2, 1>();
+      cache.clear();
+
+      auto op = [](int* ptr, ui32 stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            ptr[n * stride] += 1;
+         }
+      };
+
+      for (ui32 n = 1; n < 2 * cache.capacity; ++n)
+      {
+         array_type a(vector2ui(n, 3), 1);
+         iterate_array_constarrays_cached(op, a);
+         TESTER_ASSERT(a == array_type(vector2ui(n, 3), 2));
+      }
+      TESTER_ASSERT(cache.size() == cache.capacity);
+   }
+};
+
+TESTER_TEST_SUITE(TestArrayIterationPlan);
+TESTER_TEST(test_plan);
+TESTER_TEST(test_plan_sub_arrays);
+TESTER_TEST(test_plan_invalid);
+TESTER_TEST(test_cached);
+TESTER_TEST(test_cached_capacity);
+TESTER_TEST_SUITE_END();
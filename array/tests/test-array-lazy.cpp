@@ -0,0 +1,257 @@
+#include <array/forward.h>
+#include <tester/register.h>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace NAMESPACE_NLL;
+
+struct TestArrayLazy
+{
+   template <class array_type>
+   static array_type create(const vector3ui& shape, int offset)
+   {
+      using T = typename array_type::value_type;
+      array_type a(shape);
+      int index = offset;
+      fill_index(a, [&](const vector3ui&) { return static_cast<T>(index++ % 23 + 1); });
+      return a;
+   }
+
+   template <class array_type, class array_type2>
+   static array_type convert(const array_type2& a)
+   {
+      array_type r(a.shape());
+      fill_index(r, [&](const typename array_type::index_type& index) { return a(index); });
+      return r;
+   }
+
+   void test_operators()
+   {
+      test_operators_impl<Array_row_major<float, 3>, Array_row_major<float, 3>>();
+      test_operators_impl<Array_row_major<float, 3>, Array_column_major<float, 3>>();
+      test_operators_impl<Array_column_major<double, 3>, Array_row_major_multislice<double, 3>>();
+      test_operators_impl<Array_row_major<int, 3>, Array_row_major<int, 3>>();
+   }
+
+   template <class array_type, class array_type2>
+   void test_operators_impl()
+   {
+      using T = typename array_type::value_type;
+
+      // the lines are longer than a block of the evaluation
+      const vector3ui shape(600, 7, 3);
+      const auto a = create<array_type>(shape, 0);
+      const auto b = create<array_type2>(shape, 1);
+      const auto c = create<array_type>(shape, 2);
+
+      // identical to the operators
+      const array_type r        = (lazy(a) - b) * T(2) + c;
+      const array_type expected = (a - convert<array_type>(b)) * T(2) + c;
+      TESTER_ASSERT(r == expected);
+
+      // the reference is computed by the operators: a scalar expression may be reassociated with -ffast-math
+      const array_type r2 = T(3) * (lazy(a) * b) / c + T(1) - lazy(a) / T(2);
+      TESTER_ASSERT(r2 == T(3) * details::array_mul_elementwise(a, b) / c + T(1) - a / T(2));
+
+      // the data ordering of the result is independent of the expression
+      array_type2 r3;
+      r3 = lazy(c) + a;
+      TESTER_ASSERT(r3 == c + a);
+   }
+
+   void test_aliasing()
+   {
+      using array_type = Array<float, 2>;
+      array_type a(vector2ui(300, 4));
+      array_type b(vector2ui(300, 4));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<float>(index++ % 7); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<float>(index++ % 5); });
+
+      // the result is one of the arrays of the expression
+      const array_type expected = b + a * 2.0f;
+      a                         = lazy(b) + lazy(a) * 2.0f;
+      TESTER_ASSERT(a == expected);
+
+      // reallocated if the shape is different
+      array_type c(vector2ui(3, 3));
+      c = lazy(a) - b - 1.0f;
+      TESTER_ASSERT(c.shape() == a.shape());
+      TESTER_ASSERT(c == array_type(a - b - 1.0f));
+   }
+
+   void test_sub_arrays()
+   {
+      using array_type = Array<float, 2>;
+      array_type a(vector2ui(40, 30));
+      array_type b(vector2ui(40, 30));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<float>(index++ % 7); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<float>(index++ % 5); });
+
+      // a strided sub-array in the expression and as the result
+      array_type r                = a;
+      const auto a_sub            = a(vector2ui(2, 3), vector2ui(21, 15));
+      auto r_sub                  = r(vector2ui(10, 1), vector2ui(29, 13));
+      const array_type b_sub      = b(vector2ui(5, 5), vector2ui(24, 17));
+      const array_type a_sub_copy = a_sub;
+      r_sub                       = lazy(a_sub) * b_sub + 1.0f;
+
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            const bool inside    = x >= 10 && x <= 29 && y >= 1 && y <= 13;
+            const float expected = inside ? a_sub_copy(x - 10, y - 1) * b_sub(x - 10, y - 1) + 1.0f : a(x, y);
+            TESTER_ASSERT(r(x, y) == expected);
+         }
+      }
+   }
+
+   void test_functions()
+   {
+      using array_type = Array<float, 2>;
+      array_type a(vector2ui(301, 5));
+      array_type b(vector2ui(301, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<float>(std::sin(index++ * 0.37) * 3); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<float>(std::cos(index++ * 0.11) * 2); });
+
+      const array_type r = sqrt(sqr(lazy(a)) + sqr(b));
+      TESTER_ASSERT(r == sqrt(sqr(a) + sqr(b)));
+
+      // the vectorized functions may differ from the scalar functions used for the tails of the lines in the last bit
+      const array_type r2       = exp(lazy(a) * 0.5f) + log(abs(lazy(b)) + 1.0f) - cos(lazy(a)) * sin(lazy(b));
+      const array_type expected = exp(a * 0.5f) + log(abs(b) + 1.0f) - details::array_mul_elementwise(cos(a), sin(b));
+      TESTER_ASSERT(max(abs(r2 - expected)) < 1e-5f);
+   }
+
+   void test_sum()
+   {
+      const ui32 nb_threads   = get_parallel_nb_threads();
+      const bool reproducible = get_parallel_reproducible();
+      for (ui32 threads : {1u, 4u})
+      {
+         set_parallel_nb_threads(threads);
+         for (bool is_reproducible : {false, true})
+         {
+            set_parallel_reproducible(is_reproducible);
+            test_sum_impl<Array_row_major<double, 3>, Array_row_major<double, 3>>();
+            test_sum_impl<Array_row_major<double, 3>, Array_column_major<double, 3>>();
+            test_sum_impl<Array_row_major<int, 3>, Array_row_major_multislice<int, 3>>();
+            test_sum_impl<Array_row_major<short, 3>, Array_row_major<short, 3>>();
+         }
+      }
+      set_parallel_nb_threads(nb_threads);
+      set_parallel_reproducible(reproducible);
+   }
+
+   template <class array_type, class array_type2>
+   void test_sum_impl()
+   {
+      using T = typename array_type::value_type;
+
+      // more elements than a block of the reductions
+      const vector3ui shape(300, 40, 3);
+      const auto a = create<array_type>(shape, 0);
+      const auto b = create<array_type2>(shape, 1);
+
+      // the values are small integers: the sums are exact
+      double expected     = 0;
+      double expected_sub = 0;
+      for (ui32 z = 0; z < shape[2]; ++z)
+      {
+         for (ui32 y = 0; y < shape[1]; ++y)
+         {
+            for (ui32 x = 0; x < shape[0]; ++x)
+            {
+               expected += static_cast<double>(a(x, y, z)) * static_cast<double>(b(x, y, z));
+               expected_sub += static_cast<double>(a(x, y, z)) - static_cast<double>(b(x, y, z));
+            }
+         }
+      }
+
+      TESTER_ASSERT(static_cast<double>(sum(lazy(a) * b)) == expected);
+      TESTER_ASSERT(static_cast<double>(sum(lazy(a) - b)) == expected_sub);
+      TESTER_ASSERT(std::abs(static_cast<double>(mean(lazy(a) * b)) - expected / a.size()) < 1);
+
+      // a single array
+      TESTER_ASSERT(sum(lazy(a) * T(1)) == sum(a));
+   }
+
+   template <class T>
+   static void copy_recording_threads(T* output, ui32 output_stride, const T* input, ui32 input_stride, ui32 nb_elements)
+   {
+      {
+         std::lock_guard<std::mutex> lock(threads_mutex());
+         threads_used().insert(std::this_thread::get_id());
+      }
+      details::copy_naive(output, output_stride, input, input_stride, nb_elements);
+   }
+
+   static std::mutex& threads_mutex()
+   {
+      static std::mutex mutex;
+      return mutex;
+   }
+
+   static std::set<std::thread::id>& threads_used()
+   {
+      static std::set<std::thread::id> threads;
+      return threads;
+   }
+
+   void test_sum_threads()
+   {
+      test_sum_threads_impl<Array_row_major<float, 3>, Array_row_major<float, 3>>(vector3ui(300, 40, 3));
+      test_sum_threads_impl<Array_row_major<double, 3>, Array_column_major<double, 3>>(vector3ui(300, 40, 3));
+      test_sum_threads_impl<Array_row_major<double, 3>, Array_row_major_multislice<double, 3>>(vector3ui(20000, 2, 3));
+   }
+
+   template <class array_type, class array_type2>
+   void test_sum_threads_impl(const vector3ui& shape)
+   {
+      using T                 = typename array_type::value_type;
+      const ui32 nb_threads   = get_parallel_nb_threads();
+      const ui32 min_elements = get_parallel_min_elements();
+      set_parallel_min_elements(1);
+
+      // the values are not exactly summable: the result depends on the order of the operations
+      array_type a(shape);
+      array_type2 b(shape);
+      ui32 index = 0;
+      fill_index(a, [&](const vector3ui&) { return static_cast<T>(std::sin(static_cast<double>(index++)) * 1e3); });
+      fill_index(b, [&](const vector3ui&) { return static_cast<T>(std::cos(static_cast<double>(index++)) * 0.1); });
+
+      set_parallel_nb_threads(1);
+      const auto expected = sum(lazy(a) * b + T(0.3));
+      for (ui32 threads : {2u, 3u, 4u, 7u})
+      {
+         set_parallel_nb_threads(threads);
+         TESTER_ASSERT(sum(lazy(a) * b + T(0.3)) == expected);
+      }
+
+#ifdef WITH_OMP
+      // the deterministic sum is still computed by several threads
+      set_parallel_nb_threads(4);
+      threads_used().clear();
+      const auto product  = lazy(a) * b;
+      const auto recorded = details::LazyFunction<typename std::decay<decltype(product)>::type>(product, &copy_recording_threads<T>);
+      TESTER_ASSERT(sum(recorded) == sum(product));
+      TESTER_ASSERT(threads_used().size() > 1);
+#endif
+
+      set_parallel_nb_threads(nb_threads);
+      set_parallel_min_elements(min_elements);
+   }
+};
+
+TESTER_TEST_SUITE(TestArrayLazy);
+TESTER_TEST(test_operators);
+TESTER_TEST(test_aliasing);
+TESTER_TEST(test_sub_arrays);
+TESTER_TEST(test_functions);
+TESTER_TEST(test_sum);
+TESTER_TEST(test_sum_threads);
+TESTER_TEST_SUITE_END();
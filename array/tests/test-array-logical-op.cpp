@@ -414,6 +414,134 @@ struct TestArrayLogicalOp
       TESTER_ASSERT(!all(array, predicate_false));
    }
 
+   void test_any_predicates()
+   {
+      test_any_predicates_impl<Array_row_major<float, 3>>();
+      test_any_predicates_impl<Array_column_major<double, 3>>();
+      test_any_predicates_impl<Array_row_major_multislice<float, 3>>();
+      test_any_predicates_impl<Array_row_major<int, 3>>();
+   }
+
+   template <class array_type>
+   void test_any_predicates_impl()
+   {
+      using T = typename array_type::value_type;
+
+      // the vectorized predicates must give the same results as the equivalent lambdas
+      array_type a(vector3ui(131, 17, 5));
+      int index = 0;
+      fill_index(a, [&](const vector3ui&) { return static_cast<T>((index++ * 7919) % 1000); });
+      const auto sub = a(vector3ui(1, 2, 1), vector3ui(129, 15, 4));
+
+      const T values[] = {T(-1), T(0), T(500), T(999), T(1000)};
+      const Comparison comparisons[] = {Comparison::less,          Comparison::less_equal, Comparison::greater,
+                                        Comparison::greater_equal, Comparison::equal,      Comparison::not_equal};
+      for (auto value : values)
+      {
+         for (auto comparison : comparisons)
+         {
+            const auto predicate = predicate_compare(comparison, value);
+            const auto lambda    = [&](T element) { return details::compare_values(element, value, comparison); };
+            check_predicate(a, predicate, lambda);
+            check_predicate(sub, predicate, lambda);
+         }
+
+         const auto approx = predicate_approx_equal(value, T(2));
+         check_predicate(a, approx, [&](T element) { return std::abs(static_cast<double>(element) - value) <= 2; });
+      }
+
+      TESTER_ASSERT(!any(a, predicate_is_nan()));
+      TESTER_ASSERT(all(a, predicate_is_finite()));
+   }
+
+   template <class array_type, class Predicate, class Lambda>
+   void check_predicate(const array_type& a, const Predicate& predicate, const Lambda& lambda)
+   {
+      using index_type = typename array_type::index_type;
+
+      TESTER_ASSERT(any(a, predicate) == any(a, lambda));
+      TESTER_ASSERT(all(a, predicate) == all(a, lambda));
+
+      index_type index_predicate;
+      index_type index_lambda;
+      std::vector<index_type> indexes_predicate;
+      std::vector<index_type> indexes_lambda;
+      TESTER_ASSERT(any(a, predicate, &index_predicate, &indexes_predicate) == any(a, lambda, &index_lambda, &indexes_lambda));
+      TESTER_ASSERT(indexes_predicate == indexes_lambda);
+      TESTER_ASSERT(indexes_predicate.empty() || index_predicate == index_lambda);
+   }
+
+   void test_any_parallel()
+   {
+      // the threads must agree on the first element in memory order
+      using array_type = Array<float, 3>;
+      array_type a(vector3ui(64, 64, 64), 1.0f);
+
+      const ui32 nb_threads_settings = get_parallel_nb_threads();
+      const size_t min_elements      = get_parallel_min_elements();
+      set_parallel_min_elements(1);
+
+      const vector3ui positions[] = {vector3ui(63, 63, 63), vector3ui(5, 0, 40), vector3ui(0, 0, 0), vector3ui(17, 33, 2)};
+      for (ui32 nb_threads = 1; nb_threads <= 5; nb_threads += 2)
+      {
+         set_parallel_nb_threads(nb_threads);
+         TESTER_ASSERT(!any(a, predicate_is_nan()));
+         TESTER_ASSERT(all(a, predicate_is_finite()));
+
+         for (const auto& position : positions)
+         {
+            a(position) = std::numeric_limits<float>::quiet_NaN();
+            vector3ui index;
+            TESTER_ASSERT(any(a, predicate_is_nan(), &index));
+            TESTER_ASSERT(index == position);
+            TESTER_ASSERT(!all(a, predicate_is_finite()));
+            std::vector<vector3ui>* no_indexes = nullptr;
+            TESTER_ASSERT(any(a, [](float value) { return details::is_nan(value); }, &index, no_indexes, Parallel()));
+            TESTER_ASSERT(index == position);
+            a(position) = 1.0f;
+         }
+
+         // several elements: the first in memory order is returned
+         for (const auto& position : positions)
+         {
+            a(position) = std::numeric_limits<float>::quiet_NaN();
+         }
+         vector3ui index;
+         TESTER_ASSERT(any(a, predicate_is_nan(), &index));
+         TESTER_ASSERT(index == vector3ui(0, 0, 0));
+         a(0, 0, 0) = 1.0f;
+         TESTER_ASSERT(any(a, predicate_is_nan(), &index));
+         TESTER_ASSERT(index == vector3ui(17, 33, 2));
+
+         for (const auto& position : positions)
+         {
+            a(position) = 1.0f;
+         }
+      }
+
+      a(3, 4, 5) = std::numeric_limits<float>::infinity();
+      TESTER_ASSERT(!all(a, predicate_is_finite()));
+      TESTER_ASSERT(!any(a, predicate_is_nan()));
+
+      // the predicates of the user are called serially, in memory order, unless a Parallel is given
+      set_parallel_nb_threads(4);
+      int nb_calls         = 0;
+      const float* last    = nullptr;
+      bool in_memory_order = true;
+      const bool all_finite = all(a, [&](const float& value) {
+         ++nb_calls;
+         in_memory_order &= last < &value;
+         last = &value;
+         return details::is_finite(value);
+      });
+      TESTER_ASSERT(!all_finite);
+      TESTER_ASSERT(in_memory_order);
+      TESTER_ASSERT(nb_calls == static_cast<int>(a.getMemory().getIndexMapper().offset(vector3ui(3, 4, 5)) + 1));
+
+      set_parallel_nb_threads(nb_threads_settings);
+      set_parallel_min_elements(min_elements);
+   }
+
    void test_where()
    {
       using array_type = Array_column_major<int, 2>;
@@ -428,6 +556,105 @@ struct TestArrayLogicalOp
       TESTER_ASSERT(r[1] == vector2ui(0, 2));
       TESTER_ASSERT(r[2] == vector2ui(1, 1));
       TESTER_ASSERT(r[3] == vector2ui(1, 2));
+
+      // serial by default: a predicate with a state is called once per element, in memory order
+      const ui32 nb_threads_settings = get_parallel_nb_threads();
+      const size_t min_elements      = get_parallel_min_elements();
+      set_parallel_nb_threads(4);
+      set_parallel_min_elements(1);
+
+      Array<int, 2> b(300, 20);
+      int index = 0;
+      fill_index(b, [&](const vector2ui&) { return index++; });
+      int nb_calls   = 0;
+      int last_value = -1;
+      bool in_order  = true;
+      const auto r2  = where(b, [&](int value) {
+         ++nb_calls;
+         in_order &= value > last_value;
+         last_value = value;
+         return value % 7 == 0;
+      });
+      TESTER_ASSERT(nb_calls == static_cast<int>(b.size()));
+      TESTER_ASSERT(in_order);
+      TESTER_ASSERT(r2.size() == (b.size() + 6) / 7);
+
+      set_parallel_nb_threads(nb_threads_settings);
+      set_parallel_min_elements(min_elements);
+   }
+
+   void test_where_variants()
+   {
+      const ui32 nb_threads_settings = get_parallel_nb_threads();
+      const size_t min_elements      = get_parallel_min_elements();
+      set_parallel_min_elements(1);
+      for (ui32 nb_threads = 1; nb_threads <= 4; nb_threads += 3)
+      {
+         set_parallel_nb_threads(nb_threads);
+         test_where_variants_impl<Array_row_major<float, 3>>();
+         test_where_variants_impl<Array_column_major<int, 3>>();
+         test_where_variants_impl<Array_row_major_multislice<float, 3>>();
+      }
+      set_parallel_nb_threads(nb_threads_settings);
+      set_parallel_min_elements(min_elements);
+   }
+
+   template <class array_type>
+   void test_where_variants_impl()
+   {
+      using T = typename array_type::value_type;
+
+      array_type a(vector3ui(37, 11, 6));
+      int index = 0;
+      fill_index(a, [&](const vector3ui&) { return static_cast<T>((index++ * 7919) % 13); });
+      check_where(a);
+      check_where(a(vector3ui(2, 1, 1), vector3ui(30, 9, 4)));
+
+      // a single line: split between the threads
+      array_type line(vector3ui(1000, 1, 1));
+      fill_index(line, [&](const vector3ui&) { return static_cast<T>((index++ * 7919) % 13); });
+      check_where(line);
+   }
+
+   template <class array_type>
+   void check_where(const array_type& a)
+   {
+      using T         = typename array_type::value_type;
+      const auto p    = [](T value) { return value < 4; };
+      const auto none = [](T value) { return value > 100; };
+
+      std::vector<StaticVector<ui32, 3>> expected;
+      StaticVector<ui32, 3> first;
+      any(a, p, &first, &expected);
+      TESTER_ASSERT(!expected.empty());
+
+      const auto indexes     = where(a, p);
+      const auto offsets     = where_offsets(a, p);
+      TESTER_ASSERT(where(a, p, Parallel()) == expected);
+      const auto coordinates = where_coordinates(a, p);
+      const auto unraveled   = unravel_index(offsets, a.shape());
+      TESTER_ASSERT(indexes == expected);
+      TESTER_ASSERT(offsets.size() == expected.size());
+      TESTER_ASSERT(unraveled == coordinates);
+      for (size_t n = 0; n < expected.size(); ++n)
+      {
+         const auto& i = expected[n];
+         TESTER_ASSERT(offsets[n] == i[0] + a.shape()[0] * (i[1] + static_cast<size_t>(a.shape()[1]) * i[2]));
+         TESTER_ASSERT(coordinates[0][n] == i[0]);
+         TESTER_ASSERT(coordinates[1][n] == i[1]);
+         TESTER_ASSERT(coordinates[2][n] == i[2]);
+      }
+
+      TESTER_ASSERT(where(a, none).empty());
+      TESTER_ASSERT(where_offsets(a, none).empty());
+      TESTER_ASSERT(where_coordinates(a, none)[2].empty());
+   }
+
+   void test_unravel_index()
+   {
+      const auto coordinates = unravel_index(std::vector<size_t>{0, 5, 7}, vector2ui(3, 4));
+      TESTER_ASSERT(coordinates[0] == std::vector<ui32>({0, 2, 1}));
+      TESTER_ASSERT(coordinates[1] == std::vector<ui32>({0, 1, 2}));
    }
 };
 
@@ -449,5 +676,9 @@ TESTER_TEST(test_count);
 TESTER_TEST(test_count_axis);
 TESTER_TEST(test_any);
 TESTER_TEST(test_all);
+TESTER_TEST(test_any_predicates);
+TESTER_TEST(test_any_parallel);
 TESTER_TEST(test_where);
+TESTER_TEST(test_where_variants);
+TESTER_TEST(test_unravel_index);
 TESTER_TEST_SUITE_END();
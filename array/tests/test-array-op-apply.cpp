@@ -528,6 +528,181 @@ struct TestArrayOpApply
       TESTER_ASSERT(equal<float>(copy(1), (2.0f + 5.0f) / 2, 1e-4f));
       TESTER_ASSERT(equal<float>(copy(2), (3.0f + 6.0f) / 2, 1e-4f));
    }
+
+   void test_array_conversions()
+   {
+      using array_type = Array<float, 3>;
+      array_type b(40, 30, 5);
+      for (size_t n = 0; n < b.size(); ++n)
+      {
+         const vector3ui index(static_cast<ui32>(n % 40), static_cast<ui32>((n / 40) % 30), static_cast<ui32>(n / 1200));
+         b(index) = static_cast<float>(std::sin(n * 0.37) * 400);
+      }
+      b(0, 0, 0) = std::numeric_limits<float>::quiet_NaN();
+      b(1, 0, 0) = std::numeric_limits<float>::infinity();
+      b(2, 0, 0) = 254.5f;
+
+      // full and strided arrays
+      const auto sub = b(vector3ui{1, 2, 0}, vector3ui{38, 28, 4}, vector3ui{1, 3, 2});
+      test_array_conversions_impl(b);
+      test_array_conversions_impl(sub);
+
+      Array<ui8, 3> a = saturated(b);
+      TESTER_ASSERT(a(0, 0, 0) == 0);
+      TESTER_ASSERT(a(1, 0, 0) == 255);
+      TESTER_ASSERT(a(2, 0, 0) == 254);
+
+      a = converted(b, Conversion::round_saturate);
+      TESTER_ASSERT(a(2, 0, 0) == 255);
+
+      // saturating to the range of the type is the vectorized conversion
+      const auto c = saturate<ui8>(b, 0.0f, 255.0f);
+      TESTER_ASSERT((c == Array<ui8, 3>(saturated(b))));
+   }
+
+   template <class Array>
+   void test_array_conversions_impl(const Array& b)
+   {
+      using index_type = typename Array::index_type;
+      const NAMESPACE_NLL::Array<ui8, 3> saturated_u8         = saturated(b);
+      const NAMESPACE_NLL::Array<short, 3> rounded_s16        = converted(b, Conversion::round);
+      const NAMESPACE_NLL::Array<std::int8_t, 3> saturated_s8 = converted(b, Conversion::round_saturate);
+      const NAMESPACE_NLL::Array<double, 3> cast_f64          = b;
+      const auto rounded_s32                                  = round<int>(b);
+
+      bool all_equal = true;
+      for (ui32 z = 0; z < b.shape()[2]; ++z)
+      {
+         for (ui32 y = 0; y < b.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < b.shape()[0]; ++x)
+            {
+               const index_type index(x, y, z);
+               const float value = b(index);
+               all_equal &= saturated_u8(index) == NAMESPACE_NLL::details::convert_value<ui8>(value, Conversion::saturate);
+               all_equal &= saturated_s8(index) == NAMESPACE_NLL::details::convert_value<std::int8_t>(value, Conversion::round_saturate);
+               all_equal &= cast_f64(index) == static_cast<double>(value) || (std::isnan(cast_f64(index)) && std::isnan(value));
+               if (std::isfinite(value))
+               {
+                  all_equal &= rounded_s16(index) == static_cast<short>(std::round(value));
+                  all_equal &= rounded_s32(index) == static_cast<int>(std::round(value));
+               }
+            }
+         }
+      }
+      TESTER_ASSERT(all_equal);
+   }
+
+   void test_array_apply_functions_rvalue()
+   {
+      test_array_apply_functions_rvalue_impl<Array<float, 2>>();
+      test_array_apply_functions_rvalue_impl<Array_column_major<double, 2>>();
+      test_array_apply_functions_rvalue_impl<Array_row_major_multislice<float, 2>>();
+   }
+
+   template <class Array>
+   void test_array_apply_functions_rvalue_impl()
+   {
+      using T = typename Array::value_type;
+
+      // odd sizes: the lines have vectorized parts and tails
+      Array a(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<T>(std::sin(index++ * 0.37) * 3); });
+
+      // the functions are computed in the memory of the temporary
+      Array t         = a * T(0.5);
+      const T* memory = &t(0, 0);
+      const Array r   = exp(sqr(log(sqrt(abs(sin(cos(std::move(t))))) + T(1))));
+      TESTER_ASSERT(&r(0, 0) == memory);
+
+      // a temporary sub-array references its memory: it is not modified
+      const Array a_copy = a;
+      const Array r2     = cos(a(vector2ui(1, 1), vector2ui(30, 3)));
+      TESTER_ASSERT(a == a_copy);
+
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            const double expected = std::exp(sqr(std::log(std::sqrt(std::abs(std::sin(std::cos(a(x, y) * 0.5)))) + 1)));
+            TESTER_ASSERT(std::abs(r(x, y) - expected) < 1e-4);
+            if (x >= 1 && x <= 30 && y >= 1 && y <= 3)
+            {
+               TESTER_ASSERT(std::abs(r2(x - 1, y - 1) - std::cos(a(x, y))) < 1e-5);
+            }
+         }
+      }
+   }
+
+   void test_array_apply_functions_output()
+   {
+      test_array_apply_functions_output_impl<Array<float, 2>, Array<float, 2>>();
+      test_array_apply_functions_output_impl<Array_column_major<double, 2>, Array<double, 2>>();
+      test_array_apply_functions_output_impl<Array_row_major_multislice<float, 2>, Array_column_major<float, 2>>();
+   }
+
+   template <class Array, class Array2>
+   void test_array_apply_functions_output_impl()
+   {
+      using T = typename Array::value_type;
+
+      Array a(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<T>(std::sin(index++ * 0.37) * 3); });
+
+      // the memory of the output is reused
+      Array2 output(a.shape());
+      const T* memory = &output(0, 0);
+      TESTER_ASSERT(&exp(output, a) == &output);
+      TESTER_ASSERT(&output(0, 0) == memory);
+      TESTER_ASSERT(max(abs(output - exp(a))) < 1e-4);
+
+      sqrt(output, abs(a));
+      TESTER_ASSERT(output == sqrt(abs(a)));
+
+      // in place. The vectorized functions may differ from the scalar functions used for the unaligned elements in the last bit
+      Array b = a;
+      sqr_inplace(cos_inplace(b));
+      TESTER_ASSERT(max(abs(b - sqr(cos(a)))) < 1e-5);
+      log_inplace(sin_inplace(abs_inplace(b)));
+      TESTER_ASSERT(max(abs(b - log(sin(abs(sqr(cos(a))))))) < 1e-5);
+
+      // into a sub-array
+      Array c(vector2ui(40, 8), T(-1));
+      auto c_sub = c(vector2ui(1, 2), vector2ui(37, 6));
+      cos(c_sub, a);
+      for (ui32 y = 0; y < c.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < c.shape()[0]; ++x)
+         {
+            const bool inside = x >= 1 && x <= 37 && y >= 2 && y <= 6;
+            TESTER_ASSERT(std::abs(c(x, y) - (inside ? std::cos(a(x - 1, y - 2)) : T(-1))) < 1e-5);
+         }
+      }
+
+      // conversions
+      typename Array::template rebind<int>::other rounded(a.shape());
+      round(rounded, a);
+      TESTER_ASSERT(rounded == round<int>(a));
+      typename Array::template rebind<ui8>::other saturated_u8(a.shape());
+      saturate(saturated_u8, a, T(-1), T(1));
+      TESTER_ASSERT(saturated_u8 == saturate<ui8>(a, T(-1), T(1)));
+      cast(rounded, a);
+      TESTER_ASSERT(rounded == cast<int>(a));
+
+      Array wrong_shape(vector2ui(3, 3));
+      bool has_thrown = false;
+      try
+      {
+         exp(wrong_shape, a);
+      }
+      catch (const std::exception&)
+      {
+         has_thrown = true;
+      }
+      TESTER_ASSERT(has_thrown);
+   }
 };
 
 TESTER_TEST_SUITE(TestArrayOpApply);
@@ -541,4 +716,7 @@ TESTER_TEST(test_norm2_vec);
 TESTER_TEST(test_norm2sqr);
 TESTER_TEST(test_norm2_elementwise);
 TESTER_TEST(test_matrix_mean_add_conversion);
+TESTER_TEST(test_array_conversions);
+TESTER_TEST(test_array_apply_functions_rvalue);
+TESTER_TEST(test_array_apply_functions_output);
 TESTER_TEST_SUITE_END();
@@ -627,6 +627,295 @@ struct TestArrayOp
       TESTER_ASSERT(equal<float>(result(1, 1), a1(1, 1) * a2(1, 1), 1e-5f));
       TESTER_ASSERT(equal<float>(result(2, 1), a1(2, 1) * a2(2, 1), 1e-5f));
    }
+
+   void test_array_fused()
+   {
+      test_array_fused_impl<Array<float, 2>, Array<float, 2>>();
+      test_array_fused_impl<Array<double, 2>, Array_column_major<double, 2>>();
+      test_array_fused_impl<Array<int, 2>, Array<int, 2>>();
+      test_array_fused_impl<Array_column_major<ui8, 2>, Array<ui8, 2>>();
+   }
+
+   template <class array_type, class array_type2>
+   void test_array_fused_impl()
+   {
+      using T     = typename array_type::value_type;
+      using fused = details::FusedArithmetic<T>;
+
+      // odd sizes and different data orderings
+      array_type a(vector2ui(37, 5));
+      array_type b(vector2ui(37, 5));
+      array_type2 c(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<T>(std::sin(index++ * 0.37) * 100 + 110); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<T>(std::cos(index++ * 0.11) * 30 + 40); });
+      fill_index(c, [&](const vector2ui&) { return static_cast<T>(std::sin(index++ * 0.71) * 30 + 40); });
+      const T alpha = static_cast<T>(3.37);
+      const T beta  = static_cast<T>(1.41);
+
+      const array_type r_add   = mul_add(a, b, c);
+      const array_type r_sub   = mul_sub(a, b, c);
+      const array_type r_fma   = fma(a, alpha, b);
+      array_type2 r_axpby      = c;
+      axpby(alpha, a, beta, r_axpby);
+
+      // in place, e.g., c = a * b + c and a = a * alpha + b
+      array_type2 c_inplace = c;
+      mul_add(c_inplace, a, b, c_inplace);
+      array_type a_inplace = a;
+      fma(a_inplace, a_inplace, alpha, b);
+
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            TESTER_ASSERT(r_add(x, y) == fused::fma(a(x, y), b(x, y), c(x, y)));
+            TESTER_ASSERT(r_sub(x, y) == fused::fms(a(x, y), b(x, y), c(x, y)));
+            TESTER_ASSERT(r_fma(x, y) == fused::fma(a(x, y), alpha, b(x, y)));
+            TESTER_ASSERT(r_axpby(x, y) == fused::axpby(alpha, a(x, y), beta, c(x, y)));
+            TESTER_ASSERT(c_inplace(x, y) == r_add(x, y));
+            TESTER_ASSERT(a_inplace(x, y) == r_fma(x, y));
+         }
+      }
+
+      // strided sub-array
+      array_type r_sub_array = r_add;
+      auto sub               = r_sub_array(vector2ui(1, 1), vector2ui(30, 3));
+      const auto a_sub       = a(vector2ui(1, 1), vector2ui(30, 3));
+      axpby(beta, a_sub, alpha, sub);
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            const bool inside = x >= 1 && x <= 30 && y >= 1 && y <= 3;
+            TESTER_ASSERT(r_sub_array(x, y) == (inside ? fused::axpby(beta, a(x, y), alpha, r_add(x, y)) : r_add(x, y)));
+         }
+      }
+   }
+
+   void test_array_saturated()
+   {
+      test_array_saturated_impl<Array<ui8, 2>, Array<ui8, 2>>();
+      test_array_saturated_impl<Array_column_major<short, 2>, Array<short, 2>>();
+      test_array_saturated_impl<Array<unsigned short, 2>, Array_column_major<unsigned short, 2>>();
+      test_array_saturated_impl<Array<float, 2>, Array<float, 2>>();
+   }
+
+   template <class array_type, class array_type2>
+   void test_array_saturated_impl()
+   {
+      using T         = typename array_type::value_type;
+      using saturated = details::SaturatedArithmetic<T>;
+
+      // odd sizes, the full range of the 8-bit types and different data orderings
+      array_type a(vector2ui(37, 5));
+      array_type2 b(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<T>(std::sin(index++ * 0.37) * 127 + 128); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<T>(std::cos(index++ * 0.11) * 127 + 128); });
+
+      const array_type r_abs_diff = abs_diff(a, b);
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            TESTER_ASSERT(r_abs_diff(x, y) == saturated::abs_diff(a(x, y), b(x, y)));
+         }
+      }
+      test_array_saturated_integer(a, b, std::is_integral<T>());
+   }
+
+   template <class array_type, class array_type2>
+   void test_array_saturated_integer(const array_type&, const array_type2&, std::false_type)
+   {
+   }
+
+   template <class array_type, class array_type2>
+   void test_array_saturated_integer(const array_type& a, const array_type2& b, std::true_type)
+   {
+      using T         = typename array_type::value_type;
+      using saturated = details::SaturatedArithmetic<T>;
+
+      const T scale               = static_cast<T>(0.75 * (1 << (8 * sizeof(T) - std::is_signed<T>::value)));
+      const array_type r_add      = add_saturated(a, b);
+      const array_type r_sub      = sub_saturated(a, b);
+      const array_type r_mul_high = mul_high(a, scale);
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            TESTER_ASSERT(r_add(x, y) == saturated::add(a(x, y), b(x, y)));
+            TESTER_ASSERT(r_sub(x, y) == saturated::sub(a(x, y), b(x, y)));
+            TESTER_ASSERT(r_mul_high(x, y) == saturated::mul_high(a(x, y), scale));
+         }
+      }
+
+      // the widened sum doesn't overflow
+      std::int64_t expected_sum = 0;
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            expected_sum += a(x, y);
+         }
+      }
+      TESTER_ASSERT(static_cast<std::int64_t>(sum(a)) == expected_sum);
+      TESTER_ASSERT(static_cast<std::int64_t>(mean(a)) == expected_sum / static_cast<std::int64_t>(a.size()));
+
+      // e.g., 200 + 100 is 255 and 100 - 200 is 0 for ui8
+      TESTER_ASSERT(saturated::add(std::numeric_limits<T>::max(), 1) == std::numeric_limits<T>::max());
+      TESTER_ASSERT(saturated::sub(std::numeric_limits<T>::min(), 1) == std::numeric_limits<T>::min());
+      TESTER_ASSERT(saturated::mul_high(100, static_cast<T>(0.75 * 256)) == (sizeof(T) == 1 ? 75 : 0));
+
+      // strided sub-array
+      array_type r_sub_array = a;
+      auto sub               = r_sub_array(vector2ui(1, 1), vector2ui(30, 3));
+      array_type2 b_copy     = b;
+      sub                    = add_saturated(sub, b_copy(vector2ui(1, 1), vector2ui(30, 3)));
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            const bool inside = x >= 1 && x <= 30 && y >= 1 && y <= 3;
+            TESTER_ASSERT(r_sub_array(x, y) == (inside ? r_add(x, y) : a(x, y)));
+         }
+      }
+   }
+
+   void test_array_rvalue_operators()
+   {
+      test_array_rvalue_operators_impl<Array<float, 2>>();
+      test_array_rvalue_operators_impl<Array_column_major<int, 2>>();
+      test_array_rvalue_operators_impl<Array_row_major_multislice<float, 2>>();
+   }
+
+   template <class array_type>
+   void test_array_rvalue_operators_impl()
+   {
+      using T = typename array_type::value_type;
+      array_type a(vector2ui(7, 5));
+      array_type b(vector2ui(7, 5));
+      array_type c(vector2ui(7, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<T>(index++ % 11); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<T>(index++ % 7); });
+      fill_index(c, [&](const vector2ui&) { return static_cast<T>(index++ % 5); });
+
+      // a chain of operations is computed in the memory of the first temporary
+      array_type t        = a + b;
+      const T* memory     = &t(0, 0);
+      const array_type r  = T(2) * (((std::move(t) + c - a) * T(3) + T(1) - T(2)) / T(1)) / (b + T(1));
+      TESTER_ASSERT(&r(0, 0) == memory);
+
+      // the temporary is on the right side
+      array_type t2          = b * T(3);
+      const T* memory2       = &t2(0, 0);
+      const array_type r2    = a + std::move(t2);
+      TESTER_ASSERT(&r2(0, 0) == memory2);
+
+      array_type t4        = b * T(3);
+      const T* memory4     = &t4(0, 0);
+      const array_type r4  = a - std::move(t4);
+      TESTER_ASSERT(&r4(0, 0) == memory4);
+
+      // both operands are temporaries: the left one is reused
+      array_type t5        = a * T(2);
+      const T* memory5     = &t5(0, 0);
+      const array_type r5  = std::move(t5) - (b + c);
+      TESTER_ASSERT(&r5(0, 0) == memory5);
+
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            TESTER_ASSERT(r(x, y) == T(2) * (((a(x, y) + b(x, y) + c(x, y) - a(x, y)) * T(3) + T(1) - T(2)) / T(1)) / (b(x, y) + T(1)));
+            TESTER_ASSERT(r2(x, y) == a(x, y) + b(x, y) * T(3));
+            TESTER_ASSERT(r4(x, y) == a(x, y) - b(x, y) * T(3));
+            TESTER_ASSERT(r5(x, y) == a(x, y) * T(2) - (b(x, y) + c(x, y)));
+         }
+      }
+
+      // a temporary sub-array references its memory: it is not modified
+      const array_type a_copy = a;
+      const array_type r3     = a(vector2ui(1, 1), vector2ui(5, 3)) * T(2) + T(1);
+      TESTER_ASSERT(a == a_copy);
+      TESTER_ASSERT(r3.shape() == vector2ui(5, 3));
+      TESTER_ASSERT(r3(0, 0) == a(1, 1) * T(2) + T(1));
+      TESTER_ASSERT(r3(4, 2) == a(5, 3) * T(2) + T(1));
+   }
+
+   void test_array_output_operators()
+   {
+      test_array_output_operators_impl<Array<float, 2>, Array<float, 2>>();
+      test_array_output_operators_impl<Array_column_major<int, 2>, Array<int, 2>>();
+      test_array_output_operators_impl<Array_row_major_multislice<float, 2>, Array_column_major<float, 2>>();
+      test_array_output_operators_impl<Array<ui8, 2>, Array<ui8, 2>>();
+   }
+
+   template <class array_type, class array_type2>
+   void test_array_output_operators_impl()
+   {
+      using T = typename array_type::value_type;
+      array_type a(vector2ui(37, 5));
+      array_type2 b(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<T>(index++ % 11 + 1); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<T>(index++ % 7 + 1); });
+
+      // the memory of the output is reused
+      array_type output(a.shape());
+      const T* memory = &output(0, 0);
+      TESTER_ASSERT(&add(output, a, b) == &output);
+      TESTER_ASSERT(&output(0, 0) == memory);
+      TESTER_ASSERT(output == a + b);
+
+      sub(output, a, b);
+      TESTER_ASSERT(output == a - b);
+      add(output, a, T(3));
+      TESTER_ASSERT(output == a + T(3));
+      sub(output, a, T(1));
+      TESTER_ASSERT(output == a - T(1));
+      sub(output, a, 1u);
+      TESTER_ASSERT(output == a - T(1));
+      mul(output, a, T(2));
+      TESTER_ASSERT(output == a * T(2));
+      div(output, a, T(2));
+      TESTER_ASSERT(output == a / T(2));
+      div(output, a, b);
+      TESTER_ASSERT(output == a / b);
+
+      // in place: the output is an operand
+      array_type c = a;
+      add(c, c, b);
+      sub(c, b, c);
+      mul(c, c, T(3));
+      TESTER_ASSERT(c == (b - (a + b)) * T(3));
+
+      // into a sub-array
+      array_type d(vector2ui(40, 8), T(0));
+      auto d_sub = d(vector2ui(2, 1), vector2ui(38, 5));
+      add(d_sub, a, b);
+      for (ui32 y = 0; y < d.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < d.shape()[0]; ++x)
+         {
+            const bool inside = x >= 2 && x <= 38 && y >= 1 && y <= 5;
+            TESTER_ASSERT(d(x, y) == (inside ? T(a(x - 2, y - 1) + b(x - 2, y - 1)) : T(0)));
+         }
+      }
+
+      array_type wrong_shape(vector2ui(3, 3));
+      bool has_thrown = false;
+      try
+      {
+         add(wrong_shape, a, b);
+      }
+      catch (const std::exception&)
+      {
+         has_thrown = true;
+      }
+      TESTER_ASSERT(has_thrown);
+   }
 };
 
 TESTER_TEST_SUITE(TestArrayOp);
@@ -646,4 +935,8 @@ TESTER_TEST(test_array_div_array);
 TESTER_TEST(test_array_div_array_inplace);
 TESTER_TEST(test_array_mul_array_inplace);
 TESTER_TEST(test_array_mul_array);
+TESTER_TEST(test_array_fused);
+TESTER_TEST(test_array_saturated);
+TESTER_TEST(test_array_rvalue_operators);
+TESTER_TEST(test_array_output_operators);
 TESTER_TEST_SUITE_END();
@@ -0,0 +1,213 @@
+#include <array/forward.h>
+#include <tester/register.h>
+#include <atomic>
+
+using namespace NAMESPACE_NLL;
+
+struct TestArrayParallel
+{
+   template <class array_type>
+   static array_type create(const vector3ui& shape)
+   {
+      array_type a(shape);
+      int index = 0;
+      fill_index(a, [&](const vector3ui&) { return index++; });
+      return a;
+   }
+
+   void test_chunking_restrict()
+   {
+      using Array = Array_row_major<float, 2>;
+
+      Array a(2, 3);
+      ArrayChunking_contiguous_base<Array> chunking(a.shape(), vector2ui(0, 1), 1);
+      TESTER_ASSERT(chunking.getNbAccesses() == 6);
+      chunking.restrictAccesses(3, 5);
+
+      bool done;
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector2ui(1, 1));
+      TESTER_ASSERT(done);
+
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector2ui(0, 2));
+      TESTER_ASSERT(!done);
+   }
+
+   void test_chunking_restrict_max()
+   {
+      using Array = Array_row_major<float, 3>;
+
+      Array a(2, 3, 4);
+      ArrayChunking_contiguous_base<Array> chunking(a.shape(), vector3ui(0, 1, 2), 0);
+      TESTER_ASSERT(chunking.getNbAccesses() == 12);
+      chunking.restrictAccesses(5, 12);
+
+      bool done;
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector3ui(0, 2, 1));
+      TESTER_ASSERT(done);
+
+      done = chunking._accessElements();
+      TESTER_ASSERT(chunking.getArrayIndex() == vector3ui(0, 0, 2));
+      TESTER_ASSERT(done);
+   }
+
+   void test_iterate_array()
+   {
+      test_iterate_array_impl<Array_row_major<int, 3>>();
+      test_iterate_array_impl<Array_column_major<int, 3>>();
+      test_iterate_array_impl<Array_row_major_multislice<int, 3>>();
+   }
+
+   template <class array_type>
+   void test_iterate_array_impl()
+   {
+      using pointer_type = typename array_type::pointer_type;
+      auto a             = create<array_type>(vector3ui(20, 31, 17));
+      auto expected      = a;
+
+      auto op = [](pointer_type ptr, ui32 stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            ptr[n * stride] *= 2;
+         }
+      };
+
+      // strided sub-array
+      auto sub_a        = a(vector3ui(1, 2, 3), vector3ui(18, 29, 15));
+      auto sub_expected = expected(vector3ui(1, 2, 3), vector3ui(18, 29, 15));
+      iterate_array(sub_a, op, Parallel(4, 1));
+      iterate_array(sub_expected, op);
+      TESTER_ASSERT(a == expected);
+
+      // full array
+      iterate_array(a, op, Parallel(3, 1));
+      iterate_array(expected, op);
+      TESTER_ASSERT(a == expected);
+   }
+
+   void test_iterate_constarray()
+   {
+      using array_type         = Array_row_major<int, 3>;
+      using const_pointer_type = array_type::const_pointer_type;
+      const auto a             = create<array_type>(vector3ui(20, 31, 17));
+
+      std::atomic<int> nb_elements_visited(0);
+      std::atomic<long long> sum(0);
+      auto op = [&](const_pointer_type ptr, ui32 stride, ui32 nb_elements) {
+         long long line_sum = 0;
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            line_sum += ptr[n * stride];
+         }
+         sum += line_sum;
+         nb_elements_visited += nb_elements;
+      };
+
+      iterate_constarray(a, op, Parallel(4, 1));
+      const long long size = a.size();
+      TESTER_ASSERT(nb_elements_visited == a.size());
+      TESTER_ASSERT(sum == size * (size - 1) / 2);
+   }
+
+   void test_iterate_array_constarray_different_ordering()
+   {
+      using array_type1 = Array_row_major<int, 3>;
+      using array_type2 = Array_column_major<int, 3>;
+
+      const auto src = create<array_type2>(vector3ui(21, 32, 11));
+      array_type1 dst(src.shape());
+
+      auto op = [](int* y, ui32 y_stride, const int* x, ui32 x_stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            y[n * y_stride] = x[n * x_stride];
+         }
+      };
+      iterate_array_constarray(dst, src, op, Parallel(4, 1));
+
+      for (ui32 z = 0; z < src.shape()[2]; ++z)
+      {
+         for (ui32 y = 0; y < src.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < src.shape()[0]; ++x)
+            {
+               TESTER_ASSERT(dst(x, y, z) == src(x, y, z));
+            }
+         }
+      }
+   }
+
+   void test_iterate_array_constarray_constarray()
+   {
+      using array_type = Array_row_major<int, 3>;
+
+      const auto a1 = create<array_type>(vector3ui(21, 32, 11));
+      const auto a2 = create<array_type>(vector3ui(21, 32, 11));
+      array_type result(a1.shape());
+
+      auto op = [](int* r, ui32 r_stride, const int* x1, ui32 x1_stride, const int* x2, ui32 x2_stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            r[n * r_stride] = x1[n * x1_stride] + x2[n * x2_stride];
+         }
+      };
+      iterate_array_constarray_constarray(result, a1, a2, op, Parallel(4, 1));
+      TESTER_ASSERT(result == a1 * 2);
+   }
+
+   void test_iterate_split_line()
+   {
+      // a single memory line must be split between the threads
+      using array_type = Array_row_major<int, 2>;
+      array_type a(vector2ui(100000, 1), 1);
+
+      std::atomic<int> nb_calls(0);
+      auto op = [&](int* ptr, ui32 stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            ptr[n * stride] *= 3;
+         }
+         ++nb_calls;
+      };
+      iterate_array(a, op, Parallel(4, 1));
+      TESTER_ASSERT(nb_calls == 4);
+      TESTER_ASSERT(a == array_type(vector2ui(100000, 1), 3));
+   }
+
+   void test_split_line_alignment()
+   {
+      // the accesses of a split line are multiples of 64 bytes
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<double*>(4, 1, 1000) == 256);
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<float*>(4, 1, 1000) == 256);
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<ui8*>(4, 1, 1000) == 256);
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<double*>(3, 1, 1000) == 336);
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<ui8*>(3, 1, 1000) == 384);
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<const double*>(3, 1, 100) == 40);
+
+      // never more than the line
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<ui8*>(2, 1, 10) == 10);
+      TESTER_ASSERT(details::getNbElementsPerAccessParallel<float*>(2, 4, 10) == 10);
+   }
+
+   void test_parallel_threshold()
+   {
+      // below the minimum number of elements per thread, the traversal must be serial
+      TESTER_ASSERT(Parallel(4, 1000).nbThreads(999, 100) == 1);
+      TESTER_ASSERT(Parallel(1, 1).nbThreads(1000, 100) == 1);
+      TESTER_ASSERT(Parallel(4, 1).nbThreads(1000, 2) <= 2);
+   }
+};
+
+TESTER_TEST_SUITE(TestArrayParallel);
+TESTER_TEST(test_chunking_restrict);
+TESTER_TEST(test_chunking_restrict_max);
+TESTER_TEST(test_iterate_array);
+TESTER_TEST(test_iterate_constarray);
+TESTER_TEST(test_iterate_array_constarray_different_ordering);
+TESTER_TEST(test_iterate_array_constarray_constarray);
+TESTER_TEST(test_iterate_split_line);
+TESTER_TEST(test_split_line_alignment);
+TESTER_TEST(test_parallel_threshold);
+TESTER_TEST_SUITE_END();
@@ -175,6 +175,41 @@ struct TestArrayPerformance
       std::cout << sum << std::endl;
    }
 
+   void test_iterate_short_lines()
+   {
+      // sub-array with memory lines of 3 elements: the per-line overhead dominates
+      auto a   = create_max(shape);
+      auto sub = a(vector3ui(0, 0, 0), vector3ui(2, shape[1] - 1, shape[2] - 1));
+
+      Timer timer_processor;
+      {
+         ArrayProcessor_contiguous_byMemoryLocality<decltype(sub)> iterator(sub, 0);
+         bool hasMoreElements = true;
+         while (hasMoreElements)
+         {
+            array_type::value_type* ptr = 0;
+            hasMoreElements             = iterator.accessMaxElements(ptr);
+            for (ui32 n = 0; n < iterator.getNbElementsPerAccess(); ++n)
+            {
+               ptr[n] = ptr[n] * ptr[n];
+            }
+         }
+      }
+      std::cout << "Processor=" << timer_processor.getElapsedTime() << std::endl;
+
+      Timer timer_iterate;
+      {
+         auto op = [](array_type::value_type* ptr, ui32 stride, ui32 nb_elements) {
+            for (ui32 n = 0; n < nb_elements; ++n)
+            {
+               ptr[n * stride] = ptr[n * stride] * ptr[n * stride];
+            }
+         };
+         iterate_array(sub, op);
+      }
+      std::cout << "Iterate=" << timer_iterate.getElapsedTime() << std::endl;
+   }
+
    void test_iterator_dummy()
    {
       Timer timer;
@@ -274,6 +309,7 @@ TESTER_TEST(test_iterator_max);
 TESTER_TEST(test_values_iteration);
 TESTER_TEST(test_values_iteration_iter);
 TESTER_TEST(test_iterator_dummy);
+TESTER_TEST(test_iterate_short_lines);
 TESTER_TEST(test_write_speed);
 TESTER_TEST(test_read_speed);
 */
@@ -0,0 +1,164 @@
+#include <array/forward.h>
+#include <tester/register.h>
+
+using namespace NAMESPACE_NLL;
+
+struct TestArrayProcessorMulti
+{
+   template <class array_type>
+   static array_type create(const vector3ui& shape, int offset)
+   {
+      array_type a(shape);
+      int index = offset;
+      fill_index(a, [&](const vector3ui&) { return index++ % 23; });
+      return a;
+   }
+
+   // r = a * b + c * d
+   static void op_fma(int* r, ui32 r_stride, const int* a, ui32 a_stride, const int* b, ui32 b_stride, const int* c, ui32 c_stride, const int* d,
+                      ui32 d_stride, ui32 nb_elements)
+   {
+      for (ui32 n = 0; n < nb_elements; ++n)
+      {
+         r[n * r_stride] = a[n * a_stride] * b[n * b_stride] + c[n * c_stride] * d[n * d_stride];
+      }
+   }
+
+   template <class R, class A, class B, class C, class D>
+   static bool check_fma(const R& r, const A& a, const B& b, const C& c, const D& d)
+   {
+      for (ui32 z = 0; z < r.shape()[2]; ++z)
+      {
+         for (ui32 y = 0; y < r.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < r.shape()[0]; ++x)
+            {
+               if (r(x, y, z) != a(x, y, z) * b(x, y, z) + c(x, y, z) * d(x, y, z))
+               {
+                  return false;
+               }
+            }
+         }
+      }
+      return true;
+   }
+
+   void test_same_ordering()
+   {
+      test_same_ordering_impl<Array_row_major<int, 3>>();
+      test_same_ordering_impl<Array_column_major<int, 3>>();
+      test_same_ordering_impl<Array_row_major_multislice<int, 3>>();
+   }
+
+   template <class array_type>
+   void test_same_ordering_impl()
+   {
+      const vector3ui shape(21, 32, 11);
+      const auto a = create<array_type>(shape, 0);
+      const auto b = create<array_type>(shape, 1);
+      const auto c = create<array_type>(shape, 2);
+      const auto d = create<array_type>(shape, 3);
+
+      array_type r(shape);
+      iterate_array_constarrays(op_fma, r, a, b, c, d);
+      TESTER_ASSERT(check_fma(r, a, b, c, d));
+
+      array_type r_parallel(shape);
+      iterate_array_constarrays(Parallel(4, 1), op_fma, r_parallel, a, b, c, d);
+      TESTER_ASSERT(r_parallel == r);
+   }
+
+   void test_different_ordering()
+   {
+      using array_type1 = Array_row_major<int, 3>;
+      using array_type2 = Array_column_major<int, 3>;
+      using array_type3 = Array_row_major_multislice<int, 3>;
+
+      const vector3ui shape(37, 33, 5);
+      const auto a = create<array_type2>(shape, 0);
+      const auto b = create<array_type3>(shape, 1);
+      const auto c = create<array_type1>(shape, 2);
+      const auto d = create<array_type2>(shape, 3);
+
+      array_type1 r(shape);
+      iterate_array_constarrays(op_fma, r, a, b, c, d);
+      TESTER_ASSERT(check_fma(r, a, b, c, d));
+
+      array_type3 r_slices(shape);
+      iterate_array_constarrays(op_fma, r_slices, a, b, c, d);
+      TESTER_ASSERT(check_fma(r_slices, a, b, c, d));
+
+      array_type2 r_parallel(shape);
+      iterate_array_constarrays(Parallel(4, 1), op_fma, r_parallel, a, b, c, d);
+      TESTER_ASSERT(check_fma(r_parallel, a, b, c, d));
+   }
+
+   void test_sub_arrays()
+   {
+      using array_type1 = Array_row_major<int, 3>;
+      using array_type2 = Array_column_major<int, 3>;
+
+      const vector3ui shape(40, 35, 6);
+      auto a = create<array_type1>(shape, 0);
+      auto b = create<array_type2>(shape, 1);
+      auto r = create<array_type2>(shape, 2);
+      const auto r_before = r;
+
+      const vector3ui min_index(1, 2, 1);
+      const vector3ui max_index(36, 33, 4);
+      auto sub_a = a(min_index, max_index);
+      auto sub_b = b(min_index, max_index);
+      auto sub_r = r(min_index, max_index);
+
+      auto op = [](int* r, ui32 r_stride, const int* a, ui32 a_stride, const int* b, ui32 b_stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            r[n * r_stride] = a[n * a_stride] - b[n * b_stride];
+         }
+      };
+      iterate_array_constarrays(op, sub_r, sub_a, sub_b);
+
+      for (ui32 z = 0; z < shape[2]; ++z)
+      {
+         for (ui32 y = 0; y < shape[1]; ++y)
+         {
+            for (ui32 x = 0; x < shape[0]; ++x)
+            {
+               const vector3ui index(x, y, z);
+               const bool inside = x >= min_index[0] && y >= min_index[1] && z >= min_index[2] && x <= max_index[0] && y <= max_index[1] &&
+                                   z <= max_index[2];
+               if (inside)
+               {
+                  TESTER_ASSERT(r(index) == a(index) - b(index));
+               }
+               else
+               {
+                  TESTER_ASSERT(r(index) == r_before(index));
+               }
+            }
+         }
+      }
+   }
+
+   void test_single_array()
+   {
+      using array_type = Array_row_major<int, 2>;
+      array_type a(vector2ui(5, 3), 2);
+
+      auto op = [](int* ptr, ui32 stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            ptr[n * stride] *= 3;
+         }
+      };
+      iterate_array_constarrays(op, a);
+      TESTER_ASSERT(a == array_type(vector2ui(5, 3), 6));
+   }
+};
+
+TESTER_TEST_SUITE(TestArrayProcessorMulti);
+TESTER_TEST(test_same_ordering);
+TESTER_TEST(test_different_ordering);
+TESTER_TEST(test_sub_arrays);
+TESTER_TEST(test_single_array);
+TESTER_TEST_SUITE_END();
@@ -0,0 +1,179 @@
+#include <array/forward.h>
+#include <tester/register.h>
+
+using namespace NAMESPACE_NLL;
+
+struct TestArrayReduction
+{
+   using Isa = details::simd::Isa;
+
+   template <class array_type, class F>
+   static array_type create(const vector3ui& shape, F f)
+   {
+      array_type a(shape);
+      int index = 0;
+      fill_index(a, [&](const vector3ui&) { return f(index++); });
+      return a;
+   }
+
+   /**
+    Restore the global parallel settings at the end of a test
+    */
+   struct ParallelSettings
+   {
+      ParallelSettings() : nb_threads(get_parallel_nb_threads()), min_elements(get_parallel_min_elements()), reproducible(get_parallel_reproducible())
+      {
+      }
+
+      ~ParallelSettings()
+      {
+         set_parallel_nb_threads(nb_threads);
+         set_parallel_min_elements(min_elements);
+         set_parallel_reproducible(reproducible);
+      }
+
+      ui32 nb_threads;
+      size_t min_elements;
+      bool reproducible;
+   };
+
+   void test_reductions()
+   {
+      ParallelSettings settings;
+      set_parallel_min_elements(1);
+      for (ui32 nb_threads = 1; nb_threads <= 4; nb_threads += 3)
+      {
+         set_parallel_nb_threads(nb_threads);
+         test_reductions_impl<Array_row_major<float, 3>>();
+         test_reductions_impl<Array_column_major<double, 3>>();
+         test_reductions_impl<Array_row_major_multislice<float, 3>>();
+         test_reductions_impl<Array_row_major<int, 3>>();
+         test_reductions_impl<Array_column_major<ui8, 3>>();
+      }
+   }
+
+   template <class array_type>
+   void test_reductions_impl()
+   {
+      using T   = typename array_type::value_type;
+      auto a    = create<array_type>(vector3ui(70, 151, 9), [](int n) { return static_cast<T>((n * 7919) % 101); });
+      auto sub  = a(vector3ui(1, 2, 3), vector3ui(65, 149, 7));
+      check_reductions(a);
+      check_reductions(sub);
+   }
+
+   template <class array_type>
+   void check_reductions(const array_type& a)
+   {
+      using T = typename array_type::value_type;
+
+      double expected_sum  = 0;
+      double expected_norm = 0;
+      T expected_min       = std::numeric_limits<T>::max();
+      T expected_max       = std::numeric_limits<T>::lowest();
+      for (ui32 z = 0; z < a.shape()[2]; ++z)
+      {
+         for (ui32 y = 0; y < a.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < a.shape()[0]; ++x)
+            {
+               const T value = a(x, y, z);
+               expected_sum += value;
+               expected_norm += static_cast<double>(value) * value;
+               expected_min = std::min(expected_min, value);
+               expected_max = std::max(expected_max, value);
+            }
+         }
+      }
+
+      const double tolerance = std::is_same<T, float>::value ? 1e-6 : 1e-12;
+      TESTER_ASSERT(std::abs(sum(a) - expected_sum) <= tolerance * expected_sum || !std::is_floating_point<T>::value);
+      TESTER_ASSERT(std::abs(norm2sqr(a) - expected_norm) <= tolerance * expected_norm || !std::is_floating_point<T>::value);
+      TESTER_ASSERT(std::abs(sum<T, 3, typename array_type::Config, double>(a, Summation::kahan) - expected_sum) <= 1e-12 * expected_sum);
+      TESTER_ASSERT(std::abs(mean<T, 3, typename array_type::Config, double>(a) - expected_sum / a.size()) <= 1e-12 * expected_sum);
+      TESTER_ASSERT(min(a) == expected_min);
+      TESTER_ASSERT(max(a) == expected_max);
+      TESTER_ASSERT(minmax(a) == std::make_pair(expected_min, expected_max));
+   }
+
+   void test_reproducible()
+   {
+      // the floating point sums must be bit-identical whatever the number of threads and the instruction set
+      ParallelSettings settings;
+      set_parallel_min_elements(1);
+
+      using array_type = Array<float, 3>;
+      auto a           = create<array_type>(vector3ui(1000, 97, 11), [](int n) { return static_cast<float>(std::sin(n * 0.1) * 1000); });
+      const auto sub   = a(vector3ui(3, 0, 1), vector3ui(996, 96, 9));
+
+      auto& dispatcher         = details::simd::SimdDispatcher::instance();
+      const Isa isa            = dispatcher.getIsa();
+      const float expected     = sum(a);
+      const float expected_k   = sum(a, Summation::kahan);
+      const float expected_n   = norm2sqr(a);
+      const float expected_sub = sum(sub);
+      for (int n = 0; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(n));
+         for (ui32 nb_threads = 1; nb_threads <= 5; ++nb_threads)
+         {
+            set_parallel_nb_threads(nb_threads);
+            TESTER_ASSERT(sum(a) == expected);
+            TESTER_ASSERT(sum(a, Summation::kahan) == expected_k);
+            TESTER_ASSERT(norm2sqr(a) == expected_n);
+            TESTER_ASSERT(sum(sub) == expected_sub);
+         }
+      }
+      dispatcher.setIsa(isa);
+
+      // without reproducibility, only the rounding errors differ
+      set_parallel_reproducible(false);
+      set_parallel_nb_threads(3);
+      TESTER_ASSERT(std::abs(sum(a) - expected) <= 1e-4 * norm2(a));
+      TESTER_ASSERT(std::abs(sum(a, Summation::kahan) - expected_k) <= 1e-6 * std::abs(expected_k));
+   }
+
+   void test_accuracy()
+   {
+      // 10^7 float: a sequential float sum is off by several percents
+      using array_type = Array<float, 2>;
+      const ui32 size  = 10000000;
+      const array_type a(vector2ui(size, 1), 0.1f);
+
+      const double expected = 0.1f * static_cast<double>(size);
+      ParallelSettings settings;
+      for (int reproducible = 0; reproducible < 2; ++reproducible)
+      {
+         set_parallel_reproducible(reproducible != 0);
+         TESTER_ASSERT(std::abs(sum(a) - expected) <= 1e-5 * expected);
+         TESTER_ASSERT(std::abs(sum(a, Summation::kahan) - expected) <= 1e-7 * expected);
+         TESTER_ASSERT(std::abs(mean(a, Summation::kahan) - 0.1f) <= 1e-7);
+      }
+   }
+
+   void test_nan()
+   {
+      // the min & max ignore the NaN, as the scalar comparisons do
+      using array_type = Array<double, 2>;
+      array_type a(100, 1);
+      for (ui32 n = 0; n < a.size(); ++n)
+      {
+         a(n, 0u) = n % 3 ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(n) - 50;
+      }
+      TESTER_ASSERT(min(a) == -50);
+      TESTER_ASSERT(max(a) == 49);
+      TESTER_ASSERT(minmax(a) == std::make_pair(-50.0, 49.0));
+      TESTER_ASSERT(details::is_nan(sum(a)));
+
+      const array_type empty;
+      TESTER_ASSERT(sum(empty) == 0);
+      TESTER_ASSERT(max(empty) == std::numeric_limits<double>::lowest());
+   }
+};
+
+TESTER_TEST_SUITE(TestArrayReduction);
+TESTER_TEST(test_reductions);
+TESTER_TEST(test_reproducible);
+TESTER_TEST(test_accuracy);
+TESTER_TEST(test_nan);
+TESTER_TEST_SUITE_END();
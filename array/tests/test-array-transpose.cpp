@@ -141,6 +141,36 @@ struct TestArrayTranspose
       TESTER_ASSERT(at(1, 1, 1) == 11);
       TESTER_ASSERT(at(1, 2, 1) == 12);
    }
+
+   void test_transpose_generic_3_permutation()
+   {
+      test_transpose_generic_3_permutation_impl<Array_row_major<int, 3>>();
+      test_transpose_generic_3_permutation_impl<Array_column_major<int, 3>>();
+      test_transpose_generic_3_permutation_impl<Array_row_major_multislice<int, 3>>();
+   }
+
+   template <class array_type>
+   void test_transpose_generic_3_permutation_impl()
+   {
+      array_type a(4, 3, 2);
+      int index = 0;
+      fill_index(a, [&](const vector3ui&) { return index++; });
+
+      // the permutation is not its own inverse
+      const vector3ui new_axis(2, 0, 1);
+      auto at = transpose(a, new_axis);
+      TESTER_ASSERT(at.shape() == vector3ui(2, 4, 3));
+      for (ui32 z = 0; z < a.shape()[2]; ++z)
+      {
+         for (ui32 y = 0; y < a.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < a.shape()[0]; ++x)
+            {
+               TESTER_ASSERT(at(z, x, y) == a(x, y, z));
+            }
+         }
+      }
+   }
 };
 
 TESTER_TEST_SUITE(TestArrayTranspose);
@@ -150,4 +180,5 @@ TESTER_TEST(test_transpose_generic_2_rowmajor_strided);
 TESTER_TEST(test_transpose_generic_3_rowmajor);
 TESTER_TEST(test_transpose_generic_3_rowmajor_2);
 TESTER_TEST(test_transpose_generic_3_rowmajor_2_strided);
+TESTER_TEST(test_transpose_generic_3_permutation);
 TESTER_TEST_SUITE_END();
@@ -1,6 +1,7 @@
 #include <array/forward.h>
 #include <tester/register.h>
 #include "test-utils.h"
+#include <atomic>
 
 using namespace nll;
 
@@ -401,6 +402,241 @@ struct TestArray
       TESTER_ASSERT(iterator.getVaryingIndexOrder() == NAMESPACE_NLL::vector3ui(2, 1, 0));
    }
 
+   void testIteratorCoalesce()
+   {
+      using array_type = NAMESPACE_NLL::Array_row_major<int, 3>;
+      using processor  = NAMESPACE_NLL::ArrayProcessor_contiguous_byMemoryLocality<array_type>;
+      array_type a1(4, 5, 6);
+
+      TESTER_ASSERT(processor(a1, 0).getNbContiguousDimensions() == 3);
+
+      // sub-array contiguous on all dimensions
+      auto sub_xyz = a1(NAMESPACE_NLL::vector3ui(0, 0, 1), NAMESPACE_NLL::vector3ui(3, 4, 4));
+      TESTER_ASSERT(NAMESPACE_NLL::ArrayProcessor_contiguous_byMemoryLocality<decltype(sub_xyz)>(sub_xyz, 0).getNbContiguousDimensions() == 3);
+
+      // sub-array contiguous on (x, y) only
+      auto sub_xy = a1(NAMESPACE_NLL::vector3ui(0, 1, 1), NAMESPACE_NLL::vector3ui(3, 3, 4));
+      TESTER_ASSERT(NAMESPACE_NLL::ArrayProcessor_contiguous_byMemoryLocality<decltype(sub_xy)>(sub_xy, 0).getNbContiguousDimensions() == 2);
+
+      // sub-array contiguous on x only
+      auto sub_x = a1(NAMESPACE_NLL::vector3ui(1, 0, 0), NAMESPACE_NLL::vector3ui(2, 4, 5));
+      TESTER_ASSERT(NAMESPACE_NLL::ArrayProcessor_contiguous_byMemoryLocality<decltype(sub_x)>(sub_x, 0).getNbContiguousDimensions() == 1);
+
+      // the dimension of size 1 must be skipped
+      auto sub_yz = a1(NAMESPACE_NLL::vector3ui(2, 0, 0), NAMESPACE_NLL::vector3ui(2, 4, 5));
+      NAMESPACE_NLL::ArrayProcessor_contiguous_byMemoryLocality<decltype(sub_yz)> processor_yz(sub_yz, 0);
+      TESTER_ASSERT(processor_yz.getVaryingIndexOrder() == NAMESPACE_NLL::vector3ui(1, 2, 0));
+      TESTER_ASSERT(processor_yz.getNbContiguousDimensions() == 3);
+      TESTER_ASSERT(processor_yz.stride() == 4);
+
+      // slices can't be merged
+      using array_type_slice = NAMESPACE_NLL::Array_row_major_multislice<int, 3>;
+      array_type_slice a2(4, 5, 6);
+      TESTER_ASSERT(NAMESPACE_NLL::ArrayProcessor_contiguous_byMemoryLocality<array_type_slice>(a2, 0).getNbContiguousDimensions() == 2);
+   }
+
+   void testIteratorCoalesce_iterate()
+   {
+      using array_type = NAMESPACE_NLL::Array_row_major<int, 3>;
+      array_type a1(4, 5, 6);
+      int index = 0;
+      NAMESPACE_NLL::fill_index(a1, [&](const NAMESPACE_NLL::vector3ui&) { return index++; });
+
+      ui32 nb_calls = 0;
+      auto op       = [&](int* ptr, ui32 stride, ui32 nb_elements) {
+         TESTER_ASSERT(stride == 1);
+         TESTER_ASSERT(nb_elements == a1.size());
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            TESTER_ASSERT(ptr[n] == static_cast<int>(n));
+         }
+         ++nb_calls;
+      };
+      NAMESPACE_NLL::iterate_array(a1, op);
+      TESTER_ASSERT(nb_calls == 1);
+
+      // a sub-array contiguous on (x, y) with (x, y) contiguous in the other array too
+      array_type a2(4, 5, 6);
+      auto sub_a1 = a1(NAMESPACE_NLL::vector3ui(0, 0, 1), NAMESPACE_NLL::vector3ui(3, 4, 3));
+      auto sub_a2 = a2(NAMESPACE_NLL::vector3ui(0, 0, 2), NAMESPACE_NLL::vector3ui(3, 4, 4));
+
+      nb_calls     = 0;
+      auto op_copy = [&](int* y, ui32 y_stride, const int* x, ui32 x_stride, ui32 nb_elements) {
+         TESTER_ASSERT(nb_elements == sub_a1.size());
+         NAMESPACE_NLL::details::copy_naive(y, y_stride, x, x_stride, nb_elements);
+         ++nb_calls;
+      };
+      NAMESPACE_NLL::iterate_array_constarray(sub_a2, sub_a1, op_copy);
+      TESTER_ASSERT(nb_calls == 1);
+      TESTER_ASSERT(sub_a2 == sub_a1);
+   }
+
+   void testIteratorChunks()
+   {
+      testIteratorChunks_impl<NAMESPACE_NLL::Array_row_major<int, 3>>();
+      testIteratorChunks_impl<NAMESPACE_NLL::Array_row_major_multislice<int, 3>>();
+   }
+
+   template <class array_type>
+   void testIteratorChunks_impl()
+   {
+      array_type a1(7, 3, 2);
+      int index = 0;
+      NAMESPACE_NLL::fill_index(a1, [&](const NAMESPACE_NLL::vector3ui&) { return index++; });
+
+      NAMESPACE_NLL::ArrayProcessor_contiguous_byMemoryLocality<array_type> processor(a1, 3);
+      TESTER_ASSERT(processor.getNbAccesses() == 3 * 3 * 2);
+
+      int expected_value   = 0;
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         int* ptr        = nullptr;
+         hasMoreElements = processor.accessMaxElements(ptr);
+         const auto i    = processor.getArrayIndex();
+         TESTER_ASSERT(processor.getNbElementsPerAccess() == (i[0] == 6 ? 1 : 3));
+         for (ui32 n = 0; n < processor.getNbElementsPerAccess(); ++n)
+         {
+            TESTER_ASSERT(ptr[n * processor.stride()] == expected_value++);
+         }
+      }
+      TESTER_ASSERT(expected_value == index);
+   }
+
+   void testIterate_nested()
+   {
+      testIterate_nested_impl<NAMESPACE_NLL::Array_row_major<int, 4>>(NAMESPACE_NLL::vector4ui(5, 4, 3, 6));
+      testIterate_nested_impl<NAMESPACE_NLL::Array_column_major<int, 4>>(NAMESPACE_NLL::vector4ui(5, 4, 3, 6));
+      testIterate_nested_impl<NAMESPACE_NLL::Array_row_major<int, 5>>(NAMESPACE_NLL::StaticVector<ui32, 5>(5, 4, 3, 2, 3));
+   }
+
+   template <class array_type>
+   void testIterate_nested_impl(const typename array_type::index_type& shape)
+   {
+      using index_type = typename array_type::index_type;
+      array_type a1(shape);
+      int index = 0;
+      NAMESPACE_NLL::fill_index(a1, [&](const index_type&) { return index++; });
+
+      // sub-array which can't be coalesced
+      index_type min_index;
+      index_type max_index = shape - 1;
+      min_index[0]         = 1;
+      max_index[0]         = shape[0] - 2;
+      auto sub             = a1(min_index, max_index);
+
+      // each element must be visited once, in memory order
+      int last_value = -1;
+      ui32 nb_values = 0;
+      auto op        = [&](const int* ptr, ui32 stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            TESTER_ASSERT(ptr[n * stride] > last_value);
+            last_value = ptr[n * stride];
+            ++nb_values;
+         }
+      };
+      NAMESPACE_NLL::iterate_constarray(sub, op);
+      TESTER_ASSERT(nb_values == sub.size());
+   }
+
+   void testIterate_index()
+   {
+      testIterate_index_impl<NAMESPACE_NLL::Array_row_major<int, 3>>();
+      testIterate_index_impl<NAMESPACE_NLL::Array_column_major<int, 3>>();
+      testIterate_index_impl<NAMESPACE_NLL::Array_row_major_multislice<int, 3>>();
+   }
+
+   template <class array_type>
+   void testIterate_index_impl()
+   {
+      using index_type = typename array_type::index_type;
+      const index_type shape(7, 6, 5);
+      array_type a(shape);
+      for (ui32 z = 0; z < shape[2]; ++z)
+      {
+         for (ui32 y = 0; y < shape[1]; ++y)
+         {
+            for (ui32 x = 0; x < shape[0]; ++x)
+            {
+               a(x, y, z) = x + y * 10 + z * 100;
+            }
+         }
+      }
+
+      // the index of each element must be derived from the index of the first element of the line
+      auto sub       = a(index_type(1, 1, 1), index_type(5, 4, 3));
+      ui32 nb_values = 0;
+      auto op        = [&](const int* ptr, ui32 stride, ui32 nb_elements, const index_type& line_index, ui32 varying_index) {
+         index_type index = line_index;
+         for (ui32 n = 0; n < nb_elements; ++n, ++index[varying_index])
+         {
+            TESTER_ASSERT(ptr[n * stride] == static_cast<int>((index[0] + 1) + (index[1] + 1) * 10 + (index[2] + 1) * 100));
+            ++nb_values;
+         }
+      };
+      NAMESPACE_NLL::iterate_constarray_index(sub, op);
+      TESTER_ASSERT(nb_values == sub.size());
+
+      // lines split between threads
+      std::atomic<ui32> nb_values_parallel(0);
+      auto op_parallel = [&](int* ptr, ui32 stride, ui32 nb_elements, const index_type& line_index, ui32 varying_index) {
+         index_type index = line_index;
+         for (ui32 n = 0; n < nb_elements; ++n, ++index[varying_index])
+         {
+            ptr[n * stride] = index[0] + index[1] * 10 + index[2] * 100;
+         }
+         nb_values_parallel += nb_elements;
+      };
+      array_type b(shape);
+      NAMESPACE_NLL::iterate_array_index(b, op_parallel, NAMESPACE_NLL::Parallel(4, 1));
+      TESTER_ASSERT(nb_values_parallel == b.size());
+      TESTER_ASSERT(a == b);
+   }
+
+   void testIterate_differentOrdering()
+   {
+      testIterate_differentOrdering_impl<NAMESPACE_NLL::Array_row_major<int, 3>, NAMESPACE_NLL::Array_column_major<int, 3>>();
+      testIterate_differentOrdering_impl<NAMESPACE_NLL::Array_column_major<int, 3>, NAMESPACE_NLL::Array_row_major<int, 3>>();
+      testIterate_differentOrdering_impl<NAMESPACE_NLL::Array_row_major_multislice<int, 3>, NAMESPACE_NLL::Array_column_major<int, 3>>();
+      testIterate_differentOrdering_impl<NAMESPACE_NLL::Array_column_major<int, 3>, NAMESPACE_NLL::Array_row_major_multislice<int, 3>>();
+   }
+
+   template <class array_type1, class array_type2>
+   void testIterate_differentOrdering_impl()
+   {
+      // the shapes are not a multiple of the tile size
+      const NAMESPACE_NLL::vector3ui shape(37, 5, 70);
+      array_type2 a2(shape);
+      int index = 0;
+      NAMESPACE_NLL::fill_index(a2, [&](const NAMESPACE_NLL::vector3ui&) { return index++; });
+
+      array_type1 a1(shape);
+      auto op = [&](int* y, ui32 y_stride, const int* x, ui32 x_stride, ui32 nb_elements) {
+         NAMESPACE_NLL::details::copy_naive(y, y_stride, x, x_stride, nb_elements);
+      };
+      NAMESPACE_NLL::iterate_array_constarray(a1, a2, op);
+      TESTER_ASSERT(a1 == a2);
+
+      // sub-arrays
+      const NAMESPACE_NLL::vector3ui min_index(1, 2, 3);
+      const NAMESPACE_NLL::vector3ui max_index(35, 3, 68);
+      auto sub_a1 = a1(min_index, max_index);
+      auto sub_a2 = a2(min_index, max_index);
+      sub_a1 += sub_a2;
+      for (ui32 z = 0; z < shape[2]; ++z)
+      {
+         for (ui32 y = 0; y < shape[1]; ++y)
+         {
+            for (ui32 x = 0; x < shape[0]; ++x)
+            {
+               const bool inside = x >= min_index[0] && x <= max_index[0] && y >= min_index[1] && y <= max_index[1] && z >= min_index[2] && z <= max_index[2];
+               TESTER_ASSERT(a1(x, y, z) == (inside ? 2 : 1) * a2(x, y, z));
+            }
+         }
+      }
+   }
+
    void testFill()
    {
       // not a real test, just for very simplistic performace test against manual op
@@ -884,6 +1120,12 @@ TESTER_TEST(testArray_processor_const);
 TESTER_TEST(testArray_processor_stride);
 TESTER_TEST(testIteratorByDim);
 TESTER_TEST(testIteratorByLocality);
+TESTER_TEST(testIteratorCoalesce);
+TESTER_TEST(testIteratorCoalesce_iterate);
+TESTER_TEST(testIterate_differentOrdering);
+TESTER_TEST(testIterate_nested);
+TESTER_TEST(testIterate_index);
+TESTER_TEST(testIteratorChunks);
 TESTER_TEST(testFill);
 TESTER_TEST(testArray_subArray);
 TESTER_TEST(testInitializerList);
@@ -0,0 +1,204 @@
+#include <array/forward.h>
+#include <tester/register.h>
+
+using namespace NAMESPACE_NLL;
+
+struct TestFloat16
+{
+   void test_conversions()
+   {
+      // rounded to nearest, ties to even
+      TESTER_ASSERT(float16(1.0f).bits() == 0x3c00);
+      TESTER_ASSERT(float16(-2.0f).bits() == 0xc000);
+      TESTER_ASSERT(float16(-0.0f).bits() == 0x8000);
+      TESTER_ASSERT(float16(1.00048828125f).bits() == 0x3c00);
+      TESTER_ASSERT(float16(1.00146484375f).bits() == 0x3c02);
+      TESTER_ASSERT(float16(65504.0f).bits() == 0x7bff);
+      TESTER_ASSERT(float16(65519.0f).bits() == 0x7bff);
+      TESTER_ASSERT(float16(65520.0f).bits() == 0x7c00);
+      TESTER_ASSERT(float16(std::numeric_limits<float>::infinity()).bits() == 0x7c00);
+      TESTER_ASSERT(details::is_nan(float16(std::numeric_limits<float>::quiet_NaN())));
+      TESTER_ASSERT(details::is_nan(static_cast<float>(float16(std::numeric_limits<float>::quiet_NaN()))));
+      TESTER_ASSERT(details::is_inf(float16(-std::numeric_limits<float>::infinity())));
+
+      // denormals
+      TESTER_ASSERT(float16(5.9604644775390625e-8f).bits() == 0x0001);
+      TESTER_ASSERT(float16(2.98023223876953125e-8f).bits() == 0x0000);
+      TESTER_ASSERT(float16(3.0e-8f).bits() == 0x0001);
+      TESTER_ASSERT(static_cast<float>(float16::fromBits(0x03ff)) == 6.09755516052246094e-5f);
+
+      TESTER_ASSERT(bfloat16(1.0f).bits() == 0x3f80);
+      TESTER_ASSERT(bfloat16(1.00390625f).bits() == 0x3f80);
+      TESTER_ASSERT(bfloat16(1.01171875f).bits() == 0x3f82);
+      TESTER_ASSERT(bfloat16(std::numeric_limits<float>::max()).bits() == 0x7f80);
+      TESTER_ASSERT(details::is_nan(bfloat16(std::numeric_limits<float>::quiet_NaN())));
+      TESTER_ASSERT(details::is_nan(static_cast<float>(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+      // all the values are exactly represented in float
+      bool all_equal = true;
+      for (ui32 bits = 0; bits < (1u << 16); ++bits)
+      {
+         const float16 h  = float16::fromBits(static_cast<std::uint16_t>(bits));
+         const bfloat16 b = bfloat16::fromBits(static_cast<std::uint16_t>(bits));
+         all_equal &= details::is_nan(h) || float16(static_cast<float>(h)).bits() == bits;
+         all_equal &= details::is_nan(b) || bfloat16(static_cast<float>(b)).bits() == bits;
+         all_equal &= details::is_nan(h) == details::is_nan(static_cast<float>(h));
+         all_equal &= details::is_inf(b) == details::is_inf(static_cast<float>(b));
+      }
+      TESTER_ASSERT(all_equal);
+   }
+
+   void test_limits()
+   {
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<float16>::max()) == 65504.0f);
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<float16>::lowest()) == -65504.0f);
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<float16>::min()) == 6.103515625e-5f);
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<float16>::epsilon()) == 0.0009765625f);
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<float16>::denorm_min()) == 5.9604644775390625e-8f);
+      TESTER_ASSERT(details::is_inf(std::numeric_limits<float16>::infinity()));
+      TESTER_ASSERT(details::is_inf(static_cast<float>(std::numeric_limits<float16>::infinity())));
+
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<bfloat16>::max()) == 3.38953139e38f);
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<bfloat16>::min()) == std::numeric_limits<float>::min());
+      TESTER_ASSERT(static_cast<float>(std::numeric_limits<bfloat16>::epsilon()) == 0.0078125f);
+      TESTER_ASSERT(details::is_nan(std::numeric_limits<bfloat16>::quiet_NaN()));
+      TESTER_ASSERT(details::is_nan(static_cast<float>(std::numeric_limits<bfloat16>::quiet_NaN())));
+   }
+
+   void test_arithmetic()
+   {
+      float16 a = 1.5f;
+      float16 b = 2;
+      float16 c = a * b + 1;
+      TESTER_ASSERT(c == 4.0f);
+      TESTER_ASSERT(-c == -4.0f);
+      TESTER_ASSERT(a < b);
+
+      a += b;
+      TESTER_ASSERT(a == 3.5f);
+      a /= 2;
+      TESTER_ASSERT(a == 1.75f);
+
+      // each result is rounded to the 16-bit type
+      float16 d = 1024;
+      d += 0.25f;
+      TESTER_ASSERT(d == 1024.0f);
+
+      bfloat16 e = 256;
+      e += 1;
+      TESTER_ASSERT(e == 256.0f);
+      e *= 0.5f;
+      TESTER_ASSERT(e == 128.0f);
+   }
+
+   void test_array_operators()
+   {
+      test_array_operators_impl<Array<float16, 2>>();
+      test_array_operators_impl<Array<bfloat16, 2>>();
+      test_array_operators_impl<Array_column_major<float16, 2>>();
+   }
+
+   template <class array_type>
+   void test_array_operators_impl()
+   {
+      using T = typename array_type::value_type;
+
+      // odd sizes: the lines have vectorized parts and tails
+      Array<float, 2> a_float(vector2ui(37, 5));
+      Array<float, 2> b_float(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a_float, [&](const vector2ui&) { return static_cast<float>(std::sin(index++ * 0.37) * 100); });
+      fill_index(b_float, [&](const vector2ui&) { return static_cast<float>(std::cos(index++ * 0.11) * 3 + 3.5); });
+
+      const array_type a = a_float;
+      const array_type b = b_float;
+      const array_type r = a * T(3) + b - a;
+      const array_type q = a / b;
+
+      bool all_equal = true;
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            all_equal &= a(x, y).bits() == T(a_float(x, y)).bits();
+
+            // each operator rounds its result
+            T expected = a(x, y);
+            expected *= T(3);
+            expected += b(x, y);
+            expected -= a(x, y);
+            all_equal &= r(x, y).bits() == expected.bits();
+            all_equal &= q(x, y).bits() == T(a(x, y) / b(x, y)).bits();
+         }
+      }
+      TESTER_ASSERT(all_equal);
+
+      const Array<float, 2> r_float = r;
+      TESTER_ASSERT(r_float(3, 2) == static_cast<float>(r(3, 2)));
+   }
+
+   void test_matrix_mul()
+   {
+      test_matrix_mul_impl<Matrix_row_major<float16>>();
+      test_matrix_mul_impl<Matrix_column_major<float16>>();
+      test_matrix_mul_impl<Matrix_row_major<bfloat16>>();
+   }
+
+   template <class matrix_type>
+   void test_matrix_mul_impl()
+   {
+      using T = typename matrix_type::value_type;
+
+      // more than one block of the inner & column dimensions
+      const size_t nb_rows    = 37;
+      const size_t nb_inner   = 300;
+      const size_t nb_columns = 270;
+      matrix_type a(vector2ui(nb_rows, nb_inner));
+      matrix_type b(vector2ui(nb_inner, nb_columns));
+      for (size_t i = 0; i < nb_rows; ++i)
+      {
+         for (size_t p = 0; p < nb_inner; ++p)
+         {
+            a(i, p) = static_cast<float>(std::sin(i * 0.7 + p * 0.13));
+         }
+      }
+      for (size_t p = 0; p < nb_inner; ++p)
+      {
+         for (size_t j = 0; j < nb_columns; ++j)
+         {
+            b(p, j) = static_cast<float>(std::cos(p * 0.3 - j * 0.07));
+         }
+      }
+
+      const matrix_type c = a * b;
+      TESTER_ASSERT(c.rows() == nb_rows);
+      TESTER_ASSERT(c.columns() == nb_columns);
+
+      // accumulated in float: only the rounding of the result to T
+      const double epsilon = static_cast<float>(std::numeric_limits<T>::epsilon());
+      bool all_close       = true;
+      for (size_t i = 0; i < nb_rows; ++i)
+      {
+         for (size_t j = 0; j < nb_columns; ++j)
+         {
+            double expected = 0;
+            double magnitude = 0;
+            for (size_t p = 0; p < nb_inner; ++p)
+            {
+               expected += static_cast<double>(a(i, p)) * static_cast<double>(b(p, j));
+               magnitude += std::abs(static_cast<double>(a(i, p)) * static_cast<double>(b(p, j)));
+            }
+            all_close &= std::abs(static_cast<double>(c(i, j)) - expected) <= epsilon * std::abs(expected) + 1e-5 * magnitude;
+         }
+      }
+      TESTER_ASSERT(all_close);
+   }
+};
+
+TESTER_TEST_SUITE(TestFloat16);
+TESTER_TEST(test_conversions);
+TESTER_TEST(test_limits);
+TESTER_TEST(test_arithmetic);
+TESTER_TEST(test_array_operators);
+TESTER_TEST(test_matrix_mul);
+TESTER_TEST_SUITE_END();
@@ -8,6 +8,17 @@ DECLARE_NAMESPACE_NLL
 
 DECLARE_NAMESPACE_NLL_END
 
+template <class array_type, class = void>
+struct HasMemoryOffsets : public std::false_type
+{
+};
+
+template <class array_type>
+struct HasMemoryOffsets<array_type, decltype(memory_offsets(std::declval<const array_type&>(), std::vector<typename array_type::index_type>()), void())>
+    : public std::true_type
+{
+};
+
 struct TestIndexing
 {
    void test_stdvector()
@@ -48,9 +59,181 @@ struct TestIndexing
       TESTER_ASSERT(r(1) == 3);
       TESTER_ASSERT(r(2) == 6);*/
    }
+
+   void test_gather()
+   {
+      test_gather_impl<float>();
+      test_gather_impl<double>();
+      test_gather_impl<int>();
+   }
+
+   template <class T>
+   void test_gather_impl()
+   {
+      using array_type = Array<T, 3>;
+
+      array_type a(20, 15, 10);
+      for (size_t n = 0; n < a.size(); ++n)
+      {
+         a(static_cast<ui32>(n % 20), static_cast<ui32>((n / 20) % 15), static_cast<ui32>(n / 300)) = static_cast<T>(n);
+      }
+
+      // full array and strided sub-array (the offsets are relative to the sub-array)
+      auto sub = a(vector3ui{2, 1, 3}, vector3ui{18, 13, 9}, vector3ui{2, 3, 1});
+      test_gather_array(a);
+      test_gather_array(sub);
+   }
+
+   template <class Array>
+   void test_gather_array(const Array& a)
+   {
+      std::vector<typename Array::index_type> indexes;
+      std::array<std::vector<ui32>, 3> coordinates;
+      for (size_t n = 0; n < 5000; ++n)
+      {
+         const vector3ui index = {generateUniformDistribution<ui32>(0, a.shape()[0] - 1), generateUniformDistribution<ui32>(0, a.shape()[1] - 1),
+                                  generateUniformDistribution<ui32>(0, a.shape()[2] - 1)};
+         indexes.push_back(index);
+         for (size_t d = 0; d < 3; ++d)
+         {
+            coordinates[d].push_back(index[d]);
+         }
+      }
+
+      const auto offsets = memory_offsets(a, indexes, Parallel(0, 100));
+      TESTER_ASSERT(offsets == memory_offsets(a, coordinates));
+
+      const auto expected = loopkup(a, indexes);
+      for (ui32 nb_threads = 1; nb_threads <= 4; ++nb_threads)
+      {
+         const auto r = gather(a, offsets, Parallel(nb_threads, 100));
+         TESTER_ASSERT(r == expected);
+      }
+   }
+
+   void test_multislice()
+   {
+      // the slices are not at a fixed distance of each other: no memory offsets, the elements are found by their index
+      using array_type = Array_row_major_multislice<float, 3>;
+      static_assert(!HasMemoryOffsets<array_type>::value, "the memory offsets require a single slice of memory");
+      static_assert(HasMemoryOffsets<Array_row_major<float, 3>>::value, "the memory offsets of a single slice");
+
+      array_type a(7, 5, 4);
+      Array_row_major<float, 3> contiguous(a.shape());
+      for (size_t n = 0; n < a.size(); ++n)
+      {
+         const vector3ui index(static_cast<ui32>(n % 7), static_cast<ui32>((n / 7) % 5), static_cast<ui32>(n / 35));
+         a(index)          = static_cast<float>(n);
+         contiguous(index) = static_cast<float>(n);
+      }
+
+      const std::vector<vector3ui> indexes = {{1, 0, 1}, {6, 0, 0}, {0, 0, 3}, {6, 4, 3}, {2, 3, 2}};
+      const auto expected                  = loopkup(a, indexes);
+      const auto r                         = gather(contiguous, memory_offsets(contiguous, indexes));
+      TESTER_ASSERT(expected(vector1ui(0)) == 36);
+      TESTER_ASSERT(expected(vector1ui(3)) == 139);
+      for (ui32 n = 0; n < indexes.size(); ++n)
+      {
+         TESTER_ASSERT(r(vector1ui(n)) == expected(vector1ui(n)));
+      }
+   }
+
+   void test_scatter()
+   {
+      using array_type = Array<float, 2>;
+
+      array_type a(vector2ui(10, 12), 0);
+      auto sub = a(vector2ui{1, 2}, vector2ui{8, 10});
+
+      // the last value of a repeated offset is written
+      const std::vector<vector2ui> indexes = {{0, 0}, {3, 2}, {7, 8}, {3, 2}};
+      Vector<float> values(4);
+      values = {1, 2, 3, 4};
+      scatter(sub, memory_offsets(sub, indexes), values, Parallel(4, 1));
+
+      TESTER_ASSERT(a(1, 2) == 1);
+      TESTER_ASSERT(a(4, 4) == 4);
+      TESTER_ASSERT(a(8, 10) == 3);
+      TESTER_ASSERT(a(0, 0) == 0);
+      TESTER_ASSERT(a(9, 11) == 0);
+      TESTER_ASSERT(a(3, 2) == 0);
+
+      // many repeated offsets, distributed to the ranges of the threads
+      std::vector<vector2ui> many_indexes;
+      Vector<float> many_values(20000);
+      for (ui32 n = 0; n < many_values.size(); ++n)
+      {
+         many_indexes.push_back({generateUniformDistribution<ui32>(0, 9), generateUniformDistribution<ui32>(0, 11)});
+         many_values(vector1ui(n)) = static_cast<float>(n);
+      }
+      array_type expected(a.shape(), -1);
+      for (ui32 n = 0; n < many_values.size(); ++n)
+      {
+         expected(many_indexes[n]) = static_cast<float>(n);
+      }
+      const auto offsets = memory_offsets(a, many_indexes);
+      for (ui32 nb_threads = 1; nb_threads <= 5; ++nb_threads)
+      {
+         array_type b(a.shape(), -1);
+         scatter(b, offsets, many_values, Parallel(nb_threads, 1));
+         TESTER_ASSERT(b == expected);
+      }
+   }
+
+   void test_scatter_add()
+   {
+      using array_type = Array<double, 2>;
+      const vector2ui shape(50, 40);
+
+      // sparse (few collisions) and dense (histogram-like) contributions
+      for (size_t nb_values : {100, 100000})
+      {
+         std::vector<vector2ui> indexes(nb_values);
+         Vector<double> values(static_cast<ui32>(nb_values));
+         for (size_t n = 0; n < nb_values; ++n)
+         {
+            indexes[n] = {generateUniformDistribution<ui32>(0, 49), generateUniformDistribution<ui32>(0, 39)};
+            values(vector1ui(static_cast<ui32>(n))) = generateUniformDistribution<double>(-1, 1);
+         }
+         const auto offsets = memory_offsets(array_type(shape), indexes);
+
+         array_type expected(shape, 0);
+         for (size_t n = 0; n < nb_values; ++n)
+         {
+            expected(indexes[n]) += values(vector1ui(static_cast<ui32>(n)));
+         }
+
+         const ScatterStrategy strategies[] = {ScatterStrategy::automatic, ScatterStrategy::atomic, ScatterStrategy::partitioned};
+         for (auto strategy : strategies)
+         {
+            for (ui32 nb_threads = 1; nb_threads <= 4; ++nb_threads)
+            {
+               array_type a(shape, 0);
+               scatter_add(a, offsets, values, Parallel(nb_threads, 10), strategy);
+               if (strategy == ScatterStrategy::atomic)
+               {
+                  // the order of the additions is not defined
+                  for (size_t n = 0; n < a.size(); ++n)
+                  {
+                     const vector2ui index(static_cast<ui32>(n % 50), static_cast<ui32>(n / 50));
+                     TESTER_ASSERT(std::abs(a(index) - expected(index)) < 1e-9);
+                  }
+               }
+               else
+               {
+                  TESTER_ASSERT(a == expected);
+               }
+            }
+         }
+      }
+   }
 };
 
 TESTER_TEST_SUITE(TestIndexing);
 TESTER_TEST(test_stdvector);
 TESTER_TEST(test_arrayindex);
+TESTER_TEST(test_gather);
+TESTER_TEST(test_multislice);
+TESTER_TEST(test_scatter);
+TESTER_TEST(test_scatter_add);
 TESTER_TEST_SUITE_END();
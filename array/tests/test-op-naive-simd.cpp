@@ -0,0 +1,1137 @@
+#include <array/forward.h>
+#include <tester/register.h>
+
+using namespace NAMESPACE_NLL;
+
+struct TestOpNaiveSimd
+{
+   using Isa = details::simd::Isa;
+
+   template <class T>
+   using is_floating = NAMESPACE_NLL::details::is_floating<T>;
+
+   template <class T>
+   static std::vector<T> create(size_t size, int offset)
+   {
+      // small non-zero values so that the divisions are defined and the integers don't overflow
+      std::vector<T> v(size);
+      for (size_t n = 0; n < size; ++n)
+      {
+         v[n] = static_cast<T>((n * 7 + offset) % 13 + 1);
+      }
+      return v;
+   }
+
+   template <class T>
+   static bool equal(const std::vector<T>& v1, const std::vector<T>& v2)
+   {
+      for (size_t n = 0; n < v1.size(); ++n)
+      {
+         const double expected = static_cast<double>(v2[n]);
+         if (std::abs(static_cast<double>(v1[n]) - expected) > 1e-5 * (1 + std::abs(expected)))
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /**
+    Run the kernel on memory lines of different sizes, starting at different alignments and
+    check the elements outside the line are untouched
+    */
+   template <class T, class Kernel, class Reference>
+   static void check_binary(Kernel kernel, Reference reference)
+   {
+      for (size_t size = 0; size < 150; ++size)
+      {
+         for (size_t offset = 0; offset < 4; ++offset)
+         {
+            const size_t offset_v2  = (offset + 1) % 4;
+            std::vector<T> v1       = create<T>(size + 4, 1);
+            const std::vector<T> v2 = create<T>(size + 4, 2);
+
+            std::vector<T> expected = v1;
+            for (size_t n = 0; n < size; ++n)
+            {
+               reference(expected[n + offset], v2[n + offset_v2]);
+            }
+
+            kernel(v1.data() + offset, v2.data() + offset_v2, size);
+            TESTER_ASSERT(equal(v1, expected));
+         }
+      }
+   }
+
+   template <class T, class Kernel, class Reference>
+   static void check_unary(Kernel kernel, Reference reference)
+   {
+      for (size_t size = 0; size < 150; ++size)
+      {
+         for (size_t offset = 0; offset < 4; ++offset)
+         {
+            std::vector<T> v1 = create<T>(size + 4, 1);
+
+            std::vector<T> expected = v1;
+            for (size_t n = 0; n < size; ++n)
+            {
+               reference(expected[n + offset]);
+            }
+
+            kernel(v1.data() + offset, size);
+            TESTER_ASSERT(equal(v1, expected));
+         }
+      }
+   }
+
+   void test_kernels()
+   {
+      auto& dispatcher    = details::simd::SimdDispatcher::instance();
+      const Isa isa       = dispatcher.getIsa();
+      const Isa supported = dispatcher.getSupportedIsa();
+
+      for (int n = 0; n <= static_cast<int>(supported); ++n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(n));
+         TESTER_ASSERT(dispatcher.getIsa() <= static_cast<Isa>(n));
+
+         test_kernels_impl<float>();
+         test_kernels_impl<double>();
+         test_kernels_impl<int>();
+         test_kernels_impl<ui32>();
+         test_kernels_impl<short>();
+         test_kernels_impl<ui8>();
+      }
+
+      dispatcher.setIsa(isa);
+      TESTER_ASSERT(dispatcher.getIsa() == isa);
+   }
+
+   template <class T>
+   void test_kernels_impl()
+   {
+      const T value = static_cast<T>(3);
+      check_binary<T>([](T* v1, const T* v2, size_t size) { details::add_naive(v1, 1, v2, 1, size); },
+                      [](T& a, T b) { a = static_cast<T>(a + b); });
+      check_binary<T>([](T* v1, const T* v2, size_t size) { details::sub_naive(v1, 1, v2, 1, size); },
+                      [](T& a, T b) { a = static_cast<T>(a - b); });
+      check_binary<T>([](T* v1, const T* v2, size_t size) { details::mul_naive_elementwise(v1, 1, v2, 1, size); },
+                      [](T& a, T b) { a = static_cast<T>(a * b); });
+      check_binary<T>([](T* v1, const T* v2, size_t size) { details::div_naive_elementwise(v1, 1, v2, 1, size); },
+                      [](T& a, T b) { a = static_cast<T>(a / b); });
+      check_binary<T>([&](T* v1, const T* v2, size_t size) { details::addmul_naive(v1, 1, v2, 1, value, size); },
+                      [&](T& a, T b) { a = static_cast<T>(a - b * value); });
+
+      check_unary<T>([&](T* v1, size_t size) { details::add_naive_cte(v1, 1, size, value); }, [&](T& a) { a = static_cast<T>(a + value); });
+      check_unary<T>([&](T* v1, size_t size) { details::mul_naive(v1, 1, value, size); }, [&](T& a) { a = static_cast<T>(a * value); });
+      check_unary<T>([&](T* v1, size_t size) { details::div_naive(v1, 1, value, size); }, [&](T& a) { a = static_cast<T>(a / value); });
+   }
+
+   void test_kernels_overflow()
+   {
+      // integers wrap around the same way as the scalar code
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      std::vector<ui8> v1(100, 200);
+      const std::vector<ui8> v2(100, 100);
+      details::add_naive(v1.data(), 1, v2.data(), 1, v1.size());
+      TESTER_ASSERT(v1 == std::vector<ui8>(100, 44));
+
+      details::mul_naive_elementwise(v1.data(), 1, v2.data(), 1, v1.size());
+      TESTER_ASSERT(v1 == std::vector<ui8>(100, static_cast<ui8>(44 * 100)));
+
+      std::vector<short> s1(100, 30000);
+      details::mul_naive(s1.data(), 1, short(3), s1.size());
+      TESTER_ASSERT(s1 == std::vector<short>(100, static_cast<short>(90000)));
+
+      std::vector<int> i1(100, -5);
+      const std::vector<int> i2(100, 7);
+      details::addmul_naive(i1.data(), 1, i2.data(), 1, -3, i1.size());
+      TESTER_ASSERT(i1 == std::vector<int>(100, 16));
+      TESTER_ASSERT(dispatcher.getIsa() <= dispatcher.getSupportedIsa());
+   }
+
+   /**
+    Compare the vectorized function to the C library, in place and out of place, on memory
+    lines of different sizes and alignments
+    */
+   template <class T, class Kernel, class Reference>
+   static void check_function(Kernel kernel, Reference reference, T min_value, T max_value, double tolerance)
+   {
+      for (size_t size = 0; size < 70; size += 3)
+      {
+         for (size_t offset = 0; offset < 4; ++offset)
+         {
+            std::vector<T> input(size + 4);
+            for (size_t n = 0; n < input.size(); ++n)
+            {
+               input[n] = min_value + (max_value - min_value) * static_cast<T>((n * 37 + offset * 11) % 101) / static_cast<T>(100);
+            }
+
+            std::vector<T> expected = input;
+            for (size_t n = 0; n < size; ++n)
+            {
+               expected[n + offset] = reference(input[n + offset]);
+            }
+
+            std::vector<T> output = input;
+            kernel(output.data() + offset, input.data() + offset, size);
+            TESTER_ASSERT(equal_function(output, expected, tolerance));
+
+            kernel(input.data() + offset, input.data() + offset, size);
+            TESTER_ASSERT(equal_function(input, expected, tolerance));
+         }
+      }
+   }
+
+   template <class T>
+   static bool equal_function(const std::vector<T>& v1, const std::vector<T>& v2, double tolerance)
+   {
+      for (size_t n = 0; n < v1.size(); ++n)
+      {
+         const double value    = static_cast<double>(v1[n]);
+         const double expected = static_cast<double>(v2[n]);
+         // NaN and infinities are tested on the bit pattern: the tests are built with -ffast-math
+         if (!details::is_finite(expected))
+         {
+            if (details::is_nan(value) != details::is_nan(expected) ||
+                (details::is_inf(expected) && (!details::is_inf(value) || std::signbit(value) != std::signbit(expected))))
+            {
+               return false;
+            }
+         }
+         else if (std::abs(value - expected) > tolerance * std::max(std::abs(expected), static_cast<double>(std::numeric_limits<T>::min())))
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   void test_functions()
+   {
+      auto& dispatcher    = details::simd::SimdDispatcher::instance();
+      const Isa isa       = dispatcher.getIsa();
+      const Isa supported = dispatcher.getSupportedIsa();
+
+      for (int n = 0; n <= static_cast<int>(supported); ++n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(n));
+         test_functions_impl<float>(1e-6);
+         test_functions_impl<double>(1e-15);
+      }
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   void test_functions_impl(double tolerance)
+   {
+      using namespace details;
+
+      // sin & cos are compared in absolute error: the relative error is large close to the roots
+      const auto sin_ref = [](T v) { return std::sin(v); };
+      const auto cos_ref = [](T v) { return std::cos(v); };
+      check_function<T>([](T* o, const T* i, size_t size) { details::sin(o, 1, i, 1, static_cast<ui32>(size)); }, sin_ref, T(-10), T(10), tolerance * 4);
+      check_function<T>([](T* o, const T* i, size_t size) { details::cos(o, 1, i, 1, static_cast<ui32>(size)); }, cos_ref, T(-10), T(10), tolerance * 4);
+      check_function<T>([](T* o, const T* i, size_t size) { details::exp(o, 1, i, 1, static_cast<ui32>(size)); }, [](T v) { return std::exp(v); },
+                        T(-80), T(80), tolerance);
+      check_function<T>([](T* o, const T* i, size_t size) { details::log(o, 1, i, 1, static_cast<ui32>(size)); }, [](T v) { return std::log(v); },
+                        T(1e-3), T(1e4), tolerance);
+      check_function<T>([](T* o, const T* i, size_t size) { details::sqrt(o, 1, i, 1, static_cast<ui32>(size)); }, [](T v) { return std::sqrt(v); },
+                        T(0), T(1e4), tolerance);
+      check_function<T>([](T* o, const T* i, size_t size) { details::abs(o, 1, i, 1, static_cast<ui32>(size)); }, [](T v) { return std::abs(v); },
+                        T(-1e4), T(1e4), 0);
+
+      // arguments too large for the vectorized reduction are computed by the C library
+      check_function<T>([](T* o, const T* i, size_t size) { details::sin(o, 1, i, 1, static_cast<ui32>(size)); }, sin_ref, T(-1e9), T(1e9), tolerance * 4);
+
+      // special values follow the C library
+      const T inf = std::numeric_limits<T>::infinity();
+      const T nan = std::numeric_limits<T>::quiet_NaN();
+      const std::vector<T> special = {T(0), -T(0), inf, -inf, nan, T(-1), std::numeric_limits<T>::denorm_min(), std::numeric_limits<T>::min(),
+                                      std::numeric_limits<T>::max(), T(1000), T(-1000), T(1), T(2), T(0.5), T(100), T(-100), T(20), T(3)};
+      const auto check_special = [&](void (*f)(T*, ui32, const T*, ui32, ui32), T (*reference)(T)) {
+         std::vector<T> output(special.size());
+         f(output.data(), 1, special.data(), 1, static_cast<ui32>(special.size()));
+         std::vector<T> expected(special.size());
+         std::transform(special.begin(), special.end(), expected.begin(), reference);
+         TESTER_ASSERT(equal_function(output, expected, tolerance * 4));
+      };
+      check_special(&details::exp<T>, [](T v) { return std::exp(v); });
+      check_special(&details::log<T>, [](T v) { return std::log(v); });
+      check_special(&details::sqrt<T>, [](T v) { return std::sqrt(v); });
+      check_special(&details::sin<T>, [](T v) { return std::sin(v); });
+      check_special(&details::cos<T>, [](T v) { return std::cos(v); });
+      check_special(&details::abs<T>, [](T v) { return std::abs(v); });
+   }
+
+   void test_array_functions()
+   {
+      // unit-stride arrays use the vectorized functions, strided sub-arrays the scalar ones
+      using array_type = Array<float, 2>;
+      array_type a(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<float>(index++ % 23) * 0.25f + 0.1f; });
+
+      const auto check = [&](const array_type& result, float (*reference)(float), const array_type& input) {
+         TESTER_ASSERT(result.shape() == input.shape());
+         for (ui32 y = 0; y < input.shape()[1]; ++y)
+         {
+            for (ui32 x = 0; x < input.shape()[0]; ++x)
+            {
+               const float expected = reference(input(x, y));
+               TESTER_ASSERT(std::abs(result(x, y) - expected) <= 1e-6f * std::max(1.0f, std::abs(expected)));
+            }
+         }
+      };
+
+      check(cos(a), [](float v) { return std::cos(v); }, a);
+      check(sin(a), [](float v) { return std::sin(v); }, a);
+      check(exp(a), [](float v) { return std::exp(v); }, a);
+      check(log(a), [](float v) { return std::log(v); }, a);
+      check(sqrt(a), [](float v) { return std::sqrt(v); }, a);
+      check(abs(a), [](float v) { return std::abs(v); }, a);
+
+      const auto a_sub = a(vector2ui(1, 1), vector2ui(30, 3));
+      check(exp(a_sub), [](float v) { return std::exp(v); }, a_sub);
+      check(cos(a_sub), [](float v) { return std::cos(v); }, a_sub);
+   }
+
+   void test_reductions()
+   {
+      // the vectorized sums must be bit-identical to the scalar code, whatever the instruction set
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      test_reductions_impl<float>();
+      test_reductions_impl<double>();
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   void test_reductions_impl()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+
+      std::vector<T> v(300);
+      for (size_t n = 0; n < v.size(); ++n)
+      {
+         v[n] = static_cast<T>(std::sin(n * 0.37) * 100);
+      }
+      v[200] = std::numeric_limits<T>::quiet_NaN();
+
+      for (size_t size = 0; size < 150; ++size)
+      {
+         for (size_t offset = 0; offset < 4; ++offset)
+         {
+            const T* ptr = v.data() + offset;
+
+            dispatcher.setIsa(Isa::none);
+            const T expected_sum  = details::sum_naive(ptr, 1, size);
+            const T expected_norm = details::norm2_naive_sqr(ptr, 1, size);
+            T expected_kahan[2];
+            details::sum_kahan_naive(ptr, 1, size, expected_kahan[0], expected_kahan[1]);
+            const auto expected_minmax = std::minmax_element(ptr, ptr + size);
+
+            for (int n = 0; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+            {
+               dispatcher.setIsa(static_cast<Isa>(n));
+               TESTER_ASSERT(details::sum_naive(ptr, 1, size) == expected_sum);
+               TESTER_ASSERT(details::norm2_naive_sqr(ptr, 1, size) == expected_norm);
+
+               T kahan[2];
+               details::sum_kahan_naive(ptr, 1, size, kahan[0], kahan[1]);
+               TESTER_ASSERT(kahan[0] == expected_kahan[0] && kahan[1] == expected_kahan[1]);
+
+               T min_value = std::numeric_limits<T>::max();
+               T max_value = std::numeric_limits<T>::lowest();
+               details::minmax_naive(ptr, 1, size, min_value, max_value);
+               TESTER_ASSERT(size == 0 || (min_value == *expected_minmax.first && max_value == *expected_minmax.second));
+            }
+         }
+      }
+
+      // NaN are ignored by min & max
+      T min_value = std::numeric_limits<T>::max();
+      T max_value = std::numeric_limits<T>::lowest();
+      details::min_naive(v.data() + 200, 1, 40, min_value);
+      details::max_naive(v.data() + 180, 1, 40, max_value);
+      TESTER_ASSERT(min_value == *std::min_element(v.data() + 201, v.data() + 240));
+      TESTER_ASSERT(max_value == std::max(*std::max_element(v.data() + 180, v.data() + 200), *std::max_element(v.data() + 201, v.data() + 220)));
+   }
+
+   void test_arg_reductions()
+   {
+      // the vectorized argmin/argmax must return the first occurrence, as the scalar code
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      test_arg_reductions_impl<float>();
+      test_arg_reductions_impl<double>();
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   void test_arg_reductions_impl()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+
+      // few distinct values to have many ties
+      std::vector<T> v(300);
+      for (size_t n = 0; n < v.size(); ++n)
+      {
+         v[n] = static_cast<T>(std::round(std::sin(n * 0.37) * 4));
+      }
+
+      std::vector<T> special(v);
+      special[3]  = std::numeric_limits<T>::quiet_NaN();
+      special[40] = std::numeric_limits<T>::infinity();
+      special[41] = -std::numeric_limits<T>::infinity();
+      special[97] = std::numeric_limits<T>::quiet_NaN();
+
+      std::vector<T> nan(100, std::numeric_limits<T>::quiet_NaN());
+      nan[61] = -std::numeric_limits<T>::infinity();
+      nan[75] = -std::numeric_limits<T>::infinity();
+
+      for (size_t size = 1; size < 150; ++size)
+      {
+         for (size_t offset = 0; offset < 4; ++offset)
+         {
+            const T* ptr            = v.data() + offset;
+            const ui32 expected_max = static_cast<ui32>(std::max_element(ptr, ptr + size) - ptr);
+            const ui32 expected_min = static_cast<ui32>(std::min_element(ptr, ptr + size) - ptr);
+
+            dispatcher.setIsa(Isa::none);
+            const T* ptr_special      = special.data() + offset;
+            const auto expected_s_max = details::argmax(ptr_special, 1, static_cast<ui32>(size));
+            const auto expected_s_min = details::argmin(ptr_special, 1, static_cast<ui32>(size));
+            const T* ptr_nan          = nan.data() + offset % 2;
+            const auto expected_n_max = details::argmax(ptr_nan, 1, static_cast<ui32>(std::min<size_t>(size, 90)));
+
+            for (int n = 0; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+            {
+               dispatcher.setIsa(static_cast<Isa>(n));
+               TESTER_ASSERT(details::argmax(ptr, 1, static_cast<ui32>(size)).first == expected_max);
+               TESTER_ASSERT(details::argmin(ptr, 1, static_cast<ui32>(size)).first == expected_min);
+               TESTER_ASSERT(details::argmax(ptr_special, 1, static_cast<ui32>(size)).first == expected_s_max.first);
+               TESTER_ASSERT(details::argmin(ptr_special, 1, static_cast<ui32>(size)).first == expected_s_min.first);
+               TESTER_ASSERT(details::argmax(ptr_nan, 1, static_cast<ui32>(std::min<size_t>(size, 90))).first == expected_n_max.first);
+            }
+         }
+      }
+
+      // NaN are skipped, except if there is nothing else
+      TESTER_ASSERT(details::argmax(special.data() + 3, 1, 30).first == std::max_element(special.data() + 4, special.data() + 33) - special.data() - 3);
+      TESTER_ASSERT(details::argmin(special.data() + 41, 1, 100).first == 0);
+      TESTER_ASSERT(details::argmax(nan.data(), 1, 60).first == 0);
+      TESTER_ASSERT(details::argmax(nan.data(), 1, 100).first == 61);
+   }
+
+   void test_compare()
+   {
+      // the packed bits must be identical for all the instruction sets, including the NaN and the tail of the line
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      test_compare_impl<float>();
+      test_compare_impl<double>();
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   void test_compare_impl()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+
+      std::vector<T> v1 = create<T>(204, 1);
+      std::vector<T> v2 = create<T>(204, 2);
+      v1[5]             = std::numeric_limits<T>::quiet_NaN();
+      v2[77]            = std::numeric_limits<T>::quiet_NaN();
+      v1[100]           = std::numeric_limits<T>::infinity();
+
+      const Comparison comparisons[] = {Comparison::less,          Comparison::less_equal, Comparison::greater,
+                                        Comparison::greater_equal, Comparison::equal,      Comparison::not_equal};
+      for (auto comparison : comparisons)
+      {
+         for (size_t size = 16; size < 200; size += 7)
+         {
+            for (size_t offset = 0; offset < 4; ++offset)
+            {
+               std::vector<std::uint64_t> expected((size + 63) / 64);
+               std::vector<std::uint64_t> expected_value((size + 63) / 64);
+               for (size_t n = 0; n < size; ++n)
+               {
+                  expected[n / 64] |= std::uint64_t(details::compare_values(v1[n + offset], v2[n], comparison)) << (n % 64);
+                  expected_value[n / 64] |= std::uint64_t(details::compare_values(v1[n + offset], T(7), comparison)) << (n % 64);
+               }
+
+               for (int n = 1; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+               {
+                  dispatcher.setIsa(static_cast<Isa>(n));
+                  std::vector<std::uint64_t> bits(expected.size(), ~std::uint64_t(0));
+                  TESTER_ASSERT(details::simd::compare(bits.data(), v1.data() + offset, v2.data(), T(0), comparison, size));
+                  TESTER_ASSERT(bits == expected);
+                  TESTER_ASSERT(details::simd::compare(bits.data(), v1.data() + offset, static_cast<const T*>(nullptr), T(7), comparison, size));
+                  TESTER_ASSERT(bits == expected_value);
+               }
+            }
+         }
+      }
+   }
+
+   void test_find()
+   {
+      // the position of the first element satisfying the predicate (or not) must be identical for all the instruction sets
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      test_find_impl<float>();
+      test_find_impl<double>();
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   void test_find_impl()
+   {
+      using Predicate  = details::simd::LinePredicate<T>;
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+
+      std::vector<Predicate> predicates;
+      const Comparison comparisons[] = {Comparison::less,          Comparison::less_equal, Comparison::greater,
+                                        Comparison::greater_equal, Comparison::equal,      Comparison::not_equal};
+      for (auto comparison : comparisons)
+      {
+         Predicate predicate;
+         predicate.comparison = comparison;
+         predicate.value      = T(13);
+         predicates.push_back(predicate);
+      }
+      Predicate predicate;
+      predicate.test = Predicate::Test::nan;
+      predicates.push_back(predicate);
+      predicate.test = Predicate::Test::finite;
+      predicates.push_back(predicate);
+      predicate.test      = Predicate::Test::approx_equal;
+      predicate.value     = T(12.5);
+      predicate.tolerance = T(0.5);
+      predicates.push_back(predicate);
+
+      const auto reference = [](const Predicate& predicate, T value) {
+         switch (predicate.test)
+         {
+         case Predicate::Test::compare:
+            return details::compare_values(value, predicate.value, predicate.comparison);
+         case Predicate::Test::nan:
+            return details::is_nan(value);
+         case Predicate::Test::finite:
+            return details::is_finite(value);
+         case Predicate::Test::approx_equal:
+            return !details::is_nan(value) && std::abs(value - predicate.value) <= predicate.tolerance;
+         }
+         return false;
+      };
+
+      // a single "special" element moved along the line, on a background of values satisfying or not the predicates
+      const T specials[]    = {T(13), T(12), T(14), std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::infinity()};
+      const T backgrounds[] = {T(1), T(13), std::numeric_limits<T>::quiet_NaN()};
+      for (const auto& predicate : predicates)
+      {
+         for (auto background : backgrounds)
+         {
+            for (auto special : specials)
+            {
+               for (size_t size = 16; size < 150; size += 13)
+               {
+                  for (size_t position = 0; position < size; position += 5)
+                  {
+                     std::vector<T> v(size, background);
+                     v[position] = special;
+
+                     for (int expected = 0; expected < 2; ++expected)
+                     {
+                        size_t expected_position = size;
+                        for (size_t n = 0; n < size; ++n)
+                        {
+                           if (reference(predicate, v[n]) == (expected != 0))
+                           {
+                              expected_position = n;
+                              break;
+                           }
+                        }
+
+                        for (int n = 1; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+                        {
+                           dispatcher.setIsa(static_cast<Isa>(n));
+                           size_t found = 0;
+                           TESTER_ASSERT(details::simd::find(v.data(), predicate, expected != 0, size, found));
+                           TESTER_ASSERT(found == expected_position);
+                        }
+                     }
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   void test_gather()
+   {
+      // the gather instructions are used by AVX2 and AVX-512 only
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      test_gather_impl<float>();
+      test_gather_impl<double>();
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   void test_gather_impl()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+
+      std::vector<T> input(1000);
+      for (size_t n = 0; n < input.size(); ++n)
+      {
+         input[n] = static_cast<T>(n) * T(0.5);
+      }
+
+      for (size_t size = 16; size < 150; size += 13)
+      {
+         // scattered offsets
+         std::vector<size_t> offsets(size);
+         for (size_t i = 0; i < size; ++i)
+         {
+            offsets[i] = (i * 7919 + size * 31) % input.size();
+         }
+
+         for (int n = 1; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+         {
+            dispatcher.setIsa(static_cast<Isa>(n));
+            std::vector<T> output(size);
+            const bool vectorized = details::simd::gather(output.data(), input.data(), offsets.data(), size);
+            TESTER_ASSERT(vectorized == (static_cast<Isa>(n) >= Isa::avx2));
+            for (size_t i = 0; vectorized && i < size; ++i)
+            {
+               TESTER_ASSERT(output[i] == input[offsets[i]]);
+            }
+         }
+      }
+   }
+
+   void test_convert()
+   {
+      // all the conversions must be identical to the scalar reference for all the instruction sets
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      test_convert_from<float>();
+      test_convert_from<double>();
+      test_convert_from<std::int32_t>();
+      test_convert_from<std::int16_t>();
+      test_convert_from<std::uint16_t>();
+      test_convert_from<std::uint8_t>();
+      test_convert_from<std::int8_t>();
+      test_convert_from<float16>();
+      test_convert_from<bfloat16>();
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class From>
+   void test_convert_from()
+   {
+      test_convert_impl<float, From>();
+      test_convert_impl<double, From>();
+      test_convert_impl<std::int32_t, From>();
+      test_convert_impl<std::int16_t, From>();
+      test_convert_impl<std::uint16_t, From>();
+      test_convert_impl<std::uint8_t, From>();
+      test_convert_impl<std::int8_t, From>();
+      test_convert_impl<float16, From>();
+      test_convert_impl<bfloat16, From>();
+   }
+
+   template <class From>
+   static std::vector<From> conversion_values(std::true_type UNUSED(floating_point))
+   {
+      const double specials[] = {0.0,         -0.0,         0.3,          -0.3,         0.5,          -0.5,          1.5,
+                                 -1.5,        2.5,          -2.5,         0.49999997,   -0.49999997,  127.5,         -128.5,
+                                 255.5,       256.0,        -129.0,       32767.5,      -32768.6,     65535.4,       65536.0,
+                                 2147483520., 2147483647.,  2147483648.,  -2147483648., -2147483904., 1e10,          -1e10,
+                                 1e39,        -1e39,        4194304.5,    8388607.5,    1e300,        -1e300,        3.4028235e38,
+                                 // rounding of float16 & bfloat16: ties, denormals, overflow
+                                 65504.0,     65519.0,      65520.0,      -65520.0,     1.00048828125, 1.00146484375, 1.00390625,
+                                 1.01171875,  6.103515625e-5, 1.0e-5,   -3.0e-6,      5.9604644775390625e-8, 2.98023223876953125e-8,
+                                 3.0e-8,      3.3961e38,    1e-40};
+      std::vector<From> values;
+      for (auto value : specials)
+      {
+         values.push_back(static_cast<From>(value));
+      }
+      values.push_back(std::numeric_limits<From>::quiet_NaN());
+      values.push_back(std::numeric_limits<From>::infinity());
+      values.push_back(-std::numeric_limits<From>::infinity());
+      for (int n = 0; n < 100; ++n)
+      {
+         values.push_back(static_cast<From>(std::sin(n * 0.37) * std::pow(10.0, n % 12)));
+         values.push_back(static_cast<From>(std::sin(n * 0.71) * 120));
+      }
+      return values;
+   }
+
+   template <class From>
+   static std::vector<From> conversion_values(std::false_type UNUSED(floating_point))
+   {
+      using limits = std::numeric_limits<From>;
+      std::vector<From> values = {limits::lowest(), limits::max(), From(0), From(1), static_cast<From>(limits::lowest() + 1),
+                                  static_cast<From>(limits::max() - 1)};
+      for (int n = 0; n < 100; ++n)
+      {
+         values.push_back(static_cast<From>(static_cast<std::uint32_t>(n) * 2654435761u));
+      }
+      return values;
+   }
+
+   // static_cast is undefined if the truncated floating point value is out of the range of the integer type
+   template <class To, class From>
+   static bool is_conversion_defined(From value, std::true_type UNUSED(integral_from_floating_point))
+   {
+      const double truncated = std::trunc(static_cast<double>(value));
+      return !details::is_nan(truncated) && truncated >= static_cast<double>(std::numeric_limits<To>::lowest()) &&
+             truncated <= static_cast<double>(std::numeric_limits<To>::max());
+   }
+
+   template <class To, class From>
+   static bool is_conversion_defined(From, std::false_type)
+   {
+      return true;
+   }
+
+   template <class To, class From>
+   void test_convert_impl()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+
+      const Conversion conversions[] = {Conversion::cast, Conversion::saturate, Conversion::round, Conversion::round_saturate};
+      for (auto conversion : conversions)
+      {
+         const bool saturate = conversion == Conversion::saturate || conversion == Conversion::round_saturate;
+         const bool round    = conversion == Conversion::round || conversion == Conversion::round_saturate;
+
+         std::vector<From> input;
+         for (auto value : conversion_values<From>(is_floating<From>()))
+         {
+            const From rounded = round && is_floating<From>::value ? static_cast<From>(std::round(value)) : value;
+            using undefined    = std::integral_constant<bool, is_floating<From>::value && std::is_integral<To>::value>;
+            if (saturate || is_conversion_defined<To>(rounded, undefined()))
+            {
+               input.push_back(value);
+            }
+         }
+
+         std::vector<To> expected(input.size());
+         for (size_t n = 0; n < input.size(); ++n)
+         {
+            expected[n] = details::convert_value<To>(input[n], conversion);
+         }
+
+         for (int n = 1; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+         {
+            dispatcher.setIsa(static_cast<Isa>(n));
+
+            // all the tail sizes
+            TESTER_ASSERT(input.size() >= 40);
+            for (size_t size = input.size() - 17; size <= input.size(); ++size)
+            {
+               std::vector<To> output(size);
+               const bool vectorized = details::simd::convert(output.data(), input.data(), conversion, size);
+               TESTER_ASSERT(vectorized == (static_cast<Isa>(n) >= Isa::avx2));
+               if (vectorized)
+               {
+                  // bitwise comparison: NaN and the sign of 0 must match
+                  TESTER_ASSERT(memcmp(output.data(), expected.data(), size * sizeof(To)) == 0);
+               }
+            }
+         }
+      }
+   }
+
+   void test_reduced_float_conversions()
+   {
+      // every float16 & bfloat16 value, a sample of the float values covering all the exponents and the ties
+      test_reduced_float_conversions_impl<float16>();
+      test_reduced_float_conversions_impl<bfloat16>();
+   }
+
+   template <class T>
+   void test_reduced_float_conversions_impl()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      std::vector<T> values(1 << 16);
+      for (size_t n = 0; n < values.size(); ++n)
+      {
+         values[n] = T::fromBits(static_cast<std::uint16_t>(n));
+      }
+
+      std::vector<float> floats;
+      for (std::uint64_t bits = 0; bits < (1ull << 32); bits += 65521)
+      {
+         floats.push_back(NAMESPACE_NLL::details::bits_to_float(static_cast<std::uint32_t>(bits)));
+      }
+      for (size_t n = 0; n + 1 < values.size(); ++n)
+      {
+         // halfway between two consecutive values (exact in float)
+         const float low  = values[n];
+         const float high = values[n + 1];
+         if (std::isfinite(low) && std::isfinite(high))
+         {
+            floats.push_back(low / 2 + high / 2);
+         }
+      }
+
+      for (int n = 1; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(n));
+         const bool vectorized = static_cast<Isa>(n) >= Isa::avx2;
+
+         std::vector<float> to_float(values.size());
+         TESTER_ASSERT(details::simd::convert(to_float.data(), values.data(), Conversion::cast, values.size()) == vectorized);
+         for (size_t i = 0; vectorized && i < values.size(); ++i)
+         {
+            const float expected = values[i];
+            TESTER_ASSERT(NAMESPACE_NLL::details::float_to_bits(to_float[i]) == NAMESPACE_NLL::details::float_to_bits(expected));
+         }
+
+         std::vector<T> from_float(floats.size());
+         TESTER_ASSERT(details::simd::convert(from_float.data(), floats.data(), Conversion::cast, floats.size()) == vectorized);
+         for (size_t i = 0; vectorized && i < floats.size(); ++i)
+         {
+            TESTER_ASSERT(from_float[i].bits() == T(floats[i]).bits());
+         }
+      }
+
+      dispatcher.setIsa(isa);
+   }
+
+   void test_reduced_float_kernels()
+   {
+      test_reduced_float_kernels_impl<float16>();
+      test_reduced_float_kernels_impl<bfloat16>();
+   }
+
+   template <class T>
+   void test_reduced_float_kernels_impl()
+   {
+      // computed in float and rounded once: identical to the scalar operators
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+      const T value    = 1.37f;
+
+      for (int isa_n = 1; isa_n <= static_cast<int>(dispatcher.getSupportedIsa()); ++isa_n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(isa_n));
+         const bool vectorized = static_cast<Isa>(isa_n) >= Isa::avx2;
+         for (size_t size = 16; size < 60; ++size)
+         {
+            std::vector<T> v1(size);
+            std::vector<T> v2(size);
+            for (size_t n = 0; n < size; ++n)
+            {
+               v1[n] = static_cast<float>(std::sin(n * 0.37 + size) * 100);
+               v2[n] = static_cast<float>(std::cos(n * 0.11) * 3 + 3.5);
+            }
+
+            auto check = [&](auto kernel, auto reference) {
+               std::vector<T> output   = v1;
+               std::vector<T> expected = v1;
+               for (size_t n = 0; n < size; ++n)
+               {
+                  reference(expected[n], v2[n]);
+               }
+               TESTER_ASSERT(kernel(output.data()) == vectorized);
+               TESTER_ASSERT(!vectorized || memcmp(output.data(), expected.data(), size * sizeof(T)) == 0);
+            };
+
+            check([&](T* v) { return details::simd::add(v, v2.data(), size); }, [](T& a, T b) { a += b; });
+            check([&](T* v) { return details::simd::sub(v, v2.data(), size); }, [](T& a, T b) { a -= b; });
+            check([&](T* v) { return details::simd::mul_elementwise(v, v2.data(), size); }, [](T& a, T b) { a *= b; });
+            check([&](T* v) { return details::simd::div_elementwise(v, v2.data(), size); }, [](T& a, T b) { a /= b; });
+            check([&](T* v) { return details::simd::add_cte(v, value, size); }, [&](T& a, T) { a += value; });
+            check([&](T* v) { return details::simd::mul(v, value, size); }, [&](T& a, T) { a *= value; });
+            check([&](T* v) { return details::simd::div(v, value, size); }, [&](T& a, T) { a /= value; });
+            check([&](T* v) { return details::simd::addmul(v, v2.data(), value, size); }, [&](T& a, T b) { a -= b * value; });
+         }
+      }
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   static T fused_value(size_t n, int k)
+   {
+      // fractional floating point values so that a * b + c is rounded, large integers so that the products overflow
+      const double v = std::sin(n * 0.37 + k) * 1000;
+      return is_floating<T>::value ? T(static_cast<float>(v)) : static_cast<T>(static_cast<long long>(v * 1000));
+   }
+
+   void test_fused_kernels()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      for (int n = 0; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(n));
+
+         // the floating point types need the FMA instructions
+         const bool has_fma     = dispatcher.getIsa() >= Isa::avx2;
+         const bool has_integer = dispatcher.getIsa() >= Isa::sse2;
+         test_fused_kernels_impl<float>(has_fma);
+         test_fused_kernels_impl<double>(has_fma);
+         test_fused_kernels_impl<int>(has_integer);
+         test_fused_kernels_impl<ui32>(has_integer);
+         test_fused_kernels_impl<short>(has_integer);
+         test_fused_kernels_impl<ui8>(has_integer);
+         test_fused_kernels_impl<float16>(false);
+      }
+
+      dispatcher.setIsa(isa);
+   }
+
+   template <class T>
+   void test_fused_kernels_impl(bool vectorized)
+   {
+      using fused   = NAMESPACE_NLL::details::FusedArithmetic<T>;
+      const T alpha = fused_value<T>(3, 7);
+      const T beta  = fused_value<T>(5, 9);
+
+      for (size_t size = 0; size < 70; ++size)
+      {
+         for (size_t offset = 0; offset < 4; ++offset)
+         {
+            const size_t offset_b = (offset + 1) % 4;
+            std::vector<T> a(size + 4);
+            std::vector<T> b(size + 4);
+            std::vector<T> c(size + 4);
+            for (size_t n = 0; n < size + 4; ++n)
+            {
+               a[n] = fused_value<T>(n, 1);
+               b[n] = fused_value<T>(n, 2);
+               c[n] = fused_value<T>(n, 3);
+            }
+
+            // in place: the output is c
+            auto check = [&](auto kernel, auto reference) {
+               std::vector<T> output   = c;
+               std::vector<T> expected = c;
+               for (size_t n = 0; n < size; ++n)
+               {
+                  expected[n + offset] = reference(a[n + offset], b[n + offset_b], c[n + offset]);
+               }
+               kernel(output.data() + offset);
+               TESTER_ASSERT(memcmp(output.data(), expected.data(), output.size() * sizeof(T)) == 0);
+            };
+
+            const T* a_line = a.data() + offset;
+            const T* b_line = b.data() + offset_b;
+            check([&](T* output) { details::fma_naive(output, 1, a_line, 1, b_line, 1, output, 1, size); },
+                  [](T va, T vb, T vc) { return fused::fma(va, vb, vc); });
+            check([&](T* output) { details::fms_naive(output, 1, a_line, 1, b_line, 1, output, 1, size); },
+                  [](T va, T vb, T vc) { return fused::fms(va, vb, vc); });
+            check([&](T* output) { details::axpby_naive(output, 1, a_line, 1, alpha, output, 1, beta, size); },
+                  [&](T va, T, T vc) { return fused::axpby(alpha, va, beta, vc); });
+
+            // out of place
+            std::vector<T> output(size + 4, T(0));
+            details::fms_naive(output.data() + offset_b, 1, a_line, 1, a_line, 1, c.data() + offset, 1, size);
+            for (size_t n = 0; n < size; ++n)
+            {
+               const T expected = fused::fms(a[n + offset], a[n + offset], c[n + offset]);
+               TESTER_ASSERT(memcmp(&output[n + offset_b], &expected, sizeof(T)) == 0);
+            }
+         }
+      }
+
+      std::vector<T> v(64, alpha);
+      TESTER_ASSERT(details::simd::fma(v.data(), v.data(), v.data(), v.data(), v.size()) == vectorized);
+      TESTER_ASSERT(details::simd::axpby(v.data(), v.data(), alpha, v.data(), beta, v.size()) == vectorized);
+   }
+
+   void test_fused_rounding()
+   {
+      // a single rounding: (1 + 2^-23) * (1 - 2^-23) - 1 = -2^-46 while the product alone rounds to 1
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      const float epsilon = std::numeric_limits<float>::epsilon();
+      for (int n = 0; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(n));
+         const std::vector<float> a(31, 1 + epsilon);
+         const std::vector<float> b(31, 1 - epsilon);
+         const std::vector<float> c(31, 1.0f);
+         std::vector<float> output(31);
+         details::fms_naive(output.data(), 1, a.data(), 1, b.data(), 1, c.data(), 1, output.size());
+         TESTER_ASSERT(output == std::vector<float>(31, -epsilon * epsilon));
+      }
+
+      dispatcher.setIsa(isa);
+   }
+
+   void test_saturated_kernels()
+   {
+      auto& dispatcher = details::simd::SimdDispatcher::instance();
+      const Isa isa    = dispatcher.getIsa();
+
+      for (int n = 0; n <= static_cast<int>(dispatcher.getSupportedIsa()); ++n)
+      {
+         dispatcher.setIsa(static_cast<Isa>(n));
+
+         const bool has_integer = dispatcher.getIsa() >= Isa::sse2;
+         test_saturated_kernels_impl<ui8>(has_integer);
+         test_saturated_kernels_impl<signed char>(has_integer);
+         test_saturated_kernels_impl<char>(has_integer);
+         test_saturated_kernels_impl<unsigned short>(has_integer);
+         test_saturated_kernels_impl<short>(has_integer);
+         test_saturated_kernels_impl<int>(false);
+      }
+
+      dispatcher.setIsa(isa);
+   }
+
+   /// spread over the whole range of T, including the extremes
+   template <class T>
+   static T saturated_value(size_t n, size_t seed)
+   {
+      using unsigned_type = typename std::make_unsigned<T>::type;
+      if (n % 13 == seed)
+      {
+         return std::numeric_limits<T>::max();
+      }
+      if (n % 11 == seed)
+      {
+         return std::numeric_limits<T>::min();
+      }
+      return static_cast<T>(static_cast<unsigned_type>((n * 2654435761u + seed * 40503u) >> 7));
+   }
+
+   template <class T>
+   void test_saturated_kernels_impl(bool vectorized)
+   {
+      using saturated = NAMESPACE_NLL::details::SaturatedArithmetic<T>;
+      const T scale   = saturated_value<T>(3, 1);
+
+      for (size_t size = 0; size < 70; ++size)
+      {
+         for (size_t offset = 0; offset < 4; ++offset)
+         {
+            const size_t offset_b = (offset + 1) % 4;
+            std::vector<T> a(size + 4);
+            std::vector<T> b(size + 4);
+            for (size_t n = 0; n < size + 4; ++n)
+            {
+               a[n] = saturated_value<T>(n, 1);
+               b[n] = saturated_value<T>(n, 2);
+            }
+
+            auto check = [&](auto kernel, auto reference) {
+               std::vector<T> output   = a;
+               std::vector<T> expected = a;
+               for (size_t n = 0; n < size; ++n)
+               {
+                  expected[n + offset] = reference(a[n + offset], b[n + offset_b]);
+               }
+               kernel(output.data() + offset, b.data() + offset_b);
+               TESTER_ASSERT(output == expected);
+            };
+
+            check([&](T* v1, const T* v2) { details::add_saturated_naive(v1, 1, v2, 1, size); }, &saturated::add);
+            check([&](T* v1, const T* v2) { details::sub_saturated_naive(v1, 1, v2, 1, size); }, &saturated::sub);
+            check([&](T* v1, const T* v2) { details::abs_diff_naive(v1, 1, v2, 1, size); }, &saturated::abs_diff);
+            check([&](T* v1, const T* v2) { details::mul_high_naive(v1, 1, v2[0], size); }, [&](T va, T) { return saturated::mul_high(va, b[offset_b]); });
+            check([&](T* v1, const T*) { details::mul_high_naive(v1, 1, scale, size); }, [&](T va, T) { return saturated::mul_high(va, scale); });
+
+            std::int64_t expected_sum = 0;
+            for (size_t n = 0; n < size; ++n)
+            {
+               expected_sum += a[n + offset];
+            }
+            TESTER_ASSERT((details::sum_naive<T, std::int64_t>(a.data() + offset, 1, size) == expected_sum));
+         }
+      }
+
+      // the 32-bit partial sums would overflow
+      const std::vector<T> large_max(70001, std::numeric_limits<T>::max());
+      const std::vector<T> large_min(70001, std::numeric_limits<T>::min());
+      std::uint64_t sum = 0;
+      TESTER_ASSERT(details::simd::sum_widened(large_max.data(), sum, large_max.size()) == vectorized);
+      TESTER_ASSERT((details::sum_naive<T, std::int64_t>(large_max.data(), 1, large_max.size()) ==
+                     static_cast<std::int64_t>(std::numeric_limits<T>::max()) * 70001));
+      TESTER_ASSERT((details::sum_naive<T, std::int64_t>(large_min.data(), 1, large_min.size()) ==
+                     static_cast<std::int64_t>(std::numeric_limits<T>::min()) * 70001));
+      TESTER_ASSERT((details::sum_naive<T, double>(large_max.data(), 1, large_max.size()) ==
+                     static_cast<double>(std::numeric_limits<T>::max()) * 70001));
+
+      std::vector<T> v(64, scale);
+      TESTER_ASSERT(details::simd::add_saturated(v.data(), v.data(), v.size()) == vectorized);
+      TESTER_ASSERT(details::simd::mul_high(v.data(), scale, v.size()) == vectorized);
+   }
+
+   void test_array_operators()
+   {
+      // the operators of non-BLAS types go through the kernels
+      using array_type = Array<short, 2>;
+      array_type a(vector2ui(37, 5));
+      array_type b(vector2ui(37, 5));
+      int index = 0;
+      fill_index(a, [&](const vector2ui&) { return static_cast<short>(index++ % 11); });
+      fill_index(b, [&](const vector2ui&) { return static_cast<short>(index++ % 7 + 1); });
+
+      array_type r = a * short(3) + b - a;
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            TESTER_ASSERT(r(x, y) == a(x, y) * 3 + b(x, y) - a(x, y));
+         }
+      }
+
+      auto r_sub = r(vector2ui(1, 1), vector2ui(30, 3));
+      r_sub += short(2);
+      for (ui32 y = 0; y < a.shape()[1]; ++y)
+      {
+         for (ui32 x = 0; x < a.shape()[0]; ++x)
+         {
+            const bool inside = x >= 1 && x <= 30 && y >= 1 && y <= 3;
+            TESTER_ASSERT(r(x, y) == a(x, y) * 3 + b(x, y) - a(x, y) + (inside ? 2 : 0));
+         }
+      }
+   }
+};
+
+TESTER_TEST_SUITE(TestOpNaiveSimd);
+TESTER_TEST(test_kernels);
+TESTER_TEST(test_kernels_overflow);
+TESTER_TEST(test_array_operators);
+TESTER_TEST(test_functions);
+TESTER_TEST(test_array_functions);
+TESTER_TEST(test_reductions);
+TESTER_TEST(test_arg_reductions);
+TESTER_TEST(test_compare);
+TESTER_TEST(test_find);
+TESTER_TEST(test_gather);
+TESTER_TEST(test_convert);
+TESTER_TEST(test_reduced_float_conversions);
+TESTER_TEST(test_reduced_float_kernels);
+TESTER_TEST(test_fused_kernels);
+TESTER_TEST(test_fused_rounding);
+TESTER_TEST(test_saturated_kernels);
+TESTER_TEST_SUITE_END();
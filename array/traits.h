@@ -24,6 +24,23 @@ struct is_same<T> : public std::true_type
 {
 };
 
+/**
+@brief check the types provided are all raw pointers
+*/
+template <class... args>
+struct are_pointers;
+
+template <class x1, class... args>
+struct are_pointers<x1, args...>
+{
+   static const bool value = std::is_pointer<x1>::value && are_pointers<args...>::value;
+};
+
+template <>
+struct are_pointers<> : public std::true_type
+{
+};
+
 namespace details
 {
 struct TypelistEmpty
@@ -181,6 +198,21 @@ struct PromoteFloating<double>
    using type = double;
 };
 
+/**
+ @brief The default accumulator of the sums: the 8 and 16-bit integers are accumulated in 64 bits so that they don't overflow
+ */
+template <class T, bool SmallInteger = std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 2>
+struct PromoteSum
+{
+   using type = T;
+};
+
+template <class T>
+struct PromoteSum<T, true>
+{
+   using type = typename std::conditional<std::is_signed<T>::value, std::int64_t, std::uint64_t>::type;
+};
+
 /**
 @brief check the types provided are all identical
 */
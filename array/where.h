@@ -3,14 +3,312 @@
 DECLARE_NAMESPACE_NLL
 
 /**
- @brief Return the indices of the array where the predicate is true
+ @file
+
+ Find the elements of an array satisfying a predicate.
+
+ With a single thread, the elements are tested in a single pass and the predicate is called once per element, in memory order.
+ With several threads, the search is done in two passes: the matching elements of each chunk of memory lines are counted (in
+ parallel), then each chunk writes its matches directly at its place in a preallocated output (in parallel). The predicate is
+ then called twice per element and concurrently, so it must not have side effects. The results are in memory order, whatever
+ the number of threads.
+
+ The matches can be returned as:
+ - indexes: @ref where, serial unless a @ref Parallel is given
+ - linear offsets, the first dimension varying the fastest: @ref where_offsets. Use @ref unravel_index to get the indexes
+ - a coordinate array per dimension (structure of arrays): @ref where_coordinates
+ */
+
+namespace details
+{
+template <size_t N>
+struct WhereIndexes
+{
+   std::vector<StaticVector<ui32, N>>& indexes;
+
+   void resize(size_t nb_matches)
+   {
+      indexes.resize(nb_matches);
+   }
+
+   void set(size_t match, const StaticVector<ui32, N>& line_index, size_t, size_t, ui32 varying_index, ui32 position)
+   {
+      auto& index = indexes[match];
+      index       = line_index;
+      index[varying_index] += position;
+   }
+};
+
+template <size_t N>
+struct WhereOffsets
+{
+   std::vector<size_t>& offsets;
+
+   void resize(size_t nb_matches)
+   {
+      offsets.resize(nb_matches);
+   }
+
+   void set(size_t match, const StaticVector<ui32, N>&, size_t line_offset, size_t offset_step, ui32, ui32 position)
+   {
+      offsets[match] = line_offset + position * offset_step;
+   }
+};
+
+template <size_t N>
+struct WhereCoordinates
+{
+   std::array<std::vector<ui32>, N>& coordinates;
+
+   void resize(size_t nb_matches)
+   {
+      for (auto& c : coordinates)
+      {
+         c.resize(nb_matches);
+      }
+   }
+
+   void set(size_t match, const StaticVector<ui32, N>& line_index, size_t, size_t, ui32 varying_index, ui32 position)
+   {
+      for (size_t n = 0; n < N; ++n)
+      {
+         coordinates[n][match] = line_index[n];
+      }
+      coordinates[varying_index][match] += position;
+   }
+};
+
+/**
+ @brief Linear offset strides of a shape, the first dimension varying the fastest
+ */
+template <size_t N>
+std::array<size_t, N> offset_strides(const StaticVector<ui32, N>& shape)
+{
+   std::array<size_t, N> strides;
+   size_t stride = 1;
+   for (size_t n = 0; n < N; ++n)
+   {
+      strides[n] = stride;
+      stride *= shape[n];
+   }
+   return strides;
+}
+
+/**
+ @brief Write the elements satisfying the predicate in @p output, in memory order
+
+ Output must provide resize(nb_matches) and set(match, line_index, line_offset, offset_step, varying_index, position), the element
+ being at the index line_index + position along varying_index and at the linear offset line_offset + position * offset_step
+ */
+template <class T, size_t N, class Config, class Predicate, class Output>
+void where_constarray(const Array<T, N, Config>& array, const Predicate& p, Output& output, const Parallel& parallel)
+{
+   using array_type         = Array<T, N, Config>;
+   using pointer_type       = typename array_type::pointer_type;
+   using const_pointer_type = typename array_type::const_pointer_type;
+   using processor_type     = ConstArrayProcessor_contiguous_byMemoryLocality<array_type>;
+
+   if (array.size() == 0)
+   {
+      output.resize(0);
+      return;
+   }
+
+   processor_type processor_all(array, 0);
+
+   // split the memory lines if there are fewer lines than threads
+   const ui32 nb_threads_max = getNbThreads<pointer_type>(parallel, array.size(), std::numeric_limits<ui32>::max());
+   processor_all.setNbElementsPerAccess(getNbElementsPerAccessParallel<pointer_type>(nb_threads_max, processor_all.getNbAccesses(),
+                                                                                     processor_all.getNbElementsPerAccess()));
+
+   const ui32 nb_accesses   = processor_all.getNbAccesses();
+   const ui32 nb_threads    = std::min(nb_threads_max, nb_accesses);
+   const ui32 varying_index = processor_all.getVaryingIndex();
+   const auto strides       = offset_strides(array.shape());
+
+   // call op(processor, ptr, stride, nb_elements) for each memory line of the accesses [access_begin, access_end)
+   auto visit_lines = [&](size_t access_begin, size_t access_end, auto op) {
+      if (access_begin == access_end)
+      {
+         return;
+      }
+
+      auto processor = processor_all;
+      processor.restrictAccesses(static_cast<ui32>(access_begin), static_cast<ui32>(access_end));
+      bool hasMoreElements = true;
+      while (hasMoreElements)
+      {
+         const_pointer_type ptr(nullptr);
+         hasMoreElements = processor.accessMaxElements(ptr);
+         op(processor, ptr, processor.stride(), processor.getNbElementsPerAccess());
+      }
+   };
+
+   // write the matches of a memory line from the position match of the output, growing the output if grow
+   auto write_line = [&](size_t& match, bool grow, const processor_type& processor, const_pointer_type ptr, ui32 stride, ui32 nb_elements) {
+      bool line_known = false;
+      StaticVector<ui32, N> line_index;
+      size_t line_offset = 0;
+      for (ui32 n = 0; n < nb_elements; ++n)
+      {
+         if (p(ptr[n * stride]))
+         {
+            if (!line_known)
+            {
+               // the index of the line is only computed for the lines having a match
+               line_index  = processor.getArrayIndex();
+               line_offset = 0;
+               for (size_t d = 0; d < N; ++d)
+               {
+                  line_offset += line_index[d] * strides[d];
+               }
+               line_known = true;
+            }
+            if (grow)
+            {
+               output.resize(match + 1);
+            }
+            output.set(match++, line_index, line_offset, strides[varying_index], varying_index, n);
+         }
+      }
+   };
+
+   if (nb_threads <= 1)
+   {
+      // a single pass: the predicate is called once per element
+      size_t match = 0;
+      output.resize(0);
+      visit_lines(0, nb_accesses, [&](const processor_type& processor, const_pointer_type ptr, ui32 stride, ui32 nb_elements) {
+         write_line(match, true, processor, ptr, stride, nb_elements);
+      });
+      return;
+   }
+
+   // first pass: count the matches of each chunk
+   std::vector<size_t> counts(nb_threads + 1, 0);
+   auto count = [&](ui32 chunk, size_t access_begin, size_t access_end) {
+      size_t nb_matches = 0;
+      visit_lines(access_begin, access_end, [&](const processor_type&, const_pointer_type ptr, ui32 stride, ui32 nb_elements) {
+         for (ui32 n = 0; n < nb_elements; ++n)
+         {
+            nb_matches += p(ptr[n * stride]) ? 1 : 0;
+         }
+      });
+      counts[chunk + 1] = nb_matches;
+   };
+   parallel_chunks(nb_threads, nb_accesses, count);
+
+   std::partial_sum(counts.begin(), counts.end(), counts.begin());
+   output.resize(counts.back());
+
+   // second pass: each chunk writes its matches from its first position in the output
+   auto fill = [&](ui32 chunk, size_t access_begin, size_t access_end) {
+      size_t match = counts[chunk];
+      visit_lines(access_begin, access_end, [&](const processor_type& processor, const_pointer_type ptr, ui32 stride, ui32 nb_elements) {
+         write_line(match, false, processor, ptr, stride, nb_elements);
+      });
+      NLL_FAST_ASSERT(match == counts[chunk + 1], "the predicate must return the same result for both passes!");
+   };
+   parallel_chunks(nb_threads, nb_accesses, fill);
+}
+}
+
+/**
+ @brief Return the indices of the array where the predicate is true, in memory order
+
+ By default, the predicate is called once per element from the calling thread. With an explicit @ref Parallel, the search
+ may use several threads and the predicate must not have side effects (see the two passes above).
  */
 template <class T, size_t N, class Config, class Predicate>
-std::vector<StaticVector<ui32, N>> where(const Array<T, N, Config>& array, Predicate p)
+std::vector<StaticVector<ui32, N>> where(const Array<T, N, Config>& array, Predicate p, const Parallel& parallel = Parallel(1))
 {
    std::vector<StaticVector<ui32, N>> indexes;
-   any<T, N, Config, Predicate>(array, p, nullptr, &indexes);
+   details::WhereIndexes<N> output{indexes};
+   details::where_constarray(array, p, output, parallel);
    return indexes;
 }
 
+/**
+ @brief Return the linear offsets of the elements where the predicate is true, in memory order
+
+ The offset of the element (x, y, z) is x + y * shape[0] + z * shape[0] * shape[1], whatever the memory layout of the array.
+ This is 8 bytes per match instead of the 4 * N bytes of @ref where.
+ */
+template <class T, size_t N, class Config, class Predicate>
+std::vector<size_t> where_offsets(const Array<T, N, Config>& array, Predicate p, const Parallel& parallel = Parallel())
+{
+   std::vector<size_t> offsets;
+   details::WhereOffsets<N> output{offsets};
+   details::where_constarray(array, p, output, parallel);
+   return offsets;
+}
+
+/**
+ @brief Return the indices of the elements where the predicate is true as a coordinate array per dimension, in memory order
+
+ The match i is at (coordinates[0][i], coordinates[1][i], ...)
+ */
+template <class T, size_t N, class Config, class Predicate>
+std::array<std::vector<ui32>, N> where_coordinates(const Array<T, N, Config>& array, Predicate p, const Parallel& parallel = Parallel())
+{
+   std::array<std::vector<ui32>, N> coordinates;
+   details::WhereCoordinates<N> output{coordinates};
+   details::where_constarray(array, p, output, parallel);
+   return coordinates;
+}
+
+/**
+ @brief Convert linear offsets (see @ref where_offsets) to a coordinate array per dimension
+
+ unravel_index([0, 5, 7], shape = (3, 2)) = {[0, 2, 1], [0, 1, 2]}
+ */
+template <size_t N>
+std::array<std::vector<ui32>, N> unravel_index(const std::vector<size_t>& offsets, const StaticVector<ui32, N>& shape, const Parallel& parallel = Parallel())
+{
+   std::array<std::vector<ui32>, N> coordinates;
+   for (auto& c : coordinates)
+   {
+      c.resize(offsets.size());
+   }
+
+   // the 64-bit divisions are several times slower than the 32-bit ones: use them only if the offsets don't fit in 32 bits
+   size_t size = 1;
+   for (size_t n = 0; n < N; ++n)
+   {
+      size *= shape[n];
+   }
+   const bool offsets_32 = size <= std::numeric_limits<ui32>::max();
+
+   auto unravel = [&](ui32, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i)
+      {
+         NLL_FAST_ASSERT(offsets[i] < size, "offset out of bounds!");
+         if (offsets_32)
+         {
+            ui32 offset = static_cast<ui32>(offsets[i]);
+            for (size_t n = 0; n + 1 < N; ++n)
+            {
+               coordinates[n][i] = offset % shape[n];
+               offset /= shape[n];
+            }
+            coordinates[N - 1][i] = offset;
+         }
+         else
+         {
+            size_t offset = offsets[i];
+            for (size_t n = 0; n + 1 < N; ++n)
+            {
+               coordinates[n][i] = static_cast<ui32>(offset % shape[n]);
+               offset /= shape[n];
+            }
+            coordinates[N - 1][i] = static_cast<ui32>(offset);
+         }
+      }
+   };
+
+   const ui32 nb_threads = parallel.nbThreads(offsets.size(), std::numeric_limits<ui32>::max());
+   details::parallel_chunks(nb_threads, offsets.size(), unravel);
+   return coordinates;
+}
+
 DECLARE_NAMESPACE_NLL_END